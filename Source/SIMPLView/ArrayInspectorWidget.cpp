@@ -0,0 +1,412 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ArrayInspectorWidget.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFileInfo>
+#include <QtCore/QLocale>
+#include <QtCore/QTimer>
+#include <QtGui/QPainter>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QProgressBar>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/DREAM3DFileBrowser.h"
+
+namespace
+{
+const int k_BinCount = 64;
+}
+
+/**
+ * @brief The ArrayHistogramView class draws the histogram of an ArrayStatistics::Result as bars scaled to the
+ * fullest bin
+ */
+class ArrayHistogramView : public QWidget
+{
+public:
+  ArrayHistogramView(QWidget* parent = nullptr)
+  : QWidget(parent)
+  {
+    setMinimumHeight(80);
+  }
+
+  void setHistogram(const std::vector<qint64>& histogram)
+  {
+    m_Histogram = histogram;
+    update();
+  }
+
+protected:
+  void paintEvent(QPaintEvent* event) override
+  {
+    Q_UNUSED(event)
+
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+    if(m_Histogram.empty())
+    {
+      return;
+    }
+
+    qint64 maxCount = *std::max_element(m_Histogram.begin(), m_Histogram.end());
+    if(maxCount == 0)
+    {
+      return;
+    }
+
+    double barWidth = static_cast<double>(width()) / m_Histogram.size();
+    for(size_t i = 0; i < m_Histogram.size(); i++)
+    {
+      double barHeight = static_cast<double>(m_Histogram[i]) / maxCount * height();
+      painter.fillRect(QRectF(i * barWidth, height() - barHeight, std::max(1.0, barWidth - 1.0), barHeight), palette().highlight());
+    }
+  }
+
+private:
+  std::vector<qint64> m_Histogram;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArrayInspectorWidget::ArrayInspectorWidget(QWidget* parent)
+: QWidget(parent)
+, m_Watcher(new QFutureWatcher<bool>(this))
+, m_ReadTimer(new QTimer(this))
+{
+  m_ArrayComboBox = new QComboBox(this);
+  m_ComputeButton = new QPushButton(tr("Compute"), this);
+  m_CancelButton = new QPushButton(tr("Cancel"), this);
+  m_ProgressBar = new QProgressBar(this);
+  m_ProgressBar->setRange(0, 0);
+  m_StatusLabel = new QLabel(tr("Browse a .dream3d file to inspect its arrays."), this);
+  m_StatusLabel->setWordWrap(true);
+  m_CountLabel = new QLabel(this);
+  m_NanCountLabel = new QLabel(this);
+  m_MinLabel = new QLabel(this);
+  m_MaxLabel = new QLabel(this);
+  m_MeanLabel = new QLabel(this);
+  m_StdDevLabel = new QLabel(this);
+  m_HistogramView = new ArrayHistogramView(this);
+
+  QHBoxLayout* buttonLayout = new QHBoxLayout();
+  buttonLayout->addWidget(m_ArrayComboBox, 1);
+  buttonLayout->addWidget(m_ComputeButton);
+  buttonLayout->addWidget(m_CancelButton);
+
+  QFormLayout* resultLayout = new QFormLayout();
+  resultLayout->addRow(tr("Values:"), m_CountLabel);
+  resultLayout->addRow(tr("NaN:"), m_NanCountLabel);
+  resultLayout->addRow(tr("Minimum:"), m_MinLabel);
+  resultLayout->addRow(tr("Maximum:"), m_MaxLabel);
+  resultLayout->addRow(tr("Mean:"), m_MeanLabel);
+  resultLayout->addRow(tr("Std. Deviation:"), m_StdDevLabel);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addLayout(buttonLayout);
+  layout->addWidget(m_ProgressBar);
+  layout->addWidget(m_StatusLabel);
+  layout->addLayout(resultLayout);
+  layout->addWidget(m_HistogramView, 1);
+
+  connect(m_ComputeButton, &QPushButton::clicked, this, &ArrayInspectorWidget::computeStatistics);
+  connect(m_CancelButton, &QPushButton::clicked, this, &ArrayInspectorWidget::cancel);
+  connect(m_ArrayComboBox, QOverload<int>::of(&QComboBox::activated), this, &ArrayInspectorWidget::computeStatistics);
+  connect(m_Watcher, &QFutureWatcher<bool>::finished, this, &ArrayInspectorWidget::computationFinished);
+  connect(m_ReadTimer, &QTimer::timeout, this, &ArrayInspectorWidget::readNextChunk);
+
+  m_ReadTimer->setInterval(0);
+
+  setBusy(false);
+  refreshArrays();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArrayInspectorWidget::~ArrayInspectorWidget()
+{
+  cancel();
+  m_Watcher->waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::setFileBrowser(DREAM3DFileBrowser* fileBrowser)
+{
+  m_FileBrowser = fileBrowser;
+  refreshArrays();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::refreshArrays()
+{
+  cancel();
+
+  QString currentPath = m_ArrayComboBox->currentText();
+  m_ArrayComboBox->clear();
+  if(m_FileBrowser != nullptr && m_FileBrowser->isOpen())
+  {
+    for(const DataArrayPath& path : m_FileBrowser->getDataArrayPaths())
+    {
+      m_ArrayComboBox->addItem(path.serialize("/"));
+    }
+    m_ArrayComboBox->setCurrentText(currentPath);
+    m_StatusLabel->clear();
+  }
+  else
+  {
+    m_StatusLabel->setText(tr("Browse a .dream3d file to inspect its arrays."));
+  }
+
+  m_ArrayComboBox->setEnabled(m_ArrayComboBox->count() > 0);
+  m_ComputeButton->setEnabled(m_ArrayComboBox->count() > 0);
+  showResult(nullptr);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ArrayInspectorWidget::cacheKey(const QString& arrayPath) const
+{
+  QString filePath = m_FileBrowser->getFilePath();
+  return QString("%1|%2|%3").arg(filePath).arg(QFileInfo(filePath).lastModified().toMSecsSinceEpoch()).arg(arrayPath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::computeStatistics()
+{
+  cancel();
+  showResult(nullptr);
+
+  QString arrayPath = m_ArrayComboBox->currentText();
+  if(m_FileBrowser == nullptr || !m_FileBrowser->isOpen() || arrayPath.isEmpty())
+  {
+    return;
+  }
+
+  // The key holds the modification time of the file, so statistics that are known are shown without reading anything
+  QString key = cacheKey(arrayPath);
+  if(m_Cache.contains(key))
+  {
+    m_StatusLabel->clear();
+    showResult(&m_Cache[key]);
+    return;
+  }
+
+  DataArrayPath path = DataArrayPath::Deserialize(arrayPath, "/");
+  IDataArray::Pointer structure = m_FileBrowser->getArrayStructure(path);
+  if(!ArrayStatistics::IsSupported(structure))
+  {
+    m_StatusLabel->setText(tr("Statistics are only available for numeric arrays."));
+    return;
+  }
+
+  IDataArray::Pointer array = m_FileBrowser->cachedDataArray(path);
+  std::shared_ptr<std::atomic_bool> cancelled = std::make_shared<std::atomic_bool>(false);
+  std::shared_ptr<ArrayStatistics::Result> result = std::make_shared<ArrayStatistics::Result>();
+  std::shared_ptr<QString> errorMessage = std::make_shared<QString>();
+  m_Cancelled = cancelled;
+  m_PendingResult = result;
+  m_PendingError = errorMessage;
+  m_PendingKey = key;
+
+  m_StatusLabel->setText(tr("Computing statistics of %1...").arg(arrayPath));
+  m_ProgressBar->setRange(0, 0);
+  setBusy(true);
+
+  // Without a thread safe HDF5 an array that is not in the browser's cache is read here, on the GUI thread where
+  // SIMPLib reads files too, one chunk per turn of the event loop
+  if(array == nullptr && !DREAM3DFileBrowser::IsHDF5ThreadSafe())
+  {
+    m_ReadPath = path;
+    m_ReadArray = structure->createNewArray(structure->getNumberOfTuples(), structure->getComponentDimensions(), structure->getName(), true);
+    m_Accumulator = std::make_shared<ArrayStatistics::Accumulator>(m_ReadArray);
+    m_NextChunk = 0;
+    m_ValuesRead = 0;
+    m_ReadTimer->start();
+    return;
+  }
+
+  // Any other array not in the cache is read by the task itself, in chunks it can cancel between
+  QString filePath = m_FileBrowser->getFilePath();
+  m_Watcher->setFuture(QtConcurrent::run([filePath, path, structure, array, cancelled, result, errorMessage] {
+    IDataArray::Pointer values = (array != nullptr) ? array : DREAM3DFileBrowser::ReadDataArray(filePath, path, structure, *cancelled, *errorMessage);
+    return values != nullptr && ArrayStatistics::Compute(values, k_BinCount, *cancelled, *result);
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::cancel()
+{
+  if(m_Cancelled != nullptr)
+  {
+    *m_Cancelled = true;
+    m_StatusLabel->setText(tr("The computation was cancelled."));
+  }
+  m_ReadTimer->stop();
+  m_ReadArray.reset();
+  m_Accumulator.reset();
+  m_Cancelled.reset();
+  m_PendingResult.reset();
+  m_PendingError.reset();
+  m_PendingKey.clear();
+  setBusy(false);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::readNextChunk()
+{
+  if(m_Accumulator == nullptr || m_PendingResult == nullptr)
+  {
+    m_ReadTimer->stop();
+    return;
+  }
+
+  // A pipeline may rewrite the file between two chunks
+  QString errorMessage;
+  bool fileChanged = (cacheKey(m_ReadPath.serialize("/")) != m_PendingKey);
+  size_t chunkCount = 0;
+  size_t valueCount = 0;
+  bool read = !fileChanged && (m_ReadArray->getSize() == 0 ||
+                               (DREAM3DFileBrowser::ReadDataArrayChunk(m_FileBrowser->getFilePath(), m_ReadPath, m_ReadArray, m_NextChunk, chunkCount, valueCount, errorMessage) &&
+                                m_Accumulator->add(m_ValuesRead, valueCount)));
+  if(!read)
+  {
+    QString message = fileChanged ? tr("The file changed while the array was read.") : errorMessage;
+    cancel();
+    m_StatusLabel->setText(message);
+    return;
+  }
+
+  m_NextChunk++;
+  m_ValuesRead += valueCount;
+  if(m_NextChunk < chunkCount)
+  {
+    m_ProgressBar->setRange(0, static_cast<int>(chunkCount));
+    m_ProgressBar->setValue(static_cast<int>(m_NextChunk));
+    return;
+  }
+
+  // Only the histogram is left, and it needs the values in memory but no HDF5
+  m_ReadTimer->stop();
+  m_ProgressBar->setRange(0, 0);
+  std::shared_ptr<ArrayStatistics::Accumulator> accumulator = std::move(m_Accumulator);
+  std::shared_ptr<std::atomic_bool> cancelled = m_Cancelled;
+  std::shared_ptr<ArrayStatistics::Result> result = m_PendingResult;
+  m_ReadArray.reset();
+  m_Watcher->setFuture(QtConcurrent::run([accumulator, cancelled, result] { return accumulator->finish(k_BinCount, *cancelled, *result); }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::computationFinished()
+{
+  // A cancelled computation has already handed its state back through cancel()
+  if(m_PendingResult == nullptr)
+  {
+    return;
+  }
+
+  setBusy(false);
+  if(m_Watcher->result())
+  {
+    m_Cache.insert(m_PendingKey, *m_PendingResult);
+    m_StatusLabel->clear();
+    showResult(m_PendingResult.get());
+  }
+  else
+  {
+    m_StatusLabel->setText(*m_PendingError);
+  }
+
+  m_Cancelled.reset();
+  m_PendingResult.reset();
+  m_PendingError.reset();
+  m_PendingKey.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::showResult(const ArrayStatistics::Result* result)
+{
+  QLocale locale;
+  if(result == nullptr)
+  {
+    for(QLabel* label : {m_CountLabel, m_NanCountLabel, m_MinLabel, m_MaxLabel, m_MeanLabel, m_StdDevLabel})
+    {
+      label->clear();
+    }
+    m_HistogramView->setHistogram(std::vector<qint64>());
+    return;
+  }
+
+  m_CountLabel->setText(locale.toString(result->valueCount));
+  m_NanCountLabel->setText(locale.toString(result->nanCount));
+  m_MinLabel->setText(locale.toString(result->min, 'g', 8));
+  m_MaxLabel->setText(locale.toString(result->max, 'g', 8));
+  m_MeanLabel->setText(locale.toString(result->mean, 'g', 8));
+  m_StdDevLabel->setText(locale.toString(result->stdDev, 'g', 8));
+  m_HistogramView->setHistogram(result->histogram);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ArrayInspectorWidget::setBusy(bool busy)
+{
+  m_ProgressBar->setVisible(busy);
+  m_CancelButton->setEnabled(busy);
+  m_ComputeButton->setEnabled(!busy && m_ArrayComboBox->count() > 0);
+}
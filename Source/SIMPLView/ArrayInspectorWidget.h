@@ -0,0 +1,161 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtWidgets/QWidget>
+
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+
+#include "SIMPLView/ArrayStatistics.h"
+
+class DREAM3DFileBrowser;
+class ArrayHistogramView;
+class QComboBox;
+class QLabel;
+class QProgressBar;
+class QPushButton;
+class QTimer;
+
+/**
+ * @brief The ArrayInspectorWidget class shows the statistics of one array of the file browsed in the Data Structure
+ * dock.  A cancellable background task reads the array in chunks and computes the statistics.  Without a thread
+ * safe HDF5 the chunks are read on the GUI thread instead, one per turn of the event loop, and only the histogram
+ * is left to the background task.  Results
+ * are cached per array and file modification time, so they are recomputed only once a pipeline run has rewritten
+ * the file.
+ */
+class ArrayInspectorWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  ArrayInspectorWidget(QWidget* parent = nullptr);
+  ~ArrayInspectorWidget() override;
+
+  /**
+   * @brief Sets the browser the arrays are read from
+   * @param fileBrowser
+   */
+  void setFileBrowser(DREAM3DFileBrowser* fileBrowser);
+
+  /**
+   * @brief Refills the array list from the browser.  Called whenever the browser opens or closes a file.
+   */
+  void refreshArrays();
+
+public Q_SLOTS:
+  /**
+   * @brief Computes, or takes from the cache, the statistics of the selected array
+   */
+  void computeStatistics();
+
+  /**
+   * @brief Cancels the running computation
+   */
+  void cancel();
+
+private:
+  DREAM3DFileBrowser* m_FileBrowser = nullptr;
+
+  QComboBox* m_ArrayComboBox = nullptr;
+  QPushButton* m_ComputeButton = nullptr;
+  QPushButton* m_CancelButton = nullptr;
+  QProgressBar* m_ProgressBar = nullptr;
+  QLabel* m_StatusLabel = nullptr;
+  QLabel* m_CountLabel = nullptr;
+  QLabel* m_NanCountLabel = nullptr;
+  QLabel* m_MinLabel = nullptr;
+  QLabel* m_MaxLabel = nullptr;
+  QLabel* m_MeanLabel = nullptr;
+  QLabel* m_StdDevLabel = nullptr;
+  ArrayHistogramView* m_HistogramView = nullptr;
+
+  QFutureWatcher<bool>* m_Watcher = nullptr;
+  std::shared_ptr<std::atomic_bool> m_Cancelled;
+  std::shared_ptr<ArrayStatistics::Result> m_PendingResult;
+  std::shared_ptr<QString> m_PendingError;
+  QString m_PendingKey;
+  QHash<QString, ArrayStatistics::Result> m_Cache;
+
+  QTimer* m_ReadTimer = nullptr;
+  DataArrayPath m_ReadPath;
+  IDataArray::Pointer m_ReadArray;
+  std::shared_ptr<ArrayStatistics::Accumulator> m_Accumulator;
+  size_t m_NextChunk = 0;
+  size_t m_ValuesRead = 0;
+
+  /**
+   * @brief Returns the cache key of an array of the browsed file
+   * @param arrayPath
+   * @return
+   */
+  QString cacheKey(const QString& arrayPath) const;
+
+  /**
+   * @brief Reads the next chunk of the array on the GUI thread and adds it to the statistics, then leaves the
+   * histogram to the background task once the whole array has been read
+   */
+  void readNextChunk();
+
+  /**
+   * @brief Stores and shows the result of a finished computation
+   */
+  void computationFinished();
+
+  /**
+   * @brief Shows a result, or clears the display when result is null
+   * @param result
+   */
+  void showResult(const ArrayStatistics::Result* result);
+
+  /**
+   * @brief Switches the buttons and progress bar between the idle and busy states
+   * @param busy
+   */
+  void setBusy(bool busy);
+
+public:
+  ArrayInspectorWidget(const ArrayInspectorWidget&) = delete;            // Copy Constructor Not Implemented
+  ArrayInspectorWidget(ArrayInspectorWidget&&) = delete;                 // Move Constructor Not Implemented
+  ArrayInspectorWidget& operator=(const ArrayInspectorWidget&) = delete; // Copy Assignment Not Implemented
+  ArrayInspectorWidget& operator=(ArrayInspectorWidget&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,378 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ArrayStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+/**
+ * @brief The Moments struct holds the running statistics of one chunk
+ */
+struct ArrayStatistics::Moments
+{
+  qint64 count = 0;
+  qint64 nanCount = 0;
+  double min = std::numeric_limits<double>::max();
+  double max = std::numeric_limits<double>::lowest();
+  double mean = 0.0;
+  double m2 = 0.0; // Sum of squared differences from the mean
+};
+
+namespace
+{
+using ArrayStatistics::Moments;
+
+const size_t k_ChunkSize = 1 << 20; // Values per chunk
+const size_t k_Lanes = 8;           // Independent accumulators per kernel
+
+/**
+ * @brief Combines the moments of two chunks (Chan et al.)
+ */
+Moments Merge(const Moments& a, const Moments& b)
+{
+  if(a.count == 0)
+  {
+    Moments merged = b;
+    merged.nanCount += a.nanCount;
+    return merged;
+  }
+  if(b.count == 0)
+  {
+    Moments merged = a;
+    merged.nanCount += b.nanCount;
+    return merged;
+  }
+
+  Moments merged;
+  merged.count = a.count + b.count;
+  merged.nanCount = a.nanCount + b.nanCount;
+  merged.min = std::min(a.min, b.min);
+  merged.max = std::max(a.max, b.max);
+  double delta = b.mean - a.mean;
+  merged.mean = a.mean + delta * static_cast<double>(b.count) / static_cast<double>(merged.count);
+  merged.m2 = a.m2 + b.m2 + delta * delta * static_cast<double>(a.count) * static_cast<double>(b.count) / static_cast<double>(merged.count);
+  return merged;
+}
+
+/**
+ * @brief Computes the moments of one chunk.  The loops keep k_Lanes independent accumulators and use selects
+ * instead of branches so the compiler can vectorize them.  NaN fails every comparison, which keeps it out of the
+ * minimum and maximum; for integer types the NaN test folds away.
+ */
+template <typename T>
+Moments ComputeMoments(const T* values, size_t count)
+{
+  T lo[k_Lanes];
+  T hi[k_Lanes];
+  double sum[k_Lanes];
+  qint64 nan[k_Lanes];
+  for(size_t lane = 0; lane < k_Lanes; lane++)
+  {
+    lo[lane] = std::numeric_limits<T>::max();
+    hi[lane] = std::numeric_limits<T>::lowest();
+    sum[lane] = 0.0;
+    nan[lane] = 0;
+  }
+
+  size_t blockEnd = count - count % k_Lanes;
+  for(size_t i = 0; i < blockEnd; i += k_Lanes)
+  {
+    for(size_t lane = 0; lane < k_Lanes; lane++)
+    {
+      const T v = values[i + lane];
+      const bool valid = (v == v);
+      nan[lane] += valid ? 0 : 1;
+      sum[lane] += valid ? static_cast<double>(v) : 0.0;
+      lo[lane] = (v < lo[lane]) ? v : lo[lane];
+      hi[lane] = (v > hi[lane]) ? v : hi[lane];
+    }
+  }
+  for(size_t i = blockEnd; i < count; i++)
+  {
+    const T v = values[i];
+    const bool valid = (v == v);
+    nan[0] += valid ? 0 : 1;
+    sum[0] += valid ? static_cast<double>(v) : 0.0;
+    lo[0] = (v < lo[0]) ? v : lo[0];
+    hi[0] = (v > hi[0]) ? v : hi[0];
+  }
+
+  Moments moments;
+  double total = 0.0;
+  for(size_t lane = 0; lane < k_Lanes; lane++)
+  {
+    moments.nanCount += nan[lane];
+    total += sum[lane];
+    moments.min = std::min(moments.min, static_cast<double>(lo[lane]));
+    moments.max = std::max(moments.max, static_cast<double>(hi[lane]));
+  }
+  moments.count = static_cast<qint64>(count) - moments.nanCount;
+  if(moments.count == 0)
+  {
+    return Moments{0, moments.nanCount};
+  }
+  moments.mean = total / static_cast<double>(moments.count);
+
+  // The second pass runs over a chunk that is still in cache and avoids the cancellation of a sum of squares
+  double m2[k_Lanes] = {};
+  for(size_t i = 0; i < blockEnd; i += k_Lanes)
+  {
+    for(size_t lane = 0; lane < k_Lanes; lane++)
+    {
+      const T v = values[i + lane];
+      const double d = (v == v) ? static_cast<double>(v) - moments.mean : 0.0;
+      m2[lane] += d * d;
+    }
+  }
+  for(size_t i = blockEnd; i < count; i++)
+  {
+    const T v = values[i];
+    const double d = (v == v) ? static_cast<double>(v) - moments.mean : 0.0;
+    m2[0] += d * d;
+  }
+  moments.m2 = std::accumulate(m2, m2 + k_Lanes, 0.0);
+  return moments;
+}
+
+/**
+ * @brief Adds the finite values of one chunk to a histogram of evenly spaced bins starting at min.  NaN and
+ * infinities have no bin.  A position that is not below the last bin, including the NaN an infinite min gives,
+ * goes to the last bin, so only positions that fit in an int are converted.
+ */
+template <typename T>
+void ComputeHistogram(const T* values, size_t count, double min, double scale, int binCount, qint64* histogram)
+{
+  const int lastBin = binCount - 1;
+  for(size_t i = 0; i < count; i++)
+  {
+    const double value = static_cast<double>(values[i]);
+    if(std::isfinite(value))
+    {
+      const double position = (value - min) * scale;
+      histogram[position < lastBin ? static_cast<int>(position) : lastBin]++;
+    }
+  }
+}
+
+/**
+ * @brief Fills in the result from the moments of the whole array of a known element type and bins its values
+ */
+template <typename T>
+bool ComputeTypedHistogram(const DataArray<T>& array, const Moments& moments, int binCount, const std::atomic_bool& cancelled, ArrayStatistics::Result& result)
+{
+  result = ArrayStatistics::Result();
+  result.histogram.assign(static_cast<size_t>(std::max(1, binCount)), 0);
+  result.valueCount = moments.count;
+  result.nanCount = moments.nanCount;
+  if(moments.count == 0)
+  {
+    return true;
+  }
+  result.min = moments.min;
+  result.max = moments.max;
+  result.mean = moments.mean;
+  result.stdDev = std::sqrt(moments.m2 / static_cast<double>(moments.count));
+
+  // Each chunk fills its own histogram so the chunks never share a counter
+  const size_t valueCount = array.getSize();
+  const T* values = array.getPointer(0);
+  std::vector<size_t> chunks((valueCount + k_ChunkSize - 1) / k_ChunkSize);
+  std::iota(chunks.begin(), chunks.end(), 0);
+
+  // An infinite range, or one so small its scale overflows, cannot be split into bins
+  const double range = moments.max - moments.min;
+  double scale = range > 0.0 ? result.histogram.size() / range : 0.0;
+  if(!std::isfinite(range) || !std::isfinite(scale))
+  {
+    result.histogram.assign(1, 0);
+    scale = 0.0;
+  }
+  const int bins = static_cast<int>(result.histogram.size());
+  std::vector<std::vector<qint64>> chunkHistograms(chunks.size());
+  QtConcurrent::blockingMap(chunks, [&](size_t chunk) {
+    if(cancelled)
+    {
+      return;
+    }
+    size_t begin = chunk * k_ChunkSize;
+    chunkHistograms[chunk].assign(bins, 0);
+    ComputeHistogram(values + begin, std::min(k_ChunkSize, valueCount - begin), moments.min, scale, bins, chunkHistograms[chunk].data());
+  });
+  if(cancelled)
+  {
+    return false;
+  }
+
+  for(const std::vector<qint64>& chunkHistogram : chunkHistograms)
+  {
+    std::transform(chunkHistogram.begin(), chunkHistogram.end(), result.histogram.begin(), result.histogram.begin(), std::plus<qint64>());
+  }
+  return true;
+}
+
+/**
+ * @brief Computes the statistics of an array of a known element type
+ */
+template <typename T>
+bool ComputeTyped(const DataArray<T>& array, int binCount, const std::atomic_bool& cancelled, ArrayStatistics::Result& result)
+{
+  const size_t valueCount = array.getSize();
+  if(valueCount == 0)
+  {
+    return ComputeTypedHistogram(array, Moments(), binCount, cancelled, result);
+  }
+  const T* values = array.getPointer(0);
+
+  std::vector<size_t> chunks((valueCount + k_ChunkSize - 1) / k_ChunkSize);
+  std::iota(chunks.begin(), chunks.end(), 0);
+
+  std::vector<Moments> chunkMoments(chunks.size());
+  QtConcurrent::blockingMap(chunks, [&](size_t chunk) {
+    if(cancelled)
+    {
+      return;
+    }
+    size_t begin = chunk * k_ChunkSize;
+    chunkMoments[chunk] = ComputeMoments(values + begin, std::min(k_ChunkSize, valueCount - begin));
+  });
+  if(cancelled)
+  {
+    return false;
+  }
+
+  Moments moments;
+  for(const Moments& chunk : chunkMoments)
+  {
+    moments = Merge(moments, chunk);
+  }
+  return ComputeTypedHistogram(array, moments, binCount, cancelled, result);
+}
+
+/**
+ * @brief Calls function with the array as the DataArray of its element type
+ * @return False if the array holds none of the element types the kernels handle
+ */
+template <typename Function>
+bool Dispatch(const IDataArray::Pointer& array, Function&& function)
+{
+  auto visit = [&](auto element) {
+    using T = decltype(element);
+    auto typedArray = std::dynamic_pointer_cast<DataArray<T>>(array);
+    if(typedArray == nullptr)
+    {
+      return false;
+    }
+    function(*typedArray);
+    return true;
+  };
+  return visit(int8_t()) || visit(uint8_t()) || visit(int16_t()) || visit(uint16_t()) || visit(int32_t()) || visit(uint32_t()) || visit(int64_t()) || visit(uint64_t()) ||
+         visit(float()) || visit(double()) || visit(bool());
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArrayStatistics::IsSupported(const IDataArray::Pointer& array)
+{
+  return std::dynamic_pointer_cast<Int8ArrayType>(array) || std::dynamic_pointer_cast<UInt8ArrayType>(array) || std::dynamic_pointer_cast<Int16ArrayType>(array) ||
+         std::dynamic_pointer_cast<UInt16ArrayType>(array) || std::dynamic_pointer_cast<Int32ArrayType>(array) || std::dynamic_pointer_cast<UInt32ArrayType>(array) ||
+         std::dynamic_pointer_cast<Int64ArrayType>(array) || std::dynamic_pointer_cast<UInt64ArrayType>(array) || std::dynamic_pointer_cast<FloatArrayType>(array) ||
+         std::dynamic_pointer_cast<DoubleArrayType>(array) || std::dynamic_pointer_cast<BoolArrayType>(array);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArrayStatistics::Compute(const IDataArray::Pointer& array, int binCount, const std::atomic_bool& cancelled, Result& result)
+{
+  bool success = false;
+  bool matched = Dispatch(array, [&](const auto& typedArray) { success = ComputeTyped(typedArray, binCount, cancelled, result); });
+  return matched && success;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArrayStatistics::Accumulator::Accumulator(const IDataArray::Pointer& array)
+: m_Array(array)
+, m_Moments(std::make_unique<Moments>())
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ArrayStatistics::Accumulator::~Accumulator() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArrayStatistics::Accumulator::add(size_t begin, size_t count)
+{
+  if(m_Array == nullptr || begin + count > m_Array->getSize())
+  {
+    return false;
+  }
+  if(count == 0)
+  {
+    return IsSupported(m_Array);
+  }
+
+  // The chunks of a read are larger than those of the kernels, so they are split the same way Compute splits
+  return Dispatch(m_Array, [&](const auto& typedArray) {
+    for(size_t offset = 0; offset < count; offset += k_ChunkSize)
+    {
+      *m_Moments = Merge(*m_Moments, ComputeMoments(typedArray.getPointer(begin + offset), std::min(k_ChunkSize, count - offset)));
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ArrayStatistics::Accumulator::finish(int binCount, const std::atomic_bool& cancelled, Result& result) const
+{
+  bool success = false;
+  bool matched = Dispatch(m_Array, [&](const auto& typedArray) { success = ComputeTypedHistogram(typedArray, *m_Moments, binCount, cancelled, result); });
+  return matched && success;
+}
@@ -0,0 +1,122 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+
+/**
+ * @brief The ArrayStatistics namespace computes summary statistics of a numeric data array: minimum, maximum,
+ * mean, standard deviation, NaN count and a histogram.  All components of all tuples are treated as one set of
+ * values.  The array is split into fixed size chunks that are processed in parallel by kernels specialized for
+ * each element type; each chunk checks the cancel flag before it starts.
+ */
+namespace ArrayStatistics
+{
+struct Result
+{
+  qint64 valueCount = 0; // Values that are not NaN
+  qint64 nanCount = 0;
+  double min = 0.0;
+  double max = 0.0;
+  double mean = 0.0;
+  double stdDev = 0.0;
+  std::vector<qint64> histogram; // Evenly spaced bins from min to max of the finite values, or one bin if the range is infinite
+};
+
+/**
+ * @brief Returns true if the array holds one of the numeric element types the kernels handle
+ * @param array
+ * @return
+ */
+bool IsSupported(const IDataArray::Pointer& array);
+
+/**
+ * @brief Computes the statistics of the array.  May be called from any thread.
+ * @param array
+ * @param binCount
+ * @param cancelled
+ * @param result
+ * @return False if the computation was cancelled or the array is not supported
+ */
+bool Compute(const IDataArray::Pointer& array, int binCount, const std::atomic_bool& cancelled, Result& result);
+
+struct Moments;
+
+/**
+ * @brief The Accumulator class computes the statistics of an array whose values arrive a chunk at a time, such as
+ * while it is read from a file on the GUI thread.  The moments of each chunk are merged in as it is added; the
+ * histogram needs the final range, so finish bins the whole array afterwards and may be called from any thread.
+ */
+class Accumulator
+{
+public:
+  Accumulator(const IDataArray::Pointer& array);
+  ~Accumulator();
+
+  /**
+   * @brief Adds values of the array that were just filled in
+   * @param begin Index of the first value
+   * @param count
+   * @return False if the array is not supported or the values are not all in it
+   */
+  bool add(size_t begin, size_t count);
+
+  /**
+   * @brief Computes the statistics once every value has been added
+   * @param binCount
+   * @param cancelled
+   * @param result
+   * @return False if the computation was cancelled or the array is not supported
+   */
+  bool finish(int binCount, const std::atomic_bool& cancelled, Result& result) const;
+
+private:
+  IDataArray::Pointer m_Array;
+  std::unique_ptr<Moments> m_Moments;
+
+public:
+  Accumulator(const Accumulator&) = delete;            // Copy Constructor Not Implemented
+  Accumulator(Accumulator&&) = delete;                 // Move Constructor Not Implemented
+  Accumulator& operator=(const Accumulator&) = delete; // Copy Assignment Not Implemented
+  Accumulator& operator=(Accumulator&&) = delete;      // Move Assignment Not Implemented
+};
+} // namespace ArrayStatistics
@@ -0,0 +1,1104 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "BatchQueue.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QLocale>
+#include <QtCore/QTimer>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/DREAM3DPipelineReader.h"
+#include "SIMPLView/ExecutionScheduler.h"
+#include "SIMPLView/FilterTimingStore.h"
+#include "SIMPLView/InputPrefetcher.h"
+#include "SIMPLView/PipelineExecution.h"
+#include "SIMPLView/PipelineFileFormat.h"
+#include "SIMPLView/PipelineFileLoader.h"
+#include "SIMPLView/ProcessMemory.h"
+#include "SIMPLView/RunHistory.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue::BatchQueue(ExecutionScheduler* scheduler, ProcessPool* processPool, RunHistory* runHistory, QObject* parent)
+: QObject(parent)
+, m_Scheduler(scheduler)
+, m_ProcessPool(processPool)
+, m_RunHistory(runHistory)
+{
+  m_Prefetcher = new InputPrefetcher(this);
+  readSettings();
+  m_ProcessPool->setSize(m_Concurrency);
+
+  m_MemoryTimer = new QTimer(this);
+  m_MemoryTimer->setInterval(SIMPLView::Batch::MemorySampleInterval);
+  connect(m_MemoryTimer, &QTimer::timeout, this, &BatchQueue::sampleMemory);
+
+  connect(m_Scheduler, &ExecutionScheduler::jobStarted, this, &BatchQueue::schedulerJobStarted);
+  connect(m_Scheduler, &ExecutionScheduler::jobFinished, this, &BatchQueue::schedulerJobFinished);
+  connect(m_Scheduler, &ExecutionScheduler::cancelRequested, this, &BatchQueue::schedulerCancelRequested);
+  connect(m_ProcessPool, &ProcessPool::jobFinished, this, &BatchQueue::poolJobFinished);
+  connect(m_ProcessPool, &ProcessPool::jobProgress, this, &BatchQueue::poolJobProgress);
+  connect(m_ProcessPool, &ProcessPool::jobMessage, this, &BatchQueue::poolJobMessage);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue::~BatchQueue()
+{
+  // The scheduler and the pool are destroyed after the queue, so they must not call back into it
+  disconnect(m_Scheduler, nullptr, this, nullptr);
+  disconnect(m_ProcessPool, nullptr, this, nullptr);
+  for(auto& entry : m_ActiveRuns)
+  {
+    // Staging finishes on its worker thread; the stager is kept alive by it
+    if(entry.second.staging)
+    {
+      continue;
+    }
+
+    // A scheduler job that runs in the pool only ends when it is finished
+    if(entry.second.poolJobId >= 0)
+    {
+      m_ProcessPool->cancel(entry.second.poolJobId);
+      m_Scheduler->finish(entry.second.schedulerJobId);
+    }
+    else
+    {
+      m_Scheduler->cancel(entry.second.schedulerJobId);
+    }
+    delete entry.second.execution;
+  }
+  m_ActiveRuns.clear();
+
+  // Deleting an execution waits for its writes, so no result file is left half written
+  for(auto& entry : m_WritingExecutions)
+  {
+    delete entry.second;
+  }
+  m_WritingExecutions.clear();
+
+  // Outputs that are still copied back are finished before the application exits, as it waits for the global
+  // thread pool
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::CanQueue(const QString& filePath)
+{
+  return QFileInfo(filePath).isFile() && PipelineFileLoader::CanLoad(filePath);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::ReadPipelineFile(const QString& filePath, QJsonObject& pipeline, QString& errorMessage)
+{
+  if(QFileInfo(filePath).suffix().compare("dream3d", Qt::CaseInsensitive) != 0)
+  {
+    return PipelineFileFormat::ReadFile(filePath, pipeline, errorMessage);
+  }
+
+  QByteArray json;
+  if(!DREAM3DPipelineReader::ReadPipelineJson(filePath, json, errorMessage))
+  {
+    return false;
+  }
+  return PipelineFileFormat::FromJson(json, pipeline, errorMessage);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<int> BatchQueue::addFiles(const QStringList& filePaths)
+{
+  QList<int> jobIds;
+  for(const QString& filePath : filePaths)
+  {
+    if(!CanQueue(filePath))
+    {
+      continue;
+    }
+
+    Job job;
+    job.id = m_NextJobId++;
+    job.filePath = QFileInfo(filePath).absoluteFilePath();
+    m_Jobs.push_back(job);
+    jobIds.push_back(job.id);
+  }
+
+  if(!jobIds.isEmpty())
+  {
+    Q_EMIT jobsChanged();
+    dispatch();
+  }
+  return jobIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::retry(int jobId)
+{
+  Job* job = findJob(jobId);
+  if(nullptr == job || (job->status != Status::Failed && job->status != Status::Cancelled))
+  {
+    return;
+  }
+
+  job->status = Status::Waiting;
+  job->elapsedMilliseconds = 0;
+  job->peakMemory = 0;
+  job->progress = -1;
+  job->message.clear();
+  Q_EMIT jobsChanged();
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::cancel(int jobId)
+{
+  Job* job = findJob(jobId);
+  if(nullptr == job)
+  {
+    return;
+  }
+
+  if(job->status == Status::Waiting)
+  {
+    job->status = Status::Cancelled;
+    m_Prefetcher->release(jobId);
+    Q_EMIT jobsChanged();
+    return;
+  }
+
+  // The job is settled in schedulerJobFinished once the scheduler ended it, or in stagingFinished
+  auto active = m_ActiveRuns.find(jobId);
+  if(active != m_ActiveRuns.end() && active->second.staging)
+  {
+    active->second.cancelRequested = true;
+  }
+  else if(active != m_ActiveRuns.end())
+  {
+    m_Scheduler->cancel(active->second.schedulerJobId);
+  }
+
+  auto writing = m_WritingExecutions.find(jobId);
+  if(writing != m_WritingExecutions.end())
+  {
+    writing->second->cancel();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::remove(int jobId)
+{
+  // An active job is removed once the scheduler ended it, so its execution is not deleted while it runs
+  auto active = m_ActiveRuns.find(jobId);
+  if(active != m_ActiveRuns.end())
+  {
+    active->second.removeWhenEnded = true;
+    if(!active->second.staging)
+    {
+      m_Scheduler->cancel(active->second.schedulerJobId);
+    }
+    return;
+  }
+
+  auto iter = std::find_if(m_Jobs.begin(), m_Jobs.end(), [jobId](const Job& job) { return job.id == jobId; });
+  if(iter != m_Jobs.end())
+  {
+    m_Jobs.erase(iter);
+    m_Prefetcher->release(jobId);
+    Q_EMIT jobsChanged();
+  }
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::clearFinished()
+{
+  auto newEnd = std::remove_if(m_Jobs.begin(), m_Jobs.end(),
+                               [](const Job& job) { return job.status == Status::Succeeded || job.status == Status::Failed || job.status == Status::Cancelled; });
+  if(newEnd != m_Jobs.end())
+  {
+    m_Jobs.erase(newEnd, m_Jobs.end());
+    Q_EMIT jobsChanged();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setRunning(bool running)
+{
+  if(m_Running == running)
+  {
+    return;
+  }
+  m_Running = running;
+  Q_EMIT runningChanged(m_Running);
+
+  // The workers load the plugins while the first jobs are read and preflighted
+  if(m_Running && m_Isolated)
+  {
+    m_ProcessPool->warmUp();
+  }
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::isRunning() const
+{
+  return m_Running;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setConcurrency(int concurrency)
+{
+  m_Concurrency = std::max(concurrency, 1);
+  m_ProcessPool->setSize(m_Concurrency);
+  writeSettings();
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int BatchQueue::getConcurrency() const
+{
+  return m_Concurrency;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setIsolated(bool isolated)
+{
+  m_Isolated = isolated;
+  writeSettings();
+  if(m_Isolated)
+  {
+    m_ProcessPool->warmUp();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::isIsolated() const
+{
+  return m_Isolated;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setPrefetchBudget(qint64 bytes)
+{
+  m_Prefetcher->setBudget(bytes);
+  writeSettings();
+  prefetchUpcoming();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 BatchQueue::getPrefetchBudget() const
+{
+  return m_Prefetcher->getBudget();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setBackgroundWrites(bool background)
+{
+  m_BackgroundWrites = background;
+  writeSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::getBackgroundWrites() const
+{
+  return m_BackgroundWrites;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::setScratchDirectory(const QString& scratchDirectory)
+{
+  // Jobs that stage or copy back keep the stager they started with
+  if(scratchDirectory.isEmpty())
+  {
+    m_Stager.reset();
+  }
+  else if(nullptr == m_Stager || m_Stager->getScratchDirectory() != scratchDirectory)
+  {
+    m_Stager = std::make_shared<ScratchStager>(scratchDirectory);
+  }
+  writeSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString BatchQueue::getScratchDirectory() const
+{
+  return nullptr != m_Stager ? m_Stager->getScratchDirectory() : QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<BatchQueue::Job> BatchQueue::getJobs() const
+{
+  return m_Jobs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::hasActiveJobs() const
+{
+  return !m_ActiveRuns.empty() || !m_WritingExecutions.empty() || !m_StagingPlans.empty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue::Job* BatchQueue::findJob(int jobId)
+{
+  auto iter = std::find_if(m_Jobs.begin(), m_Jobs.end(), [jobId](const Job& job) { return job.id == jobId; });
+  return iter != m_Jobs.end() ? &(*iter) : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::dispatch()
+{
+  if(!m_Running)
+  {
+    return;
+  }
+
+  bool changed = false;
+  for(Job& job : m_Jobs)
+  {
+    if(m_ActiveRuns.size() >= static_cast<size_t>(m_Concurrency))
+    {
+      break;
+    }
+    if(job.status == Status::Waiting)
+    {
+      resetJob(job);
+      bool started = (nullptr != m_Stager) ? startStaging(job) : submitJob(job);
+      if(!started)
+      {
+        m_Prefetcher->release(job.id);
+      }
+      changed = true;
+    }
+  }
+
+  if(changed)
+  {
+    Q_EMIT jobsChanged();
+  }
+  prefetchUpcoming();
+
+  // The queue stops by itself once everything was handed out and has ended
+  if(m_ActiveRuns.empty() && std::none_of(m_Jobs.cbegin(), m_Jobs.cend(), [](const Job& job) { return job.status == Status::Waiting; }))
+  {
+    m_Running = false;
+    Q_EMIT runningChanged(m_Running);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::resetJob(Job& job)
+{
+  job.attempts++;
+  job.elapsedMilliseconds = 0;
+  job.peakMemory = 0;
+  job.processPeakMemory = false;
+  job.progress = -1;
+  job.message.clear();
+  job.prefetchedBytes = 0;
+  job.prefetchReadMilliseconds = 0;
+  job.prefetchOverlappedMilliseconds = 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::submitJob(Job& job)
+{
+  QJsonObject pipelineJson;
+  auto plan = m_StagingPlans.find(job.id);
+  if(plan != m_StagingPlans.end())
+  {
+    pipelineJson = plan->second.plan.pipeline;
+  }
+  else if(!ReadPipelineFile(job.filePath, pipelineJson, job.message))
+  {
+    job.status = Status::Failed;
+    return false;
+  }
+
+  ExecutionScheduler::PreparedRun preparedRun;
+  QString name = QFileInfo(job.filePath).fileName();
+  if(!m_Scheduler->prepareRun(pipelineJson, name, m_Concurrency, preparedRun, job.message))
+  {
+    job.status = Status::Failed;
+    return false;
+  }
+
+  ActiveRun run;
+  run.pipelineHash = RunHistory::PipelineHash(pipelineJson);
+  run.inputBytes = RunHistory::InputBytes(pipelineJson);
+  run.threads = preparedRun.threads;
+  if(m_Isolated)
+  {
+    // The worker reads the pipeline itself, so only its JSON is kept until the scheduler starts the job
+    int jobId = job.id;
+    run.pipeline = pipelineJson;
+    run.schedulerJobId =
+        m_Scheduler->submit(name, tr("Batch Queue"), ExecutionScheduler::Priority::Batch, preparedRun.threads, preparedRun.memory, [this, jobId](int) { startIsolatedRun(jobId); });
+  }
+  else
+  {
+    run.execution = new PipelineExecution(preparedRun.pipeline, this);
+    run.execution->setDeferredWrites(m_BackgroundWrites);
+    run.execution->setTimingStore(FilterTimingStore::Instance());
+    run.schedulerJobId = m_Scheduler->submitPreparedRun(preparedRun, tr("Batch Queue"), run.execution);
+  }
+  job.processPeakMemory = !m_Isolated;
+  m_ActiveRuns[job.id] = run;
+
+  job.status = Status::Queued;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::schedulerJobStarted(int schedulerJobId)
+{
+  auto active = std::find_if(m_ActiveRuns.cbegin(), m_ActiveRuns.cend(), [schedulerJobId](const std::pair<const int, ActiveRun>& entry) {
+    return entry.second.schedulerJobId == schedulerJobId;
+  });
+  Job* job = active != m_ActiveRuns.cend() ? findJob(active->first) : nullptr;
+  if(nullptr == job)
+  {
+    return;
+  }
+
+  job->status = Status::Running;
+
+  // What was not prefetched by now is read by the pipeline itself
+  InputPrefetcher::Statistics statistics = m_Prefetcher->release(job->id);
+  job->prefetchedBytes = statistics.bytes;
+  job->prefetchReadMilliseconds = statistics.readMilliseconds;
+  job->prefetchOverlappedMilliseconds = statistics.overlappedMilliseconds;
+  updateComputeActive();
+  prefetchUpcoming();
+
+  if(nullptr != active->second.execution)
+  {
+    job->peakMemory = ProcessMemory::CurrentResidentBytes();
+    if(!m_MemoryTimer->isActive())
+    {
+      m_MemoryTimer->start();
+    }
+  }
+  Q_EMIT jobsChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::schedulerJobFinished(int schedulerJobId)
+{
+  auto active = std::find_if(m_ActiveRuns.begin(), m_ActiveRuns.end(), [schedulerJobId](const std::pair<const int, ActiveRun>& entry) {
+    return entry.second.schedulerJobId == schedulerJobId;
+  });
+  if(active == m_ActiveRuns.end())
+  {
+    return;
+  }
+
+  sampleMemory();
+
+  int jobId = active->first;
+  ActiveRun run = active->second;
+  PipelineExecution* execution = run.execution;
+  m_ActiveRuns.erase(active);
+  m_Prefetcher->release(jobId);
+
+  Job* job = findJob(jobId);
+  bool ran = nullptr != job && job->status == Status::Running;
+  if(run.removeWhenEnded && nullptr != job)
+  {
+    m_Jobs.erase(m_Jobs.begin() + (job - m_Jobs.data()));
+    job = nullptr;
+  }
+  else if(nullptr != job && nullptr == execution)
+  {
+    // The progress and status messages of the run are stale once it ended
+    job->progress = -1;
+    job->message.clear();
+
+    // An isolated run without a result was cancelled before the pool ran it
+    if(job->status != Status::Running || !run.hasResult || run.result.cancelled)
+    {
+      job->status = Status::Cancelled;
+    }
+    else if(!run.result.succeeded)
+    {
+      job->status = Status::Failed;
+      job->message = run.result.errorMessages.value(0, tr("The pipeline failed."));
+    }
+    else
+    {
+      job->status = Status::Succeeded;
+    }
+    job->elapsedMilliseconds = run.result.elapsedMilliseconds;
+    job->peakMemory = run.result.peakMemory;
+  }
+  else if(nullptr != job)
+  {
+    QStringList errors = execution->getErrorMessages();
+    job->elapsedMilliseconds = execution->getElapsedMilliseconds();
+
+    // A job that is cancelled while it waits in the scheduler never ran
+    if(job->status != Status::Running || execution->wasCancelled())
+    {
+      job->status = Status::Cancelled;
+    }
+    else if(!errors.isEmpty())
+    {
+      job->status = Status::Failed;
+      job->message = errors.front();
+    }
+    else
+    {
+      job->status = execution->isWriting() ? Status::Writing : Status::Succeeded;
+    }
+  }
+  if(ran && nullptr != job)
+  {
+    recordRun(run, *job);
+  }
+
+  // An execution that still writes is kept until its files are written; deleting it would wait for them here
+  if(nullptr != execution && execution->isWriting())
+  {
+    m_WritingExecutions[jobId] = execution;
+    connect(execution, &PipelineExecution::writesFinished, this, [this, jobId] { writesFinished(jobId); });
+  }
+  else
+  {
+    ExecutionScheduler::ReleaseExecution(execution);
+  }
+
+  if(std::none_of(m_Jobs.cbegin(), m_Jobs.cend(), [](const Job& job) { return job.status == Status::Running; }))
+  {
+    m_MemoryTimer->stop();
+  }
+  updateComputeActive();
+  finishStagedRun(jobId);
+
+  Q_EMIT jobsChanged();
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::writesFinished(int jobId)
+{
+  auto writing = m_WritingExecutions.find(jobId);
+  if(writing == m_WritingExecutions.end())
+  {
+    return;
+  }
+  PipelineExecution* execution = writing->second;
+  m_WritingExecutions.erase(writing);
+
+  Job* job = findJob(jobId);
+  if(nullptr != job && job->status == Status::Writing)
+  {
+    QStringList errors = execution->getWriteErrorMessages();
+    if(!errors.isEmpty())
+    {
+      job->status = Status::Failed;
+      job->message = tr("Writing the results failed: %1").arg(errors.front());
+    }
+    else if(execution->wasCancelled())
+    {
+      job->status = Status::Cancelled;
+      job->message = tr("Writing the results was cancelled.");
+    }
+    else
+    {
+      job->status = Status::Succeeded;
+      job->message = tr("Results written in %1 s").arg(QLocale().toString(execution->getWriteMilliseconds() / 1000.0, 'f', 1));
+    }
+    finishStagedRun(jobId);
+    Q_EMIT jobsChanged();
+  }
+  else
+  {
+    finishStagedRun(jobId);
+  }
+
+  // The execution is still inside its writesFinished signal
+  execution->deleteLater();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool BatchQueue::startStaging(Job& job)
+{
+  QJsonObject pipelineJson;
+  if(!ReadPipelineFile(job.filePath, pipelineJson, job.message))
+  {
+    job.status = Status::Failed;
+    return false;
+  }
+
+  int jobId = job.id;
+  ScratchStager::Plan plan = m_Stager->createPlan(pipelineJson, QFileInfo(job.filePath).completeBaseName());
+  ActiveRun run;
+  run.staging = true;
+  m_ActiveRuns[jobId] = run;
+  job.status = Status::Staging;
+
+  // The copies run on a worker thread so the window stays responsive while large inputs cross the network
+  std::shared_ptr<ScratchStager> stager = m_Stager;
+  QFutureWatcher<QString>* watcher = new QFutureWatcher<QString>(this);
+  connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, jobId, stager, plan] {
+    stagingFinished(jobId, stager, plan, watcher->result());
+    watcher->deleteLater();
+  });
+  watcher->setFuture(QtConcurrent::run([stager, plan] {
+    QString errorMessage;
+    stager->stageInputs(plan, errorMessage);
+    return errorMessage;
+  }));
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::stagingFinished(int jobId, const std::shared_ptr<ScratchStager>& stager, const ScratchStager::Plan& plan, const QString& errorMessage)
+{
+  auto active = m_ActiveRuns.find(jobId);
+  if(active == m_ActiveRuns.end())
+  {
+    return;
+  }
+  ActiveRun run = active->second;
+  m_ActiveRuns.erase(active);
+
+  Job* job = findJob(jobId);
+  if(nullptr == job)
+  {
+    dispatch();
+    return;
+  }
+
+  // A failed staging holds no inputs
+  StagedRun stagedRun;
+  stagedRun.stager = errorMessage.isEmpty() ? stager : nullptr;
+  stagedRun.plan = plan;
+  m_StagingPlans[jobId] = stagedRun;
+  if(run.removeWhenEnded)
+  {
+    m_Jobs.erase(m_Jobs.begin() + (job - m_Jobs.data()));
+  }
+  else if(run.cancelRequested)
+  {
+    job->status = Status::Cancelled;
+  }
+  else if(!errorMessage.isEmpty())
+  {
+    job->status = Status::Failed;
+    job->message = tr("Staging the inputs failed: %1").arg(errorMessage);
+  }
+  else if(submitJob(*job))
+  {
+    // The job keeps its plan until its outputs are copied back
+    Q_EMIT jobsChanged();
+    dispatch();
+    return;
+  }
+
+  discardStagingPlan(jobId);
+  m_Prefetcher->release(jobId);
+  Q_EMIT jobsChanged();
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::finishStagedRun(int jobId)
+{
+  auto plan = m_StagingPlans.find(jobId);
+  if(plan == m_StagingPlans.end())
+  {
+    return;
+  }
+
+  // A job that still writes in the background is copied back once its files are written
+  Job* job = findJob(jobId);
+  if(nullptr != job && job->status == Status::Writing)
+  {
+    return;
+  }
+  if(nullptr == job || job->status != Status::Succeeded)
+  {
+    discardStagingPlan(jobId);
+    return;
+  }
+
+  // The copy back only reads the outputs, so the staged inputs can be replaced again
+  if(nullptr != plan->second.stager)
+  {
+    plan->second.stager->releaseInputs(plan->second.plan);
+    plan->second.stager.reset();
+  }
+
+  job->status = Status::Writing;
+  ScratchStager::Plan stagedPlan = plan->second.plan;
+  QFutureWatcher<QString>* watcher = new QFutureWatcher<QString>(this);
+  connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, jobId] {
+    copyBackFinished(jobId, watcher->result());
+    watcher->deleteLater();
+  });
+  watcher->setFuture(QtConcurrent::run([stagedPlan] {
+    QString errorMessage;
+    ScratchStager::CopyOutputsBack(stagedPlan, errorMessage);
+    return errorMessage;
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::copyBackFinished(int jobId, const QString& errorMessage)
+{
+  m_StagingPlans.erase(jobId);
+
+  Job* job = findJob(jobId);
+  if(nullptr != job && job->status == Status::Writing)
+  {
+    if(errorMessage.isEmpty())
+    {
+      job->status = Status::Succeeded;
+    }
+    else
+    {
+      job->status = Status::Failed;
+      job->message = tr("Copying the results back failed: %1").arg(errorMessage);
+    }
+    Q_EMIT jobsChanged();
+  }
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::recordRun(const ActiveRun& run, const Job& job)
+{
+  if(nullptr == m_RunHistory)
+  {
+    return;
+  }
+
+  RunHistory::Run record;
+  record.pipelineHash = run.pipelineHash;
+  record.pipelineName = QFileInfo(job.filePath).fileName();
+  record.threads = run.threads;
+  record.inputBytes = run.inputBytes;
+  record.elapsedMilliseconds = job.elapsedMilliseconds;
+  record.peakMemory = job.peakMemory;
+
+  // The results of a run that is still writing are not known yet, but its compute time is
+  record.succeeded = job.status == Status::Succeeded || job.status == Status::Writing;
+  if(nullptr != run.execution && nullptr != run.execution->getTimingRecorder())
+  {
+    record.filters = RunHistory::FilterRuns(*run.execution->getTimingRecorder());
+  }
+  m_RunHistory->record(record);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::discardStagingPlan(int jobId)
+{
+  auto plan = m_StagingPlans.find(jobId);
+  if(plan == m_StagingPlans.end())
+  {
+    return;
+  }
+
+  // The staged inputs stay for the next run; only the outputs of this one are dropped
+  if(nullptr != plan->second.stager)
+  {
+    plan->second.stager->releaseInputs(plan->second.plan);
+  }
+  QString runDirectory = plan->second.plan.runDirectory;
+  m_StagingPlans.erase(plan);
+  QtConcurrent::run([runDirectory] { QDir(runDirectory).removeRecursively(); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::startIsolatedRun(int jobId)
+{
+  auto active = m_ActiveRuns.find(jobId);
+  if(active == m_ActiveRuns.end())
+  {
+    return;
+  }
+  active->second.poolJobId = m_ProcessPool->submit(active->second.pipeline);
+  active->second.pipeline = QJsonObject();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::schedulerCancelRequested(int schedulerJobId)
+{
+  auto active = std::find_if(m_ActiveRuns.cbegin(), m_ActiveRuns.cend(), [schedulerJobId](const std::pair<const int, ActiveRun>& entry) {
+    return entry.second.schedulerJobId == schedulerJobId;
+  });
+  if(active != m_ActiveRuns.cend() && active->second.poolJobId >= 0)
+  {
+    m_ProcessPool->cancel(active->second.poolJobId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::poolJobFinished(int poolJobId, const ProcessPool::Result& result)
+{
+  auto active = std::find_if(m_ActiveRuns.begin(), m_ActiveRuns.end(), [poolJobId](const std::pair<const int, ActiveRun>& entry) {
+    return entry.second.poolJobId == poolJobId;
+  });
+  if(active == m_ActiveRuns.end())
+  {
+    return;
+  }
+
+  // The job is settled in schedulerJobFinished, like the jobs that run in the application
+  active->second.hasResult = true;
+  active->second.result = result;
+  m_Scheduler->finish(active->second.schedulerJobId);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::poolJobProgress(int poolJobId, int percent)
+{
+  auto active = std::find_if(m_ActiveRuns.cbegin(), m_ActiveRuns.cend(), [poolJobId](const std::pair<const int, ActiveRun>& entry) {
+    return entry.second.poolJobId == poolJobId;
+  });
+  Job* job = active != m_ActiveRuns.cend() ? findJob(active->first) : nullptr;
+  percent = qBound(0, percent, 100);
+  if(nullptr == job || job->status != Status::Running || job->progress == percent)
+  {
+    return;
+  }
+
+  job->progress = percent;
+  Q_EMIT jobsChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::poolJobMessage(int poolJobId, const QString& message)
+{
+  auto active = std::find_if(m_ActiveRuns.cbegin(), m_ActiveRuns.cend(), [poolJobId](const std::pair<const int, ActiveRun>& entry) {
+    return entry.second.poolJobId == poolJobId;
+  });
+  Job* job = active != m_ActiveRuns.cend() ? findJob(active->first) : nullptr;
+  if(nullptr == job || job->status != Status::Running || job->message == message)
+  {
+    return;
+  }
+
+  job->message = message;
+  Q_EMIT jobsChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::sampleMemory()
+{
+  // The pipelines share the process, so this is the peak of the process and concurrent jobs see each other's memory
+  qint64 resident = ProcessMemory::CurrentResidentBytes();
+  for(Job& job : m_Jobs)
+  {
+    auto active = m_ActiveRuns.find(job.id);
+    if(job.status == Status::Running && active != m_ActiveRuns.end() && nullptr != active->second.execution)
+    {
+      job.peakMemory = std::max(job.peakMemory, resident);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::prefetchUpcoming()
+{
+  if(!m_Running || m_Prefetcher->getBudget() == 0)
+  {
+    return;
+  }
+
+  // The jobs that start next are the queued ones and, behind them, the first waiting ones
+  int lookahead = m_Concurrency;
+  for(const Job& job : m_Jobs)
+  {
+    if(lookahead <= 0)
+    {
+      break;
+    }
+    if(job.status != Status::Queued && job.status != Status::Waiting)
+    {
+      continue;
+    }
+    lookahead--;
+    if(m_Prefetcher->contains(job.id))
+    {
+      continue;
+    }
+
+    // A pipeline that cannot be read gets no files; the job reports the error once it is submitted
+    QJsonObject pipeline;
+    QString errorMessage;
+    QStringList filePaths;
+    if(ReadPipelineFile(job.filePath, pipeline, errorMessage))
+    {
+      filePaths = InputPrefetcher::FindInputFiles(pipeline);
+    }
+    m_Prefetcher->prefetch(job.id, filePaths);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::updateComputeActive()
+{
+  m_Prefetcher->setComputeActive(std::any_of(m_Jobs.cbegin(), m_Jobs.cend(), [](const Job& job) { return job.status == Status::Running; }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::readSettings()
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::Batch::GroupName);
+  m_Concurrency = std::max(prefs.value(SIMPLView::Batch::Concurrency, 1).toInt(), 1);
+  m_Isolated = prefs.value(SIMPLView::Batch::Isolated, false).toBool();
+  m_BackgroundWrites = prefs.value(SIMPLView::Batch::BackgroundWrites, false).toBool();
+  qint64 defaultBudget = ExecutionScheduler::PhysicalMemory() / SIMPLView::Batch::DefaultPrefetchMemoryDivisor;
+  m_Prefetcher->setBudget(prefs.value(SIMPLView::Batch::PrefetchBudget, defaultBudget).toLongLong());
+  QString scratchDirectory = prefs.value(SIMPLView::Batch::ScratchDirectory, QString()).toString();
+  if(!scratchDirectory.isEmpty())
+  {
+    m_Stager = std::make_shared<ScratchStager>(scratchDirectory);
+  }
+  prefs.endGroup();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueue::writeSettings() const
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::Batch::GroupName);
+  prefs.setValue(SIMPLView::Batch::Concurrency, m_Concurrency);
+  prefs.setValue(SIMPLView::Batch::Isolated, m_Isolated);
+  prefs.setValue(SIMPLView::Batch::PrefetchBudget, m_Prefetcher->getBudget());
+  prefs.setValue(SIMPLView::Batch::BackgroundWrites, m_BackgroundWrites);
+  prefs.setValue(SIMPLView::Batch::ScratchDirectory, getScratchDirectory());
+  prefs.endGroup();
+}
@@ -0,0 +1,402 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+#include "SIMPLView/ProcessPool.h"
+#include "SIMPLView/ScratchStager.h"
+
+class ExecutionScheduler;
+class InputPrefetcher;
+class PipelineExecution;
+class QTimer;
+class RunHistory;
+
+/**
+ * @brief The BatchQueue class runs pipeline files and bookmarks without opening a window for them.  Files wait in
+ * the queue until it is started; then up to getConcurrency() of them are handed to the ExecutionScheduler at a time
+ * with the Batch priority, so they only use what the interactive runs leave free.  The application owns one queue
+ * that every window shows.  In the isolated mode the pipelines run in the worker processes of a ProcessPool instead
+ * of in the application.  While jobs run, the input files of the jobs that start next are prefetched.  With a
+ * scratch directory the inputs of a job are staged there before it is queued and its outputs are copied back
+ * once it succeeded.
+ */
+class BatchQueue : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum class Status : int
+  {
+    Waiting,
+    Staging,
+    Queued,
+    Running,
+    Writing,
+    Succeeded,
+    Failed,
+    Cancelled
+  };
+
+  struct Job
+  {
+    int id = 0;
+    QString filePath;
+    Status status = Status::Waiting;
+    int attempts = 0;
+    qint64 elapsedMilliseconds = 0;
+    qint64 peakMemory = 0;
+    bool processPeakMemory = false;
+    int progress = -1;
+    QString message;
+    qint64 prefetchedBytes = 0;
+    qint64 prefetchReadMilliseconds = 0;
+    qint64 prefetchOverlappedMilliseconds = 0;
+  };
+
+  BatchQueue(ExecutionScheduler* scheduler, ProcessPool* processPool, RunHistory* runHistory, QObject* parent = nullptr);
+  ~BatchQueue() override;
+
+  /**
+   * @brief Returns true if the file can be added to the queue
+   * @param filePath
+   * @return
+   */
+  static bool CanQueue(const QString& filePath);
+
+  /**
+   * @brief Reads the pipeline of a .json, CBOR or .dream3d file
+   * @param filePath
+   * @param pipeline
+   * @param errorMessage
+   * @return
+   */
+  static bool ReadPipelineFile(const QString& filePath, QJsonObject& pipeline, QString& errorMessage);
+
+  /**
+   * @brief Appends the files that can be queued and returns their job ids
+   * @param filePaths
+   * @return
+   */
+  QList<int> addFiles(const QStringList& filePaths);
+
+  /**
+   * @brief Puts a job that failed or was cancelled back in the queue
+   * @param jobId
+   */
+  void retry(int jobId);
+
+  /**
+   * @brief Cancels a job that has not finished yet
+   * @param jobId
+   */
+  void cancel(int jobId);
+
+  /**
+   * @brief Removes a job; a job that is still queued or running is cancelled and removed once it ended
+   * @param jobId
+   */
+  void remove(int jobId);
+
+  /**
+   * @brief Removes the jobs that succeeded, failed or were cancelled
+   */
+  void clearFinished();
+
+  /**
+   * @brief Starts or stops handing waiting jobs to the scheduler.  Stopping does not cancel the jobs that
+   * already run.
+   * @param running
+   */
+  void setRunning(bool running);
+  bool isRunning() const;
+
+  /**
+   * @brief Sets how many jobs run at the same time.  The value is kept in the preferences.
+   * @param concurrency
+   */
+  void setConcurrency(int concurrency);
+  int getConcurrency() const;
+
+  /**
+   * @brief Sets whether jobs run in worker processes.  Jobs that are already active keep running where they
+   * started.  The value is kept in the preferences.
+   * @param isolated
+   */
+  void setIsolated(bool isolated);
+  bool isIsolated() const;
+
+  /**
+   * @brief Sets how many bytes of input files may be prefetched for jobs that did not start yet.  0 turns
+   * prefetching off.  The value is kept in the preferences.
+   * @param bytes
+   */
+  void setPrefetchBudget(qint64 bytes);
+  qint64 getPrefetchBudget() const;
+
+  /**
+   * @brief Sets whether the output filters at the end of a pipeline write in the background, so the next job can
+   * start as soon as the data is computed.  A job stays Writing until its files are written.  Isolated jobs always
+   * write in their worker.  The value is kept in the preferences.
+   * @param background
+   */
+  void setBackgroundWrites(bool background);
+  bool getBackgroundWrites() const;
+
+  /**
+   * @brief Sets a local directory the inputs and outputs of the jobs are staged in, for pipelines whose data lives
+   * on a network share.  An empty path turns staging off.  The value is kept in the preferences.
+   * @param scratchDirectory
+   */
+  void setScratchDirectory(const QString& scratchDirectory);
+  QString getScratchDirectory() const;
+
+  /**
+   * @brief Returns the jobs in queue order
+   * @return
+   */
+  std::vector<Job> getJobs() const;
+
+  /**
+   * @brief Returns true while any job is staging, queued, running or writing
+   * @return
+   */
+  bool hasActiveJobs() const;
+
+Q_SIGNALS:
+  void jobsChanged();
+  void runningChanged(bool running);
+
+private:
+  /**
+   * @brief An isolated run has no execution; it holds its pipeline until the scheduler starts it and then the id
+   * of its job in the process pool.  A run that stages its inputs has no scheduler job yet.
+   */
+  struct ActiveRun
+  {
+    int schedulerJobId = -1;
+    bool staging = false;
+    bool cancelRequested = false;
+    PipelineExecution* execution = nullptr;
+    bool removeWhenEnded = false;
+    QJsonObject pipeline;
+    int poolJobId = -1;
+    bool hasResult = false;
+    ProcessPool::Result result;
+    QString pipelineHash;
+    qint64 inputBytes = 0;
+    int threads = 1;
+  };
+
+  /**
+   * @brief The plan of a staged job and the stager that holds its inputs.  The stager is reset once the inputs
+   * are released.
+   */
+  struct StagedRun
+  {
+    std::shared_ptr<ScratchStager> stager;
+    ScratchStager::Plan plan;
+  };
+
+  ExecutionScheduler* m_Scheduler = nullptr;
+  ProcessPool* m_ProcessPool = nullptr;
+  RunHistory* m_RunHistory = nullptr;
+  std::vector<Job> m_Jobs;
+  std::map<int, ActiveRun> m_ActiveRuns;
+  std::map<int, PipelineExecution*> m_WritingExecutions;
+  int m_NextJobId = 0;
+  int m_Concurrency = 1;
+  bool m_Running = false;
+  bool m_Isolated = false;
+  bool m_BackgroundWrites = false;
+  QTimer* m_MemoryTimer = nullptr;
+  InputPrefetcher* m_Prefetcher = nullptr;
+  std::shared_ptr<ScratchStager> m_Stager;
+  std::map<int, StagedRun> m_StagingPlans;
+
+  /**
+   * @brief Returns the job with the id, or nullptr
+   * @param jobId
+   * @return
+   */
+  Job* findJob(int jobId);
+
+  /**
+   * @brief Hands waiting jobs to the scheduler until getConcurrency() of them are active
+   */
+  void dispatch();
+
+  /**
+   * @brief Clears what an earlier attempt recorded for the job
+   * @param job
+   */
+  void resetJob(Job& job);
+
+  /**
+   * @brief Reads and preflights the pipeline of the job and queues it in the scheduler.  A staged job runs the
+   * pipeline of its plan.
+   * @param job
+   * @return False if the pipeline could not be prepared; the job is then marked as failed
+   */
+  bool submitJob(Job& job);
+
+  /**
+   * @brief Plans the staging of the job and copies its inputs to the scratch directory on a worker thread
+   * @param job
+   * @return False if the pipeline could not be read; the job is then marked as failed
+   */
+  bool startStaging(Job& job);
+
+  /**
+   * @brief Submits a job whose inputs were staged, or settles it if staging failed or it was cancelled
+   * @param jobId
+   * @param stager The stager that staged the inputs
+   * @param plan
+   * @param errorMessage
+   */
+  void stagingFinished(int jobId, const std::shared_ptr<ScratchStager>& stager, const ScratchStager::Plan& plan, const QString& errorMessage);
+
+  /**
+   * @brief Copies the outputs of a staged job back once it succeeded and drops the plan of a job that did not
+   * @param jobId
+   */
+  void finishStagedRun(int jobId);
+
+  /**
+   * @brief Settles a staged job whose outputs were copied back
+   * @param jobId
+   * @param errorMessage
+   */
+  void copyBackFinished(int jobId, const QString& errorMessage);
+
+  /**
+   * @brief Adds a job that ran to the run history.  Isolated runs are recorded without their filters, which the
+   * worker does not report.
+   * @param run
+   * @param job
+   */
+  void recordRun(const ActiveRun& run, const Job& job);
+
+  /**
+   * @brief Drops the plan of a staged job, releases its inputs and removes its run directory
+   * @param jobId
+   */
+  void discardStagingPlan(int jobId);
+
+  /**
+   * @brief Marks the job of a scheduler job that started as running
+   * @param schedulerJobId
+   */
+  void schedulerJobStarted(int schedulerJobId);
+
+  /**
+   * @brief Settles the job of a scheduler job that ended, including jobs cancelled before they started
+   * @param schedulerJobId
+   */
+  void schedulerJobFinished(int schedulerJobId);
+
+  /**
+   * @brief Settles a job whose results were written in the background
+   * @param jobId
+   */
+  void writesFinished(int jobId);
+
+  /**
+   * @brief Hands an isolated run to the process pool once the scheduler started it
+   * @param jobId
+   */
+  void startIsolatedRun(int jobId);
+
+  /**
+   * @brief Cancels the pool job of an isolated run the scheduler wants to stop
+   * @param schedulerJobId
+   */
+  void schedulerCancelRequested(int schedulerJobId);
+
+  /**
+   * @brief Records the result of an isolated run and ends its scheduler job
+   * @param poolJobId
+   * @param result
+   */
+  void poolJobFinished(int poolJobId, const ProcessPool::Result& result);
+
+  /**
+   * @brief Records the percent done an isolated run reported.  Runs in the application report no progress.
+   * @param poolJobId
+   * @param percent
+   */
+  void poolJobProgress(int poolJobId, int percent);
+
+  /**
+   * @brief Shows the latest status message of an isolated run as the message of its job
+   * @param poolJobId
+   * @param message
+   */
+  void poolJobMessage(int poolJobId, const QString& message);
+
+  /**
+   * @brief Records the resident memory of the process as the peak of the running jobs if it is higher.  This is the
+   * peak of the whole application, so these jobs are flagged with processPeakMemory.  Isolated runs report the peak
+   * of their worker instead.
+   */
+  void sampleMemory();
+
+  /**
+   * @brief Queues the input files of the jobs that start next for prefetching
+   */
+  void prefetchUpcoming();
+
+  /**
+   * @brief Tells the prefetcher whether any job is running
+   */
+  void updateComputeActive();
+
+  void readSettings();
+  void writeSettings() const;
+
+public:
+  BatchQueue(const BatchQueue&) = delete;            // Copy Constructor Not Implemented
+  BatchQueue(BatchQueue&&) = delete;                 // Move Constructor Not Implemented
+  BatchQueue& operator=(const BatchQueue&) = delete; // Copy Assignment Not Implemented
+  BatchQueue& operator=(BatchQueue&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,536 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "BatchQueueWidget.h"
+
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLocale>
+#include <QtCore/QMimeData>
+#include <QtCore/QSignalBlocker>
+#include <QtCore/QUrl>
+#include <QtGui/QDragEnterEvent>
+#include <QtGui/QDropEvent>
+#include <QtWidgets/QCheckBox>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QSpinBox>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/BatchQueue.h"
+
+namespace
+{
+const int k_MaximumConcurrency = 64;
+const qint64 k_BytesPerMegabyte = 1024 * 1024;
+const int k_MaximumPrefetchMegabytes = 1024 * 1024;
+
+enum Column
+{
+  FileColumn = 0,
+  StatusColumn,
+  AttemptsColumn,
+  TimeColumn,
+  MemoryColumn,
+  PrefetchColumn,
+  MessageColumn,
+  ColumnCount
+};
+
+// -----------------------------------------------------------------------------
+QString StatusName(BatchQueue::Status status)
+{
+  switch(status)
+  {
+  case BatchQueue::Status::Waiting:
+    return QObject::tr("Waiting");
+  case BatchQueue::Status::Staging:
+    return QObject::tr("Staging");
+  case BatchQueue::Status::Queued:
+    return QObject::tr("Queued");
+  case BatchQueue::Status::Running:
+    return QObject::tr("Running");
+  case BatchQueue::Status::Writing:
+    return QObject::tr("Writing");
+  case BatchQueue::Status::Succeeded:
+    return QObject::tr("Succeeded");
+  case BatchQueue::Status::Failed:
+    return QObject::tr("Failed");
+  case BatchQueue::Status::Cancelled:
+    return QObject::tr("Cancelled");
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+// -----------------------------------------------------------------------------
+void CollectFilePaths(const QJsonValue& value, QStringList& filePaths)
+{
+  if(value.isString())
+  {
+    if(BatchQueue::CanQueue(value.toString()))
+    {
+      filePaths.push_back(value.toString());
+    }
+  }
+  else if(value.isArray())
+  {
+    for(const QJsonValue& element : value.toArray())
+    {
+      CollectFilePaths(element, filePaths);
+    }
+  }
+  else if(value.isObject())
+  {
+    for(const QJsonValue& member : value.toObject())
+    {
+      CollectFilePaths(member, filePaths);
+    }
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueueWidget::BatchQueueWidget(QWidget* parent)
+: QWidget(parent)
+{
+  setAcceptDrops(true);
+
+  m_JobsTree = new QTreeWidget(this);
+  m_JobsTree->setColumnCount(ColumnCount);
+  m_JobsTree->setHeaderLabels({tr("Pipeline"), tr("Status"), tr("Attempts"), tr("Time"), tr("Peak Memory"), tr("Prefetched"), tr("Message")});
+  m_JobsTree->setRootIsDecorated(false);
+  m_JobsTree->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  m_JobsTree->setToolTip(tr("Drop pipeline files or bookmarks here to add them to the batch queue."));
+  m_JobsTree->header()->setSectionResizeMode(FileColumn, QHeaderView::Interactive);
+
+  m_AddButton = new QPushButton(tr("Add..."), this);
+  m_StartButton = new QPushButton(tr("Start"), this);
+  m_StartButton->setCheckable(true);
+  m_StartButton->setToolTip(tr("Stopping the queue lets the running jobs finish but starts no new ones."));
+  m_RetryButton = new QPushButton(tr("Retry"), this);
+  m_CancelButton = new QPushButton(tr("Cancel"), this);
+  m_RemoveButton = new QPushButton(tr("Remove"), this);
+  m_ClearButton = new QPushButton(tr("Clear Finished"), this);
+
+  m_ConcurrencySpinBox = new QSpinBox(this);
+  m_ConcurrencySpinBox->setRange(1, k_MaximumConcurrency);
+  m_ConcurrencySpinBox->setToolTip(tr("The number of pipelines that run at the same time. They share the worker threads of the execution queue."));
+
+  m_IsolatedCheckBox = new QCheckBox(tr("Run in separate processes"), this);
+  m_IsolatedCheckBox->setToolTip(tr("Each pipeline runs in a worker process that loaded the plugins once. A filter that crashes only stops its own "
+                                    "pipeline, at the cost of a little memory per worker."));
+
+  m_BackgroundWritesCheckBox = new QCheckBox(tr("Write results in the background"), this);
+  m_BackgroundWritesCheckBox->setToolTip(tr("The output filters at the end of a pipeline write on a background thread, so the next pipeline starts as "
+                                            "soon as the data is computed. The data stays in memory until it is written."));
+
+  m_PrefetchSpinBox = new QSpinBox(this);
+  m_PrefetchSpinBox->setRange(0, k_MaximumPrefetchMegabytes);
+  m_PrefetchSpinBox->setSuffix(tr(" MB"));
+  m_PrefetchSpinBox->setSpecialValueText(tr("Off"));
+  m_PrefetchSpinBox->setToolTip(tr("How much of the input files of the pipelines that start next is read ahead while the current ones compute."));
+
+  m_ScratchDirectoryEdit = new QLineEdit(this);
+  m_ScratchDirectoryEdit->setPlaceholderText(tr("Off"));
+  m_ScratchDirectoryEdit->setToolTip(tr("A local directory the input files are copied to before a pipeline runs and its results are written to before "
+                                        "they are copied to their destination. Use it when the data lives on a network share."));
+  QPushButton* scratchBrowseButton = new QPushButton(tr("Browse..."), this);
+  QHBoxLayout* scratchLayout = new QHBoxLayout();
+  scratchLayout->addWidget(m_ScratchDirectoryEdit, 1);
+  scratchLayout->addWidget(scratchBrowseButton);
+
+  QHBoxLayout* buttonLayout = new QHBoxLayout();
+  buttonLayout->addWidget(m_AddButton);
+  buttonLayout->addWidget(m_RemoveButton);
+  buttonLayout->addWidget(m_ClearButton);
+  buttonLayout->addStretch(1);
+  buttonLayout->addWidget(m_RetryButton);
+  buttonLayout->addWidget(m_CancelButton);
+  buttonLayout->addWidget(m_StartButton);
+
+  QFormLayout* settingsLayout = new QFormLayout();
+  settingsLayout->addRow(tr("Concurrent pipelines:"), m_ConcurrencySpinBox);
+  settingsLayout->addRow(tr("Prefetch budget:"), m_PrefetchSpinBox);
+  settingsLayout->addRow(tr("Scratch directory:"), scratchLayout);
+  settingsLayout->addRow(QString(), m_IsolatedCheckBox);
+  settingsLayout->addRow(QString(), m_BackgroundWritesCheckBox);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(m_JobsTree, 1);
+  layout->addLayout(buttonLayout);
+  layout->addLayout(settingsLayout);
+
+  connect(m_AddButton, &QPushButton::clicked, this, &BatchQueueWidget::addFiles);
+  connect(m_RetryButton, &QPushButton::clicked, this, &BatchQueueWidget::retrySelectedJobs);
+  connect(m_CancelButton, &QPushButton::clicked, this, &BatchQueueWidget::cancelSelectedJobs);
+  connect(m_RemoveButton, &QPushButton::clicked, this, &BatchQueueWidget::removeSelectedJobs);
+  connect(m_ClearButton, &QPushButton::clicked, this, [this] {
+    if(m_BatchQueue != nullptr)
+    {
+      m_BatchQueue->clearFinished();
+    }
+  });
+  connect(m_StartButton, &QPushButton::toggled, this, [this](bool running) {
+    if(m_BatchQueue != nullptr)
+    {
+      m_BatchQueue->setRunning(running);
+    }
+  });
+  connect(m_ConcurrencySpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int concurrency) {
+    if(m_BatchQueue != nullptr)
+    {
+      m_BatchQueue->setConcurrency(concurrency);
+    }
+  });
+  connect(m_IsolatedCheckBox, &QCheckBox::toggled, this, [this](bool isolated) {
+    if(m_BatchQueue != nullptr)
+    {
+      m_BatchQueue->setIsolated(isolated);
+    }
+  });
+  connect(m_BackgroundWritesCheckBox, &QCheckBox::toggled, this, [this](bool background) {
+    if(m_BatchQueue != nullptr)
+    {
+      m_BatchQueue->setBackgroundWrites(background);
+    }
+  });
+  connect(m_PrefetchSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int megabytes) {
+    if(m_BatchQueue != nullptr)
+    {
+      m_BatchQueue->setPrefetchBudget(megabytes * k_BytesPerMegabyte);
+    }
+  });
+  connect(m_ScratchDirectoryEdit, &QLineEdit::editingFinished, this, [this] {
+    if(m_BatchQueue != nullptr)
+    {
+      QString scratchDirectory = m_ScratchDirectoryEdit->text().trimmed();
+      m_BatchQueue->setScratchDirectory(scratchDirectory.isEmpty() ? QString() : QDir::fromNativeSeparators(scratchDirectory));
+    }
+  });
+  connect(scratchBrowseButton, &QPushButton::clicked, this, [this] {
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Scratch Directory"), m_ScratchDirectoryEdit->text());
+    if(!directory.isEmpty() && m_BatchQueue != nullptr)
+    {
+      m_ScratchDirectoryEdit->setText(QDir::toNativeSeparators(directory));
+      m_BatchQueue->setScratchDirectory(directory);
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueueWidget::~BatchQueueWidget() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::setBatchQueue(BatchQueue* queue)
+{
+  if(m_BatchQueue != nullptr)
+  {
+    disconnect(m_BatchQueue, nullptr, this, nullptr);
+  }
+
+  m_BatchQueue = queue;
+  if(m_BatchQueue != nullptr)
+  {
+    connect(m_BatchQueue, &BatchQueue::jobsChanged, this, &BatchQueueWidget::refreshJobs);
+    connect(m_BatchQueue, &BatchQueue::runningChanged, this, &BatchQueueWidget::refreshControls);
+  }
+
+  refreshControls();
+  refreshJobs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList BatchQueueWidget::DroppedFilePaths(const QMimeData* mimeData)
+{
+  QStringList filePaths;
+  if(mimeData->hasUrls())
+  {
+    for(const QUrl& url : mimeData->urls())
+    {
+      if(url.isLocalFile() && BatchQueue::CanQueue(url.toLocalFile()))
+      {
+        filePaths.push_back(url.toLocalFile());
+      }
+    }
+    return filePaths;
+  }
+
+  // Bookmarks are dragged as JSON that holds their paths; other applications may drag paths as plain text
+  for(const QString& format : mimeData->formats())
+  {
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(mimeData->data(format), &parseError);
+    if(parseError.error == QJsonParseError::NoError)
+    {
+      CollectFilePaths(doc.isArray() ? QJsonValue(doc.array()) : QJsonValue(doc.object()), filePaths);
+    }
+  }
+  if(filePaths.isEmpty() && mimeData->hasText())
+  {
+    for(const QString& line : mimeData->text().split('\n', QString::SkipEmptyParts))
+    {
+      QString filePath = line.trimmed();
+      if(filePath.startsWith("file:"))
+      {
+        filePath = QUrl(filePath).toLocalFile();
+      }
+      if(BatchQueue::CanQueue(filePath))
+      {
+        filePaths.push_back(filePath);
+      }
+    }
+  }
+
+  filePaths.removeDuplicates();
+  return filePaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::dragEnterEvent(QDragEnterEvent* event)
+{
+  if(m_BatchQueue != nullptr && !DroppedFilePaths(event->mimeData()).isEmpty())
+  {
+    event->acceptProposedAction();
+    return;
+  }
+  QWidget::dragEnterEvent(event);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::dropEvent(QDropEvent* event)
+{
+  QStringList filePaths = DroppedFilePaths(event->mimeData());
+  if(m_BatchQueue == nullptr || filePaths.isEmpty())
+  {
+    QWidget::dropEvent(event);
+    return;
+  }
+
+  m_BatchQueue->addFiles(filePaths);
+  event->acceptProposedAction();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::addFiles()
+{
+  if(m_BatchQueue == nullptr)
+  {
+    return;
+  }
+
+  QStringList filePaths = QFileDialog::getOpenFileNames(this, tr("Add Pipelines"), QString(),
+                                                        tr("Pipeline Files (*.json *.cbor *.dream3d);;Json File (*.json);;CBOR Pipeline File (*.cbor);;DREAM3D File (*.dream3d)"));
+  m_BatchQueue->addFiles(filePaths);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<int> BatchQueueWidget::selectedJobIds() const
+{
+  QList<int> jobIds;
+  for(QTreeWidgetItem* item : m_JobsTree->selectedItems())
+  {
+    jobIds.push_back(item->data(FileColumn, Qt::UserRole).toInt());
+  }
+  return jobIds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::retrySelectedJobs()
+{
+  if(m_BatchQueue == nullptr)
+  {
+    return;
+  }
+
+  // Every call refreshes the list, so the ids are collected first
+  for(int jobId : selectedJobIds())
+  {
+    m_BatchQueue->retry(jobId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::cancelSelectedJobs()
+{
+  if(m_BatchQueue == nullptr)
+  {
+    return;
+  }
+
+  for(int jobId : selectedJobIds())
+  {
+    m_BatchQueue->cancel(jobId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::removeSelectedJobs()
+{
+  if(m_BatchQueue == nullptr)
+  {
+    return;
+  }
+
+  for(int jobId : selectedJobIds())
+  {
+    m_BatchQueue->remove(jobId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::refreshControls()
+{
+  setEnabled(m_BatchQueue != nullptr);
+  if(m_BatchQueue == nullptr)
+  {
+    return;
+  }
+
+  // Every window shows the same queue, so the values are set without writing them back
+  QSignalBlocker startBlocker(m_StartButton);
+  QSignalBlocker concurrencyBlocker(m_ConcurrencySpinBox);
+  QSignalBlocker isolatedBlocker(m_IsolatedCheckBox);
+  QSignalBlocker prefetchBlocker(m_PrefetchSpinBox);
+  QSignalBlocker backgroundWritesBlocker(m_BackgroundWritesCheckBox);
+  QSignalBlocker scratchDirectoryBlocker(m_ScratchDirectoryEdit);
+
+  m_StartButton->setChecked(m_BatchQueue->isRunning());
+  m_StartButton->setText(m_BatchQueue->isRunning() ? tr("Stop") : tr("Start"));
+  m_ConcurrencySpinBox->setValue(m_BatchQueue->getConcurrency());
+  m_IsolatedCheckBox->setChecked(m_BatchQueue->isIsolated());
+  m_BackgroundWritesCheckBox->setChecked(m_BatchQueue->getBackgroundWrites());
+  m_ScratchDirectoryEdit->setText(QDir::toNativeSeparators(m_BatchQueue->getScratchDirectory()));
+  m_PrefetchSpinBox->setValue(static_cast<int>(std::min(m_BatchQueue->getPrefetchBudget() / k_BytesPerMegabyte, static_cast<qint64>(k_MaximumPrefetchMegabytes))));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void BatchQueueWidget::refreshJobs()
+{
+  if(m_BatchQueue == nullptr)
+  {
+    m_JobsTree->clear();
+    return;
+  }
+
+  QList<int> selectedIds = selectedJobIds();
+  QLocale locale;
+
+  m_JobsTree->setUpdatesEnabled(false);
+  m_JobsTree->clear();
+  for(const BatchQueue::Job& job : m_BatchQueue->getJobs())
+  {
+    // A job that writes in the background already computed its data, so its time is final
+    bool ended = job.status == BatchQueue::Status::Writing || job.status == BatchQueue::Status::Succeeded || job.status == BatchQueue::Status::Failed ||
+                 job.status == BatchQueue::Status::Cancelled;
+
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_JobsTree);
+    item->setData(FileColumn, Qt::UserRole, job.id);
+    item->setText(FileColumn, QFileInfo(job.filePath).fileName());
+    item->setToolTip(FileColumn, job.filePath);
+    if(job.status == BatchQueue::Status::Running && job.progress >= 0)
+    {
+      item->setText(StatusColumn, tr("%1 (%2%)").arg(StatusName(job.status)).arg(job.progress));
+    }
+    else
+    {
+      item->setText(StatusColumn, StatusName(job.status));
+    }
+    item->setText(AttemptsColumn, QString::number(job.attempts));
+    item->setText(TimeColumn, ended && job.elapsedMilliseconds > 0 ? FormatDuration(job.elapsedMilliseconds) : QString());
+    if(job.peakMemory > 0 && job.processPeakMemory)
+    {
+      item->setText(MemoryColumn, tr("%1 (process)").arg(locale.formattedDataSize(job.peakMemory)));
+      item->setToolTip(MemoryColumn, tr("Peak memory of SIMPLView while the pipeline ran, including the pipelines that ran alongside it"));
+    }
+    else if(job.peakMemory > 0)
+    {
+      item->setText(MemoryColumn, locale.formattedDataSize(job.peakMemory));
+      item->setToolTip(MemoryColumn, tr("Peak memory of the worker process that ran the pipeline"));
+    }
+    if(job.prefetchedBytes > 0)
+    {
+      item->setText(PrefetchColumn, locale.formattedDataSize(job.prefetchedBytes));
+      item->setToolTip(PrefetchColumn, tr("Read ahead in %1 s, of which %2 s overlapped with running pipelines")
+                                           .arg(locale.toString(job.prefetchReadMilliseconds / 1000.0, 'f', 1), locale.toString(job.prefetchOverlappedMilliseconds / 1000.0, 'f', 1)));
+    }
+    item->setText(MessageColumn, job.message);
+    item->setToolTip(MessageColumn, job.message);
+    item->setSelected(selectedIds.contains(job.id));
+  }
+  m_JobsTree->setUpdatesEnabled(true);
+}
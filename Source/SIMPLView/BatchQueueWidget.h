@@ -0,0 +1,138 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtWidgets/QWidget>
+
+class BatchQueue;
+class QCheckBox;
+class QDragEnterEvent;
+class QDropEvent;
+class QLineEdit;
+class QMimeData;
+class QPushButton;
+class QSpinBox;
+class QTreeWidget;
+
+/**
+ * @brief The BatchQueueWidget class shows the application wide BatchQueue.  Pipeline files and bookmarks are added
+ * by dropping them on the widget or with the Add button.
+ */
+class BatchQueueWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  BatchQueueWidget(QWidget* parent = nullptr);
+  ~BatchQueueWidget() override;
+
+  /**
+   * @brief Sets the queue that is shown
+   * @param queue
+   */
+  void setBatchQueue(BatchQueue* queue);
+
+  /**
+   * @brief Returns the pipeline files held by dropped data: file URLs, paths as text, or the JSON that the
+   * bookmarks view drags, whose string values are searched for pipeline files
+   * @param mimeData
+   * @return
+   */
+  static QStringList DroppedFilePaths(const QMimeData* mimeData);
+
+public Q_SLOTS:
+  /**
+   * @brief Refills the job list from the queue
+   */
+  void refreshJobs();
+
+  /**
+   * @brief Asks for pipeline files and adds them
+   */
+  void addFiles();
+
+  /**
+   * @brief Queues the selected jobs that failed or were cancelled again
+   */
+  void retrySelectedJobs();
+
+  /**
+   * @brief Cancels the selected jobs
+   */
+  void cancelSelectedJobs();
+
+  /**
+   * @brief Removes the selected jobs
+   */
+  void removeSelectedJobs();
+
+protected:
+  void dragEnterEvent(QDragEnterEvent* event) override;
+  void dropEvent(QDropEvent* event) override;
+
+private:
+  BatchQueue* m_BatchQueue = nullptr;
+
+  QTreeWidget* m_JobsTree = nullptr;
+  QPushButton* m_AddButton = nullptr;
+  QPushButton* m_StartButton = nullptr;
+  QPushButton* m_RetryButton = nullptr;
+  QPushButton* m_CancelButton = nullptr;
+  QPushButton* m_RemoveButton = nullptr;
+  QPushButton* m_ClearButton = nullptr;
+  QSpinBox* m_ConcurrencySpinBox = nullptr;
+  QCheckBox* m_IsolatedCheckBox = nullptr;
+  QCheckBox* m_BackgroundWritesCheckBox = nullptr;
+  QSpinBox* m_PrefetchSpinBox = nullptr;
+  QLineEdit* m_ScratchDirectoryEdit = nullptr;
+
+  /**
+   * @brief Returns the ids of the selected jobs
+   * @return
+   */
+  QList<int> selectedJobIds() const;
+
+  /**
+   * @brief Shows the state of the queue without writing it back
+   */
+  void refreshControls();
+
+public:
+  BatchQueueWidget(const BatchQueueWidget&) = delete;            // Copy Constructor Not Implemented
+  BatchQueueWidget(BatchQueueWidget&&) = delete;                 // Move Constructor Not Implemented
+  BatchQueueWidget& operator=(const BatchQueueWidget&) = delete; // Copy Assignment Not Implemented
+  BatchQueueWidget& operator=(BatchQueueWidget&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,523 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DREAM3DFileBrowser.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <hdf5.h>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QObject>
+
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/CoreFilters/DataContainerReader.h"
+#include "SIMPLib/HDF5/H5DataArrayReader.h"
+
+namespace
+{
+const int k_DefaultCacheLimit = 1024;        // MB
+const size_t k_ReadChunkElements = 1 << 22; // Values read from a dataset at a time
+
+/**
+ * @brief Returns true if the array of the file structure is a DataArray, whose tuples are stored one after the other
+ */
+bool IsReadableStructure(const IDataArray::Pointer& structure, QString& errorMessage)
+{
+  // Neighbor lists and string arrays are not stored one tuple after the other
+  if(structure == nullptr || !structure->getNameOfClass().startsWith("DataArray"))
+  {
+    errorMessage = QObject::tr("Only numeric arrays can be read this way.");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Opens the dataset of an array and hands it to read together with its file space, its dimensions and the
+ * memory type of the array
+ * @return False if the dataset cannot be opened, does not match the type of the array, or read fails
+ */
+bool ReadDataset(const QString& filePath, const DataArrayPath& path, const IDataArray::Pointer& array, QString& errorMessage,
+                 const std::function<herr_t(hid_t, hid_t, const std::vector<hsize_t>&, hid_t)>& read)
+{
+  hid_t fileId = QH5Utilities::openFile(filePath, true);
+  if(fileId < 0)
+  {
+    errorMessage = QObject::tr("The file '%1' could not be opened.").arg(filePath);
+    return false;
+  }
+  H5ScopedFileSentinel sentinel(&fileId, true);
+
+  QString datasetPath = QString("/%1/%2/%3/%4").arg(SIMPL::StringConstants::DataContainerGroupName, path.getDataContainerName(), path.getAttributeMatrixName(), path.getDataArrayName());
+  hid_t datasetId = H5Dopen2(fileId, datasetPath.toLatin1().constData(), H5P_DEFAULT);
+  if(datasetId < 0)
+  {
+    errorMessage = QObject::tr("The array '%1' was not found in the file.").arg(datasetPath);
+    return false;
+  }
+
+  hid_t fileSpaceId = H5Dget_space(datasetId);
+  int rank = H5Sget_simple_extent_ndims(fileSpaceId);
+  std::vector<hsize_t> dims(static_cast<size_t>(std::max(rank, 0)));
+  H5Sget_simple_extent_dims(fileSpaceId, dims.data(), nullptr);
+  hid_t fileTypeId = H5Dget_type(datasetId);
+  hid_t memoryTypeId = H5Tget_native_type(fileTypeId, H5T_DIR_ASCEND);
+
+  herr_t err = (H5Tget_size(memoryTypeId) == array->getTypeSize()) ? read(datasetId, fileSpaceId, dims, memoryTypeId) : -1;
+
+  H5Tclose(memoryTypeId);
+  H5Tclose(fileTypeId);
+  H5Sclose(fileSpaceId);
+  H5Dclose(datasetId);
+  if(err < 0)
+  {
+    errorMessage = QObject::tr("The array '%1' could not be read.").arg(path.serialize("/"));
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Returns the values of one row of the slowest dimension of a dataset
+ */
+hsize_t RowElements(const std::vector<hsize_t>& dims)
+{
+  hsize_t elementCount = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+  return elementCount / std::max(dims[0], static_cast<hsize_t>(1));
+}
+
+/**
+ * @brief Returns the rows of the slowest dimension read at a time
+ */
+hsize_t RowsPerChunk(hsize_t rowElements)
+{
+  return std::max(static_cast<hsize_t>(k_ReadChunkElements) / std::max(rowElements, static_cast<hsize_t>(1)), static_cast<hsize_t>(1));
+}
+
+/**
+ * @brief Reads rows of the slowest dimension of a dataset into the same rows of an array
+ */
+herr_t ReadRows(hid_t datasetId, hid_t fileSpaceId, const std::vector<hsize_t>& dims, hid_t memoryTypeId, hsize_t row, hsize_t rowCount, const IDataArray::Pointer& array)
+{
+  const hsize_t rowElements = RowElements(dims);
+  std::vector<hsize_t> start(dims.size(), 0);
+  std::vector<hsize_t> count = dims;
+  start[0] = row;
+  count[0] = rowCount;
+  hsize_t chunkElements = rowCount * rowElements;
+  herr_t err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, start.data(), nullptr, count.data(), nullptr);
+  hid_t memorySpaceId = H5Screate_simple(1, &chunkElements, nullptr);
+  if(err >= 0)
+  {
+    char* values = static_cast<char*>(array->getVoidPointer(0));
+    err = H5Dread(datasetId, memoryTypeId, memorySpaceId, fileSpaceId, H5P_DEFAULT, values + row * rowElements * array->getTypeSize());
+  }
+  H5Sclose(memorySpaceId);
+  return err;
+}
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DREAM3DFileBrowser::DREAM3DFileBrowser()
+: m_ArrayCache(k_DefaultCacheLimit)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DREAM3DFileBrowser::~DREAM3DFileBrowser() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DREAM3DFileBrowser::open(const QString& filePath, QString& errorMessage)
+{
+  close();
+
+  if(!QFileInfo(filePath).isReadable())
+  {
+    errorMessage = QObject::tr("The file '%1' could not be read.").arg(filePath);
+    return false;
+  }
+
+  // Preflighting the reader only reads the structure of the file; the arrays it creates are not allocated
+  DataContainerReader::Pointer reader = DataContainerReader::New();
+  reader->setInputFile(filePath);
+  DataContainerArrayProxy proxy = reader->readDataContainerArrayStructure(filePath);
+  if(reader->getErrorCode() < 0)
+  {
+    errorMessage = QObject::tr("The structure of '%1' could not be read.").arg(filePath);
+    return false;
+  }
+  proxy.setAllFlags(Qt::Checked);
+  reader->setInputFileDataContainerArrayProxy(proxy);
+  reader->preflight();
+  if(reader->getErrorCode() < 0)
+  {
+    errorMessage = QObject::tr("The structure of '%1' could not be read (error %2).").arg(filePath).arg(reader->getErrorCode());
+    return false;
+  }
+
+  m_FilePath = filePath;
+  m_LastModified = QFileInfo(filePath).lastModified();
+  m_Reader = reader;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DREAM3DFileBrowser::close()
+{
+  m_FilePath.clear();
+  m_LastModified = QDateTime();
+  m_Reader.reset();
+  m_ArrayCache.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DREAM3DFileBrowser::isOpen() const
+{
+  return m_Reader != nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString DREAM3DFileBrowser::getFilePath() const
+{
+  return m_FilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer DREAM3DFileBrowser::getBrowseFilter() const
+{
+  return m_Reader;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+DataContainerArray::Pointer DREAM3DFileBrowser::getDataContainerArray() const
+{
+  if(m_Reader == nullptr)
+  {
+    return DataContainerArray::NullPointer();
+  }
+  return m_Reader->getDataContainerArray();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<DataArrayPath> DREAM3DFileBrowser::getDataArrayPaths() const
+{
+  QVector<DataArrayPath> paths;
+  DataContainerArray::Pointer dca = getDataContainerArray();
+  if(dca == nullptr)
+  {
+    return paths;
+  }
+
+  for(const auto& dc : dca->getDataContainers())
+  {
+    for(const auto& am : dc->getAttributeMatrices())
+    {
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        paths.push_back(DataArrayPath(dc->getName(), am->getName(), arrayName));
+      }
+    }
+  }
+  return paths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QDateTime DREAM3DFileBrowser::getLastModified() const
+{
+  return m_LastModified;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer DREAM3DFileBrowser::readDataArray(const DataArrayPath& path, QString& errorMessage)
+{
+  if(!isOpen())
+  {
+    errorMessage = QObject::tr("No file is open.");
+    return IDataArray::NullPointer();
+  }
+
+  // A pipeline run may have rewritten the file since the cached arrays were read
+  QDateTime lastModified = QFileInfo(m_FilePath).lastModified();
+  if(lastModified != m_LastModified)
+  {
+    m_ArrayCache.clear();
+    m_LastModified = lastModified;
+  }
+
+  QString key = path.serialize("/");
+  if(IDataArray::Pointer* cached = m_ArrayCache.object(key))
+  {
+    return *cached;
+  }
+
+  hid_t fileId = QH5Utilities::openFile(m_FilePath, true);
+  if(fileId < 0)
+  {
+    errorMessage = QObject::tr("The file '%1' could not be opened.").arg(m_FilePath);
+    return IDataArray::NullPointer();
+  }
+  H5ScopedFileSentinel sentinel(&fileId, true);
+
+  QString groupPath = QString("/%1/%2/%3").arg(SIMPL::StringConstants::DataContainerGroupName, path.getDataContainerName(), path.getAttributeMatrixName());
+  hid_t amGid = H5Gopen(fileId, groupPath.toLatin1().constData(), H5P_DEFAULT);
+  if(amGid < 0)
+  {
+    errorMessage = QObject::tr("The attribute matrix '%1' was not found in the file.").arg(groupPath);
+    return IDataArray::NullPointer();
+  }
+  sentinel.addGroupId(&amGid);
+
+  IDataArray::Pointer array = H5DataArrayReader::ReadIDataArray(amGid, path.getDataArrayName());
+  if(array == nullptr)
+  {
+    errorMessage = QObject::tr("The array '%1' could not be read.").arg(key);
+    return IDataArray::NullPointer();
+  }
+
+  int cost = static_cast<int>(std::max<qint64>(1, ByteSize(array) / (1024 * 1024)));
+  if(cost <= m_ArrayCache.maxCost())
+  {
+    m_ArrayCache.insert(key, new IDataArray::Pointer(array), cost);
+  }
+  return array;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer DREAM3DFileBrowser::getArrayStructure(const DataArrayPath& path) const
+{
+  DataContainerArray::Pointer dca = getDataContainerArray();
+  AttributeMatrix::Pointer am = (dca != nullptr) ? dca->getAttributeMatrix(path) : AttributeMatrix::NullPointer();
+  if(am == nullptr)
+  {
+    return IDataArray::NullPointer();
+  }
+  return am->getAttributeArray(path.getDataArrayName());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer DREAM3DFileBrowser::ReadFirstTuples(const QString& filePath, const DataArrayPath& path, const IDataArray::Pointer& structure, size_t tupleCount, QString& errorMessage)
+{
+  if(!IsReadableStructure(structure, errorMessage))
+  {
+    return IDataArray::NullPointer();
+  }
+
+  tupleCount = std::min(tupleCount, structure->getNumberOfTuples());
+  IDataArray::Pointer array = structure->createNewArray(tupleCount, structure->getComponentDimensions(), structure->getName(), true);
+  bool read = ReadDataset(filePath, path, array, errorMessage, [&array](hid_t datasetId, hid_t fileSpaceId, const std::vector<hsize_t>& dims, hid_t memoryTypeId) {
+    // The first elements in storage order are a box along the slowest dimension, then one along the next
+    // dimension at the index the first box ends, and so on; their union is read in that order
+    hsize_t elementCount = static_cast<hsize_t>(array->getSize());
+    hsize_t remaining = elementCount;
+    std::vector<hsize_t> prefix(dims.size(), 0);
+    herr_t err = H5Sselect_none(fileSpaceId);
+    for(size_t i = 0; i < dims.size() && remaining > 0 && err >= 0; i++)
+    {
+      hsize_t below = std::accumulate(dims.cbegin() + i + 1, dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+      hsize_t whole = remaining / below;
+      if(whole > 0)
+      {
+        std::vector<hsize_t> count(dims.size(), 1);
+        count[i] = whole;
+        std::copy(dims.cbegin() + i + 1, dims.cend(), count.begin() + i + 1);
+        err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_OR, prefix.data(), nullptr, count.data(), nullptr);
+        remaining -= whole * below;
+      }
+      prefix[i] = whole;
+    }
+    if(err < 0 || elementCount == 0)
+    {
+      return err;
+    }
+
+    hid_t memorySpaceId = H5Screate_simple(1, &elementCount, nullptr);
+    err = H5Dread(datasetId, memoryTypeId, memorySpaceId, fileSpaceId, H5P_DEFAULT, array->getVoidPointer(0));
+    H5Sclose(memorySpaceId);
+    return err;
+  });
+  return read ? array : IDataArray::NullPointer();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer DREAM3DFileBrowser::ReadDataArray(const QString& filePath, const DataArrayPath& path, const IDataArray::Pointer& structure, const std::atomic_bool& cancelled,
+                                                      QString& errorMessage)
+{
+  if(!IsReadableStructure(structure, errorMessage))
+  {
+    return IDataArray::NullPointer();
+  }
+
+  IDataArray::Pointer array = structure->createNewArray(structure->getNumberOfTuples(), structure->getComponentDimensions(), structure->getName(), true);
+  bool read = ReadDataset(filePath, path, array, errorMessage, [&array, &cancelled](hid_t datasetId, hid_t fileSpaceId, const std::vector<hsize_t>& dims, hid_t memoryTypeId) {
+    hsize_t elementCount = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+    if(dims.empty() || elementCount != static_cast<hsize_t>(array->getSize()))
+    {
+      return static_cast<herr_t>(-1);
+    }
+
+    // Whole rows of the slowest dimension are read at a time, so a cancel takes effect within one chunk
+    hsize_t rowsPerChunk = RowsPerChunk(RowElements(dims));
+    herr_t err = 0;
+    for(hsize_t row = 0; row < dims[0] && err >= 0; row += rowsPerChunk)
+    {
+      if(cancelled)
+      {
+        return static_cast<herr_t>(-1);
+      }
+      err = ReadRows(datasetId, fileSpaceId, dims, memoryTypeId, row, std::min(rowsPerChunk, dims[0] - row), array);
+    }
+    return err;
+  });
+  if(!read && cancelled)
+  {
+    errorMessage = QObject::tr("The read was cancelled.");
+  }
+  return read ? array : IDataArray::NullPointer();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DREAM3DFileBrowser::ReadDataArrayChunk(const QString& filePath, const DataArrayPath& path, const IDataArray::Pointer& array, size_t chunk, size_t& chunkCount, size_t& valueCount,
+                                            QString& errorMessage)
+{
+  chunkCount = 0;
+  valueCount = 0;
+  if(!IsReadableStructure(array, errorMessage))
+  {
+    return false;
+  }
+
+  return ReadDataset(filePath, path, array, errorMessage, [&](hid_t datasetId, hid_t fileSpaceId, const std::vector<hsize_t>& dims, hid_t memoryTypeId) {
+    hsize_t elementCount = std::accumulate(dims.cbegin(), dims.cend(), static_cast<hsize_t>(1), std::multiplies<hsize_t>());
+    if(dims.empty() || elementCount != static_cast<hsize_t>(array->getSize()))
+    {
+      return static_cast<herr_t>(-1);
+    }
+
+    hsize_t rowElements = RowElements(dims);
+    hsize_t rowsPerChunk = RowsPerChunk(rowElements);
+    chunkCount = static_cast<size_t>((dims[0] + rowsPerChunk - 1) / rowsPerChunk);
+    if(chunk >= chunkCount)
+    {
+      return static_cast<herr_t>(-1);
+    }
+
+    hsize_t row = chunk * rowsPerChunk;
+    hsize_t rowCount = std::min(rowsPerChunk, dims[0] - row);
+    valueCount = static_cast<size_t>(rowCount * rowElements);
+    return ReadRows(datasetId, fileSpaceId, dims, memoryTypeId, row, rowCount, array);
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void DREAM3DFileBrowser::setCacheLimit(int megabytes)
+{
+  m_ArrayCache.setMaxCost(std::max(1, megabytes));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+IDataArray::Pointer DREAM3DFileBrowser::cachedDataArray(const DataArrayPath& path) const
+{
+  IDataArray::Pointer* cached = m_ArrayCache.object(path.serialize("/"));
+  if(cached == nullptr || QFileInfo(m_FilePath).lastModified() != m_LastModified)
+  {
+    return IDataArray::NullPointer();
+  }
+  return *cached;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DREAM3DFileBrowser::IsHDF5ThreadSafe()
+{
+  static const bool threadSafe = [] {
+    hbool_t isThreadSafe = 0;
+    return H5is_library_threadsafe(&isThreadSafe) >= 0 && isThreadSafe > 0;
+  }();
+  return threadSafe;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 DREAM3DFileBrowser::ByteSize(const IDataArray::Pointer& array)
+{
+  if(array == nullptr)
+  {
+    return 0;
+  }
+  return static_cast<qint64>(array->getNumberOfTuples()) * array->getNumberOfComponents() * array->getTypeSize();
+}
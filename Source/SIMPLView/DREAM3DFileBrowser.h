@@ -0,0 +1,208 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+
+#include <QtCore/QCache>
+#include <QtCore/QDateTime>
+#include <QtCore/QString>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The DREAM3DFileBrowser class exposes the structure of a .dream3d file without reading its data.  Opening
+ * a file preflights a DataContainerReader, which only reads the HDF5 metadata: the data containers, geometries,
+ * attribute matrices and, for every array, its type, tuple count and component dimensions.  The arrays it
+ * creates are never allocated.  Array values are read one array at a time, on demand, and the most recently
+ * read arrays are kept in a cache bounded by memory.
+ *
+ * All methods must be called from the GUI thread.  SIMPLib makes its HDF5 calls without any lock SIMPLView could
+ * share, so HDF5 may only be used from other threads when the library is built thread safe; see IsHDF5ThreadSafe.
+ */
+class DREAM3DFileBrowser
+{
+public:
+  DREAM3DFileBrowser();
+  ~DREAM3DFileBrowser();
+
+  /**
+   * @brief Reads the structure of a .dream3d file, replacing any file that was open
+   * @param filePath
+   * @param errorMessage
+   * @return
+   */
+  bool open(const QString& filePath, QString& errorMessage);
+
+  /**
+   * @brief Forgets the open file and releases the cached arrays
+   */
+  void close();
+
+  /**
+   * @brief Returns true if a file is open
+   * @return
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Returns the path of the open file
+   * @return
+   */
+  QString getFilePath() const;
+
+  /**
+   * @brief Returns the preflighted reader.  Its DataContainerArray holds the structure of the file and can be
+   * shown by DataStructureWidget::filterActivated.
+   * @return
+   */
+  AbstractFilter::Pointer getBrowseFilter() const;
+
+  /**
+   * @brief Returns the structure of the file.  None of its arrays are allocated.
+   * @return
+   */
+  DataContainerArray::Pointer getDataContainerArray() const;
+
+  /**
+   * @brief Returns the paths of all the arrays in the file
+   * @return
+   */
+  QVector<DataArrayPath> getDataArrayPaths() const;
+
+  /**
+   * @brief Returns the time the open file was last modified when its structure or an array was last read
+   * @return
+   */
+  QDateTime getLastModified() const;
+
+  /**
+   * @brief Reads the values of one array from the file, or returns it from the cache.  The cache is dropped when
+   * the file has been modified since it was filled.
+   * @param path
+   * @param errorMessage
+   * @return A null pointer if the array cannot be read
+   */
+  IDataArray::Pointer readDataArray(const DataArrayPath& path, QString& errorMessage);
+
+  /**
+   * @brief Returns the array of the structure of the file at the path.  Its values are not allocated.
+   * @param path
+   * @return A null pointer if the file has no such array
+   */
+  IDataArray::Pointer getArrayStructure(const DataArrayPath& path) const;
+
+  /**
+   * @brief Reads only the first tuples of an array with one hyperslab selection, whatever the size of the array.
+   * Does not use the cache, so it may be called from a worker thread when IsHDF5ThreadSafe() is true.
+   * @param filePath
+   * @param path
+   * @param structure The array of the structure of the file, which gives the type and components to read
+   * @param tupleCount
+   * @param errorMessage
+   * @return A null pointer if the array cannot be read
+   */
+  static IDataArray::Pointer ReadFirstTuples(const QString& filePath, const DataArrayPath& path, const IDataArray::Pointer& structure, size_t tupleCount, QString& errorMessage);
+
+  /**
+   * @brief Reads a whole array in chunks of rows, checking cancelled between them.  Does not use the cache, so it
+   * may be called from a worker thread when IsHDF5ThreadSafe() is true.
+   * @param filePath
+   * @param path
+   * @param structure The array of the structure of the file, which gives the type, tuples and components to read
+   * @param cancelled
+   * @param errorMessage
+   * @return A null pointer if the array cannot be read or the read was cancelled
+   */
+  static IDataArray::Pointer ReadDataArray(const QString& filePath, const DataArrayPath& path, const IDataArray::Pointer& structure, const std::atomic_bool& cancelled, QString& errorMessage);
+
+  /**
+   * @brief Reads one of the chunks ReadDataArray reads, so an array can be read a chunk at a time between events
+   * on the GUI thread.  The file is opened for each chunk.  Does not use the cache.
+   * @param filePath
+   * @param path
+   * @param array Created from the array of the structure of the file with all of its tuples
+   * @param chunk
+   * @param chunkCount Set to the number of chunks of the array
+   * @param valueCount Set to the number of values the chunk held; the chunks are stored one after the other
+   * @param errorMessage
+   * @return False if the chunk cannot be read
+   */
+  static bool ReadDataArrayChunk(const QString& filePath, const DataArrayPath& path, const IDataArray::Pointer& array, size_t chunk, size_t& chunkCount, size_t& valueCount, QString& errorMessage);
+
+  /**
+   * @brief Sets the memory, in MB, the arrays read from the file may hold in the cache.  An array larger
+   * than the limit is still returned, it is just not cached.
+   * @param megabytes
+   */
+  void setCacheLimit(int megabytes);
+
+  /**
+   * @brief Returns an array that was already read from the file, without reading it
+   * @param path
+   * @return A null pointer if the array is not in the cache
+   */
+  IDataArray::Pointer cachedDataArray(const DataArrayPath& path) const;
+
+  /**
+   * @brief Returns true if the HDF5 library serializes its own calls, so SIMPLView may read files on worker threads
+   * while pipelines use HDF5 on theirs
+   * @return
+   */
+  static bool IsHDF5ThreadSafe();
+
+  /**
+   * @brief Returns the number of bytes an array would need once its values are read
+   * @param array
+   * @return
+   */
+  static qint64 ByteSize(const IDataArray::Pointer& array);
+
+private:
+  QString m_FilePath;
+  QDateTime m_LastModified;
+  AbstractFilter::Pointer m_Reader;
+  QCache<QString, IDataArray::Pointer> m_ArrayCache;
+
+public:
+  DREAM3DFileBrowser(const DREAM3DFileBrowser&) = delete;            // Copy Constructor Not Implemented
+  DREAM3DFileBrowser(DREAM3DFileBrowser&&) = delete;                 // Move Constructor Not Implemented
+  DREAM3DFileBrowser& operator=(const DREAM3DFileBrowser&) = delete; // Copy Assignment Not Implemented
+  DREAM3DFileBrowser& operator=(DREAM3DFileBrowser&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,90 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "DREAM3DPipelineReader.h"
+
+#include <hdf5.h>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/Constants.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool DREAM3DPipelineReader::ReadPipelineJson(const QString& filePath, QByteArray& json, QString& errorMessage)
+{
+  // Missing groups and attributes are expected for older files, so HDF5 is kept from printing its error stack
+  H5E_auto2_t errorFunction = nullptr;
+  void* errorData = nullptr;
+  H5Eget_auto2(H5E_DEFAULT, &errorFunction, &errorData);
+  H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+
+  // DataContainerWriter stores the pipeline JSON in an attribute named after the group that carries it
+  const QByteArray groupName = SIMPL::StringConstants::PipelineGroupName.toLatin1();
+
+  bool success = false;
+  hid_t fileId = QH5Utilities::openFile(filePath, true);
+  if(fileId < 0)
+  {
+    errorMessage = QString("Unable to open '%1' as an HDF5 file").arg(filePath);
+  }
+  else if(H5Lexists(fileId, groupName.constData(), H5P_DEFAULT) <= 0 || H5Aexists_by_name(fileId, groupName.constData(), groupName.constData(), H5P_DEFAULT) <= 0)
+  {
+    errorMessage = QString("'%1' does not contain a JSON pipeline").arg(filePath);
+  }
+  else
+  {
+    QString pipelineJson;
+    if(QH5Lite::readStringAttribute(fileId, SIMPL::StringConstants::PipelineGroupName, SIMPL::StringConstants::PipelineGroupName, pipelineJson) < 0 || pipelineJson.isEmpty())
+    {
+      errorMessage = QString("Unable to read the pipeline stored in '%1'").arg(filePath);
+    }
+    else
+    {
+      json = pipelineJson.toUtf8();
+      success = true;
+    }
+  }
+
+  if(fileId >= 0)
+  {
+    QH5Utilities::closeFile(fileId);
+  }
+  H5Eset_auto2(H5E_DEFAULT, errorFunction, errorData);
+
+  return success;
+}
@@ -0,0 +1,332 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ExecutionQueueWidget.h"
+
+#include <algorithm>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QLocale>
+#include <QtCore/QSignalBlocker>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtWidgets/QDoubleSpinBox>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QSpinBox>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/ExecutionScheduler.h"
+
+namespace
+{
+const double k_BytesPerGB = 1024.0 * 1024.0 * 1024.0;
+
+enum Column
+{
+  NameColumn = 0,
+  OwnerColumn,
+  PriorityColumn,
+  StateColumn,
+  ThreadsColumn,
+  MemoryColumn,
+  TimeColumn,
+  ColumnCount
+};
+
+// -----------------------------------------------------------------------------
+QString PriorityName(ExecutionScheduler::Priority priority)
+{
+  switch(priority)
+  {
+  case ExecutionScheduler::Priority::Interactive:
+    return QObject::tr("Interactive");
+  case ExecutionScheduler::Priority::Batch:
+    return QObject::tr("Batch");
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+QString StateName(ExecutionScheduler::State state)
+{
+  switch(state)
+  {
+  case ExecutionScheduler::State::Queued:
+    return QObject::tr("Queued");
+  case ExecutionScheduler::State::Running:
+    return QObject::tr("Running");
+  case ExecutionScheduler::State::Finished:
+    return QObject::tr("Finished");
+  case ExecutionScheduler::State::Cancelled:
+    return QObject::tr("Cancelled");
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionQueueWidget::ExecutionQueueWidget(QWidget* parent)
+: QWidget(parent)
+{
+  m_JobsTree = new QTreeWidget(this);
+  m_JobsTree->setColumnCount(ColumnCount);
+  m_JobsTree->setHeaderLabels({tr("Run"), tr("Window"), tr("Priority"), tr("State"), tr("Threads"), tr("Memory"), tr("Time")});
+  m_JobsTree->setRootIsDecorated(false);
+  m_JobsTree->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  m_JobsTree->header()->setStretchLastSection(false);
+  m_JobsTree->header()->setSectionResizeMode(NameColumn, QHeaderView::Stretch);
+
+  m_PauseButton = new QPushButton(tr("Pause"), this);
+  m_PauseButton->setCheckable(true);
+  m_PauseButton->setToolTip(tr("Queued runs do not start while the queue is paused; running ones continue."));
+  m_CancelButton = new QPushButton(tr("Cancel"), this);
+
+  m_ThreadLimitSpinBox = new QSpinBox(this);
+  m_ThreadLimitSpinBox->setRange(1, std::max(QThread::idealThreadCount(), 1) * 4);
+  m_ThreadsPerRunSpinBox = new QSpinBox(this);
+  m_ThreadsPerRunSpinBox->setRange(1, m_ThreadLimitSpinBox->maximum());
+  m_MemoryLimitSpinBox = new QDoubleSpinBox(this);
+  m_MemoryLimitSpinBox->setRange(0.0, 1024.0 * 1024.0);
+  m_MemoryLimitSpinBox->setDecimals(1);
+  m_MemoryLimitSpinBox->setSuffix(tr(" GB"));
+  m_MemoryLimitSpinBox->setSpecialValueText(tr("No limit"));
+  m_UsageLabel = new QLabel(this);
+
+  QHBoxLayout* buttonLayout = new QHBoxLayout();
+  buttonLayout->addWidget(m_UsageLabel, 1);
+  buttonLayout->addWidget(m_PauseButton);
+  buttonLayout->addWidget(m_CancelButton);
+
+  QFormLayout* limitsLayout = new QFormLayout();
+  limitsLayout->addRow(tr("Worker threads:"), m_ThreadLimitSpinBox);
+  limitsLayout->addRow(tr("Threads per run:"), m_ThreadsPerRunSpinBox);
+  limitsLayout->addRow(tr("Memory:"), m_MemoryLimitSpinBox);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(m_JobsTree, 1);
+  layout->addLayout(buttonLayout);
+  layout->addLayout(limitsLayout);
+
+  // Keeps the run times of running and queued jobs current
+  m_ElapsedTimer = new QTimer(this);
+  m_ElapsedTimer->setInterval(1000);
+  connect(m_ElapsedTimer, &QTimer::timeout, this, &ExecutionQueueWidget::refreshJobs);
+
+  connect(m_CancelButton, &QPushButton::clicked, this, &ExecutionQueueWidget::cancelSelectedJobs);
+  connect(m_PauseButton, &QPushButton::toggled, this, [this](bool paused) {
+    if(m_Scheduler != nullptr)
+    {
+      m_Scheduler->setPaused(paused);
+    }
+  });
+  connect(m_ThreadLimitSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int threads) {
+    if(m_Scheduler != nullptr)
+    {
+      m_Scheduler->setThreadLimit(threads);
+    }
+  });
+  connect(m_ThreadsPerRunSpinBox, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int threads) {
+    if(m_Scheduler != nullptr)
+    {
+      m_Scheduler->setThreadsPerRun(threads);
+    }
+  });
+  connect(m_MemoryLimitSpinBox, QOverload<double>::of(&QDoubleSpinBox::valueChanged), this, [this](double gigabytes) {
+    if(m_Scheduler != nullptr)
+    {
+      m_Scheduler->setMemoryLimit(static_cast<qint64>(gigabytes * k_BytesPerGB));
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionQueueWidget::~ExecutionQueueWidget() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionQueueWidget::setScheduler(ExecutionScheduler* scheduler)
+{
+  if(m_Scheduler != nullptr)
+  {
+    disconnect(m_Scheduler, nullptr, this, nullptr);
+  }
+
+  m_Scheduler = scheduler;
+  if(m_Scheduler != nullptr)
+  {
+    connect(m_Scheduler, &ExecutionScheduler::jobsChanged, this, &ExecutionQueueWidget::refreshJobs);
+    connect(m_Scheduler, &ExecutionScheduler::limitsChanged, this, &ExecutionQueueWidget::refreshLimits);
+    connect(m_Scheduler, &ExecutionScheduler::pausedChanged, this, &ExecutionQueueWidget::refreshLimits);
+  }
+
+  refreshLimits();
+  refreshJobs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionQueueWidget::refreshLimits()
+{
+  setEnabled(m_Scheduler != nullptr);
+  if(m_Scheduler == nullptr)
+  {
+    return;
+  }
+
+  // Every window shows the same scheduler, so the values are set without writing them back
+  QSignalBlocker pauseBlocker(m_PauseButton);
+  QSignalBlocker threadBlocker(m_ThreadLimitSpinBox);
+  QSignalBlocker threadsPerRunBlocker(m_ThreadsPerRunSpinBox);
+  QSignalBlocker memoryBlocker(m_MemoryLimitSpinBox);
+
+  m_PauseButton->setChecked(m_Scheduler->isPaused());
+  m_PauseButton->setText(m_Scheduler->isPaused() ? tr("Resume") : tr("Pause"));
+  m_ThreadLimitSpinBox->setValue(m_Scheduler->getThreadLimit());
+  m_ThreadsPerRunSpinBox->setMaximum(m_Scheduler->getThreadLimit());
+  m_ThreadsPerRunSpinBox->setValue(m_Scheduler->getThreadsPerRun());
+  m_MemoryLimitSpinBox->setValue(m_Scheduler->getMemoryLimit() / k_BytesPerGB);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionQueueWidget::refreshJobs()
+{
+  if(m_Scheduler == nullptr)
+  {
+    m_JobsTree->clear();
+    return;
+  }
+
+  QList<int> selectedIds;
+  for(QTreeWidgetItem* item : m_JobsTree->selectedItems())
+  {
+    selectedIds.push_back(item->data(NameColumn, Qt::UserRole).toInt());
+  }
+
+  QLocale locale;
+  QDateTime now = QDateTime::currentDateTime();
+  std::vector<ExecutionScheduler::Job> jobs = m_Scheduler->getJobs();
+  bool anyActive = false;
+
+  m_JobsTree->setUpdatesEnabled(false);
+  m_JobsTree->clear();
+  for(const ExecutionScheduler::Job& job : jobs)
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_JobsTree);
+    item->setData(NameColumn, Qt::UserRole, job.id);
+    item->setText(NameColumn, job.name);
+    item->setText(OwnerColumn, job.owner);
+    item->setText(PriorityColumn, PriorityName(job.priority));
+    item->setText(StateColumn, StateName(job.state));
+    item->setText(ThreadsColumn, QString::number(job.threads));
+    item->setText(MemoryColumn, job.memory > 0 ? locale.formattedDataSize(job.memory) : QString());
+
+    // Queued jobs show how long they have been waiting, the others how long they ran
+    qint64 milliseconds = 0;
+    switch(job.state)
+    {
+    case ExecutionScheduler::State::Queued:
+      milliseconds = job.queuedTime.msecsTo(now);
+      anyActive = true;
+      break;
+    case ExecutionScheduler::State::Running:
+      milliseconds = job.startTime.msecsTo(now);
+      anyActive = true;
+      break;
+    default:
+      milliseconds = job.startTime.isValid() ? job.startTime.msecsTo(job.endTime) : 0;
+      break;
+    }
+    item->setText(TimeColumn, FormatDuration(milliseconds));
+    item->setSelected(selectedIds.contains(job.id));
+  }
+  m_JobsTree->setUpdatesEnabled(true);
+
+  QString memoryLimit = m_Scheduler->getMemoryLimit() > 0 ? locale.formattedDataSize(m_Scheduler->getMemoryLimit()) : tr("no limit");
+  m_UsageLabel->setText(tr("%1 of %2 threads, %3 of %4 reserved")
+                            .arg(m_Scheduler->getThreadsInUse())
+                            .arg(m_Scheduler->getThreadLimit())
+                            .arg(locale.formattedDataSize(m_Scheduler->getMemoryInUse()), memoryLimit));
+
+  if(anyActive && !m_ElapsedTimer->isActive())
+  {
+    m_ElapsedTimer->start();
+  }
+  else if(!anyActive)
+  {
+    m_ElapsedTimer->stop();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionQueueWidget::cancelSelectedJobs()
+{
+  if(m_Scheduler == nullptr)
+  {
+    return;
+  }
+
+  // Cancelling refreshes the list, so the ids are collected first
+  QList<int> jobIds;
+  for(QTreeWidgetItem* item : m_JobsTree->selectedItems())
+  {
+    jobIds.push_back(item->data(NameColumn, Qt::UserRole).toInt());
+  }
+  for(int jobId : jobIds)
+  {
+    m_Scheduler->cancel(jobId);
+  }
+}
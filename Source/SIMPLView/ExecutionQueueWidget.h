@@ -0,0 +1,99 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtWidgets/QWidget>
+
+class ExecutionScheduler;
+class QDoubleSpinBox;
+class QLabel;
+class QPushButton;
+class QSpinBox;
+class QTimer;
+class QTreeWidget;
+
+/**
+ * @brief The ExecutionQueueWidget class shows the runs of the application wide ExecutionScheduler and its limits.
+ * Every window has one; they all show the same queue.
+ */
+class ExecutionQueueWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  ExecutionQueueWidget(QWidget* parent = nullptr);
+  ~ExecutionQueueWidget() override;
+
+  /**
+   * @brief Sets the scheduler that is shown
+   * @param scheduler
+   */
+  void setScheduler(ExecutionScheduler* scheduler);
+
+public Q_SLOTS:
+  /**
+   * @brief Refills the job list from the scheduler
+   */
+  void refreshJobs();
+
+  /**
+   * @brief Cancels the selected jobs
+   */
+  void cancelSelectedJobs();
+
+private:
+  ExecutionScheduler* m_Scheduler = nullptr;
+
+  QTreeWidget* m_JobsTree = nullptr;
+  QPushButton* m_PauseButton = nullptr;
+  QPushButton* m_CancelButton = nullptr;
+  QSpinBox* m_ThreadLimitSpinBox = nullptr;
+  QSpinBox* m_ThreadsPerRunSpinBox = nullptr;
+  QDoubleSpinBox* m_MemoryLimitSpinBox = nullptr;
+  QLabel* m_UsageLabel = nullptr;
+  QTimer* m_ElapsedTimer = nullptr;
+
+  /**
+   * @brief Shows the limits of the scheduler without writing them back
+   */
+  void refreshLimits();
+
+public:
+  ExecutionQueueWidget(const ExecutionQueueWidget&) = delete;            // Copy Constructor Not Implemented
+  ExecutionQueueWidget(ExecutionQueueWidget&&) = delete;                 // Move Constructor Not Implemented
+  ExecutionQueueWidget& operator=(const ExecutionQueueWidget&) = delete; // Copy Assignment Not Implemented
+  ExecutionQueueWidget& operator=(ExecutionQueueWidget&&) = delete;      // Move Assignment Not Implemented
+};
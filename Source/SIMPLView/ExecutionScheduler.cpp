@@ -0,0 +1,575 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ExecutionScheduler.h"
+
+#include <algorithm>
+
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(Q_OS_MAC)
+#include <sys/sysctl.h>
+#include <sys/types.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/PipelineCostEstimator.h"
+#include "SIMPLView/PipelineExecution.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionScheduler::ExecutionScheduler(QObject* parent)
+: QObject(parent)
+{
+  readSettings();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionScheduler::~ExecutionScheduler() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExecutionScheduler::submit(const QString& name, const QString& owner, Priority priority, int threads, qint64 memory, StartFunction start)
+{
+  Job job;
+  job.id = m_NextJobId++;
+  job.name = name;
+  job.owner = owner;
+  job.priority = priority;
+  job.threads = std::max(threads, 1);
+  job.memory = std::max(memory, static_cast<qint64>(0));
+  job.state = State::Queued;
+  job.queuedTime = QDateTime::currentDateTime();
+
+  m_Jobs[job.id] = job;
+  m_StartFunctions[job.id] = std::move(start);
+
+  Q_EMIT jobsChanged();
+  scheduleLater();
+  return job.id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExecutionScheduler::submitPipeline(const QString& name, const QString& owner, Priority priority, qint64 memory, PipelineExecution* execution, int threads)
+{
+  int jobId = submit(name, owner, priority, threads < 0 ? m_ThreadsPerRun : threads, memory, [execution](int) { execution->start(); });
+
+  connect(execution, &PipelineExecution::finished, this, [this, jobId, execution] {
+    // Deferred writers still hold the computed data, so its memory stays reserved under a job of their own until
+    // they are done.  Pending writes are bounded by the memory limit that way.
+    Job job;
+    if(execution->isWriting() && getJob(jobId, job))
+    {
+      int writeJobId = registerRunning(tr("Writing %1").arg(job.name), job.owner, job.priority, 1, job.memory);
+      connect(execution, &PipelineExecution::writesFinished, this, [this, writeJobId] { finish(writeJobId); });
+      connect(execution, &QObject::destroyed, this, [this, writeJobId] { finish(writeJobId); });
+    }
+    finish(jobId);
+  });
+  connect(this, &ExecutionScheduler::cancelRequested, execution, [execution, jobId](int cancelledJobId) {
+    if(cancelledJobId == jobId)
+    {
+      execution->cancel();
+    }
+  });
+
+  // An execution that is deleted while it waits must not be started later, and one that is deleted while it
+  // runs never reports that it finished
+  connect(execution, &QObject::destroyed, this, [this, jobId] {
+    Job job;
+    if(getJob(jobId, job) && job.state == State::Running)
+    {
+      finish(jobId);
+    }
+    else
+    {
+      cancel(jobId);
+    }
+  });
+  return jobId;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExecutionScheduler::registerRunning(const QString& name, const QString& owner, Priority priority, int threads, qint64 memory)
+{
+  Job job;
+  job.id = m_NextJobId++;
+  job.name = name;
+  job.owner = owner;
+  job.priority = priority;
+  job.threads = std::min(std::max(threads, 1), m_ThreadLimit);
+  job.memory = std::max(memory, static_cast<qint64>(0));
+  job.state = State::Running;
+  job.queuedTime = QDateTime::currentDateTime();
+  job.startTime = job.queuedTime;
+
+  m_Jobs[job.id] = job;
+  m_ThreadsInUse += job.threads;
+  m_MemoryInUse += job.memory;
+
+  Q_EMIT jobsChanged();
+  Q_EMIT jobStarted(job.id);
+  return job.id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::finish(int jobId)
+{
+  auto iter = m_Jobs.find(jobId);
+  if(iter == m_Jobs.end())
+  {
+    return;
+  }
+
+  if(iter->second.state == State::Running)
+  {
+    m_ThreadsInUse -= iter->second.threads;
+    m_MemoryInUse -= iter->second.memory;
+  }
+  endJob(jobId, State::Finished);
+  scheduleLater();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::cancel(int jobId)
+{
+  auto iter = m_Jobs.find(jobId);
+  if(iter == m_Jobs.end())
+  {
+    return;
+  }
+
+  if(iter->second.state == State::Queued)
+  {
+    endJob(jobId, State::Cancelled);
+    scheduleLater();
+    return;
+  }
+
+  Q_EMIT cancelRequested(jobId);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::endJob(int jobId, State state)
+{
+  auto iter = m_Jobs.find(jobId);
+  Job job = iter->second;
+  job.state = state;
+  job.endTime = QDateTime::currentDateTime();
+  m_Jobs.erase(iter);
+  m_StartFunctions.erase(jobId);
+
+  m_EndedJobs.push_front(job);
+  while(m_EndedJobs.size() > static_cast<size_t>(SIMPLView::ExecutionQueue::EndedJobsShown))
+  {
+    m_EndedJobs.pop_back();
+  }
+
+  Q_EMIT jobsChanged();
+  Q_EMIT jobFinished(jobId);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<ExecutionScheduler::Job> ExecutionScheduler::getJobs() const
+{
+  std::vector<Job> jobs;
+  for(const auto& entry : m_Jobs)
+  {
+    jobs.push_back(entry.second);
+  }
+
+  // Running jobs first, then queued ones in the order they will start
+  std::stable_sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) {
+    if(a.state != b.state)
+    {
+      return a.state == State::Running;
+    }
+    return a.priority < b.priority;
+  });
+
+  jobs.insert(jobs.end(), m_EndedJobs.cbegin(), m_EndedJobs.cend());
+  return jobs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionScheduler::getJob(int jobId, Job& job) const
+{
+  auto iter = m_Jobs.find(jobId);
+  if(iter != m_Jobs.end())
+  {
+    job = iter->second;
+    return true;
+  }
+
+  auto ended = std::find_if(m_EndedJobs.cbegin(), m_EndedJobs.cend(), [jobId](const Job& endedJob) { return endedJob.id == jobId; });
+  if(ended != m_EndedJobs.cend())
+  {
+    job = *ended;
+    return true;
+  }
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionScheduler::isActive(int jobId) const
+{
+  return m_Jobs.find(jobId) != m_Jobs.end();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::setPaused(bool paused)
+{
+  if(m_Paused == paused)
+  {
+    return;
+  }
+  m_Paused = paused;
+  Q_EMIT pausedChanged(m_Paused);
+  scheduleLater();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionScheduler::isPaused() const
+{
+  return m_Paused;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::setThreadLimit(int threads)
+{
+  m_ThreadLimit = std::max(threads, 1);
+  m_ThreadsPerRun = std::min(m_ThreadsPerRun, m_ThreadLimit);
+
+  // Background work of the application, such as the array statistics, shares the same limit
+  QThreadPool::globalInstance()->setMaxThreadCount(m_ThreadLimit);
+
+  writeSettings();
+  Q_EMIT limitsChanged();
+  scheduleLater();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExecutionScheduler::getThreadLimit() const
+{
+  return m_ThreadLimit;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::setMemoryLimit(qint64 bytes)
+{
+  m_MemoryLimit = std::max(bytes, static_cast<qint64>(0));
+  writeSettings();
+  Q_EMIT limitsChanged();
+  scheduleLater();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ExecutionScheduler::getMemoryLimit() const
+{
+  return m_MemoryLimit;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::setThreadsPerRun(int threads)
+{
+  m_ThreadsPerRun = std::min(std::max(threads, 1), m_ThreadLimit);
+  writeSettings();
+  Q_EMIT limitsChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExecutionScheduler::getThreadsPerRun() const
+{
+  return m_ThreadsPerRun;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExecutionScheduler::getThreadsInUse() const
+{
+  return m_ThreadsInUse;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ExecutionScheduler::getMemoryInUse() const
+{
+  return m_MemoryInUse;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::scheduleLater()
+{
+  if(m_ScheduleQueued)
+  {
+    return;
+  }
+  m_ScheduleQueued = true;
+  QMetaObject::invokeMethod(this, [this] { schedule(); }, Qt::QueuedConnection);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::schedule()
+{
+  m_ScheduleQueued = false;
+  if(m_Paused)
+  {
+    return;
+  }
+
+  std::vector<Job> queued;
+  for(const auto& entry : m_Jobs)
+  {
+    if(entry.second.state == State::Queued)
+    {
+      queued.push_back(entry.second);
+    }
+  }
+  std::stable_sort(queued.begin(), queued.end(), [](const Job& a, const Job& b) { return a.priority < b.priority; });
+
+  for(const Job& candidate : queued)
+  {
+    int threads = std::min(candidate.threads, m_ThreadLimit);
+
+    // A job that is alone always runs, whatever its estimate
+    bool idle = m_ThreadsInUse == 0 && m_MemoryInUse == 0;
+    bool threadsFit = m_ThreadsInUse + threads <= m_ThreadLimit;
+    bool memoryFits = m_MemoryLimit <= 0 || m_MemoryInUse + candidate.memory <= m_MemoryLimit;
+    if(!idle && !(threadsFit && memoryFits))
+    {
+      break;
+    }
+
+    // An earlier start function may have cancelled this job
+    auto iter = m_Jobs.find(candidate.id);
+    if(iter == m_Jobs.end() || iter->second.state != State::Queued)
+    {
+      continue;
+    }
+
+    Job& job = iter->second;
+    job.state = State::Running;
+    job.threads = threads;
+    job.startTime = QDateTime::currentDateTime();
+    m_ThreadsInUse += job.threads;
+    m_MemoryInUse += job.memory;
+
+    StartFunction start = m_StartFunctions[candidate.id];
+    m_StartFunctions.erase(candidate.id);
+
+    Q_EMIT jobsChanged();
+    Q_EMIT jobStarted(candidate.id);
+    if(start)
+    {
+      start(candidate.id);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ExecutionScheduler::PhysicalMemory()
+{
+#if defined(Q_OS_WIN)
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if(GlobalMemoryStatusEx(&status) != 0)
+  {
+    return static_cast<qint64>(status.ullTotalPhys);
+  }
+  return 0;
+#elif defined(Q_OS_MAC)
+  int64_t memory = 0;
+  size_t length = sizeof(memory);
+  int mib[2] = {CTL_HW, HW_MEMSIZE};
+  if(sysctl(mib, 2, &memory, &length, nullptr, 0) == 0)
+  {
+    return static_cast<qint64>(memory);
+  }
+  return 0;
+#else
+  long pages = sysconf(_SC_PHYS_PAGES);
+  long pageSize = sysconf(_SC_PAGE_SIZE);
+  if(pages > 0 && pageSize > 0)
+  {
+    return static_cast<qint64>(pages) * static_cast<qint64>(pageSize);
+  }
+  return 0;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExecutionScheduler::prepareRun(const QJsonObject& pipelineJson, const QString& name, int concurrency, PreparedRun& run, QString& errorMessage) const
+{
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  run.pipeline = jsonReader->readPipelineFromJson(pipelineJson, nullptr);
+  if(nullptr == run.pipeline || run.pipeline->getFilterContainer().empty())
+  {
+    errorMessage = tr("The pipeline cannot be read.");
+    return false;
+  }
+  if(run.pipeline->preflightPipeline() < 0)
+  {
+    errorMessage = tr("The pipeline has preflight errors.");
+    return false;
+  }
+
+  auto filterContainer = run.pipeline->getFilterContainer();
+  run.memory = EstimatePipelineMemory(std::vector<AbstractFilter::Pointer>(filterContainer.cbegin(), filterContainer.cend()));
+  run.threads = std::max(m_ThreadLimit / std::max(concurrency, 1), 1);
+  run.pipeline->setName(name);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExecutionScheduler::submitPreparedRun(const PreparedRun& run, const QString& owner, PipelineExecution* execution)
+{
+  return submitPipeline(run.pipeline->getName(), owner, Priority::Batch, run.memory, execution, run.threads);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::ReleaseExecution(PipelineExecution* execution)
+{
+  // Deleting the execution right away would pull it out from under its own signal
+  if(nullptr != execution)
+  {
+    execution->deleteLater();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ExecutionScheduler::EstimatePipelineMemory(const std::vector<AbstractFilter::Pointer>& filters)
+{
+  auto last = std::find_if(filters.crbegin(), filters.crend(), [](const AbstractFilter::Pointer& filter) { return filter->getEnabled(); });
+  if(last == filters.crend())
+  {
+    return 0;
+  }
+  return PipelineCostEstimator::DataContainerArrayBytes((*last)->getDataContainerArray());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::readSettings()
+{
+  int idealThreads = std::max(QThread::idealThreadCount(), 1);
+  qint64 defaultMemoryLimit = static_cast<qint64>(PhysicalMemory() * SIMPLView::ExecutionQueue::DefaultMemoryFraction);
+
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::ExecutionQueue::GroupName);
+  m_ThreadLimit = std::max(prefs.value(SIMPLView::ExecutionQueue::ThreadLimit, idealThreads).toInt(), 1);
+  m_MemoryLimit = prefs.value(SIMPLView::ExecutionQueue::MemoryLimit, QVariant(static_cast<qlonglong>(defaultMemoryLimit))).toLongLong();
+  m_ThreadsPerRun = std::min(std::max(prefs.value(SIMPLView::ExecutionQueue::ThreadsPerRun, m_ThreadLimit).toInt(), 1), m_ThreadLimit);
+  prefs.endGroup();
+
+  QThreadPool::globalInstance()->setMaxThreadCount(m_ThreadLimit);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExecutionScheduler::writeSettings() const
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::ExecutionQueue::GroupName);
+  prefs.setValue(SIMPLView::ExecutionQueue::ThreadLimit, m_ThreadLimit);
+  prefs.setValue(SIMPLView::ExecutionQueue::MemoryLimit, QVariant(static_cast<qlonglong>(m_MemoryLimit)));
+  prefs.setValue(SIMPLView::ExecutionQueue::ThreadsPerRun, m_ThreadsPerRun);
+  prefs.endGroup();
+}
@@ -0,0 +1,314 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+class PipelineExecution;
+
+/**
+ * @brief The ExecutionScheduler class decides when pipeline runs start, for all windows of the application.
+ * Every run reserves a number of worker threads and an estimate of the memory it needs; a run only starts once
+ * its reservation fits next to the runs already going, so runs started in several windows queue up instead of
+ * competing for the cores and the memory.  Queued runs start in priority order, and in submission order within a
+ * priority.  A run that does not fit holds back every run of its priority and below, so large runs are not starved
+ * by a stream of small ones.
+ *
+ * Pausing stops new runs from starting; runs that already started continue.
+ *
+ * The scheduler lives on the GUI thread.
+ */
+class ExecutionScheduler : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum class Priority : int
+  {
+    Interactive = 0,
+    Batch = 1
+  };
+
+  enum class State : int
+  {
+    Queued = 0,
+    Running = 1,
+    Finished = 2,
+    Cancelled = 3
+  };
+
+  /**
+   * @brief The Job struct describes one run known to the scheduler
+   */
+  struct Job
+  {
+    int id = 0;
+    QString name;
+    QString owner;
+    Priority priority = Priority::Interactive;
+    int threads = 1;
+    qint64 memory = 0;
+    State state = State::Queued;
+    QDateTime queuedTime;
+    QDateTime startTime;
+    QDateTime endTime;
+  };
+
+  /**
+   * @brief The PreparedRun struct is a pipeline of a batch tool that was read and preflighted, with the reservation
+   * its run needs
+   */
+  struct PreparedRun
+  {
+    FilterPipeline::Pointer pipeline;
+    qint64 memory = 0;
+    int threads = 1;
+  };
+
+  /**
+   * @brief Called on the GUI thread when a job may start.  The job must call finish() once it is done, also when
+   * it could not start after all.
+   */
+  using StartFunction = std::function<void(int jobId)>;
+
+  ExecutionScheduler(QObject* parent = nullptr);
+  ~ExecutionScheduler() override;
+
+  /**
+   * @brief Queues a job
+   * @param name Shown in the queue
+   * @param owner The window or tool that submitted the job
+   * @param priority
+   * @param threads Worker threads the job uses; clamped to the thread limit so every job can eventually run
+   * @param memory Bytes the job is expected to need
+   * @param start
+   * @return The id of the job
+   */
+  int submit(const QString& name, const QString& owner, Priority priority, int threads, qint64 memory, StartFunction start);
+
+  /**
+   * @brief Queues a pipeline execution.  The execution is started when its turn comes, the job finishes with it,
+   * and cancelling the job cancels the execution.  If the execution still writes its results once it finished,
+   * the memory of the job stays reserved by a second job, on one thread, until the writes are done.
+   * @param name
+   * @param owner
+   * @param priority
+   * @param memory
+   * @param execution
+   * @param threads Worker threads the run reserves, or -1 for getThreadsPerRun()
+   * @return The id of the job
+   */
+  int submitPipeline(const QString& name, const QString& owner, Priority priority, qint64 memory, PipelineExecution* execution, int threads = -1);
+
+  /**
+   * @brief Accounts for a run that was started without waiting for the scheduler, such as a run started from the
+   * pipeline view of a window
+   * @param name
+   * @param owner
+   * @param priority
+   * @param threads
+   * @param memory
+   * @return The id of the job
+   */
+  int registerRunning(const QString& name, const QString& owner, Priority priority, int threads, qint64 memory);
+
+  /**
+   * @brief Reads a pipeline for a run of a batch tool and preflights it.  The preflight catches missing inputs
+   * before the run waits for its turn and sizes its memory reservation; the thread limit is shared evenly by the
+   * runs the tool lets go at the same time.
+   * @param pipelineJson
+   * @param name Given to the pipeline, and shown in the queue once it is submitted
+   * @param concurrency Runs of the tool that go at the same time
+   * @param run
+   * @param errorMessage
+   * @return False if the pipeline cannot be read or has preflight errors
+   */
+  bool prepareRun(const QJsonObject& pipelineJson, const QString& name, int concurrency, PreparedRun& run, QString& errorMessage) const;
+
+  /**
+   * @brief Queues a prepared run on an execution of its pipeline at batch priority
+   * @param run
+   * @param owner
+   * @param execution Runs run.pipeline; configure it before the job starts
+   * @return The id of the job
+   */
+  int submitPreparedRun(const PreparedRun& run, const QString& owner, PipelineExecution* execution);
+
+  /**
+   * @brief Deletes the execution of a job once the scheduler is done with it.  Call it from jobFinished(), which
+   * the scheduler emits from inside the finished signal of the execution.
+   * @param execution
+   */
+  static void ReleaseExecution(PipelineExecution* execution);
+
+  /**
+   * @brief Marks a running job as done and releases its reservation
+   * @param jobId
+   */
+  void finish(int jobId);
+
+  /**
+   * @brief Removes a queued job, or asks the owner of a running job to stop it through cancelRequested()
+   * @param jobId
+   */
+  void cancel(int jobId);
+
+  /**
+   * @brief Returns the queued and running jobs, followed by the most recently ended ones
+   * @return
+   */
+  std::vector<Job> getJobs() const;
+
+  /**
+   * @brief Returns a job that is queued, running or recently ended
+   * @param jobId
+   * @param job
+   * @return False if the job is unknown
+   */
+  bool getJob(int jobId, Job& job) const;
+
+  /**
+   * @brief Returns true if the job is queued or running
+   * @param jobId
+   * @return
+   */
+  bool isActive(int jobId) const;
+
+  void setPaused(bool paused);
+  bool isPaused() const;
+
+  void setThreadLimit(int threads);
+  int getThreadLimit() const;
+
+  void setMemoryLimit(qint64 bytes);
+  qint64 getMemoryLimit() const;
+
+  /**
+   * @brief Sets the threads reserved by each pipeline run.  With the default, which is the thread limit, runs do
+   * not overlap.
+   * @param threads
+   */
+  void setThreadsPerRun(int threads);
+  int getThreadsPerRun() const;
+
+  int getThreadsInUse() const;
+  qint64 getMemoryInUse() const;
+
+  /**
+   * @brief Returns the installed physical memory, or 0 if it is unknown
+   * @return
+   */
+  static qint64 PhysicalMemory();
+
+  /**
+   * @brief Estimates the memory a preflighted pipeline needs from the arrays that exist after its last enabled
+   * filter.  Arrays that are created and removed again along the way are not counted.
+   * @param filters
+   * @return
+   */
+  static qint64 EstimatePipelineMemory(const std::vector<AbstractFilter::Pointer>& filters);
+
+Q_SIGNALS:
+  /**
+   * @brief Emitted whenever a job is added, starts, ends or is removed
+   */
+  void jobsChanged();
+
+  void jobStarted(int jobId);
+
+  void jobFinished(int jobId);
+
+  /**
+   * @brief Emitted when a running job should stop.  The owner still calls finish() once it stopped.
+   * @param jobId
+   */
+  void cancelRequested(int jobId);
+
+  void pausedChanged(bool paused);
+
+  void limitsChanged();
+
+private:
+  int m_NextJobId = 1;
+  std::map<int, Job> m_Jobs;
+  std::map<int, StartFunction> m_StartFunctions;
+  std::deque<Job> m_EndedJobs;
+  bool m_Paused = false;
+  bool m_ScheduleQueued = false;
+  int m_ThreadLimit = 1;
+  qint64 m_MemoryLimit = 0;
+  int m_ThreadsPerRun = 1;
+  int m_ThreadsInUse = 0;
+  qint64 m_MemoryInUse = 0;
+
+  /**
+   * @brief Starts the queued jobs that fit on the next pass through the event loop, so start functions never run
+   * inside submit() or finish()
+   */
+  void scheduleLater();
+
+  /**
+   * @brief Starts the queued jobs that fit
+   */
+  void schedule();
+
+  /**
+   * @brief Moves a job to the list of ended jobs
+   * @param jobId
+   * @param state
+   */
+  void endJob(int jobId, State state);
+
+  void readSettings();
+  void writeSettings() const;
+
+public:
+  ExecutionScheduler(const ExecutionScheduler&) = delete;            // Copy Constructor Not Implemented
+  ExecutionScheduler(ExecutionScheduler&&) = delete;                 // Move Constructor Not Implemented
+  ExecutionScheduler& operator=(const ExecutionScheduler&) = delete; // Copy Assignment Not Implemented
+  ExecutionScheduler& operator=(ExecutionScheduler&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,453 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FilterTimingRecorder.h"
+
+#include <algorithm>
+
+#include "SIMPLib/Messages/AbstractErrorMessage.h"
+#include "SIMPLib/Messages/AbstractFilterMessage.h"
+#include "SIMPLib/Messages/FilterProgressMessage.h"
+#include "SIMPLib/Messages/PipelineProgressMessage.h"
+
+#include "SIMPLView/FilterTimingStore.h"
+#include "SIMPLView/ProcessMemory.h"
+
+namespace
+{
+const int k_UtilizationSampleInterval = 250;
+
+// Progress messages can come by the hundreds per second; reading the resident size that often is wasted
+const qint64 k_MemorySampleInterval = 100;
+
+// Below this the progress a filter reports says little about how long it takes
+const double k_MinimumFilterProgress = 0.02;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingRecorder::FilterTimingRecorder(const std::vector<AbstractFilter::Pointer>& filters, const FilterTimingStore* timingStore)
+: FilterTimingRecorder(PipelineCostEstimator::EstimatePipeline(filters, timingStore))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingRecorder::FilterTimingRecorder(const PipelineCostEstimator::Estimate& estimate)
+: m_Estimate(estimate)
+, m_Milliseconds(m_Estimate.filters.size(), -1)
+, m_PeakMemory(m_Estimate.filters.size(), 0)
+, m_Counters(m_Estimate.filters.size())
+, m_CpuMilliseconds(m_Estimate.filters.size(), -1)
+, m_StartMilliseconds(m_Estimate.filters.size(), -1)
+, m_Io(m_Estimate.filters.size())
+, m_Activity(std::make_unique<ProcessActivity::Scope>())
+, m_Overlapped(m_Estimate.filters.size(), false)
+, m_ThreadSampler(std::make_unique<ThreadUtilizationSampler>(k_UtilizationSampleInterval))
+{
+  m_RunTimer.start();
+  m_MemorySampleTimer.start();
+  m_FilterStartCpu = ThreadUtilizationSampler::ProcessCpuMilliseconds();
+  m_FilterStartIo = ProcessIo::Read();
+  m_FilterStartActivity = ProcessActivity::Current();
+  m_ThreadSampler->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingRecorder::~FilterTimingRecorder() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterTimingRecorder::collectCounters()
+{
+  m_PerformanceCounters = std::make_unique<PerformanceCounters>();
+  if(!m_PerformanceCounters->isOpen())
+  {
+    m_PerformanceCounters.reset();
+    return false;
+  }
+  m_FilterStartCounters = m_PerformanceCounters->read();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingRecorder::processMessage(const AbstractMessage::Pointer& msg)
+{
+  if(m_Finished)
+  {
+    return;
+  }
+
+  if(nullptr != std::dynamic_pointer_cast<AbstractErrorMessage>(msg))
+  {
+    m_HasErrors = true;
+    return;
+  }
+
+  if(nullptr != std::dynamic_pointer_cast<PipelineProgressMessage>(msg))
+  {
+    startNextFilter();
+    return;
+  }
+
+  if(m_MemorySampleTimer.elapsed() >= k_MemorySampleInterval)
+  {
+    sampleMemory();
+  }
+
+  // The filter that reports is the one that runs; the time since the last progress message belongs to it
+  std::shared_ptr<AbstractFilterMessage> filterMessage = std::dynamic_pointer_cast<AbstractFilterMessage>(msg);
+  if(nullptr != filterMessage)
+  {
+    int position = findFilter(filterMessage->getPipelineIndex());
+    if(position >= 0 && position != m_CurrentFilter)
+    {
+      m_CurrentFilter = position;
+      m_FilterProgress = 0.0;
+    }
+  }
+
+  std::shared_ptr<FilterProgressMessage> progressMessage = std::dynamic_pointer_cast<FilterProgressMessage>(msg);
+  if(nullptr != progressMessage && findFilter(progressMessage->getPipelineIndex()) == m_CurrentFilter)
+  {
+    m_FilterProgress = std::min(std::max(progressMessage->getProgressValue() / 100.0, 0.0), 1.0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingRecorder::finish(FilterTimingStore* timingStore, bool completed)
+{
+  if(m_Finished)
+  {
+    return;
+  }
+  m_Finished = true;
+  m_ElapsedMilliseconds = m_RunTimer.elapsed();
+
+  // The last filter only ended normally if the pipeline ran to its end
+  int filterCount = static_cast<int>(m_Milliseconds.size());
+  if(completed && !m_HasErrors && m_CurrentFilter >= 0 && m_CurrentFilter < filterCount)
+  {
+    sampleMemory();
+    readCounters();
+    readProcessUsage();
+    m_Milliseconds[m_CurrentFilter] = m_FilterTimer.elapsed();
+  }
+  m_PerformanceCounters.reset();
+  m_ThreadSampler->stop();
+  m_Activity.reset();
+
+  if(nullptr == timingStore)
+  {
+    return;
+  }
+  for(size_t i = 0; i < m_Milliseconds.size(); i++)
+  {
+    if(m_Milliseconds[i] >= 0)
+    {
+      timingStore->record(m_Estimate.filters[i].className, m_Estimate.filters[i].workBytes, m_Milliseconds[i]);
+    }
+  }
+  timingStore->save();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const PipelineCostEstimator::Estimate& FilterTimingRecorder::getEstimate() const
+{
+  return m_Estimate;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FilterTimingRecorder::getCurrentFilter() const
+{
+  return m_CurrentFilter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<qint64> FilterTimingRecorder::getMilliseconds() const
+{
+  return m_Milliseconds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<qint64> FilterTimingRecorder::getPeakMemory() const
+{
+  return m_PeakMemory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<PerformanceCounters::Values> FilterTimingRecorder::getCounters() const
+{
+  return m_Counters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<qint64> FilterTimingRecorder::getCpuMilliseconds() const
+{
+  return m_CpuMilliseconds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<ProcessIo::Counters> FilterTimingRecorder::getIo() const
+{
+  return m_Io;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<bool> FilterTimingRecorder::getOverlapped() const
+{
+  return m_Overlapped;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<qint64> FilterTimingRecorder::getStartMilliseconds() const
+{
+  return m_StartMilliseconds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<ThreadUtilizationSampler::Sample>& FilterTimingRecorder::getUtilizationSamples() const
+{
+  return m_ThreadSampler->getSamples();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 FilterTimingRecorder::getElapsedMilliseconds() const
+{
+  return m_Finished ? m_ElapsedMilliseconds : m_RunTimer.elapsed();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingRecorder::Forecast FilterTimingRecorder::forecast() const
+{
+  Forecast forecast;
+  if(m_Finished)
+  {
+    return forecast;
+  }
+
+  qint64 predictedTotal = 0;
+  int predictedCount = 0;
+  for(const PipelineCostEstimator::FilterCost& cost : m_Estimate.filters)
+  {
+    if(cost.predictedMilliseconds >= 0)
+    {
+      predictedTotal += cost.predictedMilliseconds;
+      predictedCount++;
+    }
+  }
+  if(predictedCount == 0)
+  {
+    return forecast;
+  }
+  double averagePrediction = static_cast<double>(predictedTotal) / predictedCount;
+
+  double remaining = 0.0;
+  int filterCount = static_cast<int>(m_Estimate.filters.size());
+  for(int i = std::max(m_CurrentFilter, 0); i < filterCount; i++)
+  {
+    const PipelineCostEstimator::FilterCost& cost = m_Estimate.filters[i];
+    double predicted = cost.predictedMilliseconds >= 0 ? cost.predictedMilliseconds : averagePrediction;
+    if(cost.predictedMilliseconds < 0)
+    {
+      forecast.unpredictedFilters++;
+    }
+    if(i != m_CurrentFilter)
+    {
+      remaining += predicted;
+      continue;
+    }
+
+    // The progress of the filter takes over from the prediction the further the filter gets
+    double elapsed = static_cast<double>(m_FilterTimer.elapsed());
+    double fromPrediction = std::max(predicted - elapsed, 0.0);
+    if(m_FilterProgress < k_MinimumFilterProgress)
+    {
+      remaining += fromPrediction;
+    }
+    else
+    {
+      double fromProgress = elapsed * (1.0 - m_FilterProgress) / m_FilterProgress;
+      remaining += m_FilterProgress * fromProgress + (1.0 - m_FilterProgress) * fromPrediction;
+    }
+  }
+
+  double elapsed = static_cast<double>(m_RunTimer.elapsed());
+  forecast.remainingMilliseconds = static_cast<qint64>(remaining);
+  forecast.progress = (elapsed + remaining) > 0.0 ? elapsed / (elapsed + remaining) : 0.0;
+  return forecast;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool FilterTimingRecorder::hasErrors() const
+{
+  return m_HasErrors;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingRecorder::startNextFilter()
+{
+  int filterCount = static_cast<int>(m_Milliseconds.size());
+  if(m_CurrentFilter >= 0 && m_CurrentFilter < filterCount)
+  {
+    sampleMemory();
+    m_Milliseconds[m_CurrentFilter] = m_FilterTimer.elapsed();
+  }
+  readCounters();
+  readProcessUsage();
+
+  // The pipeline may report its progress once more after the last filter
+  m_CurrentFilter = std::min(m_CurrentFilter + 1, filterCount);
+  m_FilterProgress = 0.0;
+  m_FilterTimer.start();
+  if(m_CurrentFilter < filterCount)
+  {
+    m_StartMilliseconds[m_CurrentFilter] = m_RunTimer.elapsed();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FilterTimingRecorder::findFilter(int pipelineIndex) const
+{
+  for(size_t i = 0; i < m_Estimate.filters.size(); i++)
+  {
+    if(m_Estimate.filters[i].pipelineIndex == pipelineIndex)
+    {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingRecorder::sampleMemory()
+{
+  m_MemorySampleTimer.start();
+  if(m_CurrentFilter >= 0 && m_CurrentFilter < static_cast<int>(m_PeakMemory.size()))
+  {
+    m_PeakMemory[m_CurrentFilter] = std::max(m_PeakMemory[m_CurrentFilter], ProcessMemory::CurrentResidentBytes());
+  }
+
+  // Threads a filter starts are only counted once their counters are open
+  if(nullptr != m_PerformanceCounters)
+  {
+    m_PerformanceCounters->refreshThreads();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingRecorder::readCounters()
+{
+  if(nullptr == m_PerformanceCounters)
+  {
+    return;
+  }
+  PerformanceCounters::Values values = m_PerformanceCounters->read();
+  if(m_CurrentFilter >= 0 && m_CurrentFilter < static_cast<int>(m_Counters.size()))
+  {
+    m_Counters[m_CurrentFilter] = PerformanceCounters::Difference(m_FilterStartCounters, values);
+  }
+  m_FilterStartCounters = values;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingRecorder::readProcessUsage()
+{
+  qint64 cpuMilliseconds = ThreadUtilizationSampler::ProcessCpuMilliseconds();
+  ProcessIo::Counters io = ProcessIo::Read();
+  ProcessActivity::State activity = ProcessActivity::Current();
+  if(m_CurrentFilter >= 0 && m_CurrentFilter < static_cast<int>(m_CpuMilliseconds.size()))
+  {
+    m_Overlapped[m_CurrentFilter] = ProcessActivity::OthersWereActive(m_FilterStartActivity, activity);
+    if(m_FilterStartCpu >= 0 && cpuMilliseconds >= 0)
+    {
+      m_CpuMilliseconds[m_CurrentFilter] = cpuMilliseconds - m_FilterStartCpu;
+    }
+
+    // The bytes of a prefetch, a copy or another run would be counted as the filter's own
+    if(!m_Overlapped[m_CurrentFilter])
+    {
+      m_Io[m_CurrentFilter] = ProcessIo::Difference(m_FilterStartIo, io);
+    }
+  }
+  m_FilterStartCpu = cpuMilliseconds;
+  m_FilterStartIo = io;
+  m_FilterStartActivity = activity;
+}
@@ -0,0 +1,260 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+
+#include "SIMPLib/Messages/AbstractMessage.h"
+
+#include "SIMPLView/PerformanceCounters.h"
+#include "SIMPLView/PipelineCostEstimator.h"
+#include "SIMPLView/ProcessActivity.h"
+#include "SIMPLView/ProcessIo.h"
+#include "SIMPLView/ThreadUtilizationSampler.h"
+
+class FilterTimingStore;
+
+/**
+ * @brief The FilterTimingRecorder class measures the runtime of each filter of a running pipeline from the messages
+ * the pipeline generates.  The pipeline reports its progress right before each filter starts, which marks where one
+ * filter ends and the next begins; the messages of the filters themselves correct the count when a progress
+ * message does not belong to an enabled filter.  The size of the data each filter works on is taken from the
+ * preflight when the recorder is created, along with the runtimes the timing store predicts for the forecast.  The
+ * resident memory of the process is sampled with the messages, which gives the peak memory while each filter ran.
+ * With collectCounters() the hardware counters of the CPU are read at the same boundaries.
+ *
+ * Where it can be read, the CPU time of the process is taken at the boundaries as well, which gives how many
+ * threads each filter kept busy on average, and the CPU time of the threads is sampled at a fixed interval for a
+ * timeline of the run.  Both are of the whole process, so runs that overlap are counted together.  The same holds
+ * for the bytes the process read and wrote, which are also taken at the boundaries.  The recorder marks its run as
+ * active in ProcessActivity, and a filter during which other work of the process was active is reported by
+ * getOverlapped(); its I/O is then left unmeasured rather than attributed to it.
+ */
+class FilterTimingRecorder
+{
+public:
+  /**
+   * @brief The Forecast struct is what is left of a run as predicted from the runtimes of earlier runs and the
+   * progress of the running filter
+   */
+  struct Forecast
+  {
+    double progress = -1.0; // Fraction of the runtime that has passed, -1 if nothing could be predicted
+    qint64 remainingMilliseconds = -1;
+    int unpredictedFilters = 0; // Filters still to run that have no earlier runs; they are assumed to take the average
+  };
+
+  /**
+   * @brief Creates a recorder for a preflighted pipeline that is about to run
+   * @param filters
+   * @param timingStore Predicts the runtimes of the filters for forecast(); without it nothing is forecast
+   */
+  FilterTimingRecorder(const std::vector<AbstractFilter::Pointer>& filters, const FilterTimingStore* timingStore = nullptr);
+
+  /**
+   * @brief Creates a recorder from an estimate taken at the preflight.  Use it when the run may already have
+   * started, since the data of the filters then belongs to the running pipeline.
+   * @param estimate
+   */
+  FilterTimingRecorder(const PipelineCostEstimator::Estimate& estimate);
+  ~FilterTimingRecorder();
+
+  /**
+   * @brief Counts the hardware events of each filter from now on.  Call it before the first filter starts.
+   * @return False if no hardware counter could be opened
+   */
+  bool collectCounters();
+
+  /**
+   * @brief Follows the run through a message of the pipeline
+   * @param msg
+   */
+  void processMessage(const AbstractMessage::Pointer& msg);
+
+  /**
+   * @brief Ends the run and adds the measured runtimes to the store
+   * @param timingStore
+   * @param completed False if the run was cancelled; the filter that ran last is then not recorded
+   */
+  void finish(FilterTimingStore* timingStore, bool completed);
+
+  /**
+   * @brief Returns the cost of the pipeline as estimated when the run started
+   * @return
+   */
+  const PipelineCostEstimator::Estimate& getEstimate() const;
+
+  /**
+   * @brief Returns the position of the running filter in getEstimate().filters, -1 before the first one starts
+   * @return
+   */
+  int getCurrentFilter() const;
+
+  /**
+   * @brief Returns the measured runtime of each filter in getEstimate().filters, -1 if it was not measured
+   * @return
+   */
+  std::vector<qint64> getMilliseconds() const;
+
+  /**
+   * @brief Returns the highest resident memory sampled while each filter in getEstimate().filters ran, 0 if it did
+   * not run
+   * @return
+   */
+  std::vector<qint64> getPeakMemory() const;
+
+  /**
+   * @brief Returns the hardware events counted while each filter in getEstimate().filters ran, -1 for what was not
+   * counted
+   * @return
+   */
+  std::vector<PerformanceCounters::Values> getCounters() const;
+
+  /**
+   * @brief Returns the CPU time of the process while each filter in getEstimate().filters ran, -1 if it was not
+   * measured.  The time of a filter that overlapped other work, see getOverlapped(), includes that work and is
+   * unreliable.
+   * @return
+   */
+  std::vector<qint64> getCpuMilliseconds() const;
+
+  /**
+   * @brief Returns the bytes the process read and wrote while each filter in getEstimate().filters ran, -1 for what
+   * was not measured.  The I/O of a filter that overlapped other work of the process is not measured.
+   * @return
+   */
+  std::vector<ProcessIo::Counters> getIo() const;
+
+  /**
+   * @brief Returns whether other work of the process was active while each filter in getEstimate().filters ran.
+   * The process-wide values of such a filter include that work.
+   * @return
+   */
+  std::vector<bool> getOverlapped() const;
+
+  /**
+   * @brief Returns when each filter in getEstimate().filters started, since the recorder was created, -1 if it did
+   * not run
+   * @return
+   */
+  std::vector<qint64> getStartMilliseconds() const;
+
+  /**
+   * @brief Returns the thread utilization sampled during the run, on the same clock as getStartMilliseconds()
+   * @return
+   */
+  const std::vector<ThreadUtilizationSampler::Sample>& getUtilizationSamples() const;
+
+  /**
+   * @brief Returns the wall time since the recorder was created, or of the whole run once it is finished
+   * @return
+   */
+  qint64 getElapsedMilliseconds() const;
+
+  /**
+   * @brief Predicts how much of the run has passed and how long the rest takes.  Filters count by their predicted
+   * runtime, and the running filter by its own progress once it reports some.
+   * @return
+   */
+  Forecast forecast() const;
+
+  /**
+   * @brief Returns true if the pipeline generated an error
+   * @return
+   */
+  bool hasErrors() const;
+
+private:
+  PipelineCostEstimator::Estimate m_Estimate;
+  std::vector<qint64> m_Milliseconds;
+  std::vector<qint64> m_PeakMemory;
+  std::vector<PerformanceCounters::Values> m_Counters;
+  std::unique_ptr<PerformanceCounters> m_PerformanceCounters;
+  PerformanceCounters::Values m_FilterStartCounters;
+  std::vector<qint64> m_CpuMilliseconds;
+  std::vector<qint64> m_StartMilliseconds;
+  qint64 m_FilterStartCpu = -1;
+  std::vector<ProcessIo::Counters> m_Io;
+  ProcessIo::Counters m_FilterStartIo;
+  std::unique_ptr<ProcessActivity::Scope> m_Activity;
+  ProcessActivity::State m_FilterStartActivity;
+  std::vector<bool> m_Overlapped;
+  std::unique_ptr<ThreadUtilizationSampler> m_ThreadSampler;
+  int m_CurrentFilter = -1;
+  double m_FilterProgress = 0.0;
+  QElapsedTimer m_FilterTimer;
+  QElapsedTimer m_RunTimer;
+  QElapsedTimer m_MemorySampleTimer;
+  qint64 m_ElapsedMilliseconds = 0;
+  bool m_HasErrors = false;
+  bool m_Finished = false;
+
+  /**
+   * @brief Ends the running filter and starts the next one
+   */
+  void startNextFilter();
+
+  /**
+   * @brief Returns the position of the filter with the pipeline index, or -1
+   * @param pipelineIndex
+   * @return
+   */
+  int findFilter(int pipelineIndex) const;
+
+  /**
+   * @brief Records the resident memory as the peak of the running filter if it is higher
+   */
+  void sampleMemory();
+
+  /**
+   * @brief Assigns the hardware events since the last boundary to the running filter
+   */
+  void readCounters();
+
+  /**
+   * @brief Assigns the CPU time and the I/O since the last boundary to the running filter
+   */
+  void readProcessUsage();
+
+public:
+  FilterTimingRecorder(const FilterTimingRecorder&) = delete;            // Copy Constructor Not Implemented
+  FilterTimingRecorder(FilterTimingRecorder&&) = delete;                 // Move Constructor Not Implemented
+  FilterTimingRecorder& operator=(const FilterTimingRecorder&) = delete; // Copy Assignment Not Implemented
+  FilterTimingRecorder& operator=(FilterTimingRecorder&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,197 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "FilterTimingStore.h"
+
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStandardPaths>
+
+#include "SIMPLView/PipelineFileFormat.h"
+
+namespace
+{
+const size_t k_MaximumSamples = 20;
+
+// Samples within this factor of the requested data size count as comparable
+const qint64 k_ComparableSizeFactor = 4;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingStore::FilterTimingStore()
+{
+  load();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterTimingStore* FilterTimingStore::Instance()
+{
+  static FilterTimingStore store;
+  return &store;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString FilterTimingStore::GetStorePath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/FilterTimings.json";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingStore::record(const QString& filterClassName, qint64 workBytes, qint64 milliseconds)
+{
+  if(filterClassName.isEmpty() || milliseconds < 0)
+  {
+    return;
+  }
+
+  std::deque<Sample>& samples = m_Samples[filterClassName];
+  Sample sample;
+  sample.workBytes = workBytes;
+  sample.milliseconds = milliseconds;
+  samples.push_back(sample);
+  while(samples.size() > k_MaximumSamples)
+  {
+    samples.pop_front();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 FilterTimingStore::predict(const QString& filterClassName, qint64 workBytes) const
+{
+  auto iter = m_Samples.find(filterClassName);
+  if(iter == m_Samples.end() || iter->second.empty())
+  {
+    return -1;
+  }
+
+  // Runs on data of a very different size say little about the overhead of a filter, so they are only used
+  // when nothing comparable ran
+  std::vector<Sample> comparable;
+  for(const Sample& sample : iter->second)
+  {
+    if(workBytes > 0 && sample.workBytes > 0 && sample.workBytes * k_ComparableSizeFactor >= workBytes && sample.workBytes <= workBytes * k_ComparableSizeFactor)
+    {
+      comparable.push_back(sample);
+    }
+  }
+  if(comparable.empty())
+  {
+    comparable.assign(iter->second.cbegin(), iter->second.cend());
+  }
+
+  double milliseconds = 0.0;
+  double bytes = 0.0;
+  for(const Sample& sample : comparable)
+  {
+    milliseconds += sample.milliseconds;
+    bytes += sample.workBytes;
+  }
+
+  // The runtime scales with the data; filters that work on no data take their mean runtime
+  if(workBytes > 0 && bytes > 0.0)
+  {
+    return static_cast<qint64>(milliseconds / bytes * workBytes);
+  }
+  return static_cast<qint64>(milliseconds / comparable.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int FilterTimingStore::getSampleCount(const QString& filterClassName) const
+{
+  auto iter = m_Samples.find(filterClassName);
+  return iter != m_Samples.end() ? static_cast<int>(iter->second.size()) : 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingStore::save() const
+{
+  QJsonObject root;
+  for(const auto& entry : m_Samples)
+  {
+    QJsonArray samples;
+    for(const Sample& sample : entry.second)
+    {
+      samples.push_back(QJsonArray({static_cast<double>(sample.workBytes), static_cast<double>(sample.milliseconds)}));
+    }
+    root[entry.first] = samples;
+  }
+
+  QString filePath = GetStorePath();
+  QDir().mkpath(QFileInfo(filePath).absolutePath());
+  QString errorMessage;
+  PipelineFileFormat::WriteFileAtomically(filePath, QJsonDocument(root).toJson(QJsonDocument::Compact), errorMessage);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void FilterTimingStore::load()
+{
+  QFile file(GetStorePath());
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return;
+  }
+
+  QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+  for(auto iter = root.constBegin(); iter != root.constEnd(); ++iter)
+  {
+    for(const QJsonValue& value : iter.value().toArray())
+    {
+      QJsonArray pair = value.toArray();
+      record(iter.key(), static_cast<qint64>(pair.at(0).toDouble()), static_cast<qint64>(pair.at(1).toDouble()));
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <deque>
+#include <map>
+
+#include <QtCore/QString>
+
+/**
+ * @brief The FilterTimingStore class keeps the runtimes of the filters that ran on this machine, so the runtime of
+ * a pipeline can be predicted before it runs.  Each sample holds the size of the data the filter worked on; runtimes
+ * are scaled from the samples whose data size is comparable.  The store is kept as JSON in the application data
+ * directory.
+ */
+class FilterTimingStore
+{
+public:
+  /**
+   * @brief Returns the store of the application
+   * @return
+   */
+  static FilterTimingStore* Instance();
+
+  /**
+   * @brief Returns the file the store is kept in
+   * @return
+   */
+  static QString GetStorePath();
+
+  /**
+   * @brief Adds a runtime of a filter.  Only the most recent samples of each filter are kept.
+   * @param filterClassName
+   * @param workBytes The size of the data the filter worked on
+   * @param milliseconds
+   */
+  void record(const QString& filterClassName, qint64 workBytes, qint64 milliseconds);
+
+  /**
+   * @brief Predicts the runtime of a filter on data of the given size
+   * @param filterClassName
+   * @param workBytes
+   * @return The runtime in milliseconds, or -1 if the filter never ran on this machine
+   */
+  qint64 predict(const QString& filterClassName, qint64 workBytes) const;
+
+  /**
+   * @brief Returns how many runtimes of the filter are kept
+   * @param filterClassName
+   * @return
+   */
+  int getSampleCount(const QString& filterClassName) const;
+
+  /**
+   * @brief Writes the store to its file
+   */
+  void save() const;
+
+protected:
+  FilterTimingStore();
+
+private:
+  struct Sample
+  {
+    qint64 workBytes = 0;
+    qint64 milliseconds = 0;
+  };
+
+  std::map<QString, std::deque<Sample>> m_Samples;
+
+  void load();
+
+public:
+  FilterTimingStore(const FilterTimingStore&) = delete;            // Copy Constructor Not Implemented
+  FilterTimingStore(FilterTimingStore&&) = delete;                 // Move Constructor Not Implemented
+  FilterTimingStore& operator=(const FilterTimingStore&) = delete; // Copy Assignment Not Implemented
+  FilterTimingStore& operator=(FilterTimingStore&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,359 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "InputPrefetcher.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Utilities/FilePathGenerator.h"
+#include "SIMPLib/Utilities/SIMPLDataPathValidator.h"
+
+#include "SIMPLView/ParameterSweep.h"
+#include "SIMPLView/ProcessActivity.h"
+
+namespace
+{
+const qint64 k_ReadChunkSize = 4 * 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+void CollectInputFiles(const QJsonValue& value, int depth, QStringList& filePaths)
+{
+  if(value.isString())
+  {
+    QString filePath = InputPrefetcher::AbsoluteInputPath(value.toString());
+    if(!value.toString().isEmpty() && QFileInfo(filePath).isFile())
+    {
+      filePaths.push_back(filePath);
+    }
+    return;
+  }
+  if(!value.isObject() || depth <= 0)
+  {
+    return;
+  }
+
+  QJsonObject object = value.toObject();
+  if(InputPrefetcher::IsFileList(object))
+  {
+    filePaths.append(InputPrefetcher::FileListPaths(object));
+    return;
+  }
+
+  for(const QJsonValue& member : object)
+  {
+    CollectInputFiles(member, depth - 1, filePaths);
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputPrefetcher::InputPrefetcher(QObject* parent)
+: QObject(parent)
+, m_CancelRead(false)
+{
+  // One reader keeps the requests to the storage sequential
+  m_ThreadPool.setMaxThreadCount(1);
+  m_Clock.start();
+
+  m_Watcher = new QFutureWatcher<ReadResult>(this);
+  connect(m_Watcher, &QFutureWatcher<ReadResult>::finished, this, &InputPrefetcher::readFinished);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputPrefetcher::~InputPrefetcher()
+{
+  m_Pending.clear();
+  m_CancelRead = true;
+  m_Watcher->disconnect(this);
+  m_Watcher->waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList InputPrefetcher::FindInputFiles(const QJsonObject& pipeline)
+{
+  QStringList filePaths;
+  std::vector<int> inputFilters = ParameterSweep::FindFiltersOfSubGroup(pipeline, SIMPL::FilterSubGroups::InputFilters);
+  for(int index : inputFilters)
+  {
+    QJsonObject filter = pipeline[QString::number(index)].toObject();
+    if(!filter["Filter_Enabled"].toBool(true))
+    {
+      continue;
+    }
+    for(const QJsonValue& member : filter)
+    {
+      CollectInputFiles(member, 2, filePaths);
+    }
+  }
+  filePaths.removeDuplicates();
+  return filePaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString InputPrefetcher::AbsoluteInputPath(const QString& path)
+{
+  if(QFileInfo(path).isRelative())
+  {
+    return QDir(SIMPLDataPathValidator::Instance()->getSIMPLDataDirectory()).absoluteFilePath(path);
+  }
+  return path;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool InputPrefetcher::IsFileList(const QJsonObject& object)
+{
+  return object.contains("InputPath") && object.contains("FilePrefix") && object.contains("StartIndex");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList InputPrefetcher::FileListPaths(const QJsonObject& fileList)
+{
+  bool hasMissingFiles = false;
+  bool lowToHigh = fileList["Ordering"].toInt() == 0;
+  QVector<QString> generated = FilePathGenerator::GenerateFileList(fileList["StartIndex"].toInt(), fileList["EndIndex"].toInt(), std::max(fileList["IncrementIndex"].toInt(1), 1),
+                                                                   hasMissingFiles, lowToHigh, AbsoluteInputPath(fileList["InputPath"].toString()), fileList["FilePrefix"].toString(),
+                                                                   fileList["FileSuffix"].toString(), fileList["FileExtension"].toString(), fileList["PaddingDigits"].toInt());
+  QStringList filePaths;
+  for(const QString& filePath : generated)
+  {
+    if(QFileInfo(filePath).isFile())
+    {
+      filePaths.push_back(filePath);
+    }
+  }
+  return filePaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::setBudget(qint64 bytes)
+{
+  m_Budget = std::max(bytes, static_cast<qint64>(0));
+  if(m_Budget == 0)
+  {
+    m_Pending.clear();
+  }
+  startNext();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 InputPrefetcher::getBudget() const
+{
+  return m_Budget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::prefetch(int key, const QStringList& filePaths)
+{
+  if(m_Budget == 0 || contains(key))
+  {
+    return;
+  }
+
+  // The key is known even without files, so its pipeline is not searched again
+  m_Statistics[key] = Statistics();
+  for(const QString& filePath : filePaths)
+  {
+    PendingFile file;
+    file.key = key;
+    file.filePath = filePath;
+    file.size = QFileInfo(filePath).size();
+    if(file.size > 0 && file.size <= m_Budget)
+    {
+      m_Pending.push_back(file);
+    }
+  }
+  startNext();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool InputPrefetcher::contains(int key) const
+{
+  return m_Statistics.find(key) != m_Statistics.end();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputPrefetcher::Statistics InputPrefetcher::release(int key)
+{
+  auto iter = m_Statistics.find(key);
+  if(iter == m_Statistics.end())
+  {
+    return Statistics();
+  }
+  Statistics statistics = iter->second;
+  m_Statistics.erase(iter);
+  m_HeldBytes -= statistics.bytes;
+
+  m_Pending.erase(std::remove_if(m_Pending.begin(), m_Pending.end(), [key](const PendingFile& file) { return file.key == key; }), m_Pending.end());
+  if(m_ReadingKey == key)
+  {
+    m_CancelRead = true;
+  }
+  startNext();
+  return statistics;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::setComputeActive(bool active)
+{
+  if(m_ComputeActive == active)
+  {
+    return;
+  }
+  if(active)
+  {
+    m_ComputeSince = m_Clock.elapsed();
+  }
+  else
+  {
+    m_ComputeMilliseconds += m_Clock.elapsed() - m_ComputeSince;
+  }
+  m_ComputeActive = active;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+InputPrefetcher::ReadResult InputPrefetcher::ReadFile(const QString& filePath, const std::atomic_bool& cancel)
+{
+  ReadResult result;
+  ProcessActivity::Scope activity;
+  QElapsedTimer timer;
+  timer.start();
+
+  // The data is dropped; what is kept is the copy in the page cache
+  QFile file(filePath);
+  if(file.open(QIODevice::ReadOnly))
+  {
+    QByteArray buffer(static_cast<int>(k_ReadChunkSize), Qt::Uninitialized);
+    qint64 bytesRead = file.read(buffer.data(), k_ReadChunkSize);
+    while(bytesRead > 0 && !cancel)
+    {
+      result.bytes += bytesRead;
+      bytesRead = file.read(buffer.data(), k_ReadChunkSize);
+    }
+  }
+  result.milliseconds = timer.elapsed();
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::startNext()
+{
+  if(m_ReadingKey >= 0 || m_Pending.empty())
+  {
+    return;
+  }
+
+  // Files are read in order, so a large file waits for the budget instead of being overtaken
+  const PendingFile& file = m_Pending.front();
+  if(m_HeldBytes + file.size > m_Budget)
+  {
+    return;
+  }
+
+  m_ReadingKey = file.key;
+  m_ReadingSize = file.size;
+  m_ReadStartCompute = computeMilliseconds();
+  m_HeldBytes += m_ReadingSize;
+  m_CancelRead = false;
+  m_Watcher->setFuture(QtConcurrent::run(&m_ThreadPool, &InputPrefetcher::ReadFile, file.filePath, std::cref(m_CancelRead)));
+  m_Pending.pop_front();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void InputPrefetcher::readFinished()
+{
+  ReadResult result = m_Watcher->result();
+  m_HeldBytes -= m_ReadingSize;
+
+  auto iter = m_Statistics.find(m_ReadingKey);
+  if(iter != m_Statistics.end())
+  {
+    Statistics& statistics = iter->second;
+    statistics.files++;
+    statistics.bytes += result.bytes;
+    statistics.readMilliseconds += result.milliseconds;
+    statistics.overlappedMilliseconds += std::min(computeMilliseconds() - m_ReadStartCompute, result.milliseconds);
+    m_HeldBytes += result.bytes;
+  }
+
+  m_ReadingKey = -1;
+  m_ReadingSize = 0;
+  startNext();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 InputPrefetcher::computeMilliseconds() const
+{
+  return m_ComputeMilliseconds + (m_ComputeActive ? m_Clock.elapsed() - m_ComputeSince : 0);
+}
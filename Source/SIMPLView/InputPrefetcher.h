@@ -0,0 +1,202 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <map>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
+
+/**
+ * @brief The InputPrefetcher class reads the input files of pipelines that run next on an I/O thread, so they are
+ * in the page cache of the operating system when their reader filters open them.  The files of each pipeline are
+ * grouped under a key.  The bytes read for keys that were not released yet are held against a budget, so
+ * prefetching never pushes the files of the running pipelines out of memory.
+ *
+ * The time spent reading is split into the part that overlapped with a running pipeline, which is time the
+ * pipelines no longer wait for, and the rest.
+ */
+class InputPrefetcher : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Statistics
+  {
+    int files = 0;
+    qint64 bytes = 0;
+    qint64 readMilliseconds = 0;
+    qint64 overlappedMilliseconds = 0;
+  };
+
+  InputPrefetcher(QObject* parent = nullptr);
+
+  /**
+   * @brief Stops the current read and waits for it
+   */
+  ~InputPrefetcher() override;
+
+  /**
+   * @brief Returns the files the input filters of the pipeline read: the file paths among their parameters and
+   * the files of their file lists, such as image stacks
+   * @param pipeline The JSON form of the pipeline
+   * @return The paths of the files that exist
+   */
+  static QStringList FindInputFiles(const QJsonObject& pipeline);
+
+  /**
+   * @brief Returns the absolute form of a path in a filter parameter.  Relative paths are resolved against the
+   * data directory, the same as the readers do.
+   * @param path
+   * @return
+   */
+  static QString AbsoluteInputPath(const QString& path);
+
+  /**
+   * @brief Returns true if the JSON object is a file list parameter, which names its files by a pattern
+   * @param object
+   * @return
+   */
+  static bool IsFileList(const QJsonObject& object);
+
+  /**
+   * @brief Returns the existing files of a file list parameter
+   * @param fileList
+   * @return
+   */
+  static QStringList FileListPaths(const QJsonObject& fileList);
+
+  /**
+   * @brief Sets the bytes that may be held for keys that were not released.  0 turns prefetching off.
+   * @param bytes
+   */
+  void setBudget(qint64 bytes);
+  qint64 getBudget() const;
+
+  /**
+   * @brief Queues the files of a key.  Files larger than the budget are skipped.
+   * @param key
+   * @param filePaths
+   */
+  void prefetch(int key, const QStringList& filePaths);
+
+  /**
+   * @brief Returns true if files were queued for the key and it was not released
+   * @param key
+   * @return
+   */
+  bool contains(int key) const;
+
+  /**
+   * @brief Stops prefetching for a key, usually because its pipeline started, and frees its share of the budget
+   * @param key
+   * @return What was read for the key
+   */
+  Statistics release(int key);
+
+  /**
+   * @brief Sets whether a pipeline computes.  Reads while one does count as overlapped.
+   * @param active
+   */
+  void setComputeActive(bool active);
+
+private:
+  struct PendingFile
+  {
+    int key = 0;
+    QString filePath;
+    qint64 size = 0;
+  };
+
+  struct ReadResult
+  {
+    qint64 bytes = 0;
+    qint64 milliseconds = 0;
+  };
+
+  QThreadPool m_ThreadPool;
+  QFutureWatcher<ReadResult>* m_Watcher = nullptr;
+  std::atomic_bool m_CancelRead;
+  std::deque<PendingFile> m_Pending;
+  std::map<int, Statistics> m_Statistics;
+  qint64 m_Budget = 0;
+  qint64 m_HeldBytes = 0;
+
+  int m_ReadingKey = -1;
+  qint64 m_ReadingSize = 0;
+  qint64 m_ReadStartCompute = 0;
+
+  QElapsedTimer m_Clock;
+  bool m_ComputeActive = false;
+  qint64 m_ComputeMilliseconds = 0;
+  qint64 m_ComputeSince = 0;
+
+  /**
+   * @brief Reads a file in chunks and drops the data
+   * @param filePath
+   * @param cancel Checked between chunks
+   * @return
+   */
+  static ReadResult ReadFile(const QString& filePath, const std::atomic_bool& cancel);
+
+  /**
+   * @brief Starts reading the next pending file if the budget allows it
+   */
+  void startNext();
+
+  /**
+   * @brief Books a finished read on its key
+   */
+  void readFinished();
+
+  /**
+   * @brief Returns the time pipelines computed since the prefetcher was created
+   * @return
+   */
+  qint64 computeMilliseconds() const;
+
+public:
+  InputPrefetcher(const InputPrefetcher&) = delete;            // Copy Constructor Not Implemented
+  InputPrefetcher(InputPrefetcher&&) = delete;                 // Move Constructor Not Implemented
+  InputPrefetcher& operator=(const InputPrefetcher&) = delete; // Copy Assignment Not Implemented
+  InputPrefetcher& operator=(InputPrefetcher&&) = delete;      // Move Assignment Not Implemented
+};
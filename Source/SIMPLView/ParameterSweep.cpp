@@ -0,0 +1,479 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ParameterSweep.h"
+
+#include <cmath>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+
+namespace
+{
+const int k_MaximumDepth = 4;
+const int k_MaximumValues = 10000;
+
+const QSet<QString> k_FilterMetaKeys = {"Filter_Human_Label", "Filter_Name", "Filter_Uuid", "Filter_Enabled", "FilterVersion"};
+
+// -----------------------------------------------------------------------------
+void CollectLeaves(const QJsonValue& node, QStringList& path, std::vector<ParameterSweep::Parameter>& parameters, const ParameterSweep::Parameter& filter)
+{
+  if(node.isObject() || node.isArray())
+  {
+    if(path.size() >= k_MaximumDepth)
+    {
+      return;
+    }
+
+    if(node.isObject())
+    {
+      QJsonObject object = node.toObject();
+      for(auto iter = object.constBegin(); iter != object.constEnd(); ++iter)
+      {
+        if(path.isEmpty() && k_FilterMetaKeys.contains(iter.key()))
+        {
+          continue;
+        }
+        path.push_back(iter.key());
+        CollectLeaves(iter.value(), path, parameters, filter);
+        path.pop_back();
+      }
+    }
+    else
+    {
+      QJsonArray array = node.toArray();
+      for(int i = 0; i < array.size(); i++)
+      {
+        path.push_back(QString::number(i));
+        CollectLeaves(array.at(i), path, parameters, filter);
+        path.pop_back();
+      }
+    }
+    return;
+  }
+
+  if(node.isBool() || node.isDouble() || node.isString())
+  {
+    ParameterSweep::Parameter parameter = filter;
+    parameter.path = path;
+    parameter.values = {node};
+    parameters.push_back(parameter);
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool SetValueAt(QJsonValue& node, const QStringList& path, int depth, const QJsonValue& value)
+{
+  if(depth == path.size())
+  {
+    node = value;
+    return true;
+  }
+
+  const QString& key = path[depth];
+  if(node.isObject())
+  {
+    QJsonObject object = node.toObject();
+    if(!object.contains(key))
+    {
+      return false;
+    }
+    QJsonValue child = object.value(key);
+    if(!SetValueAt(child, path, depth + 1, value))
+    {
+      return false;
+    }
+    object[key] = child;
+    node = object;
+    return true;
+  }
+
+  if(node.isArray())
+  {
+    bool ok = false;
+    int index = key.toInt(&ok);
+    QJsonArray array = node.toArray();
+    if(!ok || index < 0 || index >= array.size())
+    {
+      return false;
+    }
+    QJsonValue child = array.at(index);
+    if(!SetValueAt(child, path, depth + 1, value))
+    {
+      return false;
+    }
+    array[index] = child;
+    node = array;
+    return true;
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+bool ParseBool(const QString& text, bool& value)
+{
+  QString lower = text.toLower();
+  if(lower == "true" || lower == "1" || lower == "on" || lower == "yes")
+  {
+    value = true;
+    return true;
+  }
+  if(lower == "false" || lower == "0" || lower == "off" || lower == "no")
+  {
+    value = false;
+    return true;
+  }
+  return false;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweep::ParameterSweep() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweep::~ParameterSweep() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<ParameterSweep::Parameter> ParameterSweep::FindParameters(const QJsonObject& pipeline)
+{
+  std::vector<Parameter> parameters;
+  for(int index = 0; pipeline.contains(QString::number(index)); index++)
+  {
+    QJsonObject filterJson = pipeline.value(QString::number(index)).toObject();
+
+    Parameter filter;
+    filter.filterIndex = index;
+    filter.filterLabel = QString("%1: %2").arg(index + 1).arg(filterJson.value("Filter_Human_Label").toString());
+
+    QStringList path;
+    CollectLeaves(filterJson, path, parameters, filter);
+  }
+  return parameters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ParameterSweep::PathToString(const QStringList& path)
+{
+  return path.join(" / ");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::ParseValues(const QString& text, const QJsonValue& current, QList<QJsonValue>& values, QString& errorMessage)
+{
+  values.clear();
+  for(const QString& part : text.split(',', QString::SkipEmptyParts))
+  {
+    QString item = part.trimmed();
+    if(item.isEmpty())
+    {
+      continue;
+    }
+
+    if(current.isString())
+    {
+      values.push_back(item);
+    }
+    else if(current.isBool())
+    {
+      bool value = false;
+      if(!ParseBool(item, value))
+      {
+        errorMessage = QObject::tr("'%1' is not true or false.").arg(item);
+        return false;
+      }
+      values.push_back(value);
+    }
+    else if(item.contains(':'))
+    {
+      QStringList bounds = item.split(':');
+      QVector<double> numbers;
+      for(const QString& bound : bounds)
+      {
+        bool ok = false;
+        numbers.push_back(bound.trimmed().toDouble(&ok));
+        if(!ok)
+        {
+          errorMessage = QObject::tr("'%1' is not a range of the form start:stop:step.").arg(item);
+          return false;
+        }
+      }
+      if(numbers.size() < 2 || numbers.size() > 3)
+      {
+        errorMessage = QObject::tr("'%1' is not a range of the form start:stop:step.").arg(item);
+        return false;
+      }
+
+      double start = numbers[0];
+      double stop = numbers[1];
+      double step = numbers.size() == 3 ? numbers[2] : (stop >= start ? 1.0 : -1.0);
+      if(step == 0.0 || (stop - start) / step < 0.0)
+      {
+        errorMessage = QObject::tr("The step of '%1' does not lead from start to stop.").arg(item);
+        return false;
+      }
+
+      // The small tolerance keeps stop in the range when the step does not add up exactly
+      qint64 count = static_cast<qint64>(std::floor((stop - start) / step + 1.0e-9)) + 1;
+      if(count + values.size() > k_MaximumValues)
+      {
+        errorMessage = QObject::tr("'%1' has more than %2 values.").arg(item).arg(k_MaximumValues);
+        return false;
+      }
+      for(qint64 i = 0; i < count; i++)
+      {
+        values.push_back(start + static_cast<double>(i) * step);
+      }
+    }
+    else
+    {
+      bool ok = false;
+      double value = item.toDouble(&ok);
+      if(!ok)
+      {
+        errorMessage = QObject::tr("'%1' is not a number.").arg(item);
+        return false;
+      }
+      values.push_back(value);
+    }
+  }
+
+  if(values.isEmpty())
+  {
+    errorMessage = QObject::tr("No values were given.");
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonValue ParameterSweep::GetValue(const QJsonObject& filter, const QStringList& path)
+{
+  QJsonValue node = filter;
+  for(const QString& key : path)
+  {
+    if(node.isObject())
+    {
+      node = node.toObject().value(key);
+    }
+    else if(node.isArray())
+    {
+      bool ok = false;
+      int index = key.toInt(&ok);
+      QJsonArray array = node.toArray();
+      node = ok && index >= 0 && index < array.size() ? array.at(index) : QJsonValue(QJsonValue::Undefined);
+    }
+    else
+    {
+      return QJsonValue(QJsonValue::Undefined);
+    }
+  }
+  return node;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweep::SetValue(QJsonObject& filter, const QStringList& path, const QJsonValue& value)
+{
+  if(path.isEmpty())
+  {
+    return false;
+  }
+
+  QJsonValue node = filter;
+  if(!SetValueAt(node, path, 0, value))
+  {
+    return false;
+  }
+  filter = node.toObject();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<int> ParameterSweep::FindFiltersOfSubGroup(const QJsonObject& pipeline, const QString& subGroup)
+{
+  std::vector<int> filterIndices;
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  FilterPipeline::Pointer filterPipeline = jsonReader->readPipelineFromJson(pipeline, nullptr);
+  if(nullptr == filterPipeline)
+  {
+    return filterIndices;
+  }
+
+  // The reader keeps the order of the numbered filters of the JSON
+  int filterIndex = 0;
+  for(const AbstractFilter::Pointer& filter : filterPipeline->getFilterContainer())
+  {
+    if(filter->getSubGroupName() == subGroup)
+    {
+      filterIndices.push_back(filterIndex);
+    }
+    filterIndex++;
+  }
+  return filterIndices;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::RedirectOutputs(QJsonObject& filter, const QString& directory)
+{
+  for(auto iter = filter.begin(); iter != filter.end(); ++iter)
+  {
+    if(!iter.key().contains("Output", Qt::CaseInsensitive) || !iter.value().isString() || iter.value().toString().isEmpty())
+    {
+      continue;
+    }
+
+    // Members without a suffix name a directory, the others a file that keeps its name
+    QFileInfo fileInfo(iter.value().toString());
+    QString redirected = fileInfo.suffix().isEmpty() ? directory : QDir(directory).filePath(fileInfo.fileName());
+    iter.value() = QDir::toNativeSeparators(redirected);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::addParameter(const Parameter& parameter)
+{
+  m_Parameters.push_back(parameter);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::removeParameter(int index)
+{
+  if(index >= 0 && index < static_cast<int>(m_Parameters.size()))
+  {
+    m_Parameters.erase(m_Parameters.begin() + index);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweep::clear()
+{
+  m_Parameters.clear();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<ParameterSweep::Parameter>& ParameterSweep::getParameters() const
+{
+  return m_Parameters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ParameterSweep::getRunCount() const
+{
+  if(m_Parameters.empty())
+  {
+    return 0;
+  }
+
+  qint64 count = 1;
+  for(const Parameter& parameter : m_Parameters)
+  {
+    count *= parameter.values.size();
+  }
+  return count;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QList<QJsonValue> ParameterSweep::getRunValues(qint64 run) const
+{
+  QList<QJsonValue> values;
+  for(auto iter = m_Parameters.crbegin(); iter != m_Parameters.crend(); ++iter)
+  {
+    qint64 size = iter->values.size();
+    values.push_front(iter->values.at(static_cast<int>(run % size)));
+    run /= size;
+  }
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject ParameterSweep::createRunPipeline(const QJsonObject& pipeline, qint64 run, const std::vector<int>& outputFilters, const QString& outputDirectory) const
+{
+  QJsonObject runPipeline = pipeline;
+  QList<QJsonValue> values = getRunValues(run);
+  for(size_t i = 0; i < m_Parameters.size(); i++)
+  {
+    QString key = QString::number(m_Parameters[i].filterIndex);
+    QJsonObject filter = runPipeline.value(key).toObject();
+    SetValue(filter, m_Parameters[i].path, values.at(static_cast<int>(i)));
+    runPipeline[key] = filter;
+  }
+
+  for(int filterIndex : outputFilters)
+  {
+    QString key = QString::number(filterIndex);
+    QJsonObject filter = runPipeline.value(key).toObject();
+    RedirectOutputs(filter, outputDirectory);
+    runPipeline[key] = filter;
+  }
+  return runPipeline;
+}
@@ -0,0 +1,154 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+
+/**
+ * @brief The ParameterSweep class describes a grid of filter parameter values and builds the pipeline of every
+ * point of the grid by overriding values in the JSON of the pipeline.  Parameters are addressed by the index of
+ * their filter and the path of member names (or array indices) that leads to the value inside the filter's JSON,
+ * so nested values such as the comparison value of a threshold can be swept too.
+ */
+class ParameterSweep
+{
+public:
+  struct Parameter
+  {
+    int filterIndex = -1;
+    QString filterLabel;
+    QStringList path;
+    QList<QJsonValue> values;
+  };
+
+  ParameterSweep();
+  ~ParameterSweep();
+
+  /**
+   * @brief Returns the scalar values of the filters of the pipeline that can be swept
+   * @param pipeline The JSON form of the pipeline
+   * @return Parameters holding the current value as their only value
+   */
+  static std::vector<Parameter> FindParameters(const QJsonObject& pipeline);
+
+  /**
+   * @brief Returns the path of a parameter as it is shown to the user
+   * @param path
+   * @return
+   */
+  static QString PathToString(const QStringList& path);
+
+  /**
+   * @brief Parses the values typed for a parameter.  Values are separated by commas; numbers can also be given
+   * as a range "start:stop:step" that includes stop.  Values are converted to the type of the current value.
+   * @param text
+   * @param current
+   * @param values
+   * @param errorMessage
+   * @return
+   */
+  static bool ParseValues(const QString& text, const QJsonValue& current, QList<QJsonValue>& values, QString& errorMessage);
+
+  /**
+   * @brief Returns the value at the path inside the JSON of a filter, or an undefined value
+   * @param filter
+   * @param path
+   * @return
+   */
+  static QJsonValue GetValue(const QJsonObject& filter, const QStringList& path);
+
+  /**
+   * @brief Replaces the value at the path inside the JSON of a filter
+   * @param filter
+   * @param path
+   * @param value
+   * @return False if the path does not exist
+   */
+  static bool SetValue(QJsonObject& filter, const QStringList& path, const QJsonValue& value);
+
+  /**
+   * @brief Returns the indices of the filters of the pipeline whose filter group is the given one, such as
+   * SIMPL::FilterSubGroups::OutputFilters for the filters that write results
+   * @param pipeline
+   * @param subGroup
+   * @return
+   */
+  static std::vector<int> FindFiltersOfSubGroup(const QJsonObject& pipeline, const QString& subGroup);
+
+  /**
+   * @brief Points the output paths of a writer filter into the directory, keeping their file names
+   * @param filter
+   * @param directory
+   */
+  static void RedirectOutputs(QJsonObject& filter, const QString& directory);
+
+  void addParameter(const Parameter& parameter);
+  void removeParameter(int index);
+  void clear();
+  const std::vector<Parameter>& getParameters() const;
+
+  /**
+   * @brief Returns the number of runs of the grid, or 0 without parameters
+   * @return
+   */
+  qint64 getRunCount() const;
+
+  /**
+   * @brief Returns the value of every parameter in a run.  The last parameter varies fastest.
+   * @param run
+   * @return
+   */
+  QList<QJsonValue> getRunValues(qint64 run) const;
+
+  /**
+   * @brief Returns the pipeline of a run with its values applied and the outputs of the writer filters moved
+   * into the directory of the run
+   * @param pipeline
+   * @param run
+   * @param outputFilters The indices of the filters that write the results
+   * @param outputDirectory
+   * @return
+   */
+  QJsonObject createRunPipeline(const QJsonObject& pipeline, qint64 run, const std::vector<int>& outputFilters, const QString& outputDirectory) const;
+
+private:
+  std::vector<Parameter> m_Parameters;
+};
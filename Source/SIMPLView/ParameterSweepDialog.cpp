@@ -0,0 +1,650 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ParameterSweepDialog.h"
+
+#include <algorithm>
+#include <functional>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSignalBlocker>
+#include <QtCore/QThread>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QGroupBox>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QMessageBox>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QSpinBox>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLib/Common/Constants.h"
+
+#include "SIMPLView/ExecutionScheduler.h"
+#include "SIMPLView/PipelineExecution.h"
+#include "SIMPLView/PipelineFileFormat.h"
+#include "SIMPLView/SIMPLViewApplication.h"
+
+namespace
+{
+const qint64 k_RunCountWarning = 100;
+const QString k_RunPipelineFileName("Pipeline.json");
+
+// -----------------------------------------------------------------------------
+QString ValueToString(const QJsonValue& value)
+{
+  if(value.isBool())
+  {
+    return value.toBool() ? "true" : "false";
+  }
+  if(value.isDouble())
+  {
+    return QString::number(value.toDouble(), 'g', 10);
+  }
+  return value.toString();
+}
+
+// -----------------------------------------------------------------------------
+QString ValuesToString(const QList<QJsonValue>& values)
+{
+  QStringList strings;
+  for(const QJsonValue& value : values)
+  {
+    strings.push_back(ValueToString(value));
+  }
+  return strings.join(", ");
+}
+
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweepDialog::ParameterSweepDialog(QWidget* parent)
+: QDialog(parent)
+{
+  setWindowTitle(tr("Parameter Sweep"));
+  resize(900, 640);
+
+  // Picking the parameters
+  m_FilterCombo = new QComboBox(this);
+  m_ParameterCombo = new QComboBox(this);
+  m_CurrentValueLabel = new QLabel(this);
+  m_ValuesEdit = new QLineEdit(this);
+  m_ValuesEdit->setPlaceholderText(tr("Values such as 0.5, 1, 2 or ranges such as 10:50:10"));
+  m_AddButton = new QPushButton(tr("Add"), this);
+
+  QHBoxLayout* valuesLayout = new QHBoxLayout();
+  valuesLayout->addWidget(m_ValuesEdit, 1);
+  valuesLayout->addWidget(m_AddButton);
+
+  m_ParametersTree = new QTreeWidget(this);
+  m_ParametersTree->setHeaderLabels({tr("Filter"), tr("Parameter"), tr("Values"), tr("Count")});
+  m_ParametersTree->setRootIsDecorated(false);
+  m_ParametersTree->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  m_RemoveButton = new QPushButton(tr("Remove"), this);
+  m_RunCountLabel = new QLabel(this);
+
+  QHBoxLayout* parameterButtonsLayout = new QHBoxLayout();
+  parameterButtonsLayout->addWidget(m_RunCountLabel, 1);
+  parameterButtonsLayout->addWidget(m_RemoveButton);
+
+  QGroupBox* parametersGroup = new QGroupBox(tr("Parameters"), this);
+  QFormLayout* pickLayout = new QFormLayout();
+  pickLayout->addRow(tr("Filter:"), m_FilterCombo);
+  pickLayout->addRow(tr("Parameter:"), m_ParameterCombo);
+  pickLayout->addRow(tr("Current value:"), m_CurrentValueLabel);
+  pickLayout->addRow(tr("Values:"), valuesLayout);
+  QVBoxLayout* parametersLayout = new QVBoxLayout(parametersGroup);
+  parametersLayout->addLayout(pickLayout);
+  parametersLayout->addWidget(m_ParametersTree, 1);
+  parametersLayout->addLayout(parameterButtonsLayout);
+
+  // Where and how the runs go
+  m_OutputDirectoryEdit = new QLineEdit(this);
+  m_OutputDirectoryEdit->setToolTip(tr("Every run writes its results and its pipeline into a directory of its own below this one."));
+  QPushButton* browseButton = new QPushButton(tr("Browse..."), this);
+  QHBoxLayout* outputLayout = new QHBoxLayout();
+  outputLayout->addWidget(m_OutputDirectoryEdit, 1);
+  outputLayout->addWidget(browseButton);
+
+  m_ConcurrencySpinBox = new QSpinBox(this);
+  m_ConcurrencySpinBox->setRange(1, std::max(QThread::idealThreadCount(), 1) * 4);
+  m_ConcurrencySpinBox->setValue(std::max(QThread::idealThreadCount(), 1));
+  m_ConcurrencySpinBox->setToolTip(tr("The number of runs that execute at the same time. They share the worker threads of the execution queue."));
+
+  QFormLayout* runLayout = new QFormLayout();
+  runLayout->addRow(tr("Output directory:"), outputLayout);
+  runLayout->addRow(tr("Concurrent runs:"), m_ConcurrencySpinBox);
+
+  // The results of all runs
+  m_ResultsTree = new QTreeWidget(this);
+  m_ResultsTree->setRootIsDecorated(false);
+  m_ResultsTree->setSortingEnabled(true);
+
+  m_StartButton = new QPushButton(tr("Run Sweep"), this);
+  m_CancelButton = new QPushButton(tr("Cancel Runs"), this);
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+  buttonBox->addButton(m_StartButton, QDialogButtonBox::ActionRole);
+  buttonBox->addButton(m_CancelButton, QDialogButtonBox::ActionRole);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(parametersGroup, 1);
+  layout->addLayout(runLayout);
+  layout->addWidget(m_ResultsTree, 2);
+  layout->addWidget(buttonBox);
+
+  connect(m_FilterCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ParameterSweepDialog::updateParameterCombo);
+  connect(m_ParameterCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &ParameterSweepDialog::updateCurrentValue);
+  connect(m_AddButton, &QPushButton::clicked, this, &ParameterSweepDialog::addParameter);
+  connect(m_ValuesEdit, &QLineEdit::returnPressed, this, &ParameterSweepDialog::addParameter);
+  connect(m_RemoveButton, &QPushButton::clicked, this, &ParameterSweepDialog::removeParameters);
+  connect(browseButton, &QPushButton::clicked, this, [this] {
+    QString directory = QFileDialog::getExistingDirectory(this, tr("Sweep Output Directory"), m_OutputDirectoryEdit->text());
+    if(!directory.isEmpty())
+    {
+      m_OutputDirectoryEdit->setText(QDir::toNativeSeparators(directory));
+    }
+  });
+  connect(m_StartButton, &QPushButton::clicked, this, &ParameterSweepDialog::startSweep);
+  connect(m_CancelButton, &QPushButton::clicked, this, &ParameterSweepDialog::cancelSweep);
+  connect(buttonBox, &QDialogButtonBox::rejected, this, &ParameterSweepDialog::hide);
+
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  connect(scheduler, &ExecutionScheduler::jobStarted, this, &ParameterSweepDialog::schedulerJobStarted);
+  connect(scheduler, &ExecutionScheduler::jobFinished, this, &ParameterSweepDialog::schedulerJobFinished);
+
+  refreshParameters();
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweepDialog::~ParameterSweepDialog()
+{
+  // Deleting an execution cancels it and ends its job in the scheduler
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  disconnect(scheduler, nullptr, this, nullptr);
+  for(Run& run : m_Runs)
+  {
+    delete run.execution;
+    run.execution = nullptr;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::setPipeline(const QJsonObject& pipeline, const QString& owner)
+{
+  if(isRunning())
+  {
+    return;
+  }
+
+  m_Pipeline = pipeline;
+  m_Owner = owner;
+  m_Candidates = ParameterSweep::FindParameters(m_Pipeline);
+
+  // Parameters that no longer exist, or changed their type, are dropped from the sweep
+  ParameterSweep kept;
+  for(const ParameterSweep::Parameter& parameter : m_Sweep.getParameters())
+  {
+    QJsonValue current = ParameterSweep::GetValue(m_Pipeline.value(QString::number(parameter.filterIndex)).toObject(), parameter.path);
+    if(!parameter.values.isEmpty() && current.type() == parameter.values.front().type())
+    {
+      kept.addParameter(parameter);
+    }
+  }
+  m_Sweep = kept;
+
+  QSignalBlocker blocker(m_FilterCombo);
+  m_FilterCombo->clear();
+  int lastFilter = -1;
+  for(const ParameterSweep::Parameter& candidate : m_Candidates)
+  {
+    if(candidate.filterIndex != lastFilter)
+    {
+      m_FilterCombo->addItem(candidate.filterLabel, candidate.filterIndex);
+      lastFilter = candidate.filterIndex;
+    }
+  }
+
+  updateParameterCombo();
+  refreshParameters();
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ParameterSweepDialog::isRunning() const
+{
+  return m_ActiveRuns > 0 || m_NextRun < m_Runs.size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::updateParameterCombo()
+{
+  int filterIndex = m_FilterCombo->currentData().toInt();
+
+  QSignalBlocker blocker(m_ParameterCombo);
+  m_ParameterCombo->clear();
+  for(size_t i = 0; i < m_Candidates.size(); i++)
+  {
+    if(m_Candidates[i].filterIndex == filterIndex)
+    {
+      m_ParameterCombo->addItem(ParameterSweep::PathToString(m_Candidates[i].path), static_cast<int>(i));
+    }
+  }
+  updateCurrentValue();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::updateCurrentValue()
+{
+  int candidate = m_ParameterCombo->currentData().toInt();
+  if(m_ParameterCombo->count() == 0 || candidate < 0 || candidate >= static_cast<int>(m_Candidates.size()))
+  {
+    m_CurrentValueLabel->clear();
+    return;
+  }
+  m_CurrentValueLabel->setText(ValueToString(m_Candidates[candidate].values.front()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::addParameter()
+{
+  int candidate = m_ParameterCombo->currentData().toInt();
+  if(m_ParameterCombo->count() == 0 || candidate < 0 || candidate >= static_cast<int>(m_Candidates.size()))
+  {
+    return;
+  }
+
+  ParameterSweep::Parameter parameter = m_Candidates[candidate];
+  QString errorMessage;
+  if(!ParameterSweep::ParseValues(m_ValuesEdit->text(), parameter.values.front(), parameter.values, errorMessage))
+  {
+    QMessageBox::warning(this, tr("Parameter Sweep"), errorMessage);
+    return;
+  }
+
+  // Adding a parameter again replaces its values
+  const std::vector<ParameterSweep::Parameter>& parameters = m_Sweep.getParameters();
+  for(size_t i = 0; i < parameters.size(); i++)
+  {
+    if(parameters[i].filterIndex == parameter.filterIndex && parameters[i].path == parameter.path)
+    {
+      m_Sweep.removeParameter(static_cast<int>(i));
+      break;
+    }
+  }
+  m_Sweep.addParameter(parameter);
+  m_ValuesEdit->clear();
+  refreshParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::removeParameters()
+{
+  QList<int> rows;
+  for(QTreeWidgetItem* item : m_ParametersTree->selectedItems())
+  {
+    rows.push_back(m_ParametersTree->indexOfTopLevelItem(item));
+  }
+
+  // From the back so the remaining rows keep their index
+  std::sort(rows.begin(), rows.end(), std::greater<int>());
+  for(int row : rows)
+  {
+    m_Sweep.removeParameter(row);
+  }
+  refreshParameters();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::refreshParameters()
+{
+  m_ParametersTree->clear();
+  for(const ParameterSweep::Parameter& parameter : m_Sweep.getParameters())
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_ParametersTree);
+    item->setText(0, parameter.filterLabel);
+    item->setText(1, ParameterSweep::PathToString(parameter.path));
+    item->setText(2, ValuesToString(parameter.values));
+    item->setToolTip(2, item->text(2));
+    item->setText(3, QString::number(parameter.values.size()));
+  }
+
+  m_RunCountLabel->setText(tr("%n run(s)", "", static_cast<int>(m_Sweep.getRunCount())));
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::updateControls()
+{
+  bool running = isRunning();
+  m_FilterCombo->setEnabled(!running);
+  m_ParameterCombo->setEnabled(!running);
+  m_ValuesEdit->setEnabled(!running);
+  m_AddButton->setEnabled(!running);
+  m_RemoveButton->setEnabled(!running);
+  m_OutputDirectoryEdit->setEnabled(!running);
+  m_ConcurrencySpinBox->setEnabled(!running);
+  m_StartButton->setEnabled(!running && m_Sweep.getRunCount() > 0);
+  m_CancelButton->setEnabled(running);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::startSweep()
+{
+  qint64 runCount = m_Sweep.getRunCount();
+  if(isRunning() || runCount == 0)
+  {
+    return;
+  }
+
+  QString outputDirectory = m_OutputDirectoryEdit->text().trimmed();
+  if(outputDirectory.isEmpty() || !QDir().mkpath(outputDirectory))
+  {
+    QMessageBox::warning(this, tr("Parameter Sweep"), tr("Choose an output directory that can be created."));
+    return;
+  }
+
+  if(runCount > k_RunCountWarning &&
+     QMessageBox::question(this, tr("Parameter Sweep"), tr("The sweep runs the pipeline %1 times. Do you want to start it?").arg(runCount)) != QMessageBox::Yes)
+  {
+    return;
+  }
+
+  // The writers are found once; their outputs are moved into the directory of each run
+  m_OutputFilters = ParameterSweep::FindFiltersOfSubGroup(m_Pipeline, SIMPL::FilterSubGroups::OutputFilters);
+
+  // Later changes of the parameters must not affect the runs of this sweep
+  m_RunningSweep = m_Sweep;
+  m_Runs.clear();
+  m_NextRun = 0;
+  m_ActiveRuns = 0;
+  int digits = QString::number(runCount).size();
+  for(qint64 i = 0; i < runCount; i++)
+  {
+    Run run;
+    run.index = i;
+    run.directory = QDir(outputDirectory).filePath(QString("Run_%1").arg(i + 1, digits, 10, QChar('0')));
+    m_Runs.push_back(run);
+  }
+
+  resetResults();
+  dispatch();
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::cancelSweep()
+{
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  for(size_t i = m_NextRun; i < m_Runs.size(); i++)
+  {
+    m_Runs[i].status = RunStatus::Cancelled;
+    refreshRun(m_Runs[i]);
+  }
+  m_NextRun = m_Runs.size();
+
+  // The active runs are settled once the scheduler ended them
+  for(const Run& run : m_Runs)
+  {
+    if(run.execution != nullptr)
+    {
+      scheduler->cancel(run.schedulerJobId);
+    }
+  }
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::resetResults()
+{
+  QStringList headers = {tr("Run")};
+  for(const ParameterSweep::Parameter& parameter : m_RunningSweep.getParameters())
+  {
+    headers.push_back(QString("%1 %2").arg(parameter.filterLabel, ParameterSweep::PathToString(parameter.path)));
+  }
+  headers << tr("Status") << tr("Time") << tr("Message") << tr("Output Directory");
+
+  m_ResultsTree->clear();
+  m_ResultsTree->setColumnCount(headers.size());
+  m_ResultsTree->setHeaderLabels(headers);
+
+  for(const Run& run : m_Runs)
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_ResultsTree);
+    item->setData(0, Qt::DisplayRole, run.index + 1);
+    QList<QJsonValue> values = m_RunningSweep.getRunValues(run.index);
+    for(int i = 0; i < values.size(); i++)
+    {
+      // Numbers are stored as numbers so the column sorts numerically
+      item->setData(i + 1, Qt::DisplayRole, values[i].isDouble() ? QVariant(values[i].toDouble()) : QVariant(ValueToString(values[i])));
+    }
+    refreshRun(run);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::refreshRun(const Run& run)
+{
+  QTreeWidgetItem* item = nullptr;
+  for(int i = 0; i < m_ResultsTree->topLevelItemCount() && nullptr == item; i++)
+  {
+    if(m_ResultsTree->topLevelItem(i)->data(0, Qt::DisplayRole).toLongLong() == run.index + 1)
+    {
+      item = m_ResultsTree->topLevelItem(i);
+    }
+  }
+  if(nullptr == item)
+  {
+    return;
+  }
+
+  QString status;
+  switch(run.status)
+  {
+  case RunStatus::Waiting:
+    status = tr("Waiting");
+    break;
+  case RunStatus::Queued:
+    status = tr("Queued");
+    break;
+  case RunStatus::Running:
+    status = tr("Running");
+    break;
+  case RunStatus::Succeeded:
+    status = tr("Succeeded");
+    break;
+  case RunStatus::Failed:
+    status = tr("Failed");
+    break;
+  case RunStatus::Cancelled:
+    status = tr("Cancelled");
+    break;
+  }
+
+  int column = static_cast<int>(m_RunningSweep.getParameters().size()) + 1;
+  item->setText(column, status);
+  item->setText(column + 1, run.elapsedMilliseconds > 0 ? FormatDuration(run.elapsedMilliseconds) : QString());
+  item->setText(column + 2, run.message);
+  item->setToolTip(column + 2, run.message);
+  item->setText(column + 3, QDir::toNativeSeparators(run.directory));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::dispatch()
+{
+  while(m_NextRun < m_Runs.size() && m_ActiveRuns < m_ConcurrencySpinBox->value())
+  {
+    submitRun(m_Runs[m_NextRun]);
+    m_NextRun++;
+  }
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::submitRun(Run& run)
+{
+  QJsonObject runPipeline = m_RunningSweep.createRunPipeline(m_Pipeline, run.index, m_OutputFilters, run.directory);
+
+  // The pipeline of the run is kept with its results so the run can be repeated on its own
+  QString errorMessage;
+  if(!QDir().mkpath(run.directory) ||
+     !PipelineFileFormat::WriteFileAtomically(QDir(run.directory).filePath(k_RunPipelineFileName), PipelineFileFormat::ToJson(runPipeline), errorMessage))
+  {
+    run.status = RunStatus::Failed;
+    run.message = errorMessage.isEmpty() ? tr("The output directory of the run could not be created.") : errorMessage;
+    refreshRun(run);
+    return;
+  }
+
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  ExecutionScheduler::PreparedRun preparedRun;
+  if(!scheduler->prepareRun(runPipeline, tr("Sweep run %1").arg(run.index + 1), m_ConcurrencySpinBox->value(), preparedRun, errorMessage))
+  {
+    run.status = RunStatus::Failed;
+    run.message = errorMessage;
+    refreshRun(run);
+    return;
+  }
+
+  run.execution = new PipelineExecution(preparedRun.pipeline, this);
+  run.status = RunStatus::Queued;
+  m_ActiveRuns++;
+  run.schedulerJobId = scheduler->submitPreparedRun(preparedRun, m_Owner, run.execution);
+  refreshRun(run);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ParameterSweepDialog::Run* ParameterSweepDialog::findRun(int schedulerJobId)
+{
+  auto iter = std::find_if(m_Runs.begin(), m_Runs.end(), [schedulerJobId](const Run& run) { return run.execution != nullptr && run.schedulerJobId == schedulerJobId; });
+  return iter != m_Runs.end() ? &(*iter) : nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::schedulerJobStarted(int schedulerJobId)
+{
+  Run* run = findRun(schedulerJobId);
+  if(nullptr != run)
+  {
+    run->status = RunStatus::Running;
+    refreshRun(*run);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ParameterSweepDialog::schedulerJobFinished(int schedulerJobId)
+{
+  Run* run = findRun(schedulerJobId);
+  if(nullptr == run)
+  {
+    return;
+  }
+
+  PipelineExecution* execution = run->execution;
+  run->execution = nullptr;
+  run->elapsedMilliseconds = execution->getElapsedMilliseconds();
+  QStringList errors = execution->getErrorMessages();
+
+  // A run that is cancelled while it waits in the scheduler never started
+  if(run->status != RunStatus::Running || execution->wasCancelled())
+  {
+    run->status = RunStatus::Cancelled;
+  }
+  else if(!errors.isEmpty())
+  {
+    run->status = RunStatus::Failed;
+    run->message = errors.front();
+  }
+  else
+  {
+    run->status = RunStatus::Succeeded;
+  }
+  refreshRun(*run);
+
+  ExecutionScheduler::ReleaseExecution(execution);
+  m_ActiveRuns--;
+  dispatch();
+}
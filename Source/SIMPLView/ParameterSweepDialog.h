@@ -0,0 +1,208 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtWidgets/QDialog>
+
+#include "SIMPLView/ParameterSweep.h"
+
+class PipelineExecution;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QSpinBox;
+class QTreeWidget;
+
+/**
+ * @brief The ParameterSweepDialog class runs the pipeline of a window once for every combination of the filter
+ * parameter values the user picks.  Each run gets its own output directory, which also receives the pipeline of
+ * the run, and runs as a Batch job of the execution scheduler.  The results of all runs are shown in one table.
+ */
+class ParameterSweepDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  ParameterSweepDialog(QWidget* parent = nullptr);
+
+  /**
+   * @brief Cancels the runs that have not finished
+   */
+  ~ParameterSweepDialog() override;
+
+  /**
+   * @brief Sets the pipeline that is swept.  The chosen parameters that still exist in it are kept.
+   * @param pipeline
+   * @param owner The name the runs are shown with in the execution queue
+   */
+  void setPipeline(const QJsonObject& pipeline, const QString& owner);
+
+  /**
+   * @brief Returns true while runs of the sweep are waiting or running
+   * @return
+   */
+  bool isRunning() const;
+
+public Q_SLOTS:
+  /**
+   * @brief Starts a run for every combination of the chosen values
+   */
+  void startSweep();
+
+  /**
+   * @brief Cancels the runs that have not finished
+   */
+  void cancelSweep();
+
+private:
+  enum class RunStatus : int
+  {
+    Waiting,
+    Queued,
+    Running,
+    Succeeded,
+    Failed,
+    Cancelled
+  };
+
+  struct Run
+  {
+    qint64 index = 0;
+    QString directory;
+    RunStatus status = RunStatus::Waiting;
+    qint64 elapsedMilliseconds = 0;
+    QString message;
+    int schedulerJobId = -1;
+    PipelineExecution* execution = nullptr;
+  };
+
+  QJsonObject m_Pipeline;
+  QString m_Owner;
+  std::vector<ParameterSweep::Parameter> m_Candidates;
+  ParameterSweep m_Sweep;
+  ParameterSweep m_RunningSweep;
+  std::vector<int> m_OutputFilters;
+  std::vector<Run> m_Runs;
+  size_t m_NextRun = 0;
+  int m_ActiveRuns = 0;
+
+  QComboBox* m_FilterCombo = nullptr;
+  QComboBox* m_ParameterCombo = nullptr;
+  QLabel* m_CurrentValueLabel = nullptr;
+  QLineEdit* m_ValuesEdit = nullptr;
+  QPushButton* m_AddButton = nullptr;
+  QTreeWidget* m_ParametersTree = nullptr;
+  QPushButton* m_RemoveButton = nullptr;
+  QLabel* m_RunCountLabel = nullptr;
+  QLineEdit* m_OutputDirectoryEdit = nullptr;
+  QSpinBox* m_ConcurrencySpinBox = nullptr;
+  QTreeWidget* m_ResultsTree = nullptr;
+  QPushButton* m_StartButton = nullptr;
+  QPushButton* m_CancelButton = nullptr;
+
+  /**
+   * @brief Fills the parameter list with the parameters of the selected filter
+   */
+  void updateParameterCombo();
+
+  /**
+   * @brief Shows the current value of the selected parameter
+   */
+  void updateCurrentValue();
+
+  /**
+   * @brief Adds the selected parameter with the typed values to the sweep
+   */
+  void addParameter();
+
+  /**
+   * @brief Removes the selected parameters from the sweep
+   */
+  void removeParameters();
+
+  /**
+   * @brief Shows the parameters of the sweep and the number of runs
+   */
+  void refreshParameters();
+
+  /**
+   * @brief Recreates the columns of the result table for the parameters of the sweep
+   */
+  void resetResults();
+
+  /**
+   * @brief Shows the state of a run in the result table
+   * @param run
+   */
+  void refreshRun(const Run& run);
+
+  /**
+   * @brief Submits waiting runs until the chosen number of them are active
+   */
+  void dispatch();
+
+  /**
+   * @brief Writes the pipeline of a run into its directory, preflights it and queues it in the scheduler
+   * @param run
+   */
+  void submitRun(Run& run);
+
+  /**
+   * @brief Finds the run of a scheduler job
+   * @param schedulerJobId
+   * @return
+   */
+  Run* findRun(int schedulerJobId);
+
+  void schedulerJobStarted(int schedulerJobId);
+  void schedulerJobFinished(int schedulerJobId);
+
+  /**
+   * @brief Enables the controls that must not change while the sweep runs
+   */
+  void updateControls();
+
+public:
+  ParameterSweepDialog(const ParameterSweepDialog&) = delete;            // Copy Constructor Not Implemented
+  ParameterSweepDialog(ParameterSweepDialog&&) = delete;                 // Move Constructor Not Implemented
+  ParameterSweepDialog& operator=(const ParameterSweepDialog&) = delete; // Copy Assignment Not Implemented
+  ParameterSweepDialog& operator=(ParameterSweepDialog&&) = delete;      // Move Assignment Not Implemented
+};
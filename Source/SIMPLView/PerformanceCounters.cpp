@@ -0,0 +1,284 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PerformanceCounters.h"
+
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#if defined(Q_OS_LINUX)
+const std::array<quint64, 4> k_CounterConfigs = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+// -----------------------------------------------------------------------------
+int OpenCounter(qint64 threadId, quint64 config)
+{
+  perf_event_attr attributes;
+  std::memset(&attributes, 0, sizeof(attributes));
+  attributes.size = sizeof(attributes);
+  attributes.type = PERF_TYPE_HARDWARE;
+  attributes.config = config;
+  attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  attributes.exclude_kernel = 1;
+  attributes.exclude_hv = 1;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attributes, static_cast<pid_t>(threadId), -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+// -----------------------------------------------------------------------------
+double ReadCounter(int descriptor)
+{
+  // The value, then the time the counter was enabled and the time it actually counted
+  quint64 values[3] = {0, 0, 0};
+  if(::read(descriptor, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]);
+}
+
+// -----------------------------------------------------------------------------
+qint64 ThreadStartTime(const QString& threadId)
+{
+  QFile stat(QString("/proc/self/task/%1/stat").arg(threadId));
+  if(!stat.open(QIODevice::ReadOnly))
+  {
+    return -1;
+  }
+
+  // The start time is the 22nd field, counted from the last parenthesis as the name may hold some
+  QByteArray contents = stat.readAll();
+  QList<QByteArray> fields = contents.mid(contents.lastIndexOf(')') + 2).split(' ');
+  return fields.size() > 19 ? fields[19].toLongLong() : -1;
+}
+#endif
+
+// -----------------------------------------------------------------------------
+qint64 Subtract(qint64 start, qint64 end)
+{
+  return (start < 0 || end < 0) ? -1 : end - start;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PerformanceCounters::PerformanceCounters()
+{
+  // A counter the CPU or the kernel does not offer is given up after the first thread
+  m_Available.fill(IsSupported());
+  m_EndedTotals.fill(0.0);
+#if defined(Q_OS_LINUX)
+  m_CreatingThread = static_cast<qint64>(syscall(SYS_gettid));
+#endif
+  refreshThreads();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PerformanceCounters::~PerformanceCounters()
+{
+#if defined(Q_OS_LINUX)
+  for(const auto& thread : m_Threads)
+  {
+    for(int descriptor : thread.second.descriptors)
+    {
+      if(descriptor >= 0)
+      {
+        ::close(descriptor);
+      }
+    }
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PerformanceCounters::IsSupported()
+{
+#if defined(Q_OS_LINUX)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PerformanceCounters::Values PerformanceCounters::Difference(const Values& start, const Values& end)
+{
+  Values difference;
+  difference.cycles = Subtract(start.cycles, end.cycles);
+  difference.instructions = Subtract(start.instructions, end.instructions);
+  difference.cacheMisses = Subtract(start.cacheMisses, end.cacheMisses);
+  difference.branchMisses = Subtract(start.branchMisses, end.branchMisses);
+  return difference;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PerformanceCounters::isOpen() const
+{
+  return std::find(m_Available.cbegin(), m_Available.cend(), true) != m_Available.cend();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PerformanceCounters::refreshThreads()
+{
+#if defined(Q_OS_LINUX)
+  if(!isOpen())
+  {
+    return;
+  }
+
+  std::map<qint64, qint64> startTimes;
+  for(const QString& entry : QDir("/proc/self/task").entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+  {
+    qint64 threadId = entry.toLongLong();
+    if(threadId > 0 && threadId != m_CreatingThread)
+    {
+      startTimes[threadId] = ThreadStartTime(entry);
+    }
+  }
+
+  // Threads that ended, or whose id now belongs to a later thread, keep what they counted
+  for(auto thread = m_Threads.begin(); thread != m_Threads.end();)
+  {
+    auto startTime = startTimes.find(thread->first);
+    if(startTime == startTimes.end() || startTime->second != thread->second.startTime)
+    {
+      retireThread(thread->second);
+      thread = m_Threads.erase(thread);
+      continue;
+    }
+    ++thread;
+  }
+
+  for(const auto& startTime : startTimes)
+  {
+    qint64 threadId = startTime.first;
+    if(m_Threads.find(threadId) != m_Threads.end())
+    {
+      continue;
+    }
+
+    bool firstThread = m_Threads.empty();
+    ThreadCounters counters;
+    counters.startTime = startTime.second;
+    counters.descriptors.fill(-1);
+    for(int i = 0; i < k_CounterCount; i++)
+    {
+      if(!m_Available[i])
+      {
+        continue;
+      }
+      counters.descriptors[i] = OpenCounter(threadId, k_CounterConfigs[i]);
+
+      // A thread that ended since the directory was listed is no reason to give up the counter
+      if(counters.descriptors[i] < 0 && firstThread && errno != ESRCH)
+      {
+        m_Available[i] = false;
+      }
+    }
+    m_Threads[threadId] = counters;
+  }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PerformanceCounters::Values PerformanceCounters::read()
+{
+  Values values;
+#if defined(Q_OS_LINUX)
+  refreshThreads();
+
+  std::array<double, k_CounterCount> totals = m_EndedTotals;
+  for(const auto& thread : m_Threads)
+  {
+    for(int i = 0; i < k_CounterCount; i++)
+    {
+      if(thread.second.descriptors[i] >= 0)
+      {
+        totals[i] += ReadCounter(thread.second.descriptors[i]);
+      }
+    }
+  }
+
+  values.cycles = m_Available[0] ? static_cast<qint64>(totals[0]) : -1;
+  values.instructions = m_Available[1] ? static_cast<qint64>(totals[1]) : -1;
+  values.cacheMisses = m_Available[2] ? static_cast<qint64>(totals[2]) : -1;
+  values.branchMisses = m_Available[3] ? static_cast<qint64>(totals[3]) : -1;
+#endif
+  return values;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PerformanceCounters::retireThread(const ThreadCounters& counters)
+{
+#if defined(Q_OS_LINUX)
+  // The counter of a thread that ended can still be read for what it counted until then
+  for(int i = 0; i < k_CounterCount; i++)
+  {
+    if(counters.descriptors[i] >= 0)
+    {
+      m_EndedTotals[i] += ReadCounter(counters.descriptors[i]);
+      ::close(counters.descriptors[i]);
+    }
+  }
+#else
+  Q_UNUSED(counters)
+#endif
+}
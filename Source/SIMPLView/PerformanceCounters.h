@@ -0,0 +1,131 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <map>
+
+#include <QtCore/QtGlobal>
+
+/**
+ * @brief The PerformanceCounters class counts the CPU cycles, instructions, cache misses and branch misses of all
+ * threads of the process with the hardware counters of the CPU.  It is only supported on Linux, through
+ * perf_event_open; elsewhere, and where the kernel does not allow it, no counter opens and every value is -1.
+ *
+ * Each thread has its own counters.  Threads are looked up in /proc/self/task whenever the counters are read or
+ * refreshed, so what a new thread did before that is not counted, and a thread that starts and ends in between is
+ * missed completely.  Counters are not inherited, since the threads a run uses mostly come from pools that exist
+ * before it; an inherited counter would also count the threads that are opened on their own a second time.  A
+ * thread that ended keeps what it counted, and a thread id the system hands out again is recognised by the start
+ * time of its thread and gets counters of its own.  The thread that creates the counters is left out, which keeps
+ * the event loop of the window out of the counts, but the other threads of the process are counted whichever run
+ * they work for.  Only user space is counted, which the default perf_event_paranoid setting allows.
+ */
+class PerformanceCounters
+{
+public:
+  struct Values
+  {
+    qint64 cycles = -1;
+    qint64 instructions = -1;
+    qint64 cacheMisses = -1;
+    qint64 branchMisses = -1;
+  };
+
+  /**
+   * @brief Opens the counters for the threads that run now
+   */
+  PerformanceCounters();
+  ~PerformanceCounters();
+
+  /**
+   * @brief Returns true if hardware counters can be read on this platform
+   * @return
+   */
+  static bool IsSupported();
+
+  /**
+   * @brief Returns the counts between two reads; a counter that is missing in either read is -1
+   * @param start
+   * @param end
+   * @return
+   */
+  static Values Difference(const Values& start, const Values& end);
+
+  /**
+   * @brief Returns true if at least one counter could be opened
+   * @return
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Opens the counters of threads that started since the last refresh
+   */
+  void refreshThreads();
+
+  /**
+   * @brief Returns the counts of all threads since the counters were opened, corrected for the time the kernel
+   * had to share the hardware counters with other events
+   * @return
+   */
+  Values read();
+
+private:
+  static const int k_CounterCount = 4;
+
+  struct ThreadCounters
+  {
+    qint64 startTime = -1; // Tells a thread from a later one with the same id
+    std::array<int, k_CounterCount> descriptors;
+  };
+
+  std::map<qint64, ThreadCounters> m_Threads;
+  std::array<bool, k_CounterCount> m_Available;
+  std::array<double, k_CounterCount> m_EndedTotals;
+  qint64 m_CreatingThread = -1;
+
+  /**
+   * @brief Adds what the counters of a thread counted to the totals of the threads that ended and closes them
+   * @param counters
+   */
+  void retireThread(const ThreadCounters& counters);
+
+public:
+  PerformanceCounters(const PerformanceCounters&) = delete;            // Copy Constructor Not Implemented
+  PerformanceCounters(PerformanceCounters&&) = delete;                 // Move Constructor Not Implemented
+  PerformanceCounters& operator=(const PerformanceCounters&) = delete; // Copy Assignment Not Implemented
+  PerformanceCounters& operator=(PerformanceCounters&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,124 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineCostEstimator.h"
+
+#include <algorithm>
+
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+
+#include "SIMPLView/FilterTimingStore.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineCostEstimator::DataContainerArrayBytes(const DataContainerArray::Pointer& dca)
+{
+  if(nullptr == dca)
+  {
+    return 0;
+  }
+
+  // Preflighted arrays know their tuple and component counts without being allocated
+  qint64 bytes = 0;
+  for(const DataContainer::Pointer& dc : dca->getDataContainers())
+  {
+    for(const QString& amName : dc->getAttributeMatrixNames())
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      if(nullptr == am)
+      {
+        continue;
+      }
+      for(const QString& arrayName : am->getAttributeArrayNames())
+      {
+        IDataArray::Pointer array = am->getAttributeArray(arrayName);
+        if(nullptr != array)
+        {
+          bytes += static_cast<qint64>(array->getNumberOfTuples()) * array->getNumberOfComponents() * array->getTypeSize();
+        }
+      }
+    }
+  }
+  return bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineCostEstimator::Estimate PipelineCostEstimator::EstimatePipeline(const std::vector<AbstractFilter::Pointer>& filters, const FilterTimingStore* timingStore)
+{
+  Estimate estimate;
+  qint64 previousBytes = 0;
+  for(const AbstractFilter::Pointer& filter : filters)
+  {
+    // Disabled filters keep the data structure of an older preflight
+    if(!filter->getEnabled())
+    {
+      continue;
+    }
+
+    FilterCost cost;
+    cost.pipelineIndex = filter->getPipelineIndex();
+    cost.className = filter->getNameOfClass();
+    cost.humanLabel = filter->getHumanLabel();
+
+    // A filter whose preflight failed has no data structure; it is assumed to leave the data as it is
+    DataContainerArray::Pointer dca = filter->getDataContainerArray();
+    cost.dataBytes = (nullptr != dca) ? DataContainerArrayBytes(dca) : previousBytes;
+    cost.createdBytes = cost.dataBytes - previousBytes;
+    cost.workBytes = std::max(cost.dataBytes, previousBytes);
+    previousBytes = cost.dataBytes;
+
+    if(nullptr != timingStore)
+    {
+      cost.predictedMilliseconds = timingStore->predict(cost.className, cost.workBytes);
+    }
+    if(cost.predictedMilliseconds >= 0)
+    {
+      estimate.predictedMilliseconds += cost.predictedMilliseconds;
+    }
+    else
+    {
+      estimate.unpredictedFilters++;
+    }
+
+    // A filter holds its inputs while it creates its outputs, so the peak is the larger side of each filter
+    estimate.peakBytes = std::max(estimate.peakBytes, cost.workBytes);
+    estimate.filters.push_back(cost);
+  }
+  return estimate;
+}
@@ -0,0 +1,91 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+class FilterTimingStore;
+
+/**
+ * @brief The PipelineCostEstimator class predicts what a preflighted pipeline costs before it runs.  The preflight
+ * leaves every filter with the data structure as it is after that filter, with the tuple and component counts of
+ * each array but without allocating them.  The sizes of consecutive filters give the memory each filter adds and
+ * the peak of the pipeline; the runtimes come from the FilterTimingStore.
+ */
+class PipelineCostEstimator
+{
+public:
+  struct FilterCost
+  {
+    int pipelineIndex = 0;
+    QString className;
+    QString humanLabel;
+    qint64 createdBytes = 0;           // Negative if the filter removes more than it creates
+    qint64 dataBytes = 0;              // All arrays after the filter
+    qint64 workBytes = 0;              // The larger of the data before and after the filter
+    qint64 predictedMilliseconds = -1; // -1 if the filter never ran on this machine
+  };
+
+  struct Estimate
+  {
+    std::vector<FilterCost> filters; // Enabled filters only
+    qint64 peakBytes = 0;
+    qint64 predictedMilliseconds = 0; // The filters with a prediction
+    int unpredictedFilters = 0;
+  };
+
+  /**
+   * @brief Returns the bytes of all arrays of a data container array
+   * @param dca
+   * @return
+   */
+  static qint64 DataContainerArrayBytes(const DataContainerArray::Pointer& dca);
+
+  /**
+   * @brief Estimates the cost of a preflighted pipeline
+   * @param filters
+   * @param timingStore Predicts the runtimes; without it no runtime is predicted
+   * @return
+   */
+  static Estimate EstimatePipeline(const std::vector<AbstractFilter::Pointer>& filters, const FilterTimingStore* timingStore);
+
+  PipelineCostEstimator() = delete;
+};
@@ -0,0 +1,171 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineDelta.h"
+
+#include <QtCore/QJsonArray>
+
+#include "SIMPLib/Common/Constants.h"
+
+namespace
+{
+const QString k_Start("Start");
+const QString k_RemoveCount("RemoveCount");
+const QString k_Insert("Insert");
+const QString k_Builder("Builder");
+const QString k_Extra("Extra");
+
+// -----------------------------------------------------------------------------
+QJsonArray FilterList(const QJsonObject& pipeline)
+{
+  QJsonObject builder = pipeline[SIMPL::Settings::PipelineBuilderGroup].toObject();
+  int count = builder[SIMPL::Settings::NumFilters].toInt();
+
+  QJsonArray filters;
+  for(int i = 0; i < count; i++)
+  {
+    filters.append(pipeline[QString::number(i)]);
+  }
+  return filters;
+}
+
+// -----------------------------------------------------------------------------
+// Everything at the top level that is neither the builder nor a numbered filter
+// -----------------------------------------------------------------------------
+QJsonObject ExtraValues(const QJsonObject& pipeline)
+{
+  QJsonObject extra;
+  for(auto iter = pipeline.constBegin(); iter != pipeline.constEnd(); ++iter)
+  {
+    bool isFilterIndex = false;
+    iter.key().toInt(&isFilterIndex);
+    if(!isFilterIndex && iter.key() != SIMPL::Settings::PipelineBuilderGroup)
+    {
+      extra.insert(iter.key(), iter.value());
+    }
+  }
+  return extra;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineDelta::Create(const QJsonObject& from, const QJsonObject& to)
+{
+  QJsonArray fromFilters = FilterList(from);
+  QJsonArray toFilters = FilterList(to);
+  int fromCount = fromFilters.size();
+  int toCount = toFilters.size();
+
+  int prefix = 0;
+  while(prefix < fromCount && prefix < toCount && fromFilters.at(prefix) == toFilters.at(prefix))
+  {
+    prefix++;
+  }
+
+  int suffix = 0;
+  while(suffix < fromCount - prefix && suffix < toCount - prefix && fromFilters.at(fromCount - 1 - suffix) == toFilters.at(toCount - 1 - suffix))
+  {
+    suffix++;
+  }
+
+  QJsonArray inserted;
+  for(int i = prefix; i < toCount - suffix; i++)
+  {
+    inserted.append(toFilters.at(i));
+  }
+
+  QJsonObject delta;
+  delta[k_Start] = prefix;
+  delta[k_RemoveCount] = fromCount - prefix - suffix;
+  delta[k_Insert] = inserted;
+
+  QJsonValue toBuilder = to[SIMPL::Settings::PipelineBuilderGroup];
+  if(from[SIMPL::Settings::PipelineBuilderGroup] != toBuilder)
+  {
+    delta[k_Builder] = toBuilder;
+  }
+
+  QJsonObject toExtra = ExtraValues(to);
+  if(ExtraValues(from) != toExtra)
+  {
+    delta[k_Extra] = toExtra;
+  }
+
+  return delta;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineDelta::Apply(const QJsonObject& from, const QJsonObject& delta)
+{
+  QJsonArray filters = FilterList(from);
+
+  int start = delta[k_Start].toInt();
+  int removeCount = delta[k_RemoveCount].toInt();
+  for(int i = 0; i < removeCount && start < filters.size(); i++)
+  {
+    filters.removeAt(start);
+  }
+
+  QJsonArray inserted = delta[k_Insert].toArray();
+  for(int i = 0; i < inserted.size(); i++)
+  {
+    filters.insert(start + i, inserted.at(i));
+  }
+
+  QJsonObject pipeline = delta.contains(k_Extra) ? delta[k_Extra].toObject() : ExtraValues(from);
+
+  QJsonObject builder = delta.contains(k_Builder) ? delta[k_Builder].toObject() : from[SIMPL::Settings::PipelineBuilderGroup].toObject();
+  builder[SIMPL::Settings::NumFilters] = filters.size();
+  pipeline[SIMPL::Settings::PipelineBuilderGroup] = builder;
+
+  for(int i = 0; i < filters.size(); i++)
+  {
+    pipeline[QString::number(i)] = filters.at(i);
+  }
+
+  return pipeline;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineDelta::IsEmpty(const QJsonObject& delta)
+{
+  return delta[k_RemoveCount].toInt() == 0 && delta[k_Insert].toArray().isEmpty() && !delta.contains(k_Builder) && !delta.contains(k_Extra);
+}
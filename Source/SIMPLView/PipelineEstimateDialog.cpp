@@ -0,0 +1,132 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineEstimateDialog.h"
+
+#include <QtCore/QLocale>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+namespace
+{
+enum Column
+{
+  FilterColumn = 0,
+  CreatedColumn,
+  DataColumn,
+  TimeColumn,
+  ColumnCount
+};
+
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+// -----------------------------------------------------------------------------
+QString FormatSignedSize(const QLocale& locale, qint64 bytes)
+{
+  return bytes < 0 ? QString("-%1").arg(locale.formattedDataSize(-bytes)) : locale.formattedDataSize(bytes);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineEstimateDialog::PipelineEstimateDialog(const PipelineCostEstimator::Estimate& estimate, qint64 availableBytes, QWidget* parent)
+: QDialog(parent)
+{
+  setWindowTitle(tr("Pipeline Estimate"));
+  resize(640, 480);
+  QLocale locale;
+
+  QTreeWidget* filtersTree = new QTreeWidget(this);
+  filtersTree->setColumnCount(ColumnCount);
+  filtersTree->setHeaderLabels({tr("Filter"), tr("Creates"), tr("Data After"), tr("Predicted Time")});
+  filtersTree->setRootIsDecorated(false);
+  filtersTree->header()->setSectionResizeMode(FilterColumn, QHeaderView::Stretch);
+  for(const PipelineCostEstimator::FilterCost& cost : estimate.filters)
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(filtersTree);
+    item->setText(FilterColumn, QString("[%1] %2").arg(cost.pipelineIndex + 1).arg(cost.humanLabel));
+    item->setText(CreatedColumn, FormatSignedSize(locale, cost.createdBytes));
+    item->setText(DataColumn, locale.formattedDataSize(cost.dataBytes));
+    item->setText(TimeColumn, cost.predictedMilliseconds >= 0 ? FormatDuration(cost.predictedMilliseconds) : tr("Unknown"));
+    if(cost.predictedMilliseconds < 0)
+    {
+      item->setToolTip(TimeColumn, tr("This filter has not run on this machine yet."));
+    }
+    item->setTextAlignment(CreatedColumn, Qt::AlignRight | Qt::AlignVCenter);
+    item->setTextAlignment(DataColumn, Qt::AlignRight | Qt::AlignVCenter);
+    item->setTextAlignment(TimeColumn, Qt::AlignRight | Qt::AlignVCenter);
+  }
+
+  QString summary = tr("Peak memory: %1").arg(locale.formattedDataSize(estimate.peakBytes));
+  if(availableBytes > 0)
+  {
+    summary += tr(" of %1 available").arg(locale.formattedDataSize(availableBytes));
+  }
+  summary += "\n" + tr("Predicted runtime: %1").arg(FormatDuration(estimate.predictedMilliseconds));
+  if(estimate.unpredictedFilters > 0)
+  {
+    summary += " " + tr("plus %n filter(s) that have not run on this machine yet", "", estimate.unpredictedFilters);
+  }
+  QLabel* summaryLabel = new QLabel(summary, this);
+
+  QLabel* warningLabel = new QLabel(this);
+  warningLabel->setWordWrap(true);
+  warningLabel->setStyleSheet("QLabel { color: red; }");
+  warningLabel->setText(tr("The pipeline needs more memory than is available. It will probably be stopped by the system or slow down from swapping."));
+  warningLabel->setVisible(availableBytes > 0 && estimate.peakBytes > availableBytes);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+  connect(buttonBox, &QDialogButtonBox::rejected, this, &PipelineEstimateDialog::reject);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addWidget(filtersTree, 1);
+  layout->addWidget(summaryLabel);
+  layout->addWidget(warningLabel);
+  layout->addWidget(buttonBox);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineEstimateDialog::~PipelineEstimateDialog() = default;
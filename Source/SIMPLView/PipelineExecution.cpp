@@ -0,0 +1,401 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineExecution.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Messages/AbstractErrorMessage.h"
+
+#include "SIMPLView/FilterTimingRecorder.h"
+#include "SIMPLView/FilterTimingStore.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+QThreadPool* WriterThreadPool()
+{
+  // A single thread for all executions, so background writes do not compete with each other for the disk
+  static QThreadPool pool;
+  pool.setMaxThreadCount(1);
+  return &pool;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineExecution::PipelineExecution(const FilterPipeline::Pointer& pipeline, QObject* parent)
+: QObject(parent)
+, m_Pipeline(pipeline)
+{
+  m_WriteWatcher = new QFutureWatcher<void>(this);
+  connect(m_WriteWatcher, &QFutureWatcher<void>::finished, this, &PipelineExecution::writesDone);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineExecution::~PipelineExecution()
+{
+  if(m_Thread != nullptr)
+  {
+    m_RunningPipeline->cancel();
+    m_Thread->quit();
+    m_Thread->wait();
+  }
+
+  // The results were reported as computed, so they are written completely before the data goes away
+  if(m_Writing)
+  {
+    m_WriteWatcher->disconnect(this);
+    m_WriteWatcher->waitForFinished();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterPipeline::Pointer PipelineExecution::getPipeline() const
+{
+  return m_Pipeline;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::setDeferredWrites(bool deferred)
+{
+  m_DeferredWrites = deferred;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineExecution::getDeferredWrites() const
+{
+  return m_DeferredWrites;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::setTimingStore(FilterTimingStore* timingStore)
+{
+  m_TimingStore = timingStore;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const FilterTimingRecorder* PipelineExecution::getTimingRecorder() const
+{
+  return m_TimingRecorder.get();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::start()
+{
+  if(m_Running || m_Thread != nullptr || nullptr == m_Pipeline)
+  {
+    return;
+  }
+
+  m_Running = true;
+  m_Cancelled = false;
+  m_ErrorMessages.clear();
+  m_Timer.start();
+  m_RunningPipeline = m_DeferredWrites ? splitWriters() : m_Pipeline;
+  if(nullptr != m_TimingStore)
+  {
+    // The data sizes come from the preflight, before the run replaces the data structures of the filters
+    auto filterContainer = m_RunningPipeline->getFilterContainer();
+    m_TimingRecorder = std::make_unique<FilterTimingRecorder>(std::vector<AbstractFilter::Pointer>(filterContainer.cbegin(), filterContainer.cend()));
+  }
+  else
+  {
+    // Without a recorder the run still counts as activity for the recorders of other runs
+    m_Activity = std::make_unique<ProcessActivity::Scope>();
+  }
+
+  // Same threading as the pipeline view uses for its runs
+  m_Thread = new QThread(this);
+  m_RunningPipeline->moveToThread(m_Thread);
+  connect(m_Thread, SIGNAL(started()), m_RunningPipeline.get(), SLOT(run()));
+  connect(m_RunningPipeline.get(), SIGNAL(pipelineFinished()), m_Thread, SLOT(quit()));
+  connect(m_RunningPipeline.get(), &FilterPipeline::pipelineGeneratedMessage, this, &PipelineExecution::processMessage);
+  connect(m_Thread, &QThread::finished, this, &PipelineExecution::threadFinished);
+  m_Thread->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::cancel()
+{
+  if(m_Writing)
+  {
+    m_Cancelled = true;
+    for(const AbstractFilter::Pointer& writer : m_WriterFilters)
+    {
+      writer->setCancel(true);
+    }
+    return;
+  }
+  if(!m_Running)
+  {
+    return;
+  }
+  m_Cancelled = true;
+  m_RunningPipeline->cancel();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineExecution::isRunning() const
+{
+  return m_Running;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineExecution::wasCancelled() const
+{
+  return m_Cancelled;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList PipelineExecution::getErrorMessages() const
+{
+  return m_ErrorMessages;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineExecution::getElapsedMilliseconds() const
+{
+  return m_Running ? m_Timer.elapsed() : m_ElapsedMilliseconds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineExecution::isWriting() const
+{
+  return m_Writing;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList PipelineExecution::getWriteErrorMessages() const
+{
+  return m_WriteErrorMessages;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineExecution::getWriteMilliseconds() const
+{
+  return m_Writing ? m_WriteTimer.elapsed() : m_WriteMilliseconds;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::processMessage(const AbstractMessage::Pointer& msg)
+{
+  std::shared_ptr<AbstractErrorMessage> errorMessage = std::dynamic_pointer_cast<AbstractErrorMessage>(msg);
+  if(nullptr != errorMessage)
+  {
+    m_ErrorMessages.push_back(errorMessage->generateMessageString());
+  }
+  if(nullptr != m_TimingRecorder)
+  {
+    m_TimingRecorder->processMessage(msg);
+  }
+
+  Q_EMIT pipelineMessage(msg);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::threadFinished()
+{
+  m_ElapsedMilliseconds = m_Timer.elapsed();
+  m_Running = false;
+  m_Thread->deleteLater();
+  m_Thread = nullptr;
+  m_Activity.reset();
+  if(nullptr != m_TimingRecorder)
+  {
+    m_TimingRecorder->finish(m_TimingStore, !m_Cancelled);
+  }
+
+  // The writers only get data that was computed completely
+  if(!m_WriterFilters.empty() && !m_Cancelled && m_ErrorMessages.isEmpty())
+  {
+    startWrites();
+  }
+
+  Q_EMIT finished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterPipeline::Pointer PipelineExecution::splitWriters()
+{
+  m_WriterFilters.clear();
+  auto filterContainer = m_Pipeline->getFilterContainer();
+  std::vector<AbstractFilter::Pointer> filters(filterContainer.cbegin(), filterContainer.cend());
+
+  // The writers are the output filters after the last enabled filter that is not one
+  size_t split = filters.size();
+  bool hasWriter = false;
+  while(split > 0 && (!filters[split - 1]->getEnabled() || filters[split - 1]->getSubGroupName() == SIMPL::FilterSubGroups::OutputFilters))
+  {
+    hasWriter = hasWriter || filters[split - 1]->getEnabled();
+    split--;
+  }
+  if(split == 0 || !hasWriter)
+  {
+    return m_Pipeline;
+  }
+
+  FilterPipeline::Pointer computePipeline = FilterPipeline::New();
+  computePipeline->setName(m_Pipeline->getName());
+  for(size_t i = 0; i < split; i++)
+  {
+    computePipeline->pushBack(filters[i]);
+  }
+  for(size_t i = split; i < filters.size(); i++)
+  {
+    if(filters[i]->getEnabled())
+    {
+      m_WriterFilters.push_back(filters[i]);
+    }
+  }
+  return computePipeline;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::startWrites()
+{
+  // Disabled filters keep the data container array of the preflight, so the data comes from the last enabled one
+  auto filterContainer = m_RunningPipeline->getFilterContainer();
+  auto last = std::find_if(filterContainer.crbegin(), filterContainer.crend(), [](const AbstractFilter::Pointer& filter) { return filter->getEnabled(); });
+  DataContainerArray::Pointer dca = (last != filterContainer.crend()) ? (*last)->getDataContainerArray() : DataContainerArray::NullPointer();
+  if(nullptr == dca)
+  {
+    m_ErrorMessages.push_back(tr("The computed data could not be handed to the output filters."));
+    return;
+  }
+
+  m_Writing = true;
+  m_WriteErrorMessages.clear();
+  m_WriteTimer.start();
+  for(const AbstractFilter::Pointer& writer : m_WriterFilters)
+  {
+    connect(writer.get(), &AbstractFilter::messageGenerated, this, &PipelineExecution::processWriteMessage);
+  }
+
+  std::vector<AbstractFilter::Pointer> writers = m_WriterFilters;
+  m_WriteWatcher->setFuture(QtConcurrent::run(WriterThreadPool(), [writers, dca] {
+    ProcessActivity::Scope activity;
+    for(const AbstractFilter::Pointer& writer : writers)
+    {
+      writer->setDataContainerArray(dca);
+      writer->execute();
+      if(writer->getErrorCode() < 0 || writer->getCancel())
+      {
+        break;
+      }
+    }
+  }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::processWriteMessage(const AbstractMessage::Pointer& msg)
+{
+  std::shared_ptr<AbstractErrorMessage> errorMessage = std::dynamic_pointer_cast<AbstractErrorMessage>(msg);
+  if(nullptr != errorMessage)
+  {
+    m_WriteErrorMessages.push_back(errorMessage->generateMessageString());
+  }
+
+  Q_EMIT pipelineMessage(msg);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineExecution::writesDone()
+{
+  m_WriteMilliseconds = m_WriteTimer.elapsed();
+  m_Writing = false;
+
+  // A writer can fail without generating an error message
+  for(const AbstractFilter::Pointer& writer : m_WriterFilters)
+  {
+    disconnect(writer.get(), nullptr, this, nullptr);
+    if(writer->getErrorCode() < 0 && m_WriteErrorMessages.isEmpty())
+    {
+      m_WriteErrorMessages.push_back(tr("%1 failed with error %2.").arg(writer->getHumanLabel()).arg(writer->getErrorCode()));
+    }
+  }
+
+  Q_EMIT writesFinished();
+}
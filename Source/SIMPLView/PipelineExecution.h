@@ -0,0 +1,231 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/Filtering/FilterPipeline.h"
+#include "SIMPLib/Messages/AbstractMessage.h"
+
+#include "SIMPLView/ProcessActivity.h"
+
+class FilterTimingRecorder;
+class FilterTimingStore;
+class QThread;
+
+/**
+ * @brief The PipelineExecution class runs a FilterPipeline that is not shown in a pipeline view on its own thread,
+ * the same way SVPipelineView runs the pipeline of a window.  Error messages are collected so the owner can report
+ * them once the run is done.
+ *
+ * With deferred writes the output filters at the end of the pipeline run on a shared background I/O thread after
+ * the rest of the pipeline is done.  No filter changes the data after that point, so the writers use the data
+ * of the pipeline as it is.  finished() is then emitted once the data is computed and writesFinished() once the
+ * writers are done.
+ */
+class PipelineExecution : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineExecution(const FilterPipeline::Pointer& pipeline, QObject* parent = nullptr);
+
+  /**
+   * @brief Cancels a running pipeline and waits for its thread
+   */
+  ~PipelineExecution() override;
+
+  /**
+   * @brief Returns the pipeline being run
+   * @return
+   */
+  FilterPipeline::Pointer getPipeline() const;
+
+  /**
+   * @brief Sets whether the output filters at the end of the pipeline run in the background.  Must be called
+   * before start().
+   * @param deferred
+   */
+  void setDeferredWrites(bool deferred);
+  bool getDeferredWrites() const;
+
+  /**
+   * @brief Sets the store the runtimes of the filters are added to once the run ended.  Without one nothing is
+   * recorded.  Must be called before start().
+   * @param timingStore
+   */
+  void setTimingStore(FilterTimingStore* timingStore);
+
+  /**
+   * @brief Returns the recorder that measured the filters of the run, or nullptr without a timing store
+   * @return
+   */
+  const FilterTimingRecorder* getTimingRecorder() const;
+
+  /**
+   * @brief Starts the run.  An execution can only be started once.
+   */
+  void start();
+
+  /**
+   * @brief Asks the running filter to stop
+   */
+  void cancel();
+
+  /**
+   * @brief Returns true between start() and finished()
+   * @return
+   */
+  bool isRunning() const;
+
+  /**
+   * @brief Returns true if cancel() was called before the run ended
+   * @return
+   */
+  bool wasCancelled() const;
+
+  /**
+   * @brief Returns the error messages generated by the filters
+   * @return
+   */
+  QStringList getErrorMessages() const;
+
+  /**
+   * @brief Returns the wall time of the run so far, or of the whole run once it is done
+   * @return
+   */
+  qint64 getElapsedMilliseconds() const;
+
+  /**
+   * @brief Returns true between finished() and writesFinished() while the deferred writers run
+   * @return
+   */
+  bool isWriting() const;
+
+  /**
+   * @brief Returns the error messages of the deferred writers
+   * @return
+   */
+  QStringList getWriteErrorMessages() const;
+
+  /**
+   * @brief Returns the wall time of the deferred writers
+   * @return
+   */
+  qint64 getWriteMilliseconds() const;
+
+Q_SIGNALS:
+  /**
+   * @brief Emitted on the thread of this object for every message of the pipeline, including the deferred writers
+   * @param msg
+   */
+  void pipelineMessage(const AbstractMessage::Pointer& msg);
+
+  /**
+   * @brief Emitted once the run ended, whether it succeeded, failed or was cancelled
+   */
+  void finished();
+
+  /**
+   * @brief Emitted once the deferred writers ended.  Not emitted if nothing was deferred.
+   */
+  void writesFinished();
+
+private:
+  FilterPipeline::Pointer m_Pipeline;
+  FilterPipeline::Pointer m_RunningPipeline;
+  bool m_DeferredWrites = false;
+  std::vector<AbstractFilter::Pointer> m_WriterFilters;
+  QFutureWatcher<void>* m_WriteWatcher = nullptr;
+  QElapsedTimer m_WriteTimer;
+  qint64 m_WriteMilliseconds = 0;
+  bool m_Writing = false;
+  QStringList m_WriteErrorMessages;
+  QThread* m_Thread = nullptr;
+  QElapsedTimer m_Timer;
+  qint64 m_ElapsedMilliseconds = 0;
+  bool m_Running = false;
+  bool m_Cancelled = false;
+  QStringList m_ErrorMessages;
+  FilterTimingStore* m_TimingStore = nullptr;
+  std::unique_ptr<FilterTimingRecorder> m_TimingRecorder;
+  std::unique_ptr<ProcessActivity::Scope> m_Activity;
+
+  /**
+   * @brief Records error messages and forwards every message
+   * @param msg
+   */
+  void processMessage(const AbstractMessage::Pointer& msg);
+
+  /**
+   * @brief Cleans up once the thread is done
+   */
+  void threadFinished();
+
+  /**
+   * @brief Splits the output filters at the end of the pipeline off into m_WriterFilters
+   * @return The pipeline that computes the data
+   */
+  FilterPipeline::Pointer splitWriters();
+
+  /**
+   * @brief Runs the writers on the I/O thread
+   */
+  void startWrites();
+
+  /**
+   * @brief Records the error messages of the writers and forwards every message
+   * @param msg
+   */
+  void processWriteMessage(const AbstractMessage::Pointer& msg);
+
+  /**
+   * @brief Collects the errors of the writers once they are done
+   */
+  void writesDone();
+
+public:
+  PipelineExecution(const PipelineExecution&) = delete;            // Copy Constructor Not Implemented
+  PipelineExecution(PipelineExecution&&) = delete;                 // Move Constructor Not Implemented
+  PipelineExecution& operator=(const PipelineExecution&) = delete; // Copy Assignment Not Implemented
+  PipelineExecution& operator=(PipelineExecution&&) = delete;      // Move Assignment Not Implemented
+};
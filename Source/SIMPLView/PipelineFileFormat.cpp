@@ -0,0 +1,225 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineFileFormat.h"
+
+#include <QtCore/QCborValue>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+
+#if defined(Q_OS_WIN)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+// The encoding of the self-describe tag (55799) that starts every CBOR pipeline file
+const char k_CborSignature[] = {'\xd9', '\xd9', '\xf7'};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineFileFormat::Format PipelineFileFormat::FormatFromFilePath(const QString& filePath)
+{
+  if(QFileInfo(filePath).suffix().compare(CborSuffix, Qt::CaseInsensitive) == 0)
+  {
+    return Format::Cbor;
+  }
+  return Format::Json;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileFormat::IsCbor(const QByteArray& data)
+{
+  return data.startsWith(QByteArray::fromRawData(k_CborSignature, sizeof(k_CborSignature)));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray PipelineFileFormat::ToCbor(const QJsonObject& pipeline)
+{
+  // Integral numbers become CBOR integers and the float options only shrink values that convert back exactly,
+  // so toJsonValue restores the original doubles
+  QCborValue value(QCborKnownTags::Signature, QCborValue::fromJsonValue(pipeline));
+  return value.toCbor(QCborValue::UseFloat | QCborValue::UseFloat16);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileFormat::FromCbor(const QByteArray& data, QJsonObject& pipeline, QString& errorMessage)
+{
+  QCborParserError parserError;
+  QCborValue value = QCborValue::fromCbor(data, &parserError);
+  if(parserError.error != QCborError::NoError)
+  {
+    errorMessage = QString("Unable to parse the CBOR pipeline at offset %1: %2").arg(parserError.offset).arg(parserError.errorString());
+    return false;
+  }
+
+  if(value.isTag() && value.tag() == QCborTag(QCborKnownTags::Signature))
+  {
+    value = value.taggedValue();
+  }
+
+  if(!value.isMap())
+  {
+    errorMessage = "The CBOR document does not contain a pipeline";
+    return false;
+  }
+
+  pipeline = value.toJsonValue().toObject();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray PipelineFileFormat::ToJson(const QJsonObject& pipeline)
+{
+  return QJsonDocument(pipeline).toJson(QJsonDocument::Indented);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileFormat::FromJson(const QByteArray& data, QJsonObject& pipeline, QString& errorMessage)
+{
+  QJsonParseError parseError;
+  QJsonDocument document = QJsonDocument::fromJson(data, &parseError);
+  if(parseError.error != QJsonParseError::NoError)
+  {
+    errorMessage = QString("Unable to parse the JSON pipeline at offset %1: %2").arg(parseError.offset).arg(parseError.errorString());
+    return false;
+  }
+
+  if(!document.isObject())
+  {
+    errorMessage = "The JSON document does not contain a pipeline";
+    return false;
+  }
+
+  pipeline = document.object();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QByteArray PipelineFileFormat::Encode(const QJsonObject& pipeline, Format format)
+{
+  return format == Format::Cbor ? ToCbor(pipeline) : ToJson(pipeline);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileFormat::Decode(const QByteArray& data, QJsonObject& pipeline, QString& errorMessage)
+{
+  return IsCbor(data) ? FromCbor(data, pipeline, errorMessage) : FromJson(data, pipeline, errorMessage);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileFormat::ReadFile(const QString& filePath, QJsonObject& pipeline, QString& errorMessage)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    errorMessage = QString("Unable to open '%1' for reading: %2").arg(filePath, file.errorString());
+    return false;
+  }
+
+  return Decode(file.readAll(), pipeline, errorMessage);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileFormat::WriteFileAtomically(const QString& filePath, const QByteArray& data, QString& errorMessage)
+{
+  // QSaveFile writes to a temporary file in the same directory and renames it over the destination on commit
+  QSaveFile file(filePath);
+  if(!file.open(QIODevice::WriteOnly))
+  {
+    errorMessage = QString("Unable to open '%1' for writing: %2").arg(filePath, file.errorString());
+    return false;
+  }
+
+  if(file.write(data) != data.size() || !file.flush())
+  {
+    errorMessage = QString("Unable to write '%1': %2").arg(filePath, file.errorString());
+    file.cancelWriting();
+    return false;
+  }
+
+  // Make sure the data is on disk before the rename makes it visible
+#if defined(Q_OS_WIN)
+  int syncErr = _commit(file.handle());
+#else
+  int syncErr = fsync(file.handle());
+#endif
+  if(syncErr != 0)
+  {
+    errorMessage = QString("Unable to flush '%1' to disk").arg(filePath);
+    file.cancelWriting();
+    return false;
+  }
+
+  if(!file.commit())
+  {
+    errorMessage = QString("Unable to replace '%1': %2").arg(filePath, file.errorString());
+    return false;
+  }
+
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileFormat::WriteFile(const QString& filePath, const QJsonObject& pipeline, QString& errorMessage)
+{
+  return WriteFileAtomically(filePath, Encode(pipeline, FormatFromFilePath(filePath)), errorMessage);
+}
@@ -0,0 +1,151 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+/**
+ * @brief The PipelineFileFormat namespace reads and writes pipeline files in either the JSON form produced by
+ * FilterPipeline::toJson or a compact binary CBOR encoding of the same document.  CBOR files start with the
+ * self-describe tag, so they are recognized by their content as well as by their suffix.  Converting a pipeline
+ * to CBOR and back gives the same QJsonObject.
+ *
+ * This file only depends on QtCore so the command line converter and benchmark can build it directly.
+ */
+namespace PipelineFileFormat
+{
+enum class Format
+{
+  Json,
+  Cbor
+};
+
+static const QString JsonSuffix("json");
+static const QString CborSuffix("cbor");
+
+/**
+ * @brief Returns the format used for a file with the given path, based on its suffix
+ * @param filePath
+ * @return
+ */
+Format FormatFromFilePath(const QString& filePath);
+
+/**
+ * @brief Returns true if the data starts with the CBOR self-describe tag
+ * @param data
+ * @return
+ */
+bool IsCbor(const QByteArray& data);
+
+/**
+ * @brief Encodes the pipeline as CBOR
+ * @param pipeline
+ * @return
+ */
+QByteArray ToCbor(const QJsonObject& pipeline);
+
+/**
+ * @brief Decodes a pipeline encoded by ToCbor
+ * @param data
+ * @param pipeline
+ * @param errorMessage
+ * @return
+ */
+bool FromCbor(const QByteArray& data, QJsonObject& pipeline, QString& errorMessage);
+
+/**
+ * @brief Encodes the pipeline as indented JSON
+ * @param pipeline
+ * @return
+ */
+QByteArray ToJson(const QJsonObject& pipeline);
+
+/**
+ * @brief Decodes a JSON pipeline
+ * @param data
+ * @param pipeline
+ * @param errorMessage
+ * @return
+ */
+bool FromJson(const QByteArray& data, QJsonObject& pipeline, QString& errorMessage);
+
+/**
+ * @brief Encodes the pipeline in the given format
+ * @param pipeline
+ * @param format
+ * @return
+ */
+QByteArray Encode(const QJsonObject& pipeline, Format format);
+
+/**
+ * @brief Decodes a pipeline in either format, detected from the content
+ * @param data
+ * @param pipeline
+ * @param errorMessage
+ * @return
+ */
+bool Decode(const QByteArray& data, QJsonObject& pipeline, QString& errorMessage);
+
+/**
+ * @brief Reads a pipeline file in either format
+ * @param filePath
+ * @param pipeline
+ * @param errorMessage
+ * @return
+ */
+bool ReadFile(const QString& filePath, QJsonObject& pipeline, QString& errorMessage);
+
+/**
+ * @brief Writes data to a temporary file next to filePath, flushes it to disk and renames it over filePath, so the
+ * destination holds either the old or the new contents even if writing fails part way
+ * @param filePath
+ * @param data
+ * @param errorMessage
+ * @return
+ */
+bool WriteFileAtomically(const QString& filePath, const QByteArray& data, QString& errorMessage);
+
+/**
+ * @brief Writes a pipeline file atomically in the format selected by the file's suffix
+ * @param filePath
+ * @param pipeline
+ * @param errorMessage
+ * @return
+ */
+bool WriteFile(const QString& filePath, const QJsonObject& pipeline, QString& errorMessage);
+} // namespace PipelineFileFormat
@@ -0,0 +1,600 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineFileLoader.h"
+
+#include <map>
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QBuffer>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QThread>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/CoreFilters/EmptyFilter.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+
+#include "SIMPLView/DREAM3DPipelineReader.h"
+#include "SIMPLView/PipelineFileFormat.h"
+
+namespace
+{
+const qint64 k_ChunkSize = 1024 * 1024;
+const size_t k_BatchSize = 64;
+const QString k_DREAM3DSuffix("dream3d");
+
+/**
+ * @brief The JsonMemberScanner class splits a JSON object that arrives in chunks into its top level members
+ * without building a DOM.  Each member's value is returned as raw bytes as soon as it is complete.
+ */
+class JsonMemberScanner
+{
+public:
+  using Member = std::pair<QString, QByteArray>;
+
+  void append(const QByteArray& chunk)
+  {
+    m_Buffer.append(chunk);
+  }
+
+  /**
+   * @brief Scans the bytes appended so far and returns the members that were completed
+   * @return
+   */
+  std::vector<Member> takeMembers()
+  {
+    std::vector<Member> members;
+
+    for(; m_Pos < m_Buffer.size() && !m_Done && !m_Error; m_Pos++)
+    {
+      char c = m_Buffer[m_Pos];
+      if(m_InString)
+      {
+        if(m_Escaped)
+        {
+          m_Escaped = false;
+        }
+        else if(c == '\\')
+        {
+          m_Escaped = true;
+        }
+        else if(c == '"')
+        {
+          m_InString = false;
+          if(m_Depth == 1 && m_Phase == Phase::Key)
+          {
+            m_KeyEnd = m_Pos;
+            m_Phase = Phase::Colon;
+          }
+        }
+        continue;
+      }
+
+      switch(c)
+      {
+      case '"':
+        m_InString = true;
+        if(m_Depth == 1 && m_Phase == Phase::Key)
+        {
+          m_KeyStart = m_Pos + 1;
+        }
+        break;
+      case '{':
+      case '[':
+        if(m_Depth == 0)
+        {
+          if(c != '{')
+          {
+            m_Error = true;
+            break;
+          }
+          m_Phase = Phase::Key;
+        }
+        m_Depth++;
+        break;
+      case '}':
+      case ']':
+        m_Depth--;
+        if(m_Depth < 0)
+        {
+          m_Error = true;
+        }
+        else if(m_Depth == 0)
+        {
+          if(m_Phase == Phase::Value)
+          {
+            members.push_back(takeMember());
+          }
+          m_Done = true;
+        }
+        break;
+      case ':':
+        if(m_Depth == 1 && m_Phase == Phase::Colon)
+        {
+          m_ValueStart = m_Pos + 1;
+          m_Phase = Phase::Value;
+        }
+        break;
+      case ',':
+        if(m_Depth == 1 && m_Phase == Phase::Value)
+        {
+          members.push_back(takeMember());
+          m_Phase = Phase::Key;
+        }
+        break;
+      default:
+        break;
+      }
+    }
+
+    return members;
+  }
+
+  /**
+   * @brief Returns true once the closing brace of the top level object was found
+   * @return
+   */
+  bool isDone() const
+  {
+    return m_Done;
+  }
+
+  /**
+   * @brief Returns true if the data is not a JSON object
+   * @return
+   */
+  bool hasError() const
+  {
+    return m_Error;
+  }
+
+private:
+  enum class Phase
+  {
+    Key,
+    Colon,
+    Value
+  };
+
+  QByteArray m_Buffer;
+  int m_Pos = 0;
+  int m_Depth = 0;
+  bool m_InString = false;
+  bool m_Escaped = false;
+  bool m_Done = false;
+  bool m_Error = false;
+  Phase m_Phase = Phase::Key;
+  int m_KeyStart = 0;
+  int m_KeyEnd = 0;
+  int m_ValueStart = 0;
+
+  /**
+   * @brief Extracts the member that ends at the current position and drops the bytes before it
+   * @return
+   */
+  Member takeMember()
+  {
+    Member member(QString::fromUtf8(m_Buffer.mid(m_KeyStart, m_KeyEnd - m_KeyStart)), m_Buffer.mid(m_ValueStart, m_Pos - m_ValueStart));
+
+    // The separator at m_Pos becomes the first byte of the buffer and is skipped by the scanning loop
+    m_Buffer.remove(0, m_Pos);
+    m_Pos = 0;
+    m_KeyStart = 0;
+    m_KeyEnd = 0;
+    m_ValueStart = 0;
+    return member;
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineFileLoader::PipelineFileLoader(QObject* parent)
+: QObject(parent)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineFileLoader::~PipelineFileLoader()
+{
+  // The worker posts back to this object, so it has to be gone before this object is
+  cancel();
+  m_Future.waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileLoader::CanLoad(const QString& filePath)
+{
+  QString suffix = QFileInfo(filePath).suffix();
+  return suffix.compare(PipelineFileFormat::JsonSuffix, Qt::CaseInsensitive) == 0 || suffix.compare(PipelineFileFormat::CborSuffix, Qt::CaseInsensitive) == 0 ||
+         suffix.compare(k_DREAM3DSuffix, Qt::CaseInsensitive) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileLoader::load(const QString& filePath)
+{
+  cancel();
+  m_Future.waitForFinished();
+
+  m_FilePath = filePath;
+  m_FilterCount = 0;
+  m_ExtraMembers = QJsonObject();
+  m_Loading = true;
+  m_Cancelled = std::make_shared<std::atomic_bool>(false);
+
+  QSet<QUuid> guiThreadUuids;
+#ifdef SIMPL_EMBED_PYTHON
+  // Python filters are created by the interpreter, which is only used from the GUI thread
+  guiThreadUuids = FilterManager::Instance()->pythonFilterUuids();
+#endif
+
+  std::shared_ptr<std::atomic_bool> cancelled = m_Cancelled;
+
+  // Only the pipeline attribute of a .dream3d file is read, which takes the same short time whatever the size of the
+  // file.  It is read here because HDF5 is also used from the GUI thread and may not be built thread safe.
+  QByteArray contents;
+  if(QFileInfo(filePath).suffix().compare(k_DREAM3DSuffix, Qt::CaseInsensitive) == 0)
+  {
+    QString errorMessage;
+    if(!DREAM3DPipelineReader::ReadPipelineJson(filePath, contents, errorMessage))
+    {
+      postToGuiThread(cancelled, [this] { loadFinished(-3); });
+      return;
+    }
+  }
+
+  m_Future = QtConcurrent::run([this, filePath, contents, cancelled, guiThreadUuids] { readFile(filePath, contents, cancelled, guiThreadUuids); });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileLoader::cancel()
+{
+  if(m_Cancelled != nullptr)
+  {
+    *m_Cancelled = true;
+  }
+  m_Loading = false;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileLoader::isLoading() const
+{
+  return m_Loading;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineFileLoader::getFilePath() const
+{
+  return m_FilePath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineFileLoader::getExtraMembers() const
+{
+  return m_ExtraMembers;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileLoader::readFile(const QString& filePath, const QByteArray& contents, const std::shared_ptr<std::atomic_bool>& cancelled, const QSet<QUuid>& guiThreadUuids)
+{
+  // Contents that were already extracted from a container file are read the same way as a file on disk
+  std::unique_ptr<QIODevice> device;
+  if(contents.isNull())
+  {
+    device = std::make_unique<QFile>(filePath);
+  }
+  else
+  {
+    QBuffer* buffer = new QBuffer();
+    buffer->setData(contents);
+    device.reset(buffer);
+  }
+
+  QIODevice& file = *device;
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    postToGuiThread(cancelled, [this] { loadFinished(-1); });
+    return;
+  }
+
+  // Filters are stored under their index, but the keys are usually sorted as strings ("0", "1", "10", ...), so
+  // they are held back until every filter before them has been read
+  std::map<int, FilterSource> pendingFilters;
+  std::vector<FilterSource> batch;
+  int nextIndex = 0;
+  int numFilters = -1;
+
+  auto flushBatch = [&] {
+    if(batch.empty())
+    {
+      return;
+    }
+
+    std::vector<LoadedFilter> loadedFilters(batch.size());
+    std::vector<size_t> indices(batch.size());
+    for(size_t i = 0; i < indices.size(); i++)
+    {
+      indices[i] = i;
+    }
+    QtConcurrent::blockingMap(indices, [&](size_t& i) { loadedFilters[i] = CreateFilter(batch[i], guiThreadUuids); });
+    batch.clear();
+
+    postToGuiThread(cancelled, [this, loadedFilters]() mutable { deliverBatch(loadedFilters); });
+  };
+
+  // Top level objects that are neither filters nor the PipelineBuilder are handed to the window as they are
+  QJsonObject extraMembers;
+
+  auto addFilterSource = [&](const QString& key, const FilterSource& source) {
+    bool ok = false;
+    int index = key.toInt(&ok);
+    if(ok && index >= nextIndex)
+    {
+      pendingFilters[index] = source;
+    }
+    else if(!ok)
+    {
+      extraMembers[key] = source.json.isEmpty() ? source.object : QJsonDocument::fromJson(source.json).object();
+    }
+  };
+
+  auto takeReadyFilters = [&] {
+    while(!pendingFilters.empty() && pendingFilters.begin()->first == nextIndex)
+    {
+      batch.push_back(pendingFilters.begin()->second);
+      pendingFilters.erase(pendingFilters.begin());
+      nextIndex++;
+      if(batch.size() >= k_BatchSize)
+      {
+        flushBatch();
+      }
+    }
+
+    // Whatever is ready is shown right away
+    flushBatch();
+  };
+
+  QByteArray firstChunk = file.read(k_ChunkSize);
+  if(PipelineFileFormat::IsCbor(firstChunk))
+  {
+    // CBOR is decoded in one pass; it is compact and cheap to parse compared to JSON
+    QJsonObject pipeline;
+    QString errorMessage;
+    if(!PipelineFileFormat::FromCbor(firstChunk + file.readAll(), pipeline, errorMessage))
+    {
+      postToGuiThread(cancelled, [this] { loadFinished(-2); });
+      return;
+    }
+
+    numFilters = pipeline[SIMPL::Settings::PipelineBuilderGroup].toObject()[SIMPL::Settings::NumFilters].toInt(-1);
+    for(auto iter = pipeline.constBegin(); iter != pipeline.constEnd(); ++iter)
+    {
+      if(iter.value().isObject() && iter.key() != SIMPL::Settings::PipelineBuilderGroup)
+      {
+        addFilterSource(iter.key(), FilterSource{QByteArray(), iter.value().toObject()});
+      }
+    }
+    takeReadyFilters();
+  }
+  else
+  {
+    JsonMemberScanner scanner;
+    scanner.append(firstChunk);
+    while(!*cancelled)
+    {
+      for(const JsonMemberScanner::Member& member : scanner.takeMembers())
+      {
+        if(member.first == SIMPL::Settings::PipelineBuilderGroup)
+        {
+          QJsonObject builder = QJsonDocument::fromJson(member.second).object();
+          numFilters = builder[SIMPL::Settings::NumFilters].toInt(-1);
+          continue;
+        }
+        addFilterSource(member.first, FilterSource{member.second, QJsonObject()});
+      }
+      takeReadyFilters();
+
+      if(file.atEnd() || scanner.isDone() || scanner.hasError())
+      {
+        break;
+      }
+      scanner.append(file.read(k_ChunkSize));
+    }
+
+    if(!*cancelled && (!scanner.isDone() || scanner.hasError()))
+    {
+      postToGuiThread(cancelled, [this] { loadFinished(-2); });
+      return;
+    }
+  }
+
+  if(*cancelled)
+  {
+    return;
+  }
+
+  // Indices that were skipped in the file are skipped here too
+  for(const auto& pendingFilter : pendingFilters)
+  {
+    if(numFilters >= 0 && pendingFilter.first >= numFilters)
+    {
+      break;
+    }
+    batch.push_back(pendingFilter.second);
+    if(batch.size() >= k_BatchSize)
+    {
+      flushBatch();
+    }
+  }
+  flushBatch();
+
+  postToGuiThread(cancelled, [this, extraMembers] {
+    m_ExtraMembers = extraMembers;
+    loadFinished(0);
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineFileLoader::LoadedFilter PipelineFileLoader::CreateFilter(const FilterSource& source, const QSet<QUuid>& guiThreadUuids)
+{
+  LoadedFilter loadedFilter;
+  loadedFilter.json = source.json.isEmpty() ? source.object : QJsonDocument::fromJson(source.json).object();
+
+  QUuid uuid(loadedFilter.json[SIMPL::Settings::FilterUuid].toString());
+  if(!uuid.isNull() && guiThreadUuids.contains(uuid))
+  {
+    return loadedFilter;
+  }
+
+  loadedFilter.filter = InstantiateFilter(loadedFilter.json);
+  loadedFilter.json = QJsonObject();
+
+  // The filter was created on a pool thread, but it is owned by the pipeline model on the GUI thread
+  if(loadedFilter.filter != nullptr)
+  {
+    loadedFilter.filter->moveToThread(QCoreApplication::instance()->thread());
+  }
+  return loadedFilter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer PipelineFileLoader::InstantiateFilter(QJsonObject& json)
+{
+  FilterManager* filterManager = FilterManager::Instance();
+
+  IFilterFactory::Pointer factory = filterManager->getFactoryFromUuid(QUuid(json[SIMPL::Settings::FilterUuid].toString()));
+  if(factory == nullptr)
+  {
+    factory = filterManager->getFactoryFromClassName(json[SIMPL::Settings::FilterName].toString());
+  }
+
+  if(factory == nullptr)
+  {
+    // Keep a placeholder so the pipeline can still be saved without losing the filter
+    EmptyFilter::Pointer emptyFilter = EmptyFilter::New();
+    emptyFilter->setOriginalFilterName(json[SIMPL::Settings::FilterName].toString());
+    return emptyFilter;
+  }
+
+  AbstractFilter::Pointer filter = factory->create();
+  if(filter == nullptr)
+  {
+    return filter;
+  }
+
+  filter->readFilterParameters(json);
+  filter->setEnabled(json[SIMPL::Settings::FilterEnabled].toBool(true));
+  return filter;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileLoader::deliverBatch(std::vector<LoadedFilter>& batch)
+{
+  std::vector<AbstractFilter::Pointer> filters;
+  filters.reserve(batch.size());
+  for(LoadedFilter& loadedFilter : batch)
+  {
+    AbstractFilter::Pointer filter = loadedFilter.filter;
+    if(filter == nullptr && !loadedFilter.json.isEmpty())
+    {
+      filter = InstantiateFilter(loadedFilter.json);
+    }
+
+    if(filter != nullptr)
+    {
+      filters.push_back(filter);
+    }
+  }
+
+  if(filters.empty())
+  {
+    return;
+  }
+
+  m_FilterCount += static_cast<int>(filters.size());
+  Q_EMIT filtersLoaded(filters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileLoader::loadFinished(int err)
+{
+  m_Loading = false;
+  Q_EMIT finished(err, m_FilterCount);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileLoader::postToGuiThread(const std::shared_ptr<std::atomic_bool>& cancelled, std::function<void()> function)
+{
+  QMetaObject::invokeMethod(
+      this,
+      [cancelled, function] {
+        if(!*cancelled)
+        {
+          function();
+        }
+      },
+      Qt::QueuedConnection);
+}
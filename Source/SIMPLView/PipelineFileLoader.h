@@ -0,0 +1,194 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QFuture>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+#include "SIMPLib/Filtering/AbstractFilter.h"
+
+/**
+ * @brief The PipelineFileLoader class opens JSON and CBOR pipeline files without blocking the GUI thread.  JSON
+ * files are read in chunks and split into their top level members as they arrive, so only one filter's JSON is
+ * parsed into a DOM at a time.  Filters are instantiated and read their parameters on the global thread pool, then are handed
+ * back to the GUI thread in order, in batches, through the filtersLoaded signal.
+ */
+class PipelineFileLoader : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineFileLoader(QObject* parent = nullptr);
+  ~PipelineFileLoader() override;
+
+  /**
+   * @brief Returns true if the file is a pipeline format this loader reads: .json, .cbor, or a .dream3d file,
+   * from which only the embedded pipeline is read.
+   * @param filePath
+   * @return
+   */
+  static bool CanLoad(const QString& filePath);
+
+  /**
+   * @brief Starts loading the file.  A load that is already running is cancelled first.
+   * @param filePath
+   */
+  void load(const QString& filePath);
+
+  /**
+   * @brief Stops the current load.  Batches that were already delivered stay in the pipeline.
+   */
+  void cancel();
+
+  /**
+   * @brief Returns true while a load is running
+   * @return
+   */
+  bool isLoading() const;
+
+  /**
+   * @brief Returns the file currently or most recently loaded
+   * @return
+   */
+  QString getFilePath() const;
+
+  /**
+   * @brief Returns the top level objects of the most recently loaded file that are neither filters nor the
+   * PipelineBuilder, such as settings the window stores alongside the pipeline.  Set once the load finishes.
+   * @return
+   */
+  QJsonObject getExtraMembers() const;
+
+Q_SIGNALS:
+  /**
+   * @brief Emitted on the GUI thread for each batch of filters, in pipeline order
+   * @param filters
+   */
+  void filtersLoaded(const std::vector<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief Emitted on the GUI thread once the load ends
+   * @param err 0 on success, negative if the file could not be read or is not a JSON pipeline
+   * @param filterCount The number of filters delivered
+   */
+  void finished(int err, int filterCount);
+
+private:
+  /**
+   * @brief The LoadedFilter struct is the result of instantiating one filter on a worker thread.  Filters whose
+   * factories must run on the GUI thread keep their JSON and are created when the batch is delivered.
+   */
+  struct LoadedFilter
+  {
+    AbstractFilter::Pointer filter;
+    QJsonObject json;
+  };
+
+  /**
+   * @brief The FilterSource struct holds one filter as read from the file: either the raw JSON text, which is
+   * parsed on the worker that instantiates the filter, or an already decoded object
+   */
+  struct FilterSource
+  {
+    QByteArray json;
+    QJsonObject object;
+  };
+
+  QString m_FilePath;
+  QFuture<void> m_Future;
+  std::shared_ptr<std::atomic_bool> m_Cancelled;
+  int m_FilterCount = 0;
+  QJsonObject m_ExtraMembers;
+  bool m_Loading = false;
+
+  /**
+   * @brief Runs on the worker thread
+   * @param filePath
+   * @param contents The pipeline already extracted from the file, or a null array to read the file itself
+   * @param cancelled
+   * @param guiThreadUuids Filters that are instantiated on the GUI thread
+   */
+  void readFile(const QString& filePath, const QByteArray& contents, const std::shared_ptr<std::atomic_bool>& cancelled, const QSet<QUuid>& guiThreadUuids);
+
+  /**
+   * @brief Instantiates one filter from its JSON
+   * @param source
+   * @param guiThreadUuids
+   * @return
+   */
+  static LoadedFilter CreateFilter(const FilterSource& source, const QSet<QUuid>& guiThreadUuids);
+
+  /**
+   * @brief Creates a filter from its JSON on the calling thread
+   * @param json
+   * @return
+   */
+  static AbstractFilter::Pointer InstantiateFilter(QJsonObject& json);
+
+  /**
+   * @brief Runs on the GUI thread for every batch
+   * @param batch
+   */
+  void deliverBatch(std::vector<LoadedFilter>& batch);
+
+  /**
+   * @brief Runs on the GUI thread once the worker is done
+   * @param err
+   */
+  void loadFinished(int err);
+
+  /**
+   * @brief Queues a call to the GUI thread that is dropped if the load it belongs to was cancelled
+   * @param cancelled
+   * @param function
+   */
+  void postToGuiThread(const std::shared_ptr<std::atomic_bool>& cancelled, std::function<void()> function);
+
+public:
+  PipelineFileLoader(const PipelineFileLoader&) = delete;            // Copy Constructor Not Implemented
+  PipelineFileLoader(PipelineFileLoader&&) = delete;                 // Move Constructor Not Implemented
+  PipelineFileLoader& operator=(const PipelineFileLoader&) = delete; // Copy Assignment Not Implemented
+  PipelineFileLoader& operator=(PipelineFileLoader&&) = delete;      // Move Assignment Not Implemented
+};
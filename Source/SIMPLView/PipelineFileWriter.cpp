@@ -0,0 +1,192 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineFileWriter.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+
+#include "SIMPLView/PipelineFileFormat.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineFileWriter::PipelineFileWriter(QObject* parent)
+: QObject(parent)
+, m_Watcher(new QFutureWatcher<QString>(this))
+{
+  connect(m_Watcher, &QFutureWatcher<QString>::finished, this, [this] {
+    // waitForFinished may already have reported this write
+    if(m_CurrentFilePath.isEmpty() || !m_Watcher->future().isFinished())
+    {
+      return;
+    }
+
+    finishCurrentWrite(m_Watcher->result());
+    startNextWrite();
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineFileWriter::~PipelineFileWriter()
+{
+  // The window waits for its writes before it closes, so this only catches writes that were queued without it.
+  // Nobody is left to report them to, so failures are logged.
+  m_Watcher->waitForFinished();
+  if(!m_CurrentFilePath.isEmpty() && !m_Watcher->result().isEmpty())
+  {
+    qWarning() << "Unable to save the pipeline:" << m_Watcher->result();
+  }
+  for(const WriteRequest& request : m_Queue)
+  {
+    QString errorMessage = WritePipeline(request);
+    if(!errorMessage.isEmpty())
+    {
+      qWarning() << "Unable to save the pipeline:" << errorMessage;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileWriter::CanWrite(const QString& filePath)
+{
+  QString suffix = QFileInfo(filePath).suffix();
+  return suffix.compare(PipelineFileFormat::JsonSuffix, Qt::CaseInsensitive) == 0 || suffix.compare(PipelineFileFormat::CborSuffix, Qt::CaseInsensitive) == 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileWriter::write(const QString& filePath, const QJsonObject& pipeline)
+{
+  auto iter = std::find_if(m_Queue.begin(), m_Queue.end(), [&filePath](const WriteRequest& request) { return request.filePath == filePath; });
+  if(iter != m_Queue.end())
+  {
+    iter->pipeline = pipeline;
+  }
+  else
+  {
+    m_Queue.push_back({filePath, pipeline});
+  }
+
+  startNextWrite();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileWriter::writeAndWait(const QString& filePath, const QJsonObject& pipeline, QString& errorMessage)
+{
+  // Earlier snapshots go first so that this one is what is left on disk
+  waitForFinished();
+
+  errorMessage = WritePipeline({filePath, pipeline});
+  Q_EMIT writeFinished(filePath, errorMessage.isEmpty(), errorMessage);
+  return errorMessage.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileWriter::waitForFinished()
+{
+  if(!m_CurrentFilePath.isEmpty())
+  {
+    m_Watcher->waitForFinished();
+    finishCurrentWrite(m_Watcher->result());
+  }
+
+  while(!m_Queue.empty())
+  {
+    WriteRequest request = m_Queue.front();
+    m_Queue.pop_front();
+    QString errorMessage = WritePipeline(request);
+    Q_EMIT writeFinished(request.filePath, errorMessage.isEmpty(), errorMessage);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineFileWriter::isWriting() const
+{
+  return !m_CurrentFilePath.isEmpty() || !m_Queue.empty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileWriter::startNextWrite()
+{
+  if(!m_CurrentFilePath.isEmpty() || m_Queue.empty())
+  {
+    return;
+  }
+
+  WriteRequest request = m_Queue.front();
+  m_Queue.pop_front();
+  m_CurrentFilePath = request.filePath;
+  m_Watcher->setFuture(QtConcurrent::run([request] { return WritePipeline(request); }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineFileWriter::finishCurrentWrite(const QString& errorMessage)
+{
+  QString filePath = m_CurrentFilePath;
+  m_CurrentFilePath.clear();
+  Q_EMIT writeFinished(filePath, errorMessage.isEmpty(), errorMessage);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineFileWriter::WritePipeline(const WriteRequest& request)
+{
+  QString errorMessage;
+  if(!PipelineFileFormat::WriteFile(request.filePath, request.pipeline, errorMessage) && errorMessage.isEmpty())
+  {
+    errorMessage = QString("Unable to write '%1'").arg(request.filePath);
+  }
+  return errorMessage;
+}
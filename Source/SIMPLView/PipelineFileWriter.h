@@ -0,0 +1,138 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <deque>
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+/**
+ * @brief The PipelineFileWriter class writes pipeline snapshots to disk on a worker thread.  The snapshot is taken
+ * on the GUI thread by the caller; encoding it and writing the file happen in the background, through a temporary
+ * file that is flushed to disk and then renamed over the destination.  Writes run one at a time in the order
+ * they were requested, and a queued write is replaced by a newer one for the same file.
+ */
+class PipelineFileWriter : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineFileWriter(QObject* parent = nullptr);
+  ~PipelineFileWriter() override;
+
+  /**
+   * @brief Returns true if the file is a pipeline format this writer produces (.json and .cbor)
+   * @param filePath
+   * @return
+   */
+  static bool CanWrite(const QString& filePath);
+
+  /**
+   * @brief Queues a write of the pipeline snapshot
+   * @param filePath
+   * @param pipeline
+   */
+  void write(const QString& filePath, const QJsonObject& pipeline);
+
+  /**
+   * @brief Writes the pipeline snapshot on the calling thread once the queued writes are done.  Used where the
+   * caller cannot go on until the file is on disk, such as when the window is about to close.
+   * @param filePath
+   * @param pipeline
+   * @param errorMessage
+   * @return True if the file was written
+   */
+  bool writeAndWait(const QString& filePath, const QJsonObject& pipeline, QString& errorMessage);
+
+  /**
+   * @brief Blocks until the running and queued writes are done.  writeFinished is emitted for each of them
+   * before this returns.
+   */
+  void waitForFinished();
+
+  /**
+   * @brief Returns true while a write is running or queued
+   * @return
+   */
+  bool isWriting() const;
+
+Q_SIGNALS:
+  /**
+   * @brief Emitted once a write is done
+   * @param filePath
+   * @param success
+   * @param errorMessage
+   */
+  void writeFinished(const QString& filePath, bool success, const QString& errorMessage);
+
+private:
+  struct WriteRequest
+  {
+    QString filePath;
+    QJsonObject pipeline;
+  };
+
+  std::deque<WriteRequest> m_Queue;
+  QFutureWatcher<QString>* m_Watcher = nullptr;
+  QString m_CurrentFilePath;
+
+  /**
+   * @brief Starts the next queued write if none is running
+   */
+  void startNextWrite();
+
+  /**
+   * @brief Reports the outcome of the running write
+   * @param errorMessage
+   */
+  void finishCurrentWrite(const QString& errorMessage);
+
+  /**
+   * @brief Encodes and writes one snapshot
+   * @param request
+   * @return An empty string on success, otherwise the error message
+   */
+  static QString WritePipeline(const WriteRequest& request);
+
+public:
+  PipelineFileWriter(const PipelineFileWriter&) = delete;            // Copy Constructor Not Implemented
+  PipelineFileWriter(PipelineFileWriter&&) = delete;                 // Move Constructor Not Implemented
+  PipelineFileWriter& operator=(const PipelineFileWriter&) = delete; // Copy Assignment Not Implemented
+  PipelineFileWriter& operator=(PipelineFileWriter&&) = delete;      // Move Assignment Not Implemented
+};
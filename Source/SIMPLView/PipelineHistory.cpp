@@ -0,0 +1,300 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineHistory.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonDocument>
+
+#include "SVWidgetsLib/QtSupport/QtSSettings.h"
+
+#include "SIMPLView/PipelineDelta.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineHistory::PipelineHistory(QObject* parent)
+: QObject(parent)
+, m_ByteBudget(ReadByteBudgetSetting())
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineHistory::~PipelineHistory() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineHistory::ReadByteBudgetSetting()
+{
+  QtSSettings prefs;
+  prefs.beginGroup(SIMPLView::UndoHistory::GroupName);
+  qint64 budget = prefs.value(SIMPLView::UndoHistory::ByteBudget, QVariant(static_cast<qlonglong>(SIMPLView::UndoHistory::DefaultByteBudget))).toLongLong();
+  prefs.endGroup();
+  return budget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineHistory::setByteBudget(qint64 bytes)
+{
+  m_ByteBudget = bytes;
+  enforceBudget();
+  notifyChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineHistory::getByteBudget() const
+{
+  return m_ByteBudget;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineHistory::record(const QJsonObject& pipeline)
+{
+  if(pipeline == m_CurrentState)
+  {
+    return;
+  }
+
+  if(!m_CurrentState.isEmpty())
+  {
+    // The entry turns the new state back into the one it replaces
+    Entry entry = createEntry(PipelineDelta::Create(pipeline, m_CurrentState));
+    m_EntryBytes += entry.data.size();
+    m_UndoEntries.push_back(entry);
+  }
+
+  for(const Entry& entry : m_RedoEntries)
+  {
+    m_EntryBytes -= entry.data.size();
+  }
+  m_RedoEntries.clear();
+
+  setCurrentState(pipeline);
+  enforceBudget();
+  notifyChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineHistory::undo()
+{
+  if(m_UndoEntries.empty())
+  {
+    return QJsonObject();
+  }
+
+  Entry undoEntry = m_UndoEntries.back();
+  m_UndoEntries.pop_back();
+  m_EntryBytes -= undoEntry.data.size();
+
+  QJsonObject previous = PipelineDelta::Apply(m_CurrentState, readEntry(undoEntry));
+
+  Entry redoEntry = createEntry(PipelineDelta::Create(previous, m_CurrentState));
+  m_EntryBytes += redoEntry.data.size();
+  m_RedoEntries.push_back(redoEntry);
+
+  setCurrentState(previous);
+  enforceBudget();
+  notifyChanged();
+  return previous;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineHistory::redo()
+{
+  if(m_RedoEntries.empty())
+  {
+    return QJsonObject();
+  }
+
+  Entry redoEntry = m_RedoEntries.back();
+  m_RedoEntries.pop_back();
+  m_EntryBytes -= redoEntry.data.size();
+
+  QJsonObject next = PipelineDelta::Apply(m_CurrentState, readEntry(redoEntry));
+
+  Entry undoEntry = createEntry(PipelineDelta::Create(next, m_CurrentState));
+  m_EntryBytes += undoEntry.data.size();
+  m_UndoEntries.push_back(undoEntry);
+
+  setCurrentState(next);
+  enforceBudget();
+  notifyChanged();
+  return next;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineHistory::canUndo() const
+{
+  return !m_UndoEntries.empty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineHistory::canRedo() const
+{
+  return !m_RedoEntries.empty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineHistory::clear()
+{
+  m_UndoEntries.clear();
+  m_RedoEntries.clear();
+  m_EntryBytes = 0;
+  setCurrentState(QJsonObject());
+  notifyChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 PipelineHistory::getMemoryUsage() const
+{
+  return m_EntryBytes + m_CurrentStateBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineHistory::Entry PipelineHistory::createEntry(const QJsonObject& delta)
+{
+  Entry entry;
+  entry.id = m_NextEntryId++;
+  entry.data = QJsonDocument(delta).toJson(QJsonDocument::Compact);
+
+  // Compress on a worker thread; the uncompressed delta is used until the result comes back
+  quint64 id = entry.id;
+  QByteArray uncompressed = entry.data;
+  QFutureWatcher<QByteArray>* watcher = new QFutureWatcher<QByteArray>(this);
+  connect(watcher, &QFutureWatcher<QByteArray>::finished, this, [this, watcher, id] {
+    entryCompressed(id, watcher->result());
+    watcher->deleteLater();
+  });
+  watcher->setFuture(QtConcurrent::run([uncompressed] { return qCompress(uncompressed); }));
+
+  return entry;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineHistory::entryCompressed(quint64 id, const QByteArray& compressed)
+{
+  for(std::deque<Entry>* entries : {&m_UndoEntries, &m_RedoEntries})
+  {
+    for(Entry& entry : *entries)
+    {
+      if(entry.id != id)
+      {
+        continue;
+      }
+
+      if(!entry.compressed && compressed.size() < entry.data.size())
+      {
+        m_EntryBytes += compressed.size() - entry.data.size();
+        entry.data = compressed;
+        entry.compressed = true;
+        notifyChanged();
+      }
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineHistory::setCurrentState(const QJsonObject& pipeline)
+{
+  m_CurrentState = pipeline;
+  m_CurrentStateBytes = pipeline.isEmpty() ? 0 : QJsonDocument(pipeline).toJson(QJsonDocument::Compact).size();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PipelineHistory::readEntry(const Entry& entry) const
+{
+  QByteArray data = entry.compressed ? qUncompress(entry.data) : entry.data;
+  return QJsonDocument::fromJson(data).object();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineHistory::enforceBudget()
+{
+  // The undo entries furthest in the past go first, then the redo entries furthest in the future
+  while(getMemoryUsage() > m_ByteBudget && !m_UndoEntries.empty())
+  {
+    m_EntryBytes -= m_UndoEntries.front().data.size();
+    m_UndoEntries.pop_front();
+  }
+
+  while(getMemoryUsage() > m_ByteBudget && !m_RedoEntries.empty())
+  {
+    m_EntryBytes -= m_RedoEntries.front().data.size();
+    m_RedoEntries.pop_front();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineHistory::notifyChanged()
+{
+  Q_EMIT memoryUsageChanged(getMemoryUsage());
+  Q_EMIT undoRedoStateChanged(canUndo(), canRedo());
+}
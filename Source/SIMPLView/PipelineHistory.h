@@ -0,0 +1,182 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <deque>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+/**
+ * @brief The PipelineHistory class is a memory-bounded undo history of pipeline states.  Only the newest
+ * state is kept in full; every older (or newer, after an undo) state is stored as a compact JSON delta
+ * against its neighbor and compressed on a worker thread.  When the history grows past its byte budget
+ * the oldest entries are evicted first.  It is the history behind the Undo and Redo actions of a window.
+ *
+ * Entries hold serialized filters rather than filter instances, so the history stays valid when the
+ * filter factories are replaced, for example when the Python filters are reloaded.
+ */
+class PipelineHistory : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineHistory(QObject* parent = nullptr);
+  ~PipelineHistory() override;
+
+  /**
+   * @brief Reads the byte budget from the preferences file
+   * @return
+   */
+  static qint64 ReadByteBudgetSetting();
+
+  /**
+   * @brief Sets the maximum number of bytes the history may use.  Oldest entries are evicted first.
+   * @param bytes
+   */
+  void setByteBudget(qint64 bytes);
+
+  /**
+   * @brief getByteBudget
+   * @return
+   */
+  qint64 getByteBudget() const;
+
+  /**
+   * @brief Records a new pipeline state.  The redo entries are discarded.
+   * @param pipeline The pipeline as produced by FilterPipeline::toJson
+   */
+  void record(const QJsonObject& pipeline);
+
+  /**
+   * @brief Steps back one state and returns it
+   * @return The previous pipeline state, or an empty object if there is none
+   */
+  QJsonObject undo();
+
+  /**
+   * @brief Steps forward one state and returns it
+   * @return The next pipeline state, or an empty object if there is none
+   */
+  QJsonObject redo();
+
+  /**
+   * @brief canUndo
+   * @return
+   */
+  bool canUndo() const;
+
+  /**
+   * @brief canRedo
+   * @return
+   */
+  bool canRedo() const;
+
+  /**
+   * @brief Removes every entry, including the current state
+   */
+  void clear();
+
+  /**
+   * @brief Returns the number of bytes used by the stored deltas and the current state
+   * @return
+   */
+  qint64 getMemoryUsage() const;
+
+Q_SIGNALS:
+  void memoryUsageChanged(qint64 bytes);
+  void undoRedoStateChanged(bool canUndo, bool canRedo);
+
+private:
+  struct Entry
+  {
+    quint64 id = 0;
+    QByteArray data;
+    bool compressed = false;
+  };
+
+  std::deque<Entry> m_UndoEntries;
+  std::deque<Entry> m_RedoEntries;
+  QJsonObject m_CurrentState;
+  qint64 m_CurrentStateBytes = 0;
+  qint64 m_EntryBytes = 0;
+  qint64 m_ByteBudget = 0;
+  quint64 m_NextEntryId = 0;
+
+  /**
+   * @brief Creates an uncompressed entry for the delta and starts compressing it in the background
+   * @param delta
+   * @return
+   */
+  Entry createEntry(const QJsonObject& delta);
+
+  /**
+   * @brief Replaces the data of the entry with the given id once it has been compressed
+   * @param id
+   * @param compressed
+   */
+  void entryCompressed(quint64 id, const QByteArray& compressed);
+
+  /**
+   * @brief Makes the given pipeline the current state
+   * @param pipeline
+   */
+  void setCurrentState(const QJsonObject& pipeline);
+
+  /**
+   * @brief Decodes the delta stored in an entry
+   * @param entry
+   * @return
+   */
+  QJsonObject readEntry(const Entry& entry) const;
+
+  /**
+   * @brief Evicts the oldest entries until the history fits in its budget
+   */
+  void enforceBudget();
+
+  /**
+   * @brief Emits the memory usage and undo/redo state signals
+   */
+  void notifyChanged();
+
+public:
+  PipelineHistory(const PipelineHistory&) = delete;            // Copy Constructor Not Implemented
+  PipelineHistory(PipelineHistory&&) = delete;                 // Move Constructor Not Implemented
+  PipelineHistory& operator=(const PipelineHistory&) = delete; // Copy Assignment Not Implemented
+  PipelineHistory& operator=(PipelineHistory&&) = delete;      // Move Assignment Not Implemented
+};
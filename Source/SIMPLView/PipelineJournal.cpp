@@ -0,0 +1,366 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineJournal.h"
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTimer>
+#include <QtCore/QUuid>
+
+#include "SIMPLView/PipelineDelta.h"
+#include "SIMPLView/PipelineFileFormat.h"
+
+namespace
+{
+const QString k_JournalSuffix(".journal");
+const QString k_LockSuffix(".lock");
+
+const QString k_Type("Type");
+const QString k_Snapshot("Snapshot");
+const QString k_Delta("Delta");
+const QString k_Saved("Saved");
+const QString k_Pipeline("Pipeline");
+const QString k_Modified("Modified");
+const QString k_FilePath("FilePath");
+
+const int k_WriteInterval = 500;
+const int k_CompactionDeltaCount = 256;
+
+/**
+ * @brief Encodes one journal line
+ */
+QByteArray EncodeLine(const QJsonObject& line)
+{
+  return QJsonDocument(line).toJson(QJsonDocument::Compact) + '\n';
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineJournal::PipelineJournal(QObject* parent)
+: QObject(parent)
+, m_WriterState(std::make_shared<WriterState>())
+, m_Watcher(new QFutureWatcher<void>(this))
+, m_WriteTimer(new QTimer(this))
+{
+  QDir().mkpath(GetJournalDirectory());
+  m_JournalPath = GetJournalDirectory() + "/" + QUuid::createUuid().toString(QUuid::WithoutBraces) + k_JournalSuffix;
+  m_WriterState->journalPath = m_JournalPath;
+
+  // The lock is held for as long as the window is open, so it must never be considered stale by its age
+  m_LockFile = std::make_unique<QLockFile>(m_JournalPath + k_LockSuffix);
+  m_LockFile->setStaleLockTime(0);
+  m_LockFile->tryLock(0);
+
+  // Edits are batched so that a burst of them costs one write
+  m_WriteTimer->setSingleShot(true);
+  m_WriteTimer->setInterval(k_WriteInterval);
+  connect(m_WriteTimer, &QTimer::timeout, this, &PipelineJournal::startWrite);
+  connect(m_Watcher, &QFutureWatcher<void>::finished, this, &PipelineJournal::startWrite);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PipelineJournal::~PipelineJournal()
+{
+  m_WriteTimer->stop();
+
+  if(m_PreserveOnClose)
+  {
+    flush();
+  }
+  else
+  {
+    m_Watcher->waitForFinished();
+    QFile::remove(m_JournalPath);
+  }
+
+  // Releasing the lock is what marks a preserved journal as recoverable
+  m_LockFile.reset();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineJournal::GetJournalDirectory()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/PipelineJournals";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList PipelineJournal::FindRecoverableJournals()
+{
+  QStringList journals;
+
+  QDir dir(GetJournalDirectory());
+  for(const QFileInfo& fileInfo : dir.entryInfoList({"*" + k_JournalSuffix}, QDir::Files, QDir::Time))
+  {
+    // A journal whose lock can be taken has no live window.  With no stale time QLockFile only clears locks left
+    // by dead processes, never the lock of a window that has been open for a while.
+    QLockFile lockFile(fileInfo.absoluteFilePath() + k_LockSuffix);
+    lockFile.setStaleLockTime(0);
+    if(lockFile.tryLock(0))
+    {
+      lockFile.unlock();
+      journals.push_back(fileInfo.absoluteFilePath());
+    }
+  }
+
+  return journals;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineJournal::Replay(const QString& journalPath, QJsonObject& pipeline, QString& pipelineFilePath, bool& modified)
+{
+  QFile file(journalPath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+
+  pipeline = QJsonObject();
+  pipelineFilePath.clear();
+  modified = false;
+
+  while(!file.atEnd())
+  {
+    // The last line may have been cut short by the crash; it is skipped like any other line that does not parse
+    QJsonObject line = QJsonDocument::fromJson(file.readLine()).object();
+    QString type = line[k_Type].toString();
+    if(type == k_Snapshot)
+    {
+      pipeline = line[k_Pipeline].toObject();
+    }
+    else if(type == k_Delta)
+    {
+      pipeline = PipelineDelta::Apply(pipeline, line[k_Delta].toObject());
+    }
+    else if(type != k_Saved)
+    {
+      continue;
+    }
+
+    modified = line[k_Modified].toBool();
+    pipelineFilePath = line[k_FilePath].toString();
+  }
+
+  return !pipeline.isEmpty();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineJournal::Remove(const QString& journalPath)
+{
+  QFile::remove(journalPath);
+  QFile::remove(journalPath + k_LockSuffix);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineJournal::record(const QJsonObject& pipeline, bool modified, const QString& pipelineFilePath)
+{
+  // Only the newest state of a batch is needed to recover it
+  if(!m_PendingEntries.empty() && !m_PendingEntries.back().saved)
+  {
+    m_PendingEntries.pop_back();
+  }
+
+  Entry entry;
+  entry.pipeline = pipeline;
+  entry.modified = modified;
+  entry.pipelineFilePath = pipelineFilePath;
+  m_PendingEntries.push_back(entry);
+
+  if(!m_WriteTimer->isActive())
+  {
+    m_WriteTimer->start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineJournal::markSaved(const QString& pipelineFilePath)
+{
+  Entry entry;
+  entry.pipelineFilePath = pipelineFilePath;
+  entry.saved = true;
+  m_PendingEntries.push_back(entry);
+
+  if(!m_WriteTimer->isActive())
+  {
+    m_WriteTimer->start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineJournal::flush()
+{
+  m_Watcher->waitForFinished();
+
+  std::vector<Entry> entries;
+  entries.swap(m_PendingEntries);
+  if(!entries.empty())
+  {
+    WriteEntries(*m_WriterState, entries);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineJournal::setPreserveOnClose(bool value)
+{
+  m_PreserveOnClose = value;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PipelineJournal::getJournalPath() const
+{
+  return m_JournalPath;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineJournal::startWrite()
+{
+  if(m_Watcher->isRunning() || m_PendingEntries.empty())
+  {
+    return;
+  }
+
+  std::vector<Entry> entries;
+  entries.swap(m_PendingEntries);
+  std::shared_ptr<WriterState> state = m_WriterState;
+  m_Watcher->setFuture(QtConcurrent::run([state, entries] { WriteEntries(*state, entries); }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void PipelineJournal::WriteEntries(WriterState& state, const std::vector<Entry>& entries)
+{
+  QByteArray data;
+  for(const Entry& entry : entries)
+  {
+    QJsonObject line;
+    if(entry.saved)
+    {
+      line[k_Type] = k_Saved;
+      state.modified = false;
+    }
+    else if(state.lastPipeline.isEmpty())
+    {
+      line[k_Type] = k_Snapshot;
+      line[k_Pipeline] = entry.pipeline;
+      state.lastPipeline = entry.pipeline;
+      state.modified = entry.modified;
+    }
+    else
+    {
+      QJsonObject delta = PipelineDelta::Create(state.lastPipeline, entry.pipeline);
+      if(PipelineDelta::IsEmpty(delta) && entry.modified == state.modified && entry.pipelineFilePath == state.pipelineFilePath)
+      {
+        continue;
+      }
+
+      line[k_Type] = k_Delta;
+      line[k_Delta] = delta;
+      state.lastPipeline = entry.pipeline;
+      state.modified = entry.modified;
+      state.deltaCount++;
+    }
+
+    state.pipelineFilePath = entry.pipelineFilePath;
+    line[k_Modified] = state.modified;
+    line[k_FilePath] = state.pipelineFilePath;
+    data.append(EncodeLine(line));
+  }
+
+  if(data.isEmpty())
+  {
+    return;
+  }
+
+  // The snapshot already contains this batch; if it cannot be written the batch is appended as usual
+  if(state.deltaCount >= k_CompactionDeltaCount && Compact(state))
+  {
+    return;
+  }
+
+  QFile file(state.journalPath);
+  if(file.open(QIODevice::WriteOnly | QIODevice::Append))
+  {
+    file.write(data);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PipelineJournal::Compact(WriterState& state)
+{
+  QJsonObject line;
+  line[k_Type] = k_Snapshot;
+  line[k_Pipeline] = state.lastPipeline;
+  line[k_Modified] = state.modified;
+  line[k_FilePath] = state.pipelineFilePath;
+
+  QString errorMessage;
+  if(!PipelineFileFormat::WriteFileAtomically(state.journalPath, EncodeLine(line), errorMessage))
+  {
+    return false;
+  }
+
+  state.deltaCount = 0;
+  return true;
+}
@@ -0,0 +1,179 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLockFile>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+class QTimer;
+
+/**
+ * @brief The PipelineJournal class is an append-only record of the pipeline edits made in one window, used to
+ * restore unsaved pipelines after a crash.  Recording an edit only queues the pipeline snapshot (an implicitly
+ * shared QJsonObject); the queue is written in batches on a worker thread, each edit as a PipelineDelta against
+ * the previous one.  Once enough deltas have accumulated the journal is compacted into a single snapshot.
+ *
+ * Every journal holds a lock file while its window is open.  Journals whose lock is no longer held belong to a
+ * session that did not shut down cleanly and are offered for recovery on the next launch.
+ */
+class PipelineJournal : public QObject
+{
+  Q_OBJECT
+
+public:
+  PipelineJournal(QObject* parent = nullptr);
+  ~PipelineJournal() override;
+
+  /**
+   * @brief Returns the directory that holds the journals
+   * @return
+   */
+  static QString GetJournalDirectory();
+
+  /**
+   * @brief Returns the journals left behind by sessions that did not shut down cleanly
+   * @return
+   */
+  static QStringList FindRecoverableJournals();
+
+  /**
+   * @brief Replays a journal
+   * @param journalPath
+   * @param pipeline The last recorded pipeline
+   * @param pipelineFilePath The file the pipeline was last opened from or saved to, if any
+   * @param modified True if the pipeline had unsaved changes
+   * @return False if the journal could not be read
+   */
+  static bool Replay(const QString& journalPath, QJsonObject& pipeline, QString& pipelineFilePath, bool& modified);
+
+  /**
+   * @brief Deletes a journal and its lock file
+   * @param journalPath
+   */
+  static void Remove(const QString& journalPath);
+
+  /**
+   * @brief Queues a pipeline state.  This is cheap enough to call on every edit.
+   * @param pipeline
+   * @param modified
+   * @param pipelineFilePath
+   */
+  void record(const QJsonObject& pipeline, bool modified, const QString& pipelineFilePath);
+
+  /**
+   * @brief Records that the pipeline was saved to the given file
+   * @param pipelineFilePath
+   */
+  void markSaved(const QString& pipelineFilePath);
+
+  /**
+   * @brief Writes everything that is queued before returning
+   */
+  void flush();
+
+  /**
+   * @brief Keeps the journal on disk when this object is destroyed, so it can be recovered on the next launch
+   * @param value
+   */
+  void setPreserveOnClose(bool value);
+
+  /**
+   * @brief getJournalPath
+   * @return
+   */
+  QString getJournalPath() const;
+
+private:
+  struct Entry
+  {
+    QJsonObject pipeline;
+    bool modified = false;
+    QString pipelineFilePath;
+    bool saved = false;
+  };
+
+  /**
+   * @brief The WriterState struct is owned by whichever write is running; writes never overlap
+   */
+  struct WriterState
+  {
+    QString journalPath;
+    QJsonObject lastPipeline;
+    bool modified = false;
+    QString pipelineFilePath;
+    int deltaCount = 0;
+  };
+
+  QString m_JournalPath;
+  std::unique_ptr<QLockFile> m_LockFile;
+  std::vector<Entry> m_PendingEntries;
+  std::shared_ptr<WriterState> m_WriterState;
+  QFutureWatcher<void>* m_Watcher = nullptr;
+  QTimer* m_WriteTimer = nullptr;
+  bool m_PreserveOnClose = false;
+
+  /**
+   * @brief Hands the queued entries to a worker thread unless a write is already running
+   */
+  void startWrite();
+
+  /**
+   * @brief Appends the entries to the journal, compacting it when it has grown too long
+   * @param state
+   * @param entries
+   */
+  static void WriteEntries(WriterState& state, const std::vector<Entry>& entries);
+
+  /**
+   * @brief Replaces the journal with a single snapshot of the current state
+   * @param state
+   * @return
+   */
+  static bool Compact(WriterState& state);
+
+public:
+  PipelineJournal(const PipelineJournal&) = delete;            // Copy Constructor Not Implemented
+  PipelineJournal(PipelineJournal&&) = delete;                 // Move Constructor Not Implemented
+  PipelineJournal& operator=(const PipelineJournal&) = delete; // Copy Assignment Not Implemented
+  PipelineJournal& operator=(PipelineJournal&&) = delete;      // Move Assignment Not Implemented
+};
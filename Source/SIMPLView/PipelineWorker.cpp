@@ -0,0 +1,431 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PipelineWorker.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLocale>
+#include <QtCore/QPluginLoader>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/QMetaObjectUtilities.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Messages/FilterStatusMessage.h"
+#include "SIMPLib/Messages/PipelineProgressMessage.h"
+#include "SIMPLib/Messages/PipelineStatusMessage.h"
+#include "SIMPLib/Plugin/ISIMPLibPlugin.h"
+#include "SIMPLib/Plugin/PluginManager.h"
+#include "SIMPLib/Plugin/PluginProxy.h"
+
+#include "SVWidgetsLib/Dialogs/AboutPlugins.h"
+
+#include "SIMPLView/BatchQueue.h"
+#include "SIMPLView/PipelineExecution.h"
+#include "SIMPLView/ProcessMemory.h"
+#include "SIMPLView/ProcessPool.h"
+#include "SIMPLView/SIMPLViewApplication.h"
+#include "SIMPLView/SIMPLViewConstants.h"
+
+namespace
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WriteLine(const QJsonObject& line)
+{
+  QByteArray bytes = ProcessPool::LinePrefix + QJsonDocument(line).toJson(QJsonDocument::Compact);
+  bytes.append('\n');
+  std::fwrite(bytes.constData(), 1, static_cast<size_t>(bytes.size()), stdout);
+  std::fflush(stdout);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<std::unique_ptr<QPluginLoader>> LoadPlugins()
+{
+  QStringList pluginFilePaths = SIMPLViewApplication::FindPluginFilePaths();
+
+  FilterManager* filterManager = FilterManager::Instance();
+  FilterManager::RegisterKnownFilters(filterManager);
+
+  // The worker honours the plugins the user disabled, the same as the application
+  PluginManager* pluginManager = PluginManager::Instance();
+  QList<PluginProxy::Pointer> proxies = AboutPlugins::readPluginCache();
+  QMap<QString, bool> loadingMap;
+  for(const PluginProxy::Pointer& proxy : proxies)
+  {
+    loadingMap.insert(proxy->getPluginName(), proxy->getEnabled());
+  }
+
+  std::vector<std::unique_ptr<QPluginLoader>> loaders;
+  for(const QString& path : pluginFilePaths)
+  {
+    std::unique_ptr<QPluginLoader> loader = std::make_unique<QPluginLoader>(path);
+    ISIMPLibPlugin* ipPlugin = qobject_cast<ISIMPLibPlugin*>(loader->instance());
+    if(nullptr == ipPlugin)
+    {
+      qWarning() << "The plugin" << path << "did not load:" << loader->errorString();
+      continue;
+    }
+
+    // Only the filters are registered; a worker never shows a filter widget
+    if(loadingMap.value(ipPlugin->getPluginFileName(), true))
+    {
+      ipPlugin->registerFilters(filterManager);
+      ipPlugin->setDidLoad(true);
+    }
+    else
+    {
+      ipPlugin->setDidLoad(false);
+    }
+    ipPlugin->setLocation(path);
+    pluginManager->addPlugin(ipPlugin);
+    loaders.push_back(std::move(loader));
+  }
+  return loaders;
+}
+
+/**
+ * @brief The WorkerSession class runs the commands a worker receives, one pipeline at a time
+ */
+class WorkerSession
+{
+public:
+  WorkerSession()
+  {
+    m_MemoryTimer.setInterval(SIMPLView::Batch::MemorySampleInterval);
+    QObject::connect(&m_MemoryTimer, &QTimer::timeout, [this] { m_PeakMemory = std::max(m_PeakMemory, ProcessMemory::CurrentResidentBytes()); });
+  }
+
+  ~WorkerSession()
+  {
+    delete m_Execution;
+  }
+
+  /**
+   * @brief Handles one line of standard input
+   * @param line
+   */
+  void handleCommand(const QByteArray& line)
+  {
+    QJsonObject command = QJsonDocument::fromJson(line).object();
+    QString type = command["type"].toString();
+    if(type == "run")
+    {
+      run(command["id"].toInt(-1), command["pipeline"].toObject());
+    }
+    else if(type == "cancel")
+    {
+      if(nullptr != m_Execution && command["id"].toInt(-1) == m_JobId)
+      {
+        m_Execution->cancel();
+      }
+    }
+    else if(type == "quit")
+    {
+      quit();
+    }
+  }
+
+  /**
+   * @brief Cancels the running pipeline and leaves the event loop once it stopped
+   */
+  void quit()
+  {
+    if(nullptr != m_Execution)
+    {
+      m_Execution->cancel();
+    }
+    m_QuitRequested = true;
+    if(nullptr == m_Execution)
+    {
+      QCoreApplication::quit();
+    }
+  }
+
+private:
+  PipelineExecution* m_Execution = nullptr;
+  int m_JobId = -1;
+  qint64 m_PeakMemory = 0;
+  QTimer m_MemoryTimer;
+  bool m_QuitRequested = false;
+
+  /**
+   * @brief Starts a pipeline, or reports it as failed if it cannot run
+   * @param jobId
+   * @param pipelineJson
+   */
+  void run(int jobId, const QJsonObject& pipelineJson)
+  {
+    // The pool never sends a second pipeline to a busy worker
+    if(nullptr != m_Execution || m_QuitRequested)
+    {
+      return;
+    }
+    m_JobId = jobId;
+    m_PeakMemory = 0;
+
+    JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+    FilterPipeline::Pointer pipeline = jsonReader->readPipelineFromJson(pipelineJson, nullptr);
+    if(nullptr == pipeline || pipeline->getFilterContainer().empty())
+    {
+      writeFinished("failed", QStringList() << QObject::tr("The pipeline could not be read by the worker."), 0);
+      return;
+    }
+    if(pipeline->preflightPipeline() < 0)
+    {
+      writeFinished("failed", QStringList() << QObject::tr("The pipeline has preflight errors."), 0);
+      return;
+    }
+
+    m_Execution = new PipelineExecution(pipeline);
+    QObject::connect(m_Execution, &PipelineExecution::pipelineMessage, [this](const AbstractMessage::Pointer& msg) { forwardMessage(msg); });
+    QObject::connect(m_Execution, &PipelineExecution::finished, [this] { executionFinished(); });
+
+    m_PeakMemory = ProcessMemory::CurrentResidentBytes();
+    m_MemoryTimer.start();
+    m_Execution->start();
+  }
+
+  /**
+   * @brief Writes the progress and status messages of the running pipeline
+   * @param msg
+   */
+  void forwardMessage(const AbstractMessage::Pointer& msg) const
+  {
+    QJsonObject line;
+    line["id"] = m_JobId;
+    if(auto progressMessage = std::dynamic_pointer_cast<PipelineProgressMessage>(msg))
+    {
+      line["type"] = "progress";
+      line["progress"] = progressMessage->getProgressValue();
+    }
+    else if(std::dynamic_pointer_cast<PipelineStatusMessage>(msg) || std::dynamic_pointer_cast<FilterStatusMessage>(msg))
+    {
+      line["type"] = "status";
+      line["message"] = msg->generateMessageString();
+    }
+    else
+    {
+      return;
+    }
+    WriteLine(line);
+  }
+
+  /**
+   * @brief Reports the result of the pipeline that just ended
+   */
+  void executionFinished()
+  {
+    m_MemoryTimer.stop();
+    m_PeakMemory = std::max(m_PeakMemory, ProcessMemory::CurrentResidentBytes());
+
+    QStringList errors = m_Execution->getErrorMessages();
+    QString status = "succeeded";
+    if(m_Execution->wasCancelled())
+    {
+      status = "cancelled";
+    }
+    else if(!errors.isEmpty())
+    {
+      status = "failed";
+    }
+    writeFinished(status, errors, m_Execution->getElapsedMilliseconds());
+
+    // The execution is still inside its finished signal
+    m_Execution->deleteLater();
+    m_Execution = nullptr;
+    if(m_QuitRequested)
+    {
+      QCoreApplication::quit();
+    }
+  }
+
+  /**
+   * @brief Writes the finished line of the current job
+   * @param status
+   * @param errors
+   * @param elapsedMilliseconds
+   */
+  void writeFinished(const QString& status, const QStringList& errors, qint64 elapsedMilliseconds)
+  {
+    QJsonObject line;
+    line["type"] = "finished";
+    line["id"] = m_JobId;
+    line["status"] = status;
+    line["errors"] = QJsonArray::fromStringList(errors);
+    line["elapsed"] = static_cast<double>(elapsedMilliseconds);
+    line["peakMemory"] = static_cast<double>(m_PeakMemory);
+    WriteLine(line);
+    m_JobId = -1;
+  }
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineWorker::Exec(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QMetaObjectUtilities::RegisterMetaTypes();
+  std::vector<std::unique_ptr<QPluginLoader>> loaders = LoadPlugins();
+
+  WorkerSession session;
+
+  // Standard input is read on its own thread because there is no portable way to watch it from the event loop.
+  // The thread is detached: it stays blocked in getline() until the process exits.
+  std::thread reader([&session] {
+    std::string line;
+    while(std::getline(std::cin, line))
+    {
+      QByteArray bytes = QByteArray::fromStdString(line);
+      QMetaObject::invokeMethod(qApp, [&session, bytes] { session.handleCommand(bytes); }, Qt::QueuedConnection);
+    }
+
+    // The pool closed the pipe, so nobody is left to report to
+    QMetaObject::invokeMethod(qApp, [&session] { session.quit(); }, Qt::QueuedConnection);
+  });
+  reader.detach();
+
+  QJsonObject ready;
+  ready["type"] = "ready";
+  WriteLine(ready);
+
+  return app.exec();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PipelineWorker::ExecBatch(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QTextStream out(stdout);
+  QTextStream err(stderr);
+
+  QStringList filePaths;
+  int workers = std::max(QThread::idealThreadCount(), 1);
+  QStringList arguments = app.arguments();
+  for(int i = 1; i < arguments.size(); i++)
+  {
+    if(arguments[i] == SIMPLView::Worker::BatchArgument)
+    {
+      continue;
+    }
+    if(arguments[i] == SIMPLView::Worker::WorkersArgument)
+    {
+      bool ok = false;
+      workers = (i + 1 < arguments.size()) ? arguments[++i].toInt(&ok) : 0;
+      if(!ok || workers < 1)
+      {
+        err << QObject::tr("%1 needs a number of workers of at least 1").arg(SIMPLView::Worker::WorkersArgument) << '\n';
+        return 2;
+      }
+      continue;
+    }
+    filePaths.push_back(arguments[i]);
+  }
+  if(filePaths.isEmpty())
+  {
+    err << QObject::tr("Usage: %1 %2 [%3 N] pipeline files...").arg(QFileInfo(arguments[0]).fileName(), SIMPLView::Worker::BatchArgument, SIMPLView::Worker::WorkersArgument) << '\n';
+    return 2;
+  }
+
+  // There is no point in starting more workers than there are pipelines
+  ProcessPool pool(std::min(workers, filePaths.size()));
+  std::map<int, QString> jobFiles;
+  int failures = 0;
+  int finished = 0;
+  QLocale locale;
+
+  auto report = [&](const QString& filePath, const QString& outcome) {
+    finished++;
+    out << QString("[%1/%2] %3: %4").arg(finished).arg(filePaths.size()).arg(filePath, outcome) << '\n';
+    out.flush();
+    if(finished == filePaths.size())
+    {
+      QCoreApplication::exit(failures > 0 ? 1 : 0);
+    }
+  };
+
+  QObject::connect(&pool, &ProcessPool::jobFinished, [&](int jobId, const ProcessPool::Result& result) {
+    QString outcome;
+    if(result.succeeded)
+    {
+      outcome = QObject::tr("Succeeded in %1 s, peak memory %2")
+                    .arg(locale.toString(result.elapsedMilliseconds / 1000.0, 'f', 1), locale.formattedDataSize(result.peakMemory));
+    }
+    else
+    {
+      failures++;
+      outcome = result.cancelled ? QObject::tr("Cancelled") : QObject::tr("Failed: %1").arg(result.errorMessages.value(0, QObject::tr("Unknown error")));
+    }
+    report(jobFiles[jobId], outcome);
+  });
+
+  for(const QString& filePath : filePaths)
+  {
+    QJsonObject pipeline;
+    QString errorMessage;
+    if(!BatchQueue::ReadPipelineFile(filePath, pipeline, errorMessage))
+    {
+      failures++;
+      QTimer::singleShot(0, &app, [&report, filePath, errorMessage] { report(filePath, QObject::tr("Failed: %1").arg(errorMessage)); });
+      continue;
+    }
+    jobFiles[pool.submit(pipeline)] = filePath;
+  }
+
+  return app.exec();
+}
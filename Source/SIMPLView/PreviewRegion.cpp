@@ -0,0 +1,400 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "PreviewRegion.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QObject>
+#include <QtCore/QPair>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/Common/SIMPLArray.hpp"
+#include "SIMPLib/DataContainers/AttributeMatrix.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+#include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
+#include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Filtering/IFilterFactory.hpp"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+const QString PreviewRegion::JsonKey("PreviewRegion");
+
+namespace
+{
+const QString k_ModeKey("Mode");
+const QString k_MinimumKey("Minimum");
+const QString k_MaximumKey("Maximum");
+const QString k_FactorKey("Factor");
+const QString k_CropMode("Crop");
+const QString k_DownsampleMode("Downsample");
+
+// The crop and resample filters live in plugins; the older name of the resample filter is tried as well
+const QString k_CropFilterClassName("CropImageGeometry");
+const QStringList k_ResampleFilterClassNames = {"ResampleImageGeom", "ChangeResolution"};
+
+// -----------------------------------------------------------------------------
+QJsonArray ToJsonArray(const std::array<int, 3>& values)
+{
+  return QJsonArray{values[0], values[1], values[2]};
+}
+
+// -----------------------------------------------------------------------------
+bool FromJsonArray(const QJsonValue& value, std::array<int, 3>& values)
+{
+  QJsonArray array = value.toArray();
+  if(array.size() != 3)
+  {
+    return false;
+  }
+  for(int i = 0; i < 3; i++)
+  {
+    if(!array[i].isDouble())
+    {
+      return false;
+    }
+    values[i] = array[i].toInt();
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+AbstractFilter::Pointer CreateFilter(const QString& className)
+{
+  IFilterFactory::Pointer factory = FilterManager::Instance()->getFactoryFromClassName(className);
+  if(nullptr == factory)
+  {
+    return AbstractFilter::NullPointer();
+  }
+  return factory->create();
+}
+
+// -----------------------------------------------------------------------------
+bool SetProperties(const AbstractFilter::Pointer& filter, const QVector<QPair<const char*, QVariant>>& properties, QString& errorMessage)
+{
+  for(const auto& property : properties)
+  {
+    // setProperty only fails for names the filter does not declare, i.e. a version of the filter we do not know
+    if(!filter->setProperty(property.first, property.second))
+    {
+      errorMessage = QObject::tr("The %1 filter has no '%2' parameter.").arg(filter->getNameOfClass(), property.first);
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QJsonObject PreviewRegion::toJson() const
+{
+  QJsonObject json;
+  json[k_ModeKey] = (mode == Mode::Crop) ? k_CropMode : k_DownsampleMode;
+  json[k_MinimumKey] = ToJsonArray(minimum);
+  json[k_MaximumKey] = ToJsonArray(maximum);
+  json[k_FactorKey] = factor;
+  return json;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PreviewRegion::FromJson(const QJsonObject& json, PreviewRegion& region)
+{
+  PreviewRegion result;
+  QString modeName = json[k_ModeKey].toString();
+  if(modeName == k_CropMode)
+  {
+    result.mode = Mode::Crop;
+  }
+  else if(modeName == k_DownsampleMode)
+  {
+    result.mode = Mode::Downsample;
+  }
+  else
+  {
+    return false;
+  }
+
+  if(!FromJsonArray(json[k_MinimumKey], result.minimum) || !FromJsonArray(json[k_MaximumKey], result.maximum))
+  {
+    return false;
+  }
+  result.factor = json[k_FactorKey].toInt(0);
+
+  for(int i = 0; i < 3; i++)
+  {
+    if(result.minimum[i] < 0 || result.maximum[i] < result.minimum[i])
+    {
+      return false;
+    }
+  }
+  if(result.factor < 1)
+  {
+    return false;
+  }
+
+  region = result;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString PreviewRegion::toString() const
+{
+  if(mode == Mode::Downsample)
+  {
+    return QObject::tr("downsampled %1 times").arg(factor);
+  }
+  return QObject::tr("voxels (%1, %2, %3) to (%4, %5, %6)").arg(minimum[0]).arg(minimum[1]).arg(minimum[2]).arg(maximum[0]).arg(maximum[1]).arg(maximum[2]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int PreviewRegion::InsertIndex(const std::vector<AbstractFilter::Pointer>& filters)
+{
+  auto isInput = [](const AbstractFilter::Pointer& filter) { return filter->getEnabled() && filter->getSubGroupName() == SIMPL::FilterSubGroups::InputFilters; };
+
+  auto first = std::find_if(filters.cbegin(), filters.cend(), isInput);
+  if(first == filters.cend())
+  {
+    return 0;
+  }
+
+  // Disabled filters in between do not end the run of readers
+  auto last = first;
+  for(auto iter = first; iter != filters.cend(); ++iter)
+  {
+    if(isInput(*iter))
+    {
+      last = iter;
+    }
+    else if((*iter)->getEnabled())
+    {
+      break;
+    }
+  }
+  return static_cast<int>(last - filters.cbegin()) + 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+FilterPipeline::Pointer PreviewRegion::createPipeline(const QJsonObject& pipeline, QString& errorMessage) const
+{
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  FilterPipeline::Pointer source = jsonReader->readPipelineFromJson(pipeline, nullptr);
+  if(nullptr == source)
+  {
+    errorMessage = QObject::tr("The pipeline could not be copied.");
+    return FilterPipeline::NullPointer();
+  }
+
+  auto filterContainer = source->getFilterContainer();
+  std::vector<AbstractFilter::Pointer> filters(filterContainer.cbegin(), filterContainer.cend());
+
+  int insertIndex = InsertIndex(filters);
+  if(insertIndex == 0)
+  {
+    errorMessage = QObject::tr("The pipeline does not start by reading its input, so there is nothing to restrict the preview to.");
+    return FilterPipeline::NullPointer();
+  }
+
+  // Only the readers are preflighted; they are enough to know the geometries and their cell attribute matrices
+  FilterPipeline::Pointer readers = FilterPipeline::New();
+  for(int i = 0; i < insertIndex; i++)
+  {
+    readers->pushBack(filters[i]);
+  }
+  if(readers->preflightPipeline() < 0)
+  {
+    errorMessage = QObject::tr("The filters that read the input have errors. Fix them before running a preview.");
+    return FilterPipeline::NullPointer();
+  }
+
+  DataContainerArray::Pointer dca = filters[insertIndex - 1]->getDataContainerArray();
+  std::vector<AbstractFilter::Pointer> regionFilters;
+  if(!createRegionFilters(dca, regionFilters, errorMessage))
+  {
+    return FilterPipeline::NullPointer();
+  }
+
+  FilterPipeline::Pointer preview = FilterPipeline::New();
+  preview->setName(source->getName());
+  for(int i = 0; i < static_cast<int>(filters.size()); i++)
+  {
+    if(i == insertIndex)
+    {
+      for(const AbstractFilter::Pointer& regionFilter : regionFilters)
+      {
+        preview->pushBack(regionFilter);
+      }
+    }
+    if(filters[i]->getSubGroupName() == SIMPL::FilterSubGroups::OutputFilters)
+    {
+      continue;
+    }
+    preview->pushBack(filters[i]);
+  }
+  if(insertIndex == static_cast<int>(filters.size()))
+  {
+    for(const AbstractFilter::Pointer& regionFilter : regionFilters)
+    {
+      preview->pushBack(regionFilter);
+    }
+  }
+
+  return preview;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool PreviewRegion::createRegionFilters(const DataContainerArray::Pointer& dca, std::vector<AbstractFilter::Pointer>& filters, QString& errorMessage) const
+{
+  if(nullptr == dca)
+  {
+    errorMessage = QObject::tr("The filters that read the input did not produce any data.");
+    return false;
+  }
+
+  for(const DataContainer::Pointer& dc : dca->getDataContainers())
+  {
+    ImageGeom::Pointer image = dc->getGeometryAs<ImageGeom>();
+    if(nullptr == image)
+    {
+      continue;
+    }
+
+    // The filter crops or resamples the geometry, and with it every cell array of the data container, so there is
+    // one per data container.  A second one for another cell attribute matrix would do it again.
+    QString cellAmName;
+    for(const QString& amName : dc->getAttributeMatrixNames())
+    {
+      AttributeMatrix::Pointer am = dc->getAttributeMatrix(amName);
+      if(nullptr != am && am->getType() == AttributeMatrix::Type::Cell)
+      {
+        cellAmName = amName;
+        break;
+      }
+    }
+    if(cellAmName.isEmpty())
+    {
+      continue;
+    }
+
+    DataArrayPath cellPath(dc->getName(), cellAmName, "");
+    AbstractFilter::Pointer filter;
+    QVector<QPair<const char*, QVariant>> properties;
+    properties.push_back({"CellAttributeMatrixPath", QVariant::fromValue(cellPath)});
+    properties.push_back({"SaveAsNewDataContainer", false});
+    properties.push_back({"RenumberFeatures", false});
+
+    if(mode == Mode::Crop)
+    {
+      filter = CreateFilter(k_CropFilterClassName);
+      if(nullptr == filter)
+      {
+        errorMessage = QObject::tr("Cropping needs the %1 filter, which is not loaded.").arg(k_CropFilterClassName);
+        return false;
+      }
+
+      std::array<size_t, 3> dims = {{image->getXPoints(), image->getYPoints(), image->getZPoints()}};
+      std::array<int, 3> maximumIndex;
+      for(int i = 0; i < 3; i++)
+      {
+        if(static_cast<size_t>(minimum[i]) >= dims[i])
+        {
+          errorMessage = QObject::tr("The preview region lies outside of '%1', which is %2 x %3 x %4 voxels.").arg(dc->getName()).arg(dims[0]).arg(dims[1]).arg(dims[2]);
+          return false;
+        }
+        maximumIndex[i] = static_cast<int>(std::min(static_cast<size_t>(maximum[i]), dims[i] - 1));
+      }
+
+      properties.push_back({"XMin", minimum[0]});
+      properties.push_back({"YMin", minimum[1]});
+      properties.push_back({"ZMin", minimum[2]});
+      properties.push_back({"XMax", maximumIndex[0]});
+      properties.push_back({"YMax", maximumIndex[1]});
+      properties.push_back({"ZMax", maximumIndex[2]});
+      properties.push_back({"UpdateOrigin", true});
+    }
+    else
+    {
+      for(const QString& className : k_ResampleFilterClassNames)
+      {
+        filter = CreateFilter(className);
+        if(nullptr != filter)
+        {
+          break;
+        }
+      }
+      if(nullptr == filter)
+      {
+        errorMessage = QObject::tr("Downsampling needs the %1 filter, which is not loaded.").arg(k_ResampleFilterClassNames.front());
+        return false;
+      }
+
+      FloatVec3Type spacing = image->getSpacing();
+      for(int i = 0; i < 3; i++)
+      {
+        spacing[i] *= static_cast<float>(factor);
+      }
+      const char* spacingName = filter->metaObject()->indexOfProperty("Spacing") >= 0 ? "Spacing" : "Resolution";
+      properties.push_back({spacingName, QVariant::fromValue(spacing)});
+    }
+
+    if(!SetProperties(filter, properties, errorMessage))
+    {
+      return false;
+    }
+    filters.push_back(filter);
+  }
+
+  if(filters.empty())
+  {
+    errorMessage = QObject::tr("The filters that read the input do not produce an image geometry with cell data.");
+    return false;
+  }
+  return true;
+}
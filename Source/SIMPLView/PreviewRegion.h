@@ -0,0 +1,119 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Filtering/FilterPipeline.h"
+
+/**
+ * @brief The PreviewRegion class describes the part of the input a preview run is limited to: either a box of voxels
+ * or the whole volume downsampled by an integer factor.  A preview runs a copy of the pipeline with a crop or
+ * resample filter injected right after the filters that read the input, for every image geometry they produce.
+ *
+ * The region is saved with the pipeline under its own top level key, which JsonFilterParametersReader skips, so
+ * normal and batch runs of the same file are not affected by it.
+ */
+class PreviewRegion
+{
+public:
+  enum class Mode : int
+  {
+    Crop = 0,
+    Downsample = 1
+  };
+
+  static const QString JsonKey;
+
+  Mode mode = Mode::Crop;
+  std::array<int, 3> minimum = {{0, 0, 0}};
+  std::array<int, 3> maximum = {{63, 63, 63}}; // Inclusive
+  int factor = 4;
+
+  /**
+   * @brief Returns the region as stored in a pipeline file
+   * @return
+   */
+  QJsonObject toJson() const;
+
+  /**
+   * @brief Reads a region stored by toJson
+   * @param json
+   * @param region
+   * @return False if the object is not a valid region
+   */
+  static bool FromJson(const QJsonObject& json, PreviewRegion& region);
+
+  /**
+   * @brief Returns a short description of the region for menus and status messages
+   * @return
+   */
+  QString toString() const;
+
+  /**
+   * @brief Creates the preview copy of a pipeline.  The pipeline is read back from its JSON so the filters of the
+   * window are not touched; filters that write files are left out so a preview never overwrites real output.
+   * The reader filters are preflighted to find the image geometries the region applies to.
+   * @param pipeline The pipeline as produced by FilterPipeline::toJson
+   * @param errorMessage
+   * @return A null pointer on error
+   */
+  FilterPipeline::Pointer createPipeline(const QJsonObject& pipeline, QString& errorMessage) const;
+
+  /**
+   * @brief Returns the position right after the filters that read the input: the first run of enabled input
+   * filters, or 0 if the pipeline does not start by reading anything
+   * @param filters
+   * @return
+   */
+  static int InsertIndex(const std::vector<AbstractFilter::Pointer>& filters);
+
+private:
+  /**
+   * @brief Creates the crop or resample filters for every image geometry in the data container array
+   * @param dca
+   * @param filters
+   * @param errorMessage
+   * @return
+   */
+  bool createRegionFilters(const DataContainerArray::Pointer& dca, std::vector<AbstractFilter::Pointer>& filters, QString& errorMessage) const;
+};
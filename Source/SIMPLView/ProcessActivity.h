@@ -0,0 +1,87 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <QtCore/QtGlobal>
+
+/**
+ * @brief The ProcessActivity namespace keeps track of the work that runs inside the process besides a single run:
+ * other runs, their background writes, input prefetches and staging copies.  The CPU time and the I/O the process
+ * reports cover all of it, so a run can only attribute them to its filters while nothing else was active.
+ */
+namespace ProcessActivity
+{
+/**
+ * @brief The State struct is a snapshot of the activity of the process
+ */
+struct State
+{
+  int active = 0;      // Work that is active now
+  quint64 started = 0; // Work that started since the process did
+};
+
+/**
+ * @brief The Scope class marks work as active for as long as it exists
+ */
+class Scope
+{
+public:
+  Scope();
+  ~Scope();
+
+public:
+  Scope(const Scope&) = delete;            // Copy Constructor Not Implemented
+  Scope(Scope&&) = delete;                 // Move Constructor Not Implemented
+  Scope& operator=(const Scope&) = delete; // Copy Assignment Not Implemented
+  Scope& operator=(Scope&&) = delete;      // Move Assignment Not Implemented
+};
+
+/**
+ * @brief Returns the activity of the process now
+ * @return
+ */
+State Current();
+
+/**
+ * @brief Returns true if work other than the caller's own was active at some point between two snapshots that
+ * were taken while the caller's own scope existed
+ * @param start
+ * @param end
+ * @return
+ */
+bool OthersWereActive(const State& start, const State& end);
+
+} // namespace ProcessActivity
@@ -0,0 +1,131 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ProcessIo.h"
+
+#include <QtCore/QFile>
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(Q_OS_MAC)
+#include <libproc.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+// -----------------------------------------------------------------------------
+qint64 Subtract(qint64 start, qint64 end)
+{
+  return (start < 0 || end < 0) ? -1 : end - start;
+}
+} // namespace
+
+namespace ProcessIo
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Counters Read()
+{
+  Counters counters;
+#if defined(Q_OS_WIN)
+  // The transfer counts include devices other than files, but Windows has no storage counts per process
+  IO_COUNTERS ioCounters;
+  if(GetProcessIoCounters(GetCurrentProcess(), &ioCounters) != 0)
+  {
+    counters.readBytes = static_cast<qint64>(ioCounters.ReadTransferCount);
+    counters.writtenBytes = static_cast<qint64>(ioCounters.WriteTransferCount);
+  }
+#elif defined(Q_OS_MAC)
+  rusage_info_v2 usage;
+  if(proc_pid_rusage(getpid(), RUSAGE_INFO_V2, reinterpret_cast<rusage_info_t*>(&usage)) == 0)
+  {
+    counters.storageReadBytes = static_cast<qint64>(usage.ri_diskio_bytesread);
+    counters.storageWrittenBytes = static_cast<qint64>(usage.ri_diskio_byteswritten);
+  }
+#else
+  QFile io("/proc/self/io");
+  if(!io.open(QIODevice::ReadOnly))
+  {
+    return counters;
+  }
+  for(const QByteArray& line : io.readAll().split('\n'))
+  {
+    QList<QByteArray> fields = line.split(':');
+    if(fields.size() != 2)
+    {
+      continue;
+    }
+    QByteArray name = fields[0].trimmed();
+    qint64 value = fields[1].trimmed().toLongLong();
+    if(name == "rchar")
+    {
+      counters.readBytes = value;
+    }
+    else if(name == "wchar")
+    {
+      counters.writtenBytes = value;
+    }
+    else if(name == "read_bytes")
+    {
+      counters.storageReadBytes = value;
+    }
+    else if(name == "write_bytes")
+    {
+      counters.storageWrittenBytes = value;
+    }
+  }
+#endif
+  return counters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Counters Difference(const Counters& start, const Counters& end)
+{
+  Counters difference;
+  difference.readBytes = Subtract(start.readBytes, end.readBytes);
+  difference.writtenBytes = Subtract(start.writtenBytes, end.writtenBytes);
+  difference.storageReadBytes = Subtract(start.storageReadBytes, end.storageReadBytes);
+  difference.storageWrittenBytes = Subtract(start.storageWrittenBytes, end.storageWrittenBytes);
+  return difference;
+}
+
+} // namespace ProcessIo
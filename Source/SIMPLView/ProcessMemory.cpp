@@ -0,0 +1,131 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ProcessMemory.h"
+
+#include <QtCore/QFile>
+
+#if defined(Q_OS_WIN)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+
+#include <psapi.h>
+#elif defined(Q_OS_MAC)
+#include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ProcessMemory
+{
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 CurrentResidentBytes()
+{
+#if defined(Q_OS_WIN)
+  PROCESS_MEMORY_COUNTERS counters;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) != 0)
+  {
+    return static_cast<qint64>(counters.WorkingSetSize);
+  }
+  return 0;
+#elif defined(Q_OS_MAC)
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+  if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+  {
+    return static_cast<qint64>(info.resident_size);
+  }
+  return 0;
+#else
+  // The second field of statm is the resident size in pages
+  QFile statm("/proc/self/statm");
+  if(!statm.open(QIODevice::ReadOnly))
+  {
+    return 0;
+  }
+  QList<QByteArray> fields = statm.readAll().split(' ');
+  if(fields.size() < 2)
+  {
+    return 0;
+  }
+  return fields[1].toLongLong() * static_cast<qint64>(sysconf(_SC_PAGE_SIZE));
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 AvailablePhysicalBytes()
+{
+#if defined(Q_OS_WIN)
+  MEMORYSTATUSEX status;
+  status.dwLength = sizeof(status);
+  if(GlobalMemoryStatusEx(&status) != 0)
+  {
+    return static_cast<qint64>(status.ullAvailPhys);
+  }
+  return 0;
+#elif defined(Q_OS_MAC)
+  // Inactive pages are given up by other processes before the system swaps
+  vm_statistics64_data_t statistics;
+  mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+  if(host_statistics64(mach_host_self(), HOST_VM_INFO64, reinterpret_cast<host_info64_t>(&statistics), &count) == KERN_SUCCESS)
+  {
+    return (static_cast<qint64>(statistics.free_count) + static_cast<qint64>(statistics.inactive_count)) * static_cast<qint64>(vm_page_size);
+  }
+  return 0;
+#else
+  // MemAvailable already counts the page cache that can be dropped
+  QFile meminfo("/proc/meminfo");
+  if(!meminfo.open(QIODevice::ReadOnly))
+  {
+    return 0;
+  }
+  for(const QByteArray& line : meminfo.readAll().split('\n'))
+  {
+    if(line.startsWith("MemAvailable:"))
+    {
+      return line.mid(13).trimmed().split(' ').value(0).toLongLong() * 1024;
+    }
+  }
+  return 0;
+#endif
+}
+
+} // namespace ProcessMemory
@@ -0,0 +1,453 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ProcessPool.h"
+
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTimer>
+#include <QtCore/QVector>
+
+#include "SIMPLView/SIMPLViewConstants.h"
+
+const QString ProcessPool::WorkerArgument("--pipeline-worker");
+const QByteArray ProcessPool::LinePrefix("SIMPLViewWorker ");
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProcessPool::ProcessPool(int size, QObject* parent)
+: QObject(parent)
+, m_Size(std::max(size, 1))
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProcessPool::~ProcessPool()
+{
+  for(const std::unique_ptr<Worker>& worker : m_Workers)
+  {
+    worker->process->disconnect(this);
+    if(worker->process->state() == QProcess::Running)
+    {
+      QJsonObject command;
+      command["type"] = "quit";
+      send(*worker, command);
+      worker->process->closeWriteChannel();
+    }
+  }
+
+  // The workers were all asked to quit first so they shut down at the same time
+  for(const std::unique_ptr<Worker>& worker : m_Workers)
+  {
+    if(worker->process->state() != QProcess::NotRunning && !worker->process->waitForFinished(SIMPLView::Worker::QuitTimeout))
+    {
+      worker->process->kill();
+      worker->process->waitForFinished(SIMPLView::Worker::QuitTimeout);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::setSize(int size)
+{
+  m_Size = std::max(size, 1);
+  QMetaObject::invokeMethod(this, [this] { dispatch(); }, Qt::QueuedConnection);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ProcessPool::getSize() const
+{
+  return m_Size;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::warmUp()
+{
+  m_FailedStarts = 0;
+  int alive = static_cast<int>(std::count_if(m_Workers.begin(), m_Workers.end(), [](const std::unique_ptr<Worker>& worker) { return !worker->quitting; }));
+  for(; alive < m_Size; alive++)
+  {
+    startWorker();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ProcessPool::submit(const QJsonObject& pipeline)
+{
+  PendingJob job;
+  job.id = m_NextJobId++;
+  job.pipeline = pipeline;
+  m_Pending.push_back(job);
+
+  // Dispatch later so the caller knows the job id before jobStarted() is emitted
+  QMetaObject::invokeMethod(this, [this] { dispatch(); }, Qt::QueuedConnection);
+  return job.id;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::cancel(int jobId)
+{
+  auto pending = std::find_if(m_Pending.begin(), m_Pending.end(), [jobId](const PendingJob& job) { return job.id == jobId; });
+  if(pending != m_Pending.end())
+  {
+    m_Pending.erase(pending);
+    Result result;
+    result.cancelled = true;
+    Q_EMIT jobFinished(jobId, result);
+    return;
+  }
+
+  for(const std::unique_ptr<Worker>& worker : m_Workers)
+  {
+    if(worker->jobId != jobId || worker->cancelRequested)
+    {
+      continue;
+    }
+    worker->cancelRequested = true;
+    QJsonObject command;
+    command["type"] = "cancel";
+    command["id"] = jobId;
+    send(*worker, command);
+
+    // A filter that never checks for cancellation would keep the worker busy forever
+    QProcess* process = worker->process;
+    QTimer::singleShot(SIMPLView::Worker::CancelGracePeriod, process, [this, process, jobId] {
+      Worker* current = findWorker(process);
+      if(nullptr != current && current->jobId == jobId)
+      {
+        process->kill();
+      }
+    });
+    return;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ProcessPool::isIdle() const
+{
+  return m_Pending.empty() && std::none_of(m_Workers.begin(), m_Workers.end(), [](const std::unique_ptr<Worker>& worker) { return worker->jobId >= 0; });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::startWorker()
+{
+  std::unique_ptr<Worker> worker = std::make_unique<Worker>();
+  QProcess* process = new QProcess(this);
+  process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+  worker->process = process;
+
+  connect(process, &QProcess::readyReadStandardOutput, this, [this, process] { readWorkerOutput(process); });
+  connect(process, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [this, process] { workerExited(process); });
+  connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
+    // A process that failed to start never emits finished()
+    if(error == QProcess::FailedToStart)
+    {
+      workerExited(process);
+    }
+  });
+
+  m_Workers.push_back(std::move(worker));
+  process->start(QCoreApplication::applicationFilePath(), QStringList() << WorkerArgument);
+
+  // A worker that hangs before it is ready counts as a failed start once it is killed
+  QTimer::singleShot(SIMPLView::Worker::StartTimeout, process, [this, process] {
+    Worker* current = findWorker(process);
+    if(nullptr != current && !current->ready && !current->quitting)
+    {
+      process->kill();
+    }
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::dispatch()
+{
+  int alive = static_cast<int>(std::count_if(m_Workers.begin(), m_Workers.end(), [](const std::unique_ptr<Worker>& worker) { return !worker->quitting; }));
+
+  // Idle workers above the size quit; busy ones are handled once their job is done
+  for(const std::unique_ptr<Worker>& worker : m_Workers)
+  {
+    if(alive <= m_Size)
+    {
+      break;
+    }
+    if(!worker->quitting && worker->jobId < 0)
+    {
+      QJsonObject command;
+      command["type"] = "quit";
+      send(*worker, command);
+      worker->quitting = true;
+      alive--;
+    }
+  }
+
+  // Signals are emitted after the loop because a receiver may submit more jobs and start more workers
+  QVector<int> startedJobs;
+  for(const std::unique_ptr<Worker>& worker : m_Workers)
+  {
+    if(m_Pending.empty())
+    {
+      break;
+    }
+    if(!worker->ready || worker->quitting || worker->jobId >= 0)
+    {
+      continue;
+    }
+    PendingJob job = m_Pending.front();
+    m_Pending.pop_front();
+
+    worker->jobId = job.id;
+    worker->cancelRequested = false;
+    worker->timer.start();
+    QJsonObject command;
+    command["type"] = "run";
+    command["id"] = job.id;
+    command["pipeline"] = job.pipeline;
+    send(*worker, command);
+    startedJobs.push_back(job.id);
+  }
+
+  if(m_FailedStarts < SIMPLView::Worker::MaxFailedStarts)
+  {
+    int starting = static_cast<int>(std::count_if(m_Workers.begin(), m_Workers.end(), [](const std::unique_ptr<Worker>& worker) { return !worker->ready && !worker->quitting; }));
+    while(starting < static_cast<int>(m_Pending.size()) && alive < m_Size)
+    {
+      startWorker();
+      starting++;
+      alive++;
+    }
+  }
+
+  for(int jobId : startedJobs)
+  {
+    Q_EMIT jobStarted(jobId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProcessPool::Worker* ProcessPool::findWorker(QProcess* process) const
+{
+  auto iter = std::find_if(m_Workers.begin(), m_Workers.end(), [process](const std::unique_ptr<Worker>& worker) { return worker->process == process; });
+  return iter == m_Workers.end() ? nullptr : iter->get();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::send(Worker& worker, const QJsonObject& command)
+{
+  // Compact JSON escapes line breaks inside strings, so every command is exactly one line
+  QByteArray line = QJsonDocument(command).toJson(QJsonDocument::Compact);
+  line.append('\n');
+  worker.process->write(line);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::readWorkerOutput(QProcess* process)
+{
+  Worker* worker = findWorker(process);
+  if(nullptr == worker)
+  {
+    return;
+  }
+  worker->buffer.append(process->readAllStandardOutput());
+
+  int newline = worker->buffer.indexOf('\n');
+  while(newline >= 0)
+  {
+    QByteArray line = worker->buffer.left(newline).trimmed();
+    worker->buffer.remove(0, newline + 1);
+
+    // Anything else on standard output was printed by a filter
+    if(line.startsWith(LinePrefix))
+    {
+      QJsonDocument document = QJsonDocument::fromJson(line.mid(LinePrefix.size()));
+      if(document.isObject())
+      {
+        handleLine(*worker, document.object());
+      }
+    }
+
+    worker = findWorker(process);
+    if(nullptr == worker)
+    {
+      return;
+    }
+    newline = worker->buffer.indexOf('\n');
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::handleLine(Worker& worker, const QJsonObject& line)
+{
+  QString type = line["type"].toString();
+  int jobId = line["id"].toInt(-1);
+
+  if(type == "ready")
+  {
+    worker.ready = true;
+    m_FailedStarts = 0;
+    dispatch();
+  }
+  else if(jobId < 0 || jobId != worker.jobId)
+  {
+    return;
+  }
+  else if(type == "progress")
+  {
+    Q_EMIT jobProgress(jobId, line["progress"].toInt());
+  }
+  else if(type == "status")
+  {
+    Q_EMIT jobMessage(jobId, line["message"].toString());
+  }
+  else if(type == "finished")
+  {
+    Result result;
+    QString status = line["status"].toString();
+    result.succeeded = (status == "succeeded");
+    result.cancelled = (status == "cancelled");
+    QJsonArray errors = line["errors"].toArray();
+    for(const QJsonValue& error : errors)
+    {
+      result.errorMessages.push_back(error.toString());
+    }
+    result.elapsedMilliseconds = static_cast<qint64>(line["elapsed"].toDouble());
+    result.peakMemory = static_cast<qint64>(line["peakMemory"].toDouble());
+
+    worker.jobId = -1;
+    worker.cancelRequested = false;
+    Q_EMIT jobFinished(jobId, result);
+    dispatch();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::workerExited(QProcess* process)
+{
+  auto iter = std::find_if(m_Workers.begin(), m_Workers.end(), [process](const std::unique_ptr<Worker>& worker) { return worker->process == process; });
+  if(iter == m_Workers.end())
+  {
+    return;
+  }
+  std::unique_ptr<Worker> worker = std::move(*iter);
+  m_Workers.erase(iter);
+  process->deleteLater();
+
+  if(worker->ready)
+  {
+    m_FailedStarts = 0;
+  }
+  else if(!worker->quitting)
+  {
+    m_FailedStarts++;
+  }
+
+  if(worker->jobId >= 0)
+  {
+    Result result;
+    result.elapsedMilliseconds = worker->timer.elapsed();
+    if(worker->cancelRequested)
+    {
+      result.cancelled = true;
+    }
+    else
+    {
+      result.crashed = true;
+      if(process->exitStatus() == QProcess::CrashExit)
+      {
+        result.errorMessages.push_back(tr("The worker process running the pipeline crashed."));
+      }
+      else
+      {
+        result.errorMessages.push_back(tr("The worker process running the pipeline exited with code %1.").arg(process->exitCode()));
+      }
+    }
+    Q_EMIT jobFinished(worker->jobId, result);
+  }
+
+  if(m_FailedStarts >= SIMPLView::Worker::MaxFailedStarts)
+  {
+    failPendingJobs(tr("The worker processes could not be started."));
+    m_FailedStarts = 0;
+    return;
+  }
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ProcessPool::failPendingJobs(const QString& message)
+{
+  std::deque<PendingJob> pending;
+  pending.swap(m_Pending);
+  for(const PendingJob& job : pending)
+  {
+    Result result;
+    result.errorMessages.push_back(message);
+    Q_EMIT jobFinished(job.id, result);
+  }
+}
@@ -0,0 +1,205 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QProcess>
+#include <QtCore/QStringList>
+
+/**
+ * @brief The ProcessPool class runs pipelines in worker processes, so pipelines that run at the same time do not
+ * share the filter and plugin singletons and a crashing filter only takes its worker down.  The workers are this
+ * executable started with WorkerArgument; each loads the plugins once and then runs one pipeline after the other.
+ *
+ * The pool talks to a worker with one JSON object per line.  The pool writes {"type":"run","id":..,"pipeline":..},
+ * {"type":"cancel","id":..} and {"type":"quit"} to the worker's standard input.  The worker writes "ready",
+ * "progress", "status" and "finished" objects to its standard output, each line starting with
+ * LinePrefix so output of filters that print to standard output is ignored.
+ */
+class ProcessPool : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Result
+  {
+    bool succeeded = false;
+    bool cancelled = false;
+    bool crashed = false;
+    QStringList errorMessages;
+    qint64 elapsedMilliseconds = 0;
+    qint64 peakMemory = 0;
+  };
+
+  /**
+   * @brief The command line argument that starts the executable as a worker
+   */
+  static const QString WorkerArgument;
+
+  /**
+   * @brief The prefix of the protocol lines a worker writes
+   */
+  static const QByteArray LinePrefix;
+
+  ProcessPool(int size, QObject* parent = nullptr);
+
+  /**
+   * @brief Asks the workers to quit and kills the ones that do not
+   */
+  ~ProcessPool() override;
+
+  /**
+   * @brief Sets the number of worker processes.  Busy workers above the size quit once their pipeline is done.
+   * @param size
+   */
+  void setSize(int size);
+  int getSize() const;
+
+  /**
+   * @brief Starts the workers that are not running yet, so the next runs do not wait for plugins to load
+   */
+  void warmUp();
+
+  /**
+   * @brief Queues a pipeline.  It runs in the first worker that is ready.
+   * @param pipeline The JSON form of the pipeline
+   * @return The id of the job
+   */
+  int submit(const QJsonObject& pipeline);
+
+  /**
+   * @brief Cancels a job.  A worker that does not stop in time is killed.
+   * @param jobId
+   */
+  void cancel(int jobId);
+
+  /**
+   * @brief Returns true if no job is queued or running
+   * @return
+   */
+  bool isIdle() const;
+
+Q_SIGNALS:
+  void jobStarted(int jobId);
+  void jobProgress(int jobId, int percent);
+  void jobMessage(int jobId, const QString& message);
+  void jobFinished(int jobId, const ProcessPool::Result& result);
+
+private:
+  struct Worker
+  {
+    QProcess* process = nullptr;
+    bool ready = false;
+    bool quitting = false;
+    int jobId = -1;
+    bool cancelRequested = false;
+    QByteArray buffer;
+    QElapsedTimer timer;
+  };
+
+  struct PendingJob
+  {
+    int id = 0;
+    QJsonObject pipeline;
+  };
+
+  std::vector<std::unique_ptr<Worker>> m_Workers;
+  std::deque<PendingJob> m_Pending;
+  int m_Size = 1;
+  int m_NextJobId = 0;
+  int m_FailedStarts = 0;
+
+  /**
+   * @brief Starts one worker process.  It is killed if it is not ready within SIMPLView::Worker::StartTimeout.
+   */
+  void startWorker();
+
+  /**
+   * @brief Hands pending jobs to ready workers and starts workers while jobs wait
+   */
+  void dispatch();
+
+  /**
+   * @brief Returns the worker of a process, or nullptr
+   * @param process
+   * @return
+   */
+  Worker* findWorker(QProcess* process) const;
+
+  /**
+   * @brief Writes a command line to a worker
+   * @param worker
+   * @param command
+   */
+  void send(Worker& worker, const QJsonObject& command);
+
+  /**
+   * @brief Handles the complete lines a worker wrote
+   * @param process
+   */
+  void readWorkerOutput(QProcess* process);
+
+  /**
+   * @brief Handles one protocol line of a worker
+   * @param worker
+   * @param line
+   */
+  void handleLine(Worker& worker, const QJsonObject& line);
+
+  /**
+   * @brief Fails the job of a worker that died and replaces the worker
+   * @param process
+   */
+  void workerExited(QProcess* process);
+
+  /**
+   * @brief Fails the pending jobs when no worker can be started
+   * @param message
+   */
+  void failPendingJobs(const QString& message);
+
+public:
+  ProcessPool(const ProcessPool&) = delete;            // Copy Constructor Not Implemented
+  ProcessPool(ProcessPool&&) = delete;                 // Move Constructor Not Implemented
+  ProcessPool& operator=(const ProcessPool&) = delete; // Copy Assignment Not Implemented
+  ProcessPool& operator=(ProcessPool&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,417 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "RunHistory.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QSysInfo>
+#include <QtSql/QSqlDatabase>
+#include <QtSql/QSqlError>
+#include <QtSql/QSqlQuery>
+
+#include "SIMPLView/FilterTimingRecorder.h"
+#include "SIMPLView/InputPrefetcher.h"
+
+namespace
+{
+const size_t k_BaselineRuns = 10;
+const size_t k_MinimumBaselineRuns = 3;
+const double k_RegressionFactor = 1.5;
+
+// Short runs vary too much from run to run to be flagged
+const qint64 k_MinimumRegressionMilliseconds = 1000;
+
+// -----------------------------------------------------------------------------
+QJsonValue WithoutText(const QJsonValue& value)
+{
+  if(value.isObject())
+  {
+    QJsonObject object;
+    QJsonObject source = value.toObject();
+    for(auto iter = source.constBegin(); iter != source.constEnd(); ++iter)
+    {
+      if(!iter.value().isString())
+      {
+        object[iter.key()] = WithoutText(iter.value());
+      }
+    }
+    return object;
+  }
+  if(value.isArray())
+  {
+    QJsonArray array;
+    for(const QJsonValue& element : value.toArray())
+    {
+      if(!element.isString())
+      {
+        array.push_back(WithoutText(element));
+      }
+    }
+    return array;
+  }
+  return value;
+}
+
+// -----------------------------------------------------------------------------
+double Median(std::vector<double> values)
+{
+  std::sort(values.begin(), values.end());
+  size_t middle = values.size() / 2;
+  return (values.size() % 2 == 1) ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistory::RunHistory(QObject* parent)
+: QObject(parent)
+, m_ConnectionName(QString("RunHistory_%1").arg(reinterpret_cast<quintptr>(this)))
+{
+  QString databasePath = GetDatabasePath();
+  QDir().mkpath(QFileInfo(databasePath).absolutePath());
+
+  QSqlDatabase database = QSqlDatabase::addDatabase("QSQLITE", m_ConnectionName);
+  database.setDatabaseName(databasePath);
+  m_Open = database.open() && createTables();
+  if(!m_Open)
+  {
+    qDebug() << "Unable to open the run history: " << database.lastError().text();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistory::~RunHistory()
+{
+  // The connection can only be removed once no QSqlDatabase refers to it
+  {
+    QSqlDatabase database = QSqlDatabase::database(m_ConnectionName, false);
+    database.close();
+  }
+  QSqlDatabase::removeDatabase(m_ConnectionName);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RunHistory::GetDatabasePath()
+{
+  return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/RunHistory.sqlite";
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString RunHistory::PipelineHash(const QJsonObject& pipeline)
+{
+  // The filter versions are text as well, so a plugin update keeps the history of the pipeline
+  QJsonObject hashed;
+  for(auto iter = pipeline.constBegin(); iter != pipeline.constEnd(); ++iter)
+  {
+    if(iter.key() == "PipelineBuilder" || !iter.value().isObject())
+    {
+      continue;
+    }
+    QJsonObject filter = WithoutText(iter.value()).toObject();
+    filter["Filter_Name"] = iter.value().toObject()["Filter_Name"];
+    hashed[iter.key()] = filter;
+  }
+  return QString::fromLatin1(QCryptographicHash::hash(QJsonDocument(hashed).toJson(QJsonDocument::Compact), QCryptographicHash::Sha1).toHex());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 RunHistory::InputBytes(const QJsonObject& pipeline)
+{
+  qint64 bytes = 0;
+  for(const QString& filePath : InputPrefetcher::FindInputFiles(pipeline))
+  {
+    bytes += QFileInfo(filePath).size();
+  }
+  return bytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<RunHistory::FilterRun> RunHistory::FilterRuns(const FilterTimingRecorder& recorder)
+{
+  std::vector<FilterRun> filterRuns;
+  const PipelineCostEstimator::Estimate& estimate = recorder.getEstimate();
+  std::vector<qint64> milliseconds = recorder.getMilliseconds();
+  std::vector<qint64> peakMemory = recorder.getPeakMemory();
+  for(size_t i = 0; i < estimate.filters.size(); i++)
+  {
+    FilterRun filterRun;
+    filterRun.position = static_cast<int>(i);
+    filterRun.className = estimate.filters[i].className;
+    filterRun.humanLabel = estimate.filters[i].humanLabel;
+    filterRun.elapsedMilliseconds = milliseconds[i];
+    filterRun.peakMemory = peakMemory[i];
+    filterRun.workBytes = estimate.filters[i].workBytes;
+    filterRuns.push_back(filterRun);
+  }
+  return filterRuns;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RunHistory::isOpen() const
+{
+  return m_Open;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RunHistory::record(Run run)
+{
+  if(!m_Open)
+  {
+    return;
+  }
+  if(!run.started.isValid())
+  {
+    run.started = QDateTime::currentDateTime().addMSecs(-run.elapsedMilliseconds);
+  }
+  run.host = QSysInfo::machineHostName();
+
+  QSqlDatabase database = QSqlDatabase::database(m_ConnectionName);
+  database.transaction();
+
+  QSqlQuery query(database);
+  query.prepare("INSERT INTO Runs (PipelineHash, PipelineName, Started, Host, Threads, InputBytes, ElapsedMilliseconds, PeakMemory, Succeeded) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
+  query.addBindValue(run.pipelineHash);
+  query.addBindValue(run.pipelineName);
+  query.addBindValue(run.started.toMSecsSinceEpoch());
+  query.addBindValue(run.host);
+  query.addBindValue(run.threads);
+  query.addBindValue(run.inputBytes);
+  query.addBindValue(run.elapsedMilliseconds);
+  query.addBindValue(run.peakMemory);
+  query.addBindValue(run.succeeded ? 1 : 0);
+  if(!query.exec())
+  {
+    qDebug() << "Unable to record the run: " << query.lastError().text();
+    database.rollback();
+    return;
+  }
+  qint64 runId = query.lastInsertId().toLongLong();
+
+  query.prepare("INSERT INTO FilterRuns (RunId, Position, ClassName, HumanLabel, ElapsedMilliseconds, PeakMemory, WorkBytes) VALUES (?, ?, ?, ?, ?, ?, ?)");
+  for(const FilterRun& filterRun : run.filters)
+  {
+    // A filter that was not measured has nothing to compare
+    if(filterRun.elapsedMilliseconds < 0)
+    {
+      continue;
+    }
+    query.addBindValue(runId);
+    query.addBindValue(filterRun.position);
+    query.addBindValue(filterRun.className);
+    query.addBindValue(filterRun.humanLabel);
+    query.addBindValue(filterRun.elapsedMilliseconds);
+    query.addBindValue(filterRun.peakMemory);
+    query.addBindValue(filterRun.workBytes);
+    query.exec();
+  }
+  database.commit();
+
+  Q_EMIT runRecorded();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<std::pair<QString, QString>> RunHistory::getPipelines() const
+{
+  std::vector<std::pair<QString, QString>> pipelines;
+  if(!m_Open)
+  {
+    return pipelines;
+  }
+
+  QSqlQuery query(QSqlDatabase::database(m_ConnectionName));
+  query.exec("SELECT PipelineHash, PipelineName FROM Runs WHERE Id IN (SELECT MAX(Id) FROM Runs GROUP BY PipelineHash) ORDER BY Id DESC");
+  while(query.next())
+  {
+    pipelines.emplace_back(query.value(0).toString(), query.value(1).toString());
+  }
+  return pipelines;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList RunHistory::getFilterClassNames() const
+{
+  QStringList classNames;
+  if(!m_Open)
+  {
+    return classNames;
+  }
+
+  QSqlQuery query(QSqlDatabase::database(m_ConnectionName));
+  query.exec("SELECT DISTINCT ClassName FROM FilterRuns ORDER BY ClassName");
+  while(query.next())
+  {
+    classNames.push_back(query.value(0).toString());
+  }
+  return classNames;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<RunHistory::TrendPoint> RunHistory::getPipelineTrend(const QString& pipelineHash) const
+{
+  std::vector<TrendPoint> points;
+  if(!m_Open)
+  {
+    return points;
+  }
+
+  QSqlQuery query(QSqlDatabase::database(m_ConnectionName));
+  query.prepare("SELECT Id, Started, PipelineName, Host, ElapsedMilliseconds, InputBytes FROM Runs WHERE PipelineHash = ? AND Succeeded = 1 ORDER BY Started");
+  query.addBindValue(pipelineHash);
+  query.exec();
+  while(query.next())
+  {
+    TrendPoint point;
+    point.runId = query.value(0).toLongLong();
+    point.started = QDateTime::fromMSecsSinceEpoch(query.value(1).toLongLong());
+    point.pipelineName = query.value(2).toString();
+    point.host = query.value(3).toString();
+    point.elapsedMilliseconds = query.value(4).toLongLong();
+    point.workBytes = query.value(5).toLongLong();
+    points.push_back(point);
+  }
+
+  // The inputs of one pipeline rarely change much in size, and reading them is only part of the runtime
+  FlagRegressions(points, false);
+  return points;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<RunHistory::TrendPoint> RunHistory::getFilterTrend(const QString& className) const
+{
+  std::vector<TrendPoint> points;
+  if(!m_Open)
+  {
+    return points;
+  }
+
+  QSqlQuery query(QSqlDatabase::database(m_ConnectionName));
+  query.prepare("SELECT Runs.Id, Runs.Started, Runs.PipelineName, Runs.Host, FilterRuns.ElapsedMilliseconds, FilterRuns.WorkBytes FROM FilterRuns "
+                "JOIN Runs ON Runs.Id = FilterRuns.RunId WHERE FilterRuns.ClassName = ? AND Runs.Succeeded = 1 ORDER BY Runs.Started, FilterRuns.Position");
+  query.addBindValue(className);
+  query.exec();
+  while(query.next())
+  {
+    TrendPoint point;
+    point.runId = query.value(0).toLongLong();
+    point.started = QDateTime::fromMSecsSinceEpoch(query.value(1).toLongLong());
+    point.pipelineName = query.value(2).toString();
+    point.host = query.value(3).toString();
+    point.elapsedMilliseconds = query.value(4).toLongLong();
+    point.workBytes = query.value(5).toLongLong();
+    points.push_back(point);
+  }
+
+  // One filter works on data of very different sizes across pipelines
+  FlagRegressions(points, true);
+  return points;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool RunHistory::createTables()
+{
+  QSqlQuery query(QSqlDatabase::database(m_ConnectionName));
+  return query.exec("CREATE TABLE IF NOT EXISTS Runs (Id INTEGER PRIMARY KEY AUTOINCREMENT, PipelineHash TEXT NOT NULL, PipelineName TEXT, Started INTEGER NOT NULL, "
+                    "Host TEXT, Threads INTEGER, InputBytes INTEGER, ElapsedMilliseconds INTEGER, PeakMemory INTEGER, Succeeded INTEGER)") &&
+         query.exec("CREATE TABLE IF NOT EXISTS FilterRuns (RunId INTEGER NOT NULL REFERENCES Runs(Id), Position INTEGER, ClassName TEXT NOT NULL, HumanLabel TEXT, "
+                    "ElapsedMilliseconds INTEGER, PeakMemory INTEGER, WorkBytes INTEGER)") &&
+         query.exec("CREATE INDEX IF NOT EXISTS RunsByPipeline ON Runs (PipelineHash)") && query.exec("CREATE INDEX IF NOT EXISTS FilterRunsByClass ON FilterRuns (ClassName)");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RunHistory::FlagRegressions(std::vector<TrendPoint>& points, bool perByte)
+{
+  // Filters that work on no data are compared by their runtime, with each other
+  auto scaled = [perByte](const TrendPoint& point) { return perByte && point.workBytes > 0; };
+
+  for(size_t i = 0; i < points.size(); i++)
+  {
+    TrendPoint& point = points[i];
+    std::vector<double> previous;
+    for(size_t j = i; j > 0 && previous.size() < k_BaselineRuns; j--)
+    {
+      const TrendPoint& earlier = points[j - 1];
+      if(earlier.host != point.host || scaled(earlier) != scaled(point))
+      {
+        continue;
+      }
+      previous.push_back(scaled(earlier) ? static_cast<double>(earlier.elapsedMilliseconds) / earlier.workBytes : earlier.elapsedMilliseconds);
+    }
+    if(previous.size() < k_MinimumBaselineRuns)
+    {
+      continue;
+    }
+
+    double baseline = Median(previous);
+    point.baselineMilliseconds = static_cast<qint64>(scaled(point) ? baseline * point.workBytes : baseline);
+    point.regression = point.elapsedMilliseconds > point.baselineMilliseconds * k_RegressionFactor &&
+                       point.elapsedMilliseconds - point.baselineMilliseconds >= k_MinimumRegressionMilliseconds;
+  }
+}
@@ -0,0 +1,196 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+class FilterTimingRecorder;
+
+/**
+ * @brief The RunHistory class records every pipeline run of the application in a SQLite database in the application
+ * data directory: the pipeline, the host, the threads, the size of the inputs and the runtime and peak memory of
+ * the run and of each of its filters.
+ *
+ * A run is flagged as a regression when it took much longer than the median of the runs before it on the same
+ * host.  Filter runs are compared by their runtime per byte of data, so runs on inputs of different size can be
+ * compared; this shows when a plugin update made a filter slower.
+ */
+class RunHistory : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct FilterRun
+  {
+    int position = 0;
+    QString className;
+    QString humanLabel;
+    qint64 elapsedMilliseconds = -1; // -1 if the filter was not measured
+    qint64 peakMemory = 0;
+    qint64 workBytes = 0;
+  };
+
+  struct Run
+  {
+    qint64 id = 0;
+    QString pipelineHash;
+    QString pipelineName;
+    QDateTime started;
+    QString host;
+    int threads = 0;
+    qint64 inputBytes = 0;
+    qint64 elapsedMilliseconds = 0;
+    qint64 peakMemory = 0;
+    bool succeeded = false;
+    std::vector<FilterRun> filters;
+  };
+
+  /**
+   * @brief One point of a trend: a run of a pipeline or of a filter, with the baseline it is compared to
+   */
+  struct TrendPoint
+  {
+    qint64 runId = 0;
+    QDateTime started;
+    QString pipelineName;
+    QString host;
+    qint64 elapsedMilliseconds = 0;
+    qint64 workBytes = 0;
+    qint64 baselineMilliseconds = -1; // -1 until enough runs came before it
+    bool regression = false;
+  };
+
+  RunHistory(QObject* parent = nullptr);
+  ~RunHistory() override;
+
+  /**
+   * @brief Returns the file of the database
+   * @return
+   */
+  static QString GetDatabasePath();
+
+  /**
+   * @brief Hashes the filters and parameters of a pipeline.  Text parameters such as paths and array names are left
+   * out, so a pipeline that runs on new files keeps its history.
+   * @param pipeline
+   * @return
+   */
+  static QString PipelineHash(const QJsonObject& pipeline);
+
+  /**
+   * @brief Returns the total size of the files the input filters of a pipeline read
+   * @param pipeline
+   * @return
+   */
+  static qint64 InputBytes(const QJsonObject& pipeline);
+
+  /**
+   * @brief Returns the filters measured by a recorder
+   * @param recorder
+   * @return
+   */
+  static std::vector<FilterRun> FilterRuns(const FilterTimingRecorder& recorder);
+
+  /**
+   * @brief Returns true if the database could be opened
+   * @return
+   */
+  bool isOpen() const;
+
+  /**
+   * @brief Records a run.  The host and, if it is not set, the start time are filled in.
+   * @param run
+   */
+  void record(Run run);
+
+  /**
+   * @brief Returns the pipelines that have runs, as pairs of hash and the name of their last run, most recent first
+   * @return
+   */
+  std::vector<std::pair<QString, QString>> getPipelines() const;
+
+  /**
+   * @brief Returns the class names of the filters that have runs
+   * @return
+   */
+  QStringList getFilterClassNames() const;
+
+  /**
+   * @brief Returns the successful runs of a pipeline in the order they ran
+   * @param pipelineHash
+   * @return
+   */
+  std::vector<TrendPoint> getPipelineTrend(const QString& pipelineHash) const;
+
+  /**
+   * @brief Returns the measured runs of a filter in the order they ran, from every pipeline
+   * @param className
+   * @return
+   */
+  std::vector<TrendPoint> getFilterTrend(const QString& className) const;
+
+Q_SIGNALS:
+  void runRecorded();
+
+private:
+  QString m_ConnectionName;
+  bool m_Open = false;
+
+  /**
+   * @brief Creates the tables if they do not exist yet
+   * @return
+   */
+  bool createTables();
+
+  /**
+   * @brief Compares each point with the median of the points before it on the same host
+   * @param points
+   * @param perByte Compares the runtime per byte of data instead of the runtime
+   */
+  static void FlagRegressions(std::vector<TrendPoint>& points, bool perByte);
+
+public:
+  RunHistory(const RunHistory&) = delete;            // Copy Constructor Not Implemented
+  RunHistory(RunHistory&&) = delete;                 // Move Constructor Not Implemented
+  RunHistory& operator=(const RunHistory&) = delete; // Copy Assignment Not Implemented
+  RunHistory& operator=(RunHistory&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,298 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "RunHistoryDialog.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QLocale>
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/RunHistory.h"
+
+namespace
+{
+enum Kind
+{
+  PipelineKind = 0,
+  FilterKind
+};
+
+enum Column
+{
+  StartedColumn = 0,
+  PipelineColumn,
+  HostColumn,
+  DataColumn,
+  TimeColumn,
+  BaselineColumn,
+  ColumnCount
+};
+
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+} // namespace
+
+/**
+ * @brief The TrendPlot class plots the runtime of each run in the order they ran, with the baseline each run was
+ * compared to as a line.
+ */
+class RunHistoryDialog::TrendPlot : public QWidget
+{
+public:
+  TrendPlot(QWidget* parent)
+  : QWidget(parent)
+  {
+    setMinimumHeight(160);
+    setAutoFillBackground(true);
+    setBackgroundRole(QPalette::Base);
+  }
+
+  void setPoints(const std::vector<RunHistory::TrendPoint>& points)
+  {
+    m_Points = points;
+    update();
+  }
+
+protected:
+  void paintEvent(QPaintEvent* event) override
+  {
+    Q_UNUSED(event)
+    if(m_Points.empty())
+    {
+      return;
+    }
+
+    qint64 highest = 1;
+    for(const RunHistory::TrendPoint& point : m_Points)
+    {
+      highest = std::max({highest, point.elapsedMilliseconds, point.baselineMilliseconds});
+    }
+
+    const int margin = 8;
+    QRectF area = rect().adjusted(margin, margin, -margin, -margin);
+    auto position = [&](size_t i, qint64 milliseconds) {
+      double x = m_Points.size() > 1 ? area.left() + area.width() * i / (m_Points.size() - 1) : area.center().x();
+      return QPointF(x, area.bottom() - area.height() * milliseconds / highest);
+    };
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QPainterPath baseline;
+    for(size_t i = 0; i < m_Points.size(); i++)
+    {
+      if(m_Points[i].baselineMilliseconds < 0)
+      {
+        continue;
+      }
+      QPointF point = position(i, m_Points[i].baselineMilliseconds);
+      baseline.elementCount() == 0 ? baseline.moveTo(point) : baseline.lineTo(point);
+    }
+    painter.setPen(QPen(palette().color(QPalette::Mid), 1, Qt::DashLine));
+    painter.drawPath(baseline);
+
+    QPainterPath runtimes;
+    for(size_t i = 0; i < m_Points.size(); i++)
+    {
+      QPointF point = position(i, m_Points[i].elapsedMilliseconds);
+      i == 0 ? runtimes.moveTo(point) : runtimes.lineTo(point);
+    }
+    painter.setPen(QPen(palette().color(QPalette::Highlight), 1.5));
+    painter.drawPath(runtimes);
+
+    painter.setPen(Qt::NoPen);
+    for(size_t i = 0; i < m_Points.size(); i++)
+    {
+      painter.setBrush(m_Points[i].regression ? QColor(Qt::red) : palette().color(QPalette::Highlight));
+      painter.drawEllipse(position(i, m_Points[i].elapsedMilliseconds), 3.0, 3.0);
+    }
+  }
+
+private:
+  std::vector<RunHistory::TrendPoint> m_Points;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistoryDialog::RunHistoryDialog(RunHistory* runHistory, QWidget* parent)
+: QDialog(parent)
+, m_RunHistory(runHistory)
+{
+  setWindowTitle(tr("Run History"));
+  resize(760, 560);
+
+  m_KindCombo = new QComboBox(this);
+  m_KindCombo->addItems({tr("Pipeline"), tr("Filter Type")});
+  m_ItemCombo = new QComboBox(this);
+  m_ItemCombo->setSizeAdjustPolicy(QComboBox::AdjustToMinimumContentsLengthWithIcon);
+
+  QHBoxLayout* selectionLayout = new QHBoxLayout();
+  selectionLayout->addWidget(m_KindCombo);
+  selectionLayout->addWidget(m_ItemCombo, 1);
+
+  m_Plot = new TrendPlot(this);
+
+  m_RunsTree = new QTreeWidget(this);
+  m_RunsTree->setColumnCount(ColumnCount);
+  m_RunsTree->setHeaderLabels({tr("Started"), tr("Pipeline"), tr("Host"), tr("Data"), tr("Time"), tr("Baseline")});
+  m_RunsTree->setRootIsDecorated(false);
+  m_RunsTree->header()->setSectionResizeMode(PipelineColumn, QHeaderView::Stretch);
+
+  m_SummaryLabel = new QLabel(this);
+  m_SummaryLabel->setWordWrap(true);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+  connect(buttonBox, &QDialogButtonBox::rejected, this, &RunHistoryDialog::reject);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addLayout(selectionLayout);
+  layout->addWidget(m_Plot);
+  layout->addWidget(m_RunsTree, 1);
+  layout->addWidget(m_SummaryLabel);
+  layout->addWidget(buttonBox);
+
+  connect(m_KindCombo, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &RunHistoryDialog::refreshItems);
+  connect(m_ItemCombo, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged), this, &RunHistoryDialog::refreshTrend);
+  connect(m_RunHistory, &RunHistory::runRecorded, this, &RunHistoryDialog::refreshItems);
+
+  refreshItems();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistoryDialog::~RunHistoryDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RunHistoryDialog::refreshItems()
+{
+  // A new run keeps the selection when the list is refilled
+  QString selected = m_ItemCombo->currentData().toString();
+  {
+    QSignalBlocker blocker(m_ItemCombo);
+    m_ItemCombo->clear();
+    if(m_KindCombo->currentIndex() == PipelineKind)
+    {
+      for(const std::pair<QString, QString>& pipeline : m_RunHistory->getPipelines())
+      {
+        m_ItemCombo->addItem(pipeline.second.isEmpty() ? tr("Untitled") : pipeline.second, pipeline.first);
+      }
+    }
+    else
+    {
+      for(const QString& className : m_RunHistory->getFilterClassNames())
+      {
+        m_ItemCombo->addItem(className, className);
+      }
+    }
+    m_ItemCombo->setCurrentIndex(std::max(0, m_ItemCombo->findData(selected)));
+  }
+  refreshTrend();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RunHistoryDialog::refreshTrend()
+{
+  std::vector<RunHistory::TrendPoint> points;
+  QString key = m_ItemCombo->currentData().toString();
+  if(!key.isEmpty())
+  {
+    points = (m_KindCombo->currentIndex() == PipelineKind) ? m_RunHistory->getPipelineTrend(key) : m_RunHistory->getFilterTrend(key);
+  }
+  m_Plot->setPoints(points);
+
+  QLocale locale;
+  int regressions = 0;
+  m_RunsTree->clear();
+  for(auto iter = points.rbegin(); iter != points.rend(); ++iter)
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_RunsTree);
+    item->setText(StartedColumn, locale.toString(iter->started, QLocale::ShortFormat));
+    item->setText(PipelineColumn, iter->pipelineName);
+    item->setText(HostColumn, iter->host);
+    item->setText(DataColumn, locale.formattedDataSize(iter->workBytes));
+    item->setText(TimeColumn, FormatDuration(iter->elapsedMilliseconds));
+    item->setText(BaselineColumn, iter->baselineMilliseconds >= 0 ? FormatDuration(iter->baselineMilliseconds) : QString());
+    item->setTextAlignment(DataColumn, Qt::AlignRight | Qt::AlignVCenter);
+    item->setTextAlignment(TimeColumn, Qt::AlignRight | Qt::AlignVCenter);
+    item->setTextAlignment(BaselineColumn, Qt::AlignRight | Qt::AlignVCenter);
+    if(iter->regression)
+    {
+      regressions++;
+      for(int column = 0; column < ColumnCount; column++)
+      {
+        item->setForeground(column, QColor(Qt::red));
+      }
+      item->setToolTip(TimeColumn, tr("This run took much longer than the runs before it on the same host."));
+    }
+  }
+
+  if(!m_RunHistory->isOpen())
+  {
+    m_SummaryLabel->setText(tr("The run history could not be opened."));
+  }
+  else if(points.empty())
+  {
+    m_SummaryLabel->setText(tr("No runs have been recorded yet."));
+  }
+  else
+  {
+    QString summary = tr("%n run(s)", "", static_cast<int>(points.size()));
+    if(regressions > 0)
+    {
+      summary += ", " + tr("%n slower than the baseline", "", regressions);
+    }
+    m_SummaryLabel->setText(summary);
+  }
+}
@@ -0,0 +1,413 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "RunReportDialog.h"
+
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QLocale>
+#include <QtCore/QThread>
+#include <QtGui/QHelpEvent>
+#include <QtGui/QPainter>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QMessageBox>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QToolTip>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/FilterTimingRecorder.h"
+#include "SIMPLView/PipelineFileFormat.h"
+#include "SIMPLView/ProcessIo.h"
+
+namespace
+{
+enum Column
+{
+  FilterColumn = 0,
+  TimeColumn,
+  ParallelismColumn,
+  ReadColumn,
+  WrittenColumn,
+  MemoryColumn,
+  CyclesColumn,
+  InstructionsColumn,
+  IpcColumn,
+  CacheMissesColumn,
+  BranchMissesColumn,
+  ColumnCount
+};
+
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+// -----------------------------------------------------------------------------
+QString FormatCount(const QLocale& locale, qint64 count)
+{
+  if(count < 0)
+  {
+    return QString();
+  }
+  const char* suffixes[] = {"", " K", " M", " G", " T"};
+  double value = static_cast<double>(count);
+  int suffix = 0;
+  while(value >= 1000.0 && suffix < 4)
+  {
+    value /= 1000.0;
+    suffix++;
+  }
+  return locale.toString(value, 'f', suffix == 0 ? 0 : 2) + suffixes[suffix];
+}
+
+// -----------------------------------------------------------------------------
+QString FormatTransfer(const QLocale& locale, qint64 bytes, qint64 milliseconds)
+{
+  if(bytes < 0)
+  {
+    return QString();
+  }
+  if(milliseconds <= 0)
+  {
+    return locale.formattedDataSize(bytes);
+  }
+  return QString("%1 (%2/s)").arg(locale.formattedDataSize(bytes)).arg(locale.formattedDataSize(bytes * 1000 / milliseconds));
+}
+
+// -----------------------------------------------------------------------------
+QString CsvField(const QString& text)
+{
+  if(!text.contains(',') && !text.contains('"') && !text.contains('\n'))
+  {
+    return text;
+  }
+  return QString("\"%1\"").arg(QString(text).replace("\"", "\"\""));
+}
+
+// -----------------------------------------------------------------------------
+QString CsvNumber(qint64 value)
+{
+  return value < 0 ? QString() : QString::number(value);
+}
+} // namespace
+
+/**
+ * @brief The Timeline class plots how many threads worked over the run, with the filters as alternating bands.
+ * The dashed line marks the threads the machine can run at once.  The threads are those of the whole process, so
+ * other work of the application that ran at the same time shows up as well.
+ */
+class RunReportDialog::Timeline : public QWidget
+{
+public:
+  Timeline(const FilterTimingRecorder& recorder, QWidget* parent)
+  : QWidget(parent)
+  , m_Samples(recorder.getUtilizationSamples())
+  , m_StartMilliseconds(recorder.getStartMilliseconds())
+  , m_ElapsedMilliseconds(std::max(recorder.getElapsedMilliseconds(), static_cast<qint64>(1)))
+  {
+    for(const PipelineCostEstimator::FilterCost& cost : recorder.getEstimate().filters)
+    {
+      m_Labels.push_back(QString("[%1] %2").arg(cost.pipelineIndex + 1).arg(cost.humanLabel));
+    }
+    setMinimumHeight(120);
+    setAutoFillBackground(true);
+    setBackgroundRole(QPalette::Base);
+  }
+
+protected:
+  bool event(QEvent* event) override
+  {
+    if(event->type() != QEvent::ToolTip)
+    {
+      return QWidget::event(event);
+    }
+
+    // The filter under the mouse and the parallelism sampled there
+    QHelpEvent* helpEvent = static_cast<QHelpEvent*>(event);
+    qint64 milliseconds = static_cast<qint64>(static_cast<double>(helpEvent->pos().x()) / width() * m_ElapsedMilliseconds);
+    QString text;
+    for(size_t i = 0; i < m_StartMilliseconds.size(); i++)
+    {
+      if(m_StartMilliseconds[i] >= 0 && m_StartMilliseconds[i] <= milliseconds)
+      {
+        text = m_Labels[i];
+      }
+    }
+    auto sample = std::find_if(m_Samples.cbegin(), m_Samples.cend(), [milliseconds](const ThreadUtilizationSampler::Sample& sample) { return sample.milliseconds >= milliseconds; });
+    if(sample != m_Samples.cend())
+    {
+      text += (text.isEmpty() ? "" : "\n") + tr("%1 threads busy, parallelism %2").arg(sample->busyThreads).arg(QLocale().toString(sample->parallelism, 'f', 1));
+    }
+    QToolTip::showText(helpEvent->globalPos(), text, this);
+    return true;
+  }
+
+  void paintEvent(QPaintEvent* event) override
+  {
+    Q_UNUSED(event)
+    double threads = QThread::idealThreadCount();
+    double highest = threads;
+    for(const ThreadUtilizationSampler::Sample& sample : m_Samples)
+    {
+      highest = std::max(highest, sample.parallelism);
+    }
+    auto x = [this](qint64 milliseconds) { return static_cast<double>(width()) * milliseconds / m_ElapsedMilliseconds; };
+    auto y = [this, highest](double parallelism) { return height() - (height() - 4) * parallelism / highest; };
+
+    QPainter painter(this);
+    for(size_t i = 0; i < m_StartMilliseconds.size(); i++)
+    {
+      if(m_StartMilliseconds[i] < 0 || i % 2 == 1)
+      {
+        continue;
+      }
+      qint64 end = m_ElapsedMilliseconds;
+      if(i + 1 < m_StartMilliseconds.size() && m_StartMilliseconds[i + 1] >= 0)
+      {
+        end = m_StartMilliseconds[i + 1];
+      }
+      painter.fillRect(QRectF(x(m_StartMilliseconds[i]), 0, x(end) - x(m_StartMilliseconds[i]), height()), palette().color(QPalette::AlternateBase));
+    }
+
+    qint64 previous = 0;
+    for(const ThreadUtilizationSampler::Sample& sample : m_Samples)
+    {
+      painter.fillRect(QRectF(QPointF(x(previous), y(sample.parallelism)), QPointF(x(sample.milliseconds), height())), palette().color(QPalette::Highlight));
+      previous = sample.milliseconds;
+    }
+
+    painter.setPen(QPen(palette().color(QPalette::Text), 1, Qt::DashLine));
+    painter.drawLine(QPointF(0, y(threads)), QPointF(width(), y(threads)));
+  }
+
+private:
+  std::vector<ThreadUtilizationSampler::Sample> m_Samples;
+  std::vector<qint64> m_StartMilliseconds;
+  std::vector<QString> m_Labels;
+  qint64 m_ElapsedMilliseconds = 1;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunReportDialog::RunReportDialog(const FilterTimingRecorder& recorder, const QString& pipelineName, QWidget* parent)
+: QDialog(parent)
+, m_PipelineName(pipelineName)
+{
+  setWindowTitle(tr("Run Report - %1").arg(pipelineName));
+  resize(900, 480);
+  QLocale locale;
+
+  const PipelineCostEstimator::Estimate& estimate = recorder.getEstimate();
+  std::vector<qint64> milliseconds = recorder.getMilliseconds();
+  std::vector<qint64> peakMemory = recorder.getPeakMemory();
+  std::vector<PerformanceCounters::Values> counters = recorder.getCounters();
+  std::vector<qint64> cpuMilliseconds = recorder.getCpuMilliseconds();
+  std::vector<ProcessIo::Counters> io = recorder.getIo();
+  std::vector<bool> overlapped = recorder.getOverlapped();
+
+  QTreeWidget* filtersTree = new QTreeWidget(this);
+  filtersTree->setColumnCount(ColumnCount);
+  filtersTree->setHeaderLabels({tr("Filter"), tr("Time"), tr("Parallelism"), tr("Read"), tr("Written"), tr("Peak Memory"), tr("Cycles"), tr("Instructions"), tr("IPC"), tr("Cache Misses"), tr("Branch Misses")});
+  filtersTree->headerItem()->setToolTip(ParallelismColumn, tr("CPU time divided by wall time: how many threads the filter kept busy on average."));
+  filtersTree->headerItem()->setToolTip(ReadColumn, tr("Bytes read by the process while the filter ran, from local and network file systems, and the rate. Not attributed "
+                                                         "when other work of the application ran at the same time."));
+  filtersTree->headerItem()->setToolTip(WrittenColumn, tr("Bytes written by the process while the filter ran, and the rate."));
+  filtersTree->headerItem()->setToolTip(IpcColumn, tr("Instructions per cycle. A low value with many cache misses points to a filter that waits on memory."));
+  filtersTree->setRootIsDecorated(false);
+  filtersTree->header()->setSectionResizeMode(FilterColumn, QHeaderView::Stretch);
+
+  m_CsvLines.push_back("Position,Filter,Class,Milliseconds,CPU Milliseconds,Parallelism,Read Bytes,Written Bytes,Storage Read Bytes,Storage Written Bytes,Peak Memory Bytes,Cycles,Instructions,Cache Misses,"
+                       "Branch Misses,Overlapped");
+  bool counted = false;
+  int overlappedCount = 0;
+  qint64 totalRead = 0;
+  qint64 totalWritten = 0;
+  for(size_t i = 0; i < estimate.filters.size(); i++)
+  {
+    const PipelineCostEstimator::FilterCost& cost = estimate.filters[i];
+    const PerformanceCounters::Values& values = counters[i];
+    counted = counted || values.cycles >= 0 || values.instructions >= 0;
+
+    QTreeWidgetItem* item = new QTreeWidgetItem(filtersTree);
+    item->setText(FilterColumn, QString("[%1] %2").arg(cost.pipelineIndex + 1).arg(cost.humanLabel));
+    item->setText(TimeColumn, milliseconds[i] >= 0 ? FormatDuration(milliseconds[i]) : tr("Not measured"));
+    QString parallelism;
+    if(milliseconds[i] > 0 && cpuMilliseconds[i] >= 0)
+    {
+      parallelism = QString::number(static_cast<double>(cpuMilliseconds[i]) / milliseconds[i], 'f', 2);
+      item->setText(ParallelismColumn, locale.toString(static_cast<double>(cpuMilliseconds[i]) / milliseconds[i], 'f', 1) + "x");
+      if(overlapped[i])
+      {
+        // The CPU time is of the whole process, so it is kept but marked
+        item->setText(ParallelismColumn, item->text(ParallelismColumn) + "*");
+        item->setToolTip(ParallelismColumn, tr("Unreliable: includes the CPU time of other work of the application that ran at the same time."));
+      }
+    }
+    // Where the system calls are not counted, what reached the disks is all there is
+    const ProcessIo::Counters& filterIo = io[i];
+    qint64 readBytes = filterIo.readBytes >= 0 ? filterIo.readBytes : filterIo.storageReadBytes;
+    qint64 writtenBytes = filterIo.writtenBytes >= 0 ? filterIo.writtenBytes : filterIo.storageWrittenBytes;
+    item->setText(ReadColumn, FormatTransfer(locale, readBytes, milliseconds[i]));
+    item->setText(WrittenColumn, FormatTransfer(locale, writtenBytes, milliseconds[i]));
+    if(overlapped[i])
+    {
+      // The process only counts its I/O as a whole, which then includes the other work
+      overlappedCount++;
+      item->setText(ReadColumn, tr("Not attributed"));
+      item->setText(WrittenColumn, tr("Not attributed"));
+      item->setToolTip(ReadColumn, tr("Other work of the application ran while this filter ran."));
+      item->setToolTip(WrittenColumn, tr("Other work of the application ran while this filter ran."));
+    }
+    else if(filterIo.readBytes >= 0 && filterIo.storageReadBytes >= 0)
+    {
+      // Much more read than fetched from disk comes from the page cache or from a network file system
+      item->setToolTip(ReadColumn, tr("%1 fetched from local disks").arg(locale.formattedDataSize(filterIo.storageReadBytes)));
+    }
+    if(!overlapped[i] && filterIo.writtenBytes >= 0 && filterIo.storageWrittenBytes >= 0)
+    {
+      item->setToolTip(WrittenColumn, tr("%1 sent to local disks").arg(locale.formattedDataSize(filterIo.storageWrittenBytes)));
+    }
+    totalRead += std::max(readBytes, static_cast<qint64>(0));
+    totalWritten += std::max(writtenBytes, static_cast<qint64>(0));
+
+    item->setText(MemoryColumn, peakMemory[i] > 0 ? locale.formattedDataSize(peakMemory[i]) : QString());
+    item->setText(CyclesColumn, FormatCount(locale, values.cycles));
+    item->setText(InstructionsColumn, FormatCount(locale, values.instructions));
+    if(values.cycles > 0 && values.instructions >= 0)
+    {
+      item->setText(IpcColumn, locale.toString(static_cast<double>(values.instructions) / values.cycles, 'f', 2));
+    }
+    item->setText(CacheMissesColumn, FormatCount(locale, values.cacheMisses));
+    if(values.cacheMisses >= 0 && values.instructions > 0)
+    {
+      item->setToolTip(CacheMissesColumn, tr("%1 per 1000 instructions").arg(locale.toString(values.cacheMisses * 1000.0 / values.instructions, 'f', 2)));
+    }
+    item->setText(BranchMissesColumn, FormatCount(locale, values.branchMisses));
+    if(overlapped[i] && (values.cycles >= 0 || values.instructions >= 0))
+    {
+      for(int column = CyclesColumn; column <= BranchMissesColumn; column++)
+      {
+        if(!item->text(column).isEmpty())
+        {
+          item->setText(column, item->text(column) + "*");
+          item->setToolTip(column, tr("Unreliable: includes the threads of other work of the application that ran at the same time."));
+        }
+      }
+    }
+    for(int column = TimeColumn; column < ColumnCount; column++)
+    {
+      item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+    }
+
+    QStringList fields;
+    fields << QString::number(cost.pipelineIndex + 1) << CsvField(cost.humanLabel) << CsvField(cost.className);
+    fields << CsvNumber(milliseconds[i]) << CsvNumber(cpuMilliseconds[i]) << parallelism;
+    fields << CsvNumber(filterIo.readBytes) << CsvNumber(filterIo.writtenBytes) << CsvNumber(filterIo.storageReadBytes) << CsvNumber(filterIo.storageWrittenBytes);
+    fields << CsvNumber(peakMemory[i]) << CsvNumber(values.cycles) << CsvNumber(values.instructions) << CsvNumber(values.cacheMisses) << CsvNumber(values.branchMisses);
+    fields << QString::number(overlapped[i] ? 1 : 0);
+    m_CsvLines.push_back(fields.join(','));
+  }
+
+  // Without counters their columns would only be empty
+  for(int column = CyclesColumn; column <= BranchMissesColumn; column++)
+  {
+    filtersTree->setColumnHidden(column, !counted);
+  }
+
+  QString summary = tr("Total time: %1").arg(FormatDuration(recorder.getElapsedMilliseconds()));
+  summary += "\n" + tr("Read: %1, written: %2").arg(FormatTransfer(locale, totalRead, recorder.getElapsedMilliseconds()), FormatTransfer(locale, totalWritten, recorder.getElapsedMilliseconds()));
+  if(overlappedCount > 0)
+  {
+    summary += "\n" + tr("Other runs, prefetches, copies or background writes of the application were active while %n filter(s) ran. Their I/O is not attributed to "
+                         "them or counted in the totals, and their parallelism (marked *) includes the other work, as does the timeline.",
+                         "", overlappedCount);
+  }
+  if(counted)
+  {
+    // The counters follow the threads of the process, not the run
+    summary += "\n" + tr("Hardware events are counted on every thread of the process except the one of the window, including threads that work for other runs. "
+                         "A thread is only counted from the first message of the pipeline after it started, so short-lived threads may be missed.");
+  }
+  QLabel* summaryLabel = new QLabel(summary, this);
+  summaryLabel->setWordWrap(true);
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+  QPushButton* exportButton = buttonBox->addButton(tr("Export..."), QDialogButtonBox::ActionRole);
+  connect(exportButton, &QPushButton::clicked, this, &RunReportDialog::exportReport);
+  connect(buttonBox, &QDialogButtonBox::rejected, this, &RunReportDialog::reject);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  if(!recorder.getUtilizationSamples().empty())
+  {
+    Timeline* timeline = new Timeline(recorder, this);
+    layout->addWidget(timeline);
+  }
+  layout->addWidget(filtersTree, 1);
+  layout->addWidget(summaryLabel);
+  layout->addWidget(buttonBox);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunReportDialog::~RunReportDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void RunReportDialog::exportReport()
+{
+  QString proposedFile = QDir::homePath() + "/" + QFileInfo(m_PipelineName).completeBaseName() + "_RunReport.csv";
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Export Run Report"), proposedFile, tr("CSV File (*.csv);;All Files (*.*)"));
+  if(filePath.isEmpty())
+  {
+    return;
+  }
+
+  QString errorMessage;
+  if(!PipelineFileFormat::WriteFileAtomically(filePath, (m_CsvLines.join('\n') + '\n').toUtf8(), errorMessage))
+  {
+    QMessageBox::critical(this, tr("Export Run Report"), tr("The report could not be written: %1").arg(errorMessage));
+  }
+}
@@ -74,6 +74,11 @@
 #include "SVWidgetsLib/Widgets/SVStyle.h"
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/BatchQueue.h"
+#include "SIMPLView/ExecutionScheduler.h"
+#include "SIMPLView/PipelineJournal.h"
+#include "SIMPLView/ProcessPool.h"
+#include "SIMPLView/RunHistory.h"
 #include "SIMPLView/SIMPLView.h"
 #include "SIMPLView/SIMPLViewConstants.h"
 #include "SIMPLView/SIMPLViewVersion.h"
@@ -145,6 +150,11 @@ SIMPLViewApplication::SIMPLViewApplication(int& argc, char** argv)
 
   readSettings();
 
+  m_ExecutionScheduler = new ExecutionScheduler(this);
+  m_ProcessPool = new ProcessPool(1, this);
+  m_RunHistory = new RunHistory(this);
+  m_BatchQueue = new BatchQueue(m_ExecutionScheduler, m_ProcessPool, m_RunHistory, this);
+
   // Create the default menu bar
   createDefaultMenuBar();
 
@@ -169,6 +179,14 @@ SIMPLViewApplication::~SIMPLViewApplication()
   delete this->m_SplashScreen;
   this->m_SplashScreen = nullptr;
 
+  // The batch queue cancels its jobs in the scheduler and the process pool, so it goes first
+  delete m_BatchQueue;
+  m_BatchQueue = nullptr;
+  delete m_ProcessPool;
+  m_ProcessPool = nullptr;
+  delete m_RunHistory;
+  m_RunHistory = nullptr;
+
   for(int i = 0; i < m_PluginLoaders.size(); i++)
   {
     delete m_PluginLoaders[i];
@@ -277,7 +295,7 @@ bool SIMPLViewApplication::initialize(int argc, char* argv[])
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
+QStringList SIMPLViewApplication::FindPluginFilePaths()
 {
   QStringList pluginDirs;
   pluginDirs << applicationDirPath();
@@ -400,6 +418,16 @@ QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
     }
   }
 
+  return pluginFilePaths;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QVector<ISIMPLibPlugin*> SIMPLViewApplication::loadPlugins()
+{
+  QStringList pluginFilePaths = FindPluginFilePaths();
+
   FilterManager* filterManager = FilterManager::Instance();
   FilterWidgetManager* fwm = FilterWidgetManager::Instance();
 
@@ -512,7 +540,7 @@ void SIMPLViewApplication::listenNewInstanceTriggered()
 void SIMPLViewApplication::listenOpenPipelineTriggered()
 {
   QString proposedDir = m_OpenDialogLastFilePath;
-  QString filePath = QFileDialog::getOpenFileName(nullptr, tr("Open Pipeline"), proposedDir, tr("Json File (*.json);;DREAM3D File (*.dream3d);;All Files (*.*)"));
+  QString filePath = QFileDialog::getOpenFileName(nullptr, tr("Open Pipeline"), proposedDir, tr("Json File (*.json);;CBOR Pipeline File (*.cbor);;DREAM3D File (*.dream3d);;All Files (*.*)"));
   if(filePath.isEmpty())
   {
     return;
@@ -1076,49 +1104,17 @@ void SIMPLViewApplication::reloadPythonFilters()
     }
   }
 
-  static const QString k_UndoStackMessageKey = "DisplayClearUndoStackMessageBox";
-
-  QtSSettings settings;
-  bool displayDialog = settings.value(k_UndoStackMessageKey, true).toBool();
-
+  // The undo histories hold serialized pipelines and are kept, but the commands of the views hold instances of the
+  // Python filters that are about to be removed
   for(SIMPLView_UI* instance : m_SIMPLViewInstances)
   {
-    if(!instance->undoStackIsClear())
-    {
-      int result = QMessageBox::StandardButton::Yes;
-
-      if(displayDialog)
-      {
-        QCheckBox* checkBox = new QCheckBox("Do not ask me this again");
-        QMessageBox messageBox;
-        messageBox.setWindowTitle("Warning");
-        messageBox.setText("In order to reload Python filters, the undo stack must be cleared. Continue?");
-        messageBox.setIcon(QMessageBox::Icon::Warning);
-        messageBox.addButton(QMessageBox::StandardButton::No);
-        messageBox.addButton(QMessageBox::StandardButton::Yes);
-        messageBox.setDefaultButton(QMessageBox::StandardButton::No);
-        // Takes ownership
-        messageBox.setCheckBox(checkBox);
-
-        result = messageBox.exec();
-
-        displayDialog = !checkBox->isChecked();
-        settings.setValue(k_UndoStackMessageKey, displayDialog);
-      }
-
-      switch(result)
-      {
-      case QMessageBox::StandardButton::Yes:
-        instance->clearUndoStack();
-        break;
-      default:
-        return;
-      }
-    }
+    instance->clearUndoStack();
   }
 
+  // Each affected pipeline is cleared and rebuilt inside one transaction so it is refreshed only once
   for(auto&& [instance, pipeline] : savedPipelines)
   {
+    instance->beginPipelineTransaction("Reload Python Filters");
     instance->clearPipeline(false);
     instance->clearUndoStack();
   }
@@ -1156,6 +1152,7 @@ void SIMPLViewApplication::reloadPythonFilters()
   for(auto&& [instance, json] : savedPipelines)
   {
     instance->deserializePipeline(json);
+    instance->endPipelineTransaction();
   }
 
   Q_EMIT filterFactoriesUpdated();
@@ -1447,6 +1444,87 @@ void SIMPLViewApplication::createMacDockMenu()
 #endif
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::preservePipelineJournals()
+{
+  for(SIMPLView_UI* instance : m_SIMPLViewInstances)
+  {
+    instance->preservePipelineJournal();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewApplication::recoverPipelineJournals()
+{
+  QStringList journals = PipelineJournal::FindRecoverableJournals();
+
+  // Journals without unsaved changes have nothing worth recovering
+  struct RecoverablePipeline
+  {
+    QString journalPath;
+    QJsonObject pipeline;
+    QString pipelineFilePath;
+  };
+  std::vector<RecoverablePipeline> recoverablePipelines;
+  for(const QString& journalPath : journals)
+  {
+    RecoverablePipeline recoverable;
+    recoverable.journalPath = journalPath;
+    bool modified = false;
+    if(PipelineJournal::Replay(journalPath, recoverable.pipeline, recoverable.pipelineFilePath, modified) && modified)
+    {
+      recoverablePipelines.push_back(recoverable);
+    }
+    else
+    {
+      PipelineJournal::Remove(journalPath);
+    }
+  }
+
+  if(recoverablePipelines.empty())
+  {
+    return;
+  }
+
+  QMessageBox messageBox;
+  messageBox.setWindowTitle("Recover Pipelines");
+  messageBox.setText(QString("%1 did not shut down cleanly and %2 unsaved pipeline(s) can be recovered.").arg(BrandedStrings::ApplicationName).arg(recoverablePipelines.size()));
+  messageBox.setInformativeText("Would you like to recover them? Choose Cancel to be asked again on the next launch.");
+  messageBox.setIcon(QMessageBox::Icon::Question);
+  messageBox.setStandardButtons(QMessageBox::Yes | QMessageBox::Discard | QMessageBox::Cancel);
+  messageBox.setDefaultButton(QMessageBox::Yes);
+  int result = messageBox.exec();
+
+  if(result == QMessageBox::Cancel)
+  {
+    return;
+  }
+
+  for(const RecoverablePipeline& recoverable : recoverablePipelines)
+  {
+    if(result == QMessageBox::Yes)
+    {
+      // The recovered window starts its own journal
+      SIMPLView_UI* ui = getNewSIMPLViewInstance();
+      ui->show();
+      ui->deserializePipeline(recoverable.pipeline);
+      if(!recoverable.pipelineFilePath.isEmpty())
+      {
+        QFileInfo fi(recoverable.pipelineFilePath);
+        ui->setWindowTitle(QString("[*]") + fi.baseName() + " - " + QApplication::applicationName());
+        ui->setWindowFilePath(recoverable.pipelineFilePath);
+      }
+      ui->setWindowModified(true);
+    }
+
+    PipelineJournal::Remove(recoverable.journalPath);
+  }
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -1455,6 +1533,38 @@ QMenu* SIMPLViewApplication::getRecentFilesMenu()
   return m_MenuRecentFiles;
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExecutionScheduler* SIMPLViewApplication::getExecutionScheduler() const
+{
+  return m_ExecutionScheduler;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+BatchQueue* SIMPLViewApplication::getBatchQueue() const
+{
+  return m_BatchQueue;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ProcessPool* SIMPLViewApplication::getProcessPool() const
+{
+  return m_ProcessPool;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+RunHistory* SIMPLViewApplication::getRunHistory() const
+{
+  return m_RunHistory;
+}
+
 // -----------------------------------------------------------------------------
 bool SIMPLViewApplication::notify(QObject* receiver, QEvent* event)
 {
@@ -1473,6 +1583,7 @@ bool SIMPLViewApplication::notify(QObject* receiver, QEvent* event)
     qCritical().noquote() << exception.what();
     if(exceptionDepth <= 1)
     {
+      preservePipelineJournals();
       DetailedErrorDialog::critical(nullptr, "Error", message, exception.what());
     }
     else
@@ -1488,6 +1599,7 @@ bool SIMPLViewApplication::notify(QObject* receiver, QEvent* event)
     qCritical().noquote() << message;
     if(exceptionDepth <= 1)
     {
+      preservePipelineJournals();
       QMessageBox::critical(nullptr, "Error", message);
     }
     else
@@ -53,6 +53,10 @@ class ISIMPLibPlugin;
 class SIMPLViewToolbox;
 class SVPipelineFilterWidget;
 class SVPipelineViewWidget;
+class BatchQueue;
+class ExecutionScheduler;
+class ProcessPool;
+class RunHistory;
 
 /**
  * @brief The SIMPLViewApplication class
@@ -78,6 +82,13 @@ public:
    */
   static UpdateCheck::SIMPLVersionData_t FillVersionData();
 
+  /**
+   * @brief Returns the plugin files next to the application and in SIMPL_PLUGIN_PATH.  This may change the
+   * working directory the same way the application always did before loading plugins.
+   * @return
+   */
+  static QStringList FindPluginFilePaths();
+
   bool initialize(int argc, char* argv[]);
 
   /**
@@ -121,6 +132,30 @@ public:
    */
   QMenu* getRecentFilesMenu();
 
+  /**
+   * @brief Returns the scheduler that all windows run their pipelines through
+   * @return
+   */
+  ExecutionScheduler* getExecutionScheduler() const;
+
+  /**
+   * @brief Returns the queue of pipeline files that run without a window
+   * @return
+   */
+  BatchQueue* getBatchQueue() const;
+
+  /**
+   * @brief Returns the worker processes that run pipelines isolated from the application
+   * @return
+   */
+  ProcessPool* getProcessPool() const;
+
+  /**
+   * @brief Returns the record of the pipeline runs of the application
+   * @return
+   */
+  RunHistory* getRunHistory() const;
+
 #ifdef SIMPL_EMBED_PYTHON
   /**
    * @brief Enables/disables GUI elements for Python functionality based on value
@@ -162,6 +197,12 @@ public Q_SLOTS:
    */
   void updateRecentFileList(const QString& file);
 
+  /**
+   * @brief Offers to restore the unsaved pipelines that were left in journals by a session that did not
+   * shut down cleanly
+   */
+  void recoverPipelineJournals();
+
 protected:
   // This is a set of all SIMPLView instances currently available
   QList<SIMPLView_UI*> m_SIMPLViewInstances;
@@ -186,6 +227,12 @@ protected:
    */
   void checkForUpdatesAtStartup();
 
+  /**
+   * @brief Writes out and keeps the journals of every open window, so their pipelines can be recovered
+   * on the next launch
+   */
+  void preservePipelineJournals();
+
 protected Q_SLOTS:
   /**
    * @brief versionCheckReply
@@ -204,6 +251,11 @@ private:
 
   QSharedPointer<UpdateCheck> m_UpdateCheck;
 
+  ExecutionScheduler* m_ExecutionScheduler = nullptr;
+  BatchQueue* m_BatchQueue = nullptr;
+  ProcessPool* m_ProcessPool = nullptr;
+  RunHistory* m_RunHistory = nullptr;
+
   QString m_LastFilePathOpened;
 
   QMenu* m_MenuFile = nullptr;
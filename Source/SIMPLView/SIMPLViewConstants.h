@@ -49,4 +49,49 @@ static const QString LastVersionCheck("LastVersionCheck");
 static const QString WhenToCheck("WhenToCheck");
 static const QString UpdateWebSite("http://dream3d.bluequartz.net/dream3d_version.json");
 } // namespace UpdateWebsite
+
+namespace UndoHistory
+{
+static const QString GroupName("UndoHistory");
+static const QString ByteBudget("ByteBudget");
+static const qint64 DefaultByteBudget = 64 * 1024 * 1024;
+} // namespace UndoHistory
+
+namespace ExecutionQueue
+{
+static const QString GroupName("ExecutionQueue");
+static const QString ThreadLimit("ThreadLimit");
+static const QString MemoryLimit("MemoryLimit");
+static const QString ThreadsPerRun("ThreadsPerRun");
+static const double DefaultMemoryFraction = 0.8;
+static const int EndedJobsShown = 50;
+} // namespace ExecutionQueue
+
+namespace Batch
+{
+static const QString GroupName("BatchQueue");
+static const QString Concurrency("Concurrency");
+static const QString Isolated("Isolated");
+static const QString PrefetchBudget("PrefetchBudget");
+static const QString BackgroundWrites("BackgroundWrites");
+static const QString ScratchDirectory("ScratchDirectory");
+static const int DefaultPrefetchMemoryDivisor = 8;
+static const int MemorySampleInterval = 500;
+} // namespace Batch
+
+namespace Profiling
+{
+static const QString GroupName("Profiling");
+static const QString HardwareCounters("HardwareCounters");
+} // namespace Profiling
+
+namespace Worker
+{
+static const QString BatchArgument("--batch");
+static const QString WorkersArgument("--workers");
+static const int QuitTimeout = 3000;
+static const int StartTimeout = 30000;
+static const int CancelGracePeriod = 10000;
+static const int MaxFailedStarts = 3;
+} // namespace Worker
 } // namespace SIMPLView
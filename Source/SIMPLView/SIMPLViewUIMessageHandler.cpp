@@ -36,15 +36,27 @@
 #include "SIMPLViewUIMessageHandler.h"
 
 #include <QtCore/QTextStream>
+#include <QtWidgets/QLabel>
 
 #include "SIMPLib/Messages/FilterProgressMessage.h"
 #include "SIMPLib/Messages/FilterStatusMessage.h"
 #include "SIMPLib/Messages/PipelineProgressMessage.h"
 #include "SIMPLib/Messages/PipelineStatusMessage.h"
 
+#include "SIMPLView/FilterTimingRecorder.h"
 #include "SIMPLView/SIMPLView_UI.h"
 #include "SVWidgetsLib/Widgets/SVStyle.h"
 
+namespace
+{
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -69,13 +81,26 @@ void SIMPLViewUIMessageHandler::processMessage(const FilterStatusMessage* msg) c
   appendStatusMessageToPipelineOutput(statusMessage);
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLViewUIMessageHandler::processMessage(const FilterProgressMessage* msg) const
+{
+  Q_UNUSED(msg)
+  showForecast();
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 void SIMPLViewUIMessageHandler::processMessage(const PipelineProgressMessage* msg) const
 {
-  float progValue = static_cast<float>(msg->getProgressValue()) / 100;
-  m_UIWidget->m_Ui->pipelineListWidget->setProgressValue(progValue);
+  // The count of the filters that ran is all that is left when none of them ran before
+  if(!showForecast())
+  {
+    float progValue = static_cast<float>(msg->getProgressValue()) / 100;
+    m_UIWidget->m_Ui->pipelineListWidget->setProgressValue(progValue);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -116,3 +141,32 @@ void SIMPLViewUIMessageHandler::appendStatusMessageToPipelineOutput(const QStrin
 
   m_UIWidget->m_Ui->stdOutWidget->appendText(statusMessage);
 }
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLViewUIMessageHandler::showForecast() const
+{
+  if(nullptr == m_UIWidget->m_TimingRecorder)
+  {
+    return false;
+  }
+  FilterTimingRecorder::Forecast forecast = m_UIWidget->m_TimingRecorder->forecast();
+  if(forecast.progress < 0.0)
+  {
+    return false;
+  }
+
+  m_UIWidget->m_Ui->pipelineListWidget->setProgressValue(static_cast<float>(forecast.progress));
+
+  QLabel* forecastLabel = m_UIWidget->m_PipelineForecastLabel;
+  forecastLabel->setText(QObject::tr("Remaining: %1").arg(FormatDuration(forecast.remainingMilliseconds)));
+  QString toolTip;
+  if(forecast.unpredictedFilters > 0)
+  {
+    toolTip = QObject::tr("%n filter(s) still to run have not run on this machine before and are assumed to take an average time.", "", forecast.unpredictedFilters);
+  }
+  forecastLabel->setToolTip(toolTip);
+  forecastLabel->setVisible(true);
+  return true;
+}
@@ -56,9 +56,16 @@ public:
    */
   void processMessage(const FilterStatusMessage* msg) const override;
 
+  /**
+   * @brief Updates the progress bar and the remaining time of the running pipeline with the progress of the filter
+   * @param msg
+   */
+  void processMessage(const FilterProgressMessage* msg) const override;
+
   /**
    * @brief Sets the SIMPLView_UI progress bar with the incoming PipelineProgressMessage's
-   * progress value.
+   * progress value.  When earlier runs predict the runtimes of the filters the progress is weighted by them and
+   * the remaining time is shown as well.
    * @param msg
    */
   void processMessage(const PipelineProgressMessage* msg) const override;
@@ -78,4 +85,10 @@ private:
    * @param msg
    */
   void appendStatusMessageToPipelineOutput(const QString& statusMessage) const;
+
+  /**
+   * @brief Shows the forecast of the running pipeline in the progress bar and the status bar
+   * @return False if the runtime of the pipeline could not be predicted
+   */
+  bool showForecast() const;
 };
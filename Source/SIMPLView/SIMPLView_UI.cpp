@@ -36,17 +36,36 @@
 #include "SIMPLView_UI.h"
 
 #include <algorithm>
+#include <limits>
+#include <memory>
 
 //-- Qt Includes
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QLocale>
 #include <QtCore/QString>
+#include <QtCore/QTextStream>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtGui/QCloseEvent>
 #include <QtGui/QDesktopServices>
+#include <QtWidgets/QAbstractButton>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QDialog>
+#include <QtWidgets/QDialogButtonBox>
 #include <QtWidgets/QFileDialog>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QInputDialog>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QPlainTextEdit>
 #include <QtWidgets/QShortcut>
+#include <QtWidgets/QSpinBox>
+#include <QtWidgets/QUndoCommand>
+#include <QtWidgets/QVBoxLayout>
 
 //-- SIMPLView Includes
 #include <QtCore/QDebug>
@@ -55,6 +74,7 @@
 #include "SIMPLib/Common/DocRequestManager.h"
 #include "SIMPLib/FilterParameters/JsonFilterParametersReader.h"
 #include "SIMPLib/Filtering/FilterManager.h"
+#include "SIMPLib/Messages/AbstractErrorMessage.h"
 #include "SIMPLib/Plugin/PluginManager.h"
 #include "SIMPLib/Utilities/SIMPLDataPathValidator.h"
 
@@ -76,6 +96,7 @@
 #include "SVWidgetsLib/Widgets/SVStyle.h"
 #include "SVWidgetsLib/Widgets/StatusBarWidget.h"
 #include "SVWidgetsLib/Widgets/util/AddFilterCommand.h"
+#include "SVWidgetsLib/Widgets/util/RemoveFilterCommand.h"
 
 #include <QtGui/QDesktopServices>
 #include <QtWidgets/QMessageBox>
@@ -91,14 +112,63 @@
 #endif
 
 #include "SIMPLView/AboutSIMPLView.h"
+#include "SIMPLView/PipelineFileFormat.h"
+#include "SIMPLView/DREAM3DFileBrowser.h"
+#include "SIMPLView/ExecutionScheduler.h"
+#include "SIMPLView/FilterTimingRecorder.h"
+#include "SIMPLView/FilterTimingStore.h"
+#include "SIMPLView/PipelineFileLoader.h"
+#include "SIMPLView/ParameterSweepDialog.h"
+#include "SIMPLView/PerformanceCounters.h"
+#include "SIMPLView/PipelineCostEstimator.h"
+#include "SIMPLView/PipelineEstimateDialog.h"
+#include "SIMPLView/PipelineExecution.h"
+#include "SIMPLView/PipelineFileWriter.h"
+#include "SIMPLView/PipelineHistory.h"
+#include "SIMPLView/PipelineJournal.h"
+#include "SIMPLView/PipelineTransaction.h"
+#include "SIMPLView/ProcessMemory.h"
+#include "SIMPLView/RunHistory.h"
+#include "SIMPLView/RunHistoryDialog.h"
+#include "SIMPLView/RunReportDialog.h"
 #include "SIMPLView/SIMPLView.h"
 #include "SIMPLView/SIMPLViewApplication.h"
 #include "SIMPLView/SIMPLViewConstants.h"
 #include "SIMPLView/SIMPLViewUIMessageHandler.h"
 #include "SIMPLView/SIMPLViewVersion.h"
+#include "SIMPLView/WatchFolderDialog.h"
 
 #include "BrandedStrings.h"
 
+namespace
+{
+/**
+ * @brief The AppliedCommandGroup class groups commands that were already applied one by one.  The redo that
+ * QUndoStack::push runs when the group is pushed is skipped; later redos apply the children again.
+ */
+class AppliedCommandGroup : public QUndoCommand
+{
+public:
+  explicit AppliedCommandGroup(const QString& text)
+  : QUndoCommand(text)
+  {
+  }
+
+  void redo() override
+  {
+    if(m_Applied)
+    {
+      m_Applied = false;
+      return;
+    }
+    QUndoCommand::redo();
+  }
+
+private:
+  bool m_Applied = true;
+};
+} // namespace
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -149,6 +219,17 @@ SIMPLView_UI::~SIMPLView_UI()
 {
   writeSettings();
 
+  // Runs of this window must not start, or be waited for, after it is gone
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  ExecutionScheduler::Job job;
+  if(scheduler->getJob(m_PipelineJobId, job) && job.state == ExecutionScheduler::State::Queued)
+  {
+    scheduler->cancel(m_PipelineJobId);
+  }
+  PipelineExecution* previewExecution = m_PreviewExecution;
+  m_PreviewExecution = nullptr;
+  delete previewExecution;
+
   dream3dApp->unregisterSIMPLViewWindow(this);
 
   if(dream3dApp->activeWindow() == this)
@@ -175,19 +256,19 @@ void SIMPLView_UI::resizeEvent(QResizeEvent* event)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::listenSavePipelineTriggered()
 {
-  savePipeline();
+  savePipeline(false);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool SIMPLView_UI::savePipeline()
+bool SIMPLView_UI::savePipeline(bool waitForWrite)
 {
   QString filePath;
   if(windowFilePath().isEmpty())
   {
     // When the file hasn't been saved before, the same functionality as a "Save As" occurs...
-    return savePipelineAs();
+    return savePipelineAs(waitForWrite);
   }
 
   filePath = windowFilePath();
@@ -195,21 +276,19 @@ bool SIMPLView_UI::savePipeline()
   // Fix the separators
   filePath = QDir::toNativeSeparators(filePath);
 
-  // Write the pipeline
-  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
-  try
+  // Write the pipeline.  A background write clears the save flag once pipelineFileWritten reports it is on disk.
+  if(writePipelineFile(filePath, waitForWrite) < 0)
   {
-    viewWidget->writePipeline(filePath);
-  } catch(const std::exception& exception)
-  {
-    DetailedErrorDialog::warning(nullptr, "Error", "Caught exception while attempting to save pipeline.", exception.what());
     return false;
   }
 
   // Set window title and save flag
   QFileInfo prefFileInfo = QFileInfo(filePath);
   setWindowTitle("[*]" + prefFileInfo.baseName() + " - " + BrandedStrings::ApplicationName);
-  setWindowModified(false);
+  if(waitForWrite || !PipelineFileWriter::CanWrite(filePath))
+  {
+    setWindowModified(false);
+  }
 
   // Add file to the recent files list
   QtSRecentFileList* list = QtSRecentFileList::Instance();
@@ -223,16 +302,19 @@ bool SIMPLView_UI::savePipeline()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::listenSavePipelineAsTriggered()
 {
-  savePipelineAs();
+  savePipelineAs(false);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-bool SIMPLView_UI::savePipelineAs()
+bool SIMPLView_UI::savePipelineAs(bool waitForWrite)
 {
   QString proposedFile = m_LastOpenedFilePath + QDir::separator() + "Untitled.json";
-  QString filePath = QFileDialog::getSaveFileName(this, tr("Save Pipeline To File"), proposedFile, tr("Json File (*.json);;SIMPLView File (*.dream3d);;All Files (*.*)"));
+  QString cborFilter = tr("CBOR Pipeline File (*.cbor)");
+  QString selectedFilter;
+  QString filePath = QFileDialog::getSaveFileName(this, tr("Save Pipeline To File"), proposedFile, tr("Json File (*.json);;%1;;SIMPLView File (*.dream3d);;All Files (*.*)").arg(cborFilter),
+                                                  &selectedFilter);
   if(filePath.isEmpty())
   {
     return false;
@@ -244,31 +326,42 @@ bool SIMPLView_UI::savePipelineAs()
   QFileInfo fi(filePath);
   if(fi.suffix().isEmpty())
   {
-    filePath.append(".json");
+    filePath.append(selectedFilter == cborFilter ? ".cbor" : ".json");
     fi.setFile(filePath);
   }
 
-  // Write the pipeline
-  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
-
-  int err = 0;
-  try
-  {
-    err = viewWidget->writePipeline(filePath);
-  } catch(const std::exception& exception)
+  // Write the pipeline.  It has to be on disk before the user is told it was saved, so a background write is
+  // finished by pipelineFileWritten.
+  bool background = !waitForWrite && PipelineFileWriter::CanWrite(filePath);
+  m_PendingSaveAsFilePath = background ? filePath : QString();
+  int err = writePipelineFile(filePath, waitForWrite);
+  if(err < 0)
   {
-    DetailedErrorDialog::warning(nullptr, "Error", "Caught exception while attempting to save pipeline.", exception.what());
+    m_PendingSaveAsFilePath.clear();
     return false;
   }
 
-  if(err < 0)
+  if(!background)
   {
-    return false;
+    pipelineSavedAs(filePath);
   }
+  return true;
+}
 
-  // Set window title and save flag
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineSavedAs(const QString& filePath)
+{
+  QFileInfo fi(filePath);
+
+  // Set window title and save flag.  A background write leaves the flag to pipelineFileWritten, which knows
+  // whether the pipeline was edited while it was written.
   setWindowTitle("[*]" + fi.baseName() + " - " + BrandedStrings::ApplicationName);
-  setWindowModified(false);
+  if(!m_PipelineFileWriter->isWriting() && m_EditCount == m_SavedEditCount)
+  {
+    setWindowModified(false);
+  }
 
   // Add file to the recent files list
   QtSRecentFileList* list = QtSRecentFileList::Instance();
@@ -291,8 +384,108 @@ bool SIMPLView_UI::savePipelineAs()
   {
     m_Ui->bookmarksWidget->getBookmarksTreeView()->addBookmark(filePath, QModelIndex());
   }
+}
 
-  return true;
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SIMPLView_UI::writePipelineFile(const QString& filePath, bool waitForWrite)
+{
+  if(PipelineFileWriter::CanWrite(filePath))
+  {
+    // Only the snapshot is taken here; the file is written in the background
+    QJsonObject pipeline;
+    try
+    {
+      SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+      FilterPipeline::Pointer filterPipeline = viewWidget->getFilterPipeline();
+      filterPipeline->setName(QFileInfo(filePath).completeBaseName());
+      pipeline = filterPipeline->toJson();
+      if(m_HasPreviewRegion)
+      {
+        pipeline[PreviewRegion::JsonKey] = m_PreviewRegion.toJson();
+      }
+    } catch(const std::exception& exception)
+    {
+      DetailedErrorDialog::warning(nullptr, "Error", "Caught exception while attempting to save pipeline.", exception.what());
+      return -1;
+    }
+
+    m_SavedEditCount = m_EditCount;
+    if(waitForWrite)
+    {
+      QString errorMessage;
+      if(!m_PipelineFileWriter->writeAndWait(filePath, pipeline, errorMessage))
+      {
+        QMessageBox::warning(this, BrandedStrings::ApplicationName, tr("The pipeline could not be saved.\n%1").arg(errorMessage));
+        return -1;
+      }
+      return 0;
+    }
+
+    m_PipelineFileWriter->write(filePath, pipeline);
+    statusBar()->showMessage(tr("Saving %1...").arg(QFileInfo(filePath).fileName()));
+    return 0;
+  }
+
+  SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
+  try
+  {
+    int err = viewWidget->writePipeline(filePath);
+    if(err >= 0)
+    {
+      m_SavedEditCount = m_EditCount;
+      m_PipelineJournal->markSaved(filePath);
+    }
+    return err;
+  } catch(const std::exception& exception)
+  {
+    DetailedErrorDialog::warning(nullptr, "Error", "Caught exception while attempting to save pipeline.", exception.what());
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineFileWritten(const QString& filePath, bool success, const QString& errorMessage)
+{
+  QString fileName = QFileInfo(filePath).fileName();
+  bool savedAs = !m_PendingSaveAsFilePath.isEmpty() && QDir::toNativeSeparators(m_PendingSaveAsFilePath) == QDir::toNativeSeparators(filePath);
+  if(savedAs)
+  {
+    m_PendingSaveAsFilePath.clear();
+  }
+
+  if(success)
+  {
+    statusBar()->showMessage(tr("Saved %1").arg(fileName), 5000);
+    m_PipelineJournal->markSaved(filePath);
+    if(savedAs)
+    {
+      pipelineSavedAs(filePath);
+      return;
+    }
+
+    // The window stays modified until the last snapshot of it is on disk and nothing was edited since it was taken
+    bool isWindowFile = QDir::toNativeSeparators(windowFilePath()) == QDir::toNativeSeparators(filePath);
+    if(isWindowFile && !m_PipelineFileWriter->isWriting() && m_EditCount == m_SavedEditCount)
+    {
+      setWindowModified(false);
+    }
+    return;
+  }
+
+  statusBar()->showMessage(tr("Unable to save %1: %2").arg(fileName, errorMessage));
+  if(savedAs)
+  {
+    QMessageBox::warning(this, BrandedStrings::ApplicationName, tr("The pipeline could not be saved.\n%1").arg(errorMessage));
+  }
+
+  if(QDir::toNativeSeparators(windowFilePath()) == QDir::toNativeSeparators(filePath))
+  {
+    setWindowModified(true);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -327,7 +520,9 @@ void SIMPLView_UI::activateBookmark(const QString& filePath, bool execute)
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::closeEvent(QCloseEvent* event)
 {
-  if(m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning())
+  bool sweepRunning = m_ParameterSweepDialog != nullptr && m_ParameterSweepDialog->isRunning();
+  bool watchingFolder = m_WatchFolderDialog != nullptr && m_WatchFolderDialog->isBusy();
+  if(m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning() || isPreviewRunning() || sweepRunning || watchingFolder)
   {
     QMessageBox runningPipelineBox;
     runningPipelineBox.setWindowTitle("Pipeline is Running");
@@ -339,6 +534,9 @@ void SIMPLView_UI::closeEvent(QCloseEvent* event)
     return;
   }
 
+  // A background save that fails leaves the window modified, so the user is asked about it below
+  m_PipelineFileWriter->waitForFinished();
+
   QMessageBox::StandardButton choice = checkDirtyDocument();
   if(choice == QMessageBox::Cancel)
   {
@@ -512,6 +710,35 @@ void SIMPLView_UI::setupGui()
   // Set the IssuesWidget as a PipelineMessageObserver Object.
   viewWidget->addPipelineMessageObserver(m_Ui->issuesWidget);
 
+  // Pipeline states are recorded once the edits settle, so typing into a parameter does not create one entry per keystroke
+  m_PipelineHistory = new PipelineHistory(this);
+  m_PipelineJournal = new PipelineJournal(this);
+  m_HistoryRecordTimer = new QTimer(this);
+  m_HistoryRecordTimer->setSingleShot(true);
+  m_HistoryRecordTimer->setInterval(250);
+  connect(m_HistoryRecordTimer, &QTimer::timeout, this, &SIMPLView_UI::recordPipelineState);
+
+  m_PipelineFileLoader = new PipelineFileLoader(this);
+  connect(m_PipelineFileLoader, &PipelineFileLoader::filtersLoaded, this, &SIMPLView_UI::pipelineFiltersLoaded);
+  connect(m_PipelineFileLoader, &PipelineFileLoader::finished, this, &SIMPLView_UI::pipelineFileLoadFinished);
+
+  m_PipelineFileWriter = new PipelineFileWriter(this);
+  connect(m_PipelineFileWriter, &PipelineFileWriter::writeFinished, this, &SIMPLView_UI::pipelineFileWritten);
+
+  m_FileBrowser = std::make_unique<DREAM3DFileBrowser>();
+  m_DataBrowserTitle = m_Ui->dataBrowserDockWidget->windowTitle();
+  m_Ui->arrayInspectorWidget->setFileBrowser(m_FileBrowser.get());
+  m_Ui->sliceViewerWidget->setFileBrowser(m_FileBrowser.get());
+  m_Ui->executionQueueWidget->setScheduler(dream3dApp->getExecutionScheduler());
+  m_Ui->batchQueueWidget->setBatchQueue(dream3dApp->getBatchQueue());
+
+  m_PipelineForecastLabel = new QLabel(this);
+  m_PipelineForecastLabel->setVisible(false);
+  statusBar()->addPermanentWidget(m_PipelineForecastLabel);
+  m_UndoMemoryLabel = new QLabel(this);
+  statusBar()->addPermanentWidget(m_UndoMemoryLabel);
+  connect(m_PipelineHistory, &PipelineHistory::memoryUsageChanged, this, &SIMPLView_UI::updateUndoMemoryLabel);
+
   createSIMPLViewMenuSystem();
 
   // Hook up the signals from the various docks to the PipelineViewWidget that will either add a filter
@@ -527,8 +754,13 @@ void SIMPLView_UI::setupGui()
 
   tabifyDockWidget(m_Ui->filterListDockWidget, m_Ui->filterLibraryDockWidget);
   tabifyDockWidget(m_Ui->filterLibraryDockWidget, m_Ui->bookmarksDockWidget);
+  tabifyDockWidget(m_Ui->dataBrowserDockWidget, m_Ui->arrayInspectorDockWidget);
+  tabifyDockWidget(m_Ui->arrayInspectorDockWidget, m_Ui->sliceViewerDockWidget);
+  tabifyDockWidget(m_Ui->stdOutDockWidget, m_Ui->executionQueueDockWidget);
+  tabifyDockWidget(m_Ui->executionQueueDockWidget, m_Ui->batchQueueDockWidget);
 
   m_Ui->filterListDockWidget->raise();
+  m_Ui->dataBrowserDockWidget->raise();
 
   // Shortcut to close the window
   new QShortcut(QKeySequence(QKeySequence::Close), this, SLOT(close()));
@@ -552,21 +784,32 @@ void SIMPLView_UI::setupGui()
   connect(dream3dApp, &SIMPLViewApplication::filterFactoriesUpdated, m_Ui->filterListWidget, &FilterListToolboxWidget::loadFilterList);
   connect(dream3dApp, &SIMPLViewApplication::filterFactoriesUpdated, m_Ui->filterLibraryWidget, &FilterLibraryToolboxWidget::refreshFilterGroups);
 
+  connectDockWidgetSignalsSlots(m_Ui->arrayInspectorDockWidget);
+  connectDockWidgetSignalsSlots(m_Ui->batchQueueDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->bookmarksDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->dataBrowserDockWidget);
+  connectDockWidgetSignalsSlots(m_Ui->executionQueueDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->filterLibraryDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->filterListDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->issuesDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->pipelineDockWidget);
+  connectDockWidgetSignalsSlots(m_Ui->sliceViewerDockWidget);
   connectDockWidgetSignalsSlots(m_Ui->stdOutDockWidget);
 
+  m_Ui->arrayInspectorDockWidget->installEventFilter(this);
+  m_Ui->batchQueueDockWidget->installEventFilter(this);
   m_Ui->bookmarksDockWidget->installEventFilter(this);
   m_Ui->dataBrowserDockWidget->installEventFilter(this);
+  m_Ui->executionQueueDockWidget->installEventFilter(this);
   m_Ui->filterLibraryDockWidget->installEventFilter(this);
   m_Ui->filterListDockWidget->installEventFilter(this);
   m_Ui->issuesDockWidget->installEventFilter(this);
   m_Ui->pipelineDockWidget->installEventFilter(this);
+  m_Ui->sliceViewerDockWidget->installEventFilter(this);
   m_Ui->stdOutDockWidget->installEventFilter(this);
+
+  recordPipelineState();
+  updateUndoMemoryLabel(m_PipelineHistory->getMemoryUsage());
 }
 
 // -----------------------------------------------------------------------------
@@ -617,6 +860,29 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_ActionCheckForUpdates = new QAction("Check For Updates", this);
   m_ActionPluginInformation = new QAction("Plugin Information", this);
   m_ActionClearCache = new QAction("Reset Preferences", this);
+  m_ActionBrowseFile = new QAction("Browse File...", this);
+  m_ActionPreviewArray = new QAction("Preview Array...", this);
+  m_ActionPreviewPipeline = new QAction("Preview on ROI", this);
+  m_ActionCancelPreview = new QAction("Cancel Preview", this);
+  m_ActionConfigurePreviewRegion = new QAction("Preview Region...", this);
+  m_ActionEstimatePipeline = new QAction("Estimate Cost...", this);
+  m_ActionRunHistory = new QAction("Run History...", this);
+  m_ActionRunReport = new QAction("Last Run Report...", this);
+  m_ActionRunReport->setEnabled(false);
+  m_ActionCountHardwareEvents = new QAction("Count Hardware Events", this);
+  m_ActionCountHardwareEvents->setCheckable(true);
+  m_ActionCountHardwareEvents->setEnabled(PerformanceCounters::IsSupported());
+  m_ActionCountHardwareEvents->setToolTip(tr("Counts the CPU cycles, instructions, cache misses and branch misses of each filter"));
+  {
+    QtSSettings prefs;
+    prefs.beginGroup(SIMPLView::Profiling::GroupName);
+    m_ActionCountHardwareEvents->setChecked(PerformanceCounters::IsSupported() && prefs.value(SIMPLView::Profiling::HardwareCounters, false).toBool());
+    prefs.endGroup();
+  }
+  m_ActionParameterSweep = new QAction("Parameter Sweep...", this);
+  m_ActionWatchFolder = new QAction("Watch Folder...", this);
+  m_ActionUndo = new QAction("Undo", this);
+  m_ActionRedo = new QAction("Redo", this);
 
   // SIMPLView_UI Actions
   connect(m_ActionNew, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenNewInstanceTriggered);
@@ -630,6 +896,24 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   connect(m_ActionShowSIMPLViewHelp, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenShowSIMPLViewHelpTriggered);
   connect(m_ActionPluginInformation, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenDisplayPluginInfoDialogTriggered);
   connect(m_ActionClearCache, &QAction::triggered, dream3dApp, &SIMPLViewApplication::listenClearSIMPLViewCacheTriggered);
+  connect(m_ActionBrowseFile, &QAction::triggered, this, &SIMPLView_UI::listenBrowseFileTriggered);
+  connect(m_ActionPreviewArray, &QAction::triggered, this, &SIMPLView_UI::listenPreviewArrayTriggered);
+  connect(m_ActionPreviewPipeline, &QAction::triggered, this, &SIMPLView_UI::executePreview);
+  connect(m_ActionCancelPreview, &QAction::triggered, this, &SIMPLView_UI::cancelPreview);
+  connect(m_ActionConfigurePreviewRegion, &QAction::triggered, this, &SIMPLView_UI::listenConfigurePreviewRegionTriggered);
+  connect(m_ActionEstimatePipeline, &QAction::triggered, this, &SIMPLView_UI::listenEstimatePipelineTriggered);
+  connect(m_ActionRunHistory, &QAction::triggered, this, &SIMPLView_UI::listenRunHistoryTriggered);
+  connect(m_ActionRunReport, &QAction::triggered, this, &SIMPLView_UI::listenRunReportTriggered);
+  connect(m_ActionCountHardwareEvents, &QAction::toggled, this, [](bool checked) {
+    QtSSettings prefs;
+    prefs.beginGroup(SIMPLView::Profiling::GroupName);
+    prefs.setValue(SIMPLView::Profiling::HardwareCounters, checked);
+    prefs.endGroup();
+  });
+  connect(m_ActionParameterSweep, &QAction::triggered, this, &SIMPLView_UI::listenParameterSweepTriggered);
+  connect(m_ActionWatchFolder, &QAction::triggered, this, &SIMPLView_UI::listenWatchFolderTriggered);
+  connect(m_ActionUndo, &QAction::triggered, this, &SIMPLView_UI::listenUndoTriggered);
+  connect(m_ActionRedo, &QAction::triggered, this, &SIMPLView_UI::listenRedoTriggered);
 
   m_ActionNew->setShortcut(QKeySequence::New);
   m_ActionOpen->setShortcut(QKeySequence::Open);
@@ -639,6 +923,18 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_ActionCheckForUpdates->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_U));
   m_ActionShowSIMPLViewHelp->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_H));
   m_ActionPluginInformation->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_I));
+  m_ActionPreviewPipeline->setShortcut(QKeySequence(Qt::CTRL + Qt::SHIFT + Qt::Key_P));
+  m_ActionUndo->setShortcut(QKeySequence::Undo);
+  m_ActionRedo->setShortcut(QKeySequence::Redo);
+
+  m_ActionPreviewArray->setEnabled(false);
+  m_ActionCancelPreview->setEnabled(false);
+  m_ActionUndo->setEnabled(m_PipelineHistory->canUndo());
+  m_ActionRedo->setEnabled(m_PipelineHistory->canRedo());
+  connect(m_PipelineHistory, &PipelineHistory::undoRedoStateChanged, [=](bool canUndo, bool canRedo) {
+    m_ActionUndo->setEnabled(canUndo);
+    m_ActionRedo->setEnabled(canRedo);
+  });
 
   // Pipeline View Actions
   SVPipelineView* viewWidget = m_Ui->pipelineListWidget->getPipelineView();
@@ -646,8 +942,10 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   QAction* actionCopy = viewWidget->getActionCopy();
   QAction* actionPaste = viewWidget->getActionPaste();
   QAction* actionClearPipeline = viewWidget->getActionClearPipeline();
-  QAction* actionUndo = viewWidget->getActionUndo();
-  QAction* actionRedo = viewWidget->getActionRedo();
+
+  // Undo and redo go through the pipeline history; the view's own actions would fight over the shortcuts
+  viewWidget->getActionUndo()->setShortcut(QKeySequence());
+  viewWidget->getActionRedo()->setShortcut(QKeySequence());
 
   // Bookmarks Actions
   BookmarksTreeView* bookmarksView = m_Ui->bookmarksWidget->getBookmarksTreeView();
@@ -659,6 +957,8 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_SIMPLViewMenu->addMenu(m_MenuFile);
   m_MenuFile->addAction(m_ActionNew);
   m_MenuFile->addAction(m_ActionOpen);
+  m_MenuFile->addAction(m_ActionBrowseFile);
+  m_MenuFile->addAction(m_ActionPreviewArray);
   m_MenuFile->addSeparator();
   m_MenuFile->addAction(m_ActionSave);
   m_MenuFile->addAction(m_ActionSaveAs);
@@ -669,8 +969,8 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
 
   // Create Edit Menu
   m_SIMPLViewMenu->addMenu(m_MenuEdit);
-  m_MenuEdit->addAction(actionUndo);
-  m_MenuEdit->addAction(actionRedo);
+  m_MenuEdit->addAction(m_ActionUndo);
+  m_MenuEdit->addAction(m_ActionRedo);
   m_MenuEdit->addSeparator();
   m_MenuEdit->addAction(actionCut);
   m_MenuEdit->addAction(actionCopy);
@@ -697,6 +997,10 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   m_MenuView->addAction(m_Ui->issuesDockWidget->toggleViewAction());
   m_MenuView->addAction(m_Ui->stdOutDockWidget->toggleViewAction());
   m_MenuView->addAction(m_Ui->dataBrowserDockWidget->toggleViewAction());
+  m_MenuView->addAction(m_Ui->arrayInspectorDockWidget->toggleViewAction());
+  m_MenuView->addAction(m_Ui->sliceViewerDockWidget->toggleViewAction());
+  m_MenuView->addAction(m_Ui->executionQueueDockWidget->toggleViewAction());
+  m_MenuView->addAction(m_Ui->batchQueueDockWidget->toggleViewAction());
 
   // Create Bookmarks Menu
   m_SIMPLViewMenu->addMenu(m_MenuBookmarks);
@@ -707,6 +1011,17 @@ void SIMPLView_UI::createSIMPLViewMenuSystem()
   // Create Pipeline Menu
   m_SIMPLViewMenu->addMenu(m_MenuPipeline);
   m_MenuPipeline->addAction(actionClearPipeline);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionPreviewPipeline);
+  m_MenuPipeline->addAction(m_ActionCancelPreview);
+  m_MenuPipeline->addAction(m_ActionConfigurePreviewRegion);
+  m_MenuPipeline->addSeparator();
+  m_MenuPipeline->addAction(m_ActionEstimatePipeline);
+  m_MenuPipeline->addAction(m_ActionRunHistory);
+  m_MenuPipeline->addAction(m_ActionRunReport);
+  m_MenuPipeline->addAction(m_ActionCountHardwareEvents);
+  m_MenuPipeline->addAction(m_ActionParameterSweep);
+  m_MenuPipeline->addAction(m_ActionWatchFolder);
 #ifdef SIMPL_EMBED_PYTHON
   m_ActionReloadPython = new QAction("Reload Python Filters", this);
   m_ActionReloadPython->setShortcut(QKeySequence(Qt::CTRL + Qt::Key_R));
@@ -778,27 +1093,56 @@ void SIMPLView_UI::connectSignalsSlots()
 
   /* Pipeline List Widget Connections */
   connect(m_Ui->pipelineListWidget, &PipelineListWidget::pipelineCanceled, pipelineView, &SVPipelineView::cancelPipeline);
+  connect(m_Ui->pipelineListWidget, &PipelineListWidget::pipelineCanceled, this, [this] { m_PipelineCancelRequested = true; });
+
+  // The Start button starts the pipeline view directly, which would skip the queue of the scheduler
+  QAbstractButton* startButton = m_Ui->pipelineListWidget->findChild<QAbstractButton*>("startPipelineBtn");
+  if(nullptr != startButton)
+  {
+    disconnect(startButton, nullptr, m_Ui->pipelineListWidget, nullptr);
+    connect(startButton, &QAbstractButton::clicked, this, &SIMPLView_UI::startPipelineClicked);
+  }
 
   /* Pipeline View Connections */
   connect(pipelineView->selectionModel(), &QItemSelectionModel::selectionChanged, this, &SIMPLView_UI::filterSelectionChanged);
   connect(pipelineView, &SVPipelineView::filterParametersChanged, [=](AbstractFilter::Pointer filter) {
-    m_Ui->dataBrowserWidget->filterActivated(filter);
+    showFilterDataStructure(filter);
     markDocumentAsDirty();
+    m_HistoryRecordTimer->start();
   });
-  connect(pipelineView, &SVPipelineView::clearDataStructureWidgetTriggered, [=] { m_Ui->dataBrowserWidget->filterActivated(AbstractFilter::NullPointer()); });
+  connect(pipelineView, &SVPipelineView::clearDataStructureWidgetTriggered, [=] { showFilterDataStructure(AbstractFilter::NullPointer()); });
   connect(pipelineView, &SVPipelineView::filterInputWidgetNeedsCleared, this, &SIMPLView_UI::clearFilterInputWidget);
   connect(pipelineView, &SVPipelineView::displayIssuesTriggered, m_Ui->issuesWidget, &IssuesWidget::displayCachedMessages);
   connect(pipelineView, &SVPipelineView::clearIssuesTriggered, m_Ui->issuesWidget, &IssuesWidget::clearIssues);
   connect(pipelineView, &SVPipelineView::writeSIMPLViewSettingsTriggered, [=] { writeSettings(); });
 
   // Connection that displays issues in the Issue Table when the preflight is finished
+  // Preflights that finish while a transaction is open are only displayed once the transaction ends
   connect(pipelineView, &SVPipelineView::preflightFinished, [=](int32_t pipelineFilterCount, int err) {
-    m_Ui->dataBrowserWidget->refreshData();
-    m_Ui->issuesWidget->displayCachedMessages();
-    m_Ui->pipelineListWidget->preflightFinished(pipelineFilterCount, err);
+    if(!pipelineView->isPipelineCurrentlyRunning())
+    {
+      capturePreflightEstimate();
+    }
+    if(m_TransactionDepth > 0)
+    {
+      m_PreflightResultPending = true;
+      m_PendingPreflightFilterCount = pipelineFilterCount;
+      m_PendingPreflightError = err;
+      return;
+    }
+    updatePreflightResults(pipelineFilterCount, err);
   });
 
+  // The recorder sees each message first, so the progress shown for it is up to date
+  connect(pipelineView, &SVPipelineView::pipelineHasMessage, this, [this](const AbstractMessage::Pointer& msg) {
+    // Previews also report through processPipelineMessage, so only the messages of the pipeline view are timed
+    if(nullptr != m_TimingRecorder)
+    {
+      m_TimingRecorder->processMessage(msg);
+    }
+  });
   connect(pipelineView, &SVPipelineView::pipelineHasMessage, this, &SIMPLView_UI::processPipelineMessage);
+  connect(pipelineView, &SVPipelineView::pipelineStarted, this, &SIMPLView_UI::pipelineDidStart);
   connect(pipelineView, &SVPipelineView::pipelineFinished, this, &SIMPLView_UI::pipelineDidFinish);
   connect(pipelineView, &SVPipelineView::pipelineFilePathUpdated, this, &SIMPLView_UI::setWindowFilePath);
 
@@ -806,6 +1150,7 @@ void SIMPLView_UI::connectSignalsSlots()
   connect(pipelineView, &SVPipelineView::filePathOpened, [=](const QString& filePath) { m_LastOpenedFilePath = filePath; });
 
   connect(pipelineView, SIGNAL(filterEnabledStateChanged()), this, SLOT(markDocumentAsDirty()));
+  connect(pipelineView, SIGNAL(filterEnabledStateChanged()), m_HistoryRecordTimer, SLOT(start()));
   connect(pipelineView, SIGNAL(statusMessage(const QString&)), statusBar(), SLOT(showMessage(const QString&)));
   connect(pipelineView, SIGNAL(stdOutMessage(const QString&)), this, SLOT(addStdOutputMessage(const QString&)));
 
@@ -814,6 +1159,14 @@ void SIMPLView_UI::connectSignalsSlots()
   connect(pipelineModel, &PipelineModel::standardOutputMessageGenerated, [=](const QString& msg) { addStdOutputMessage(msg); });
 
   connect(pipelineModel, &PipelineModel::pipelineDataChanged, [=] {});
+  connect(pipelineModel, &PipelineModel::rowsAboutToBeInserted, this, &SIMPLView_UI::pipelineRowsAboutToChange);
+  connect(pipelineModel, &PipelineModel::rowsAboutToBeRemoved, this, &SIMPLView_UI::pipelineRowsAboutToChange);
+  connect(pipelineModel, &PipelineModel::rowsAboutToBeMoved, this, &SIMPLView_UI::pipelineRowsAboutToChange);
+
+  /* Execution Scheduler Connections */
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  connect(scheduler, &ExecutionScheduler::jobFinished, this, &SIMPLView_UI::scheduledJobFinished);
+  connect(scheduler, &ExecutionScheduler::cancelRequested, this, &SIMPLView_UI::scheduledJobCancelRequested);
 }
 
 // -----------------------------------------------------------------------------
@@ -845,7 +1198,39 @@ void SIMPLView_UI::showDockWidget(QDockWidget* dockWidget)
 int SIMPLView_UI::openPipeline(const QString& filePath)
 {
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
-  int err = pipelineView->openPipeline(filePath);
+
+  // The filters of a file that is still loading are dropped
+  if(m_PipelineFileLoader->isLoading())
+  {
+    m_PipelineFileLoader->cancel();
+    PipelineTransaction transaction(this, "Open Pipeline");
+    m_LoadCommand->undo();
+    m_LoadCommand.reset();
+  }
+
+  if(PipelineFileLoader::CanLoad(filePath) && QFileInfo(filePath).isReadable())
+  {
+    // The batches the loader delivers are shown as they arrive, but their commands are grouped so that the file
+    // is undone as one step
+    m_LoadCommand = std::make_unique<AppliedCommandGroup>("Open Pipeline");
+    m_PipelineFileLoader->load(filePath);
+    m_LastOpenedFilePath = filePath;
+
+    QFileInfo fi(filePath);
+    setWindowTitle(QString("[*]") + fi.baseName() + " - " + QApplication::applicationName());
+    setWindowFilePath(filePath);
+    setWindowModified(false);
+    statusBar()->showMessage(tr("Opening %1...").arg(fi.fileName()));
+    return 0;
+  }
+
+  // The transaction ends before the window is marked unmodified, so the changes the view signals while opening
+  // do not mark it modified again
+  int err = 0;
+  {
+    PipelineTransaction transaction(this, "Open Pipeline");
+    err = pipelineView->openPipeline(filePath);
+  }
   if(err >= 0)
   {
     PipelineModel* model = pipelineView->getPipelineModel();
@@ -867,104 +1252,134 @@ int SIMPLView_UI::openPipeline(const QString& filePath)
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLView_UI::handlePipelineChanges()
+void SIMPLView_UI::pipelineFiltersLoaded(const std::vector<AbstractFilter::Pointer>& filters)
 {
-  markDocumentAsDirty();
-
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
-  QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
-  std::sort(selectedIndexes.begin(), selectedIndexes.end());
-
-  if(selectedIndexes.size() == 1)
-  {
-    QModelIndex selectedIndex = selectedIndexes[0];
-    PipelineModel* model = getPipelineModel();
-
-    AbstractFilter::Pointer filter = model->filter(selectedIndex);
-    m_Ui->dataBrowserWidget->filterActivated(filter);
-  }
-  else
-  {
-    m_Ui->dataBrowserWidget->filterActivated(AbstractFilter::NullPointer());
-  }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void SIMPLView_UI::executePipeline()
-{
-  m_Ui->pipelineListWidget->getPipelineView()->executePipeline();
-}
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void SIMPLView_UI::setLoadedPlugins(QVector<ISIMPLibPlugin*> plugins)
-{
-  m_LoadedPlugins = plugins;
+  // The transaction only spans this batch; the pipeline is preflighted once the whole file is loaded
+  PipelineTransaction transaction(this, m_LoadCommand->text());
+  QUndoCommand* command = new AddFilterCommand(filters, pipelineView, m_LoadCommand->text(), -1, m_LoadCommand.get());
+  command->redo();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-QMessageBox::StandardButton SIMPLView_UI::checkDirtyDocument()
+void SIMPLView_UI::pipelineFileLoadFinished(int err, int filterCount)
 {
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  QString filePath = m_PipelineFileLoader->getFilePath();
 
-  if(this->isWindowModified())
+  // The filters are already in the pipeline; the group makes them one undo step
+  std::unique_ptr<QUndoCommand> loadCommand = std::move(m_LoadCommand);
+  if(loadCommand != nullptr && loadCommand->childCount() > 0)
   {
-    int r = QMessageBox::warning(this, BrandedStrings::ApplicationName, tr("The Pipeline has been modified.\nDo you want to save your changes?"), QMessageBox::Save | QMessageBox::Default,
-                                 QMessageBox::Discard, QMessageBox::Cancel | QMessageBox::Escape);
-    if(r == QMessageBox::Save)
-    {
-      if(savePipeline())
-      {
-        return QMessageBox::Save;
-      }
+    pipelineView->addUndoCommand(loadCommand.release());
+    pipelineView->preflightPipeline();
+  }
 
-      return QMessageBox::Cancel;
-    }
-    if(r == QMessageBox::Discard)
+  if(err < 0 && filterCount == 0)
+  {
+    statusBar()->clearMessage();
+    m_ExecuteAfterLoad = false;
+
+    // The view does not read CBOR, so the error is reported here.  Other files are opened by the view the
+    // usual way, which also reports why they could not be read.
+    QJsonObject pipeline;
+    QString errorMessage;
+    if(PipelineFileFormat::FormatFromFilePath(filePath) == PipelineFileFormat::Format::Cbor && !PipelineFileFormat::ReadFile(filePath, pipeline, errorMessage))
     {
-      return QMessageBox::Discard;
+      DetailedErrorDialog::warning(nullptr, "Error", "Unable to open the pipeline.", errorMessage);
+      return;
     }
-    if(r == QMessageBox::Cancel)
+
     {
-      return QMessageBox::Cancel;
+      PipelineTransaction transaction(this, "Open Pipeline");
+      pipelineView->openPipeline(filePath);
     }
+
+    // Opening the file does not count as a modification
+    setWindowModified(false);
+    return;
   }
 
-  return QMessageBox::Ignore;
-}
+  PipelineModel* model = pipelineView->getPipelineModel();
+  if(model->rowCount() > 0)
+  {
+    QModelIndex index = model->index(0, PipelineItem::PipelineItemData::Contents);
+    pipelineView->selectionModel()->select(index, QItemSelectionModel::ClearAndSelect);
+  }
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-void SIMPLView_UI::populateMenus(QObject* plugin)
-{
+  if(err < 0)
+  {
+    // The filters that were read are kept, but they are not the whole file, so the window is detached from it and
+    // stays modified; saving it cannot overwrite the file with what is left
+    m_ExecuteAfterLoad = false;
+    statusBar()->showMessage(tr("Unable to read all of %1").arg(QFileInfo(filePath).fileName()));
+    DetailedErrorDialog::warning(nullptr, "Error", tr("Only the first %1 filters of the pipeline could be read.").arg(filterCount),
+                                 tr("'%1' is truncated or is not a valid pipeline file (error %2).").arg(filePath).arg(err));
+    setWindowFilePath(QString());
+    setWindowTitle("[*]Untitled Pipeline - " + BrandedStrings::ApplicationName);
+    markDocumentAsDirty();
+    return;
+  }
+
+  // The preview region is kept with the pipeline but is not part of it
+  PreviewRegion region;
+  if(PreviewRegion::FromJson(m_PipelineFileLoader->getExtraMembers()[PreviewRegion::JsonKey].toObject(), region))
+  {
+    m_PreviewRegion = region;
+    m_HasPreviewRegion = true;
+  }
+
+  // Loading the file does not count as a modification
+  flushPipelineChanges();
+  setWindowModified(false);
+
+  statusBar()->showMessage(tr("Opened %1 (%2 filters)").arg(QFileInfo(filePath).fileName()).arg(filterCount));
+
+  if(m_ExecuteAfterLoad)
+  {
+    m_ExecuteAfterLoad = false;
+    executePipeline();
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLView_UI::processPipelineMessage(const AbstractMessage::Pointer& msg)
+void SIMPLView_UI::handlePipelineChanges()
 {
-  SIMPLViewUIMessageHandler msgHandler(this);
-  msg->visit(&msgHandler);
+  // A single cut, paste, undo or redo can emit a burst of change signals, so the UI refresh is
+  // deferred to the next pass through the event loop (or to the end of the open transaction)
+  if(m_PipelineChangesPending)
+  {
+    return;
+  }
+
+  m_PipelineChangesPending = true;
+  if(m_TransactionDepth == 0)
+  {
+    QTimer::singleShot(0, this, &SIMPLView_UI::flushPipelineChanges);
+  }
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLView_UI::pipelineDidFinish()
+void SIMPLView_UI::flushPipelineChanges()
 {
-  // Re-enable FilterListToolboxWidget signals - resume adding filters
-  m_Ui->filterListWidget->blockSignals(false);
+  if(!m_PipelineChangesPending || m_TransactionDepth > 0)
+  {
+    return;
+  }
 
-  // Re-enable FilterLibraryToolboxWidget signals - resume adding filters
-  m_Ui->filterLibraryWidget->blockSignals(false);
+  m_PipelineChangesPending = false;
+  markDocumentAsDirty();
+  m_HistoryRecordTimer->start();
 
-  QModelIndexList selectedIndexes = m_Ui->pipelineListWidget->getPipelineView()->selectionModel()->selectedRows();
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  QModelIndexList selectedIndexes = pipelineView->selectionModel()->selectedRows();
   std::sort(selectedIndexes.begin(), selectedIndexes.end());
 
   if(selectedIndexes.size() == 1)
@@ -973,62 +1388,619 @@ void SIMPLView_UI::pipelineDidFinish()
     PipelineModel* model = getPipelineModel();
 
     AbstractFilter::Pointer filter = model->filter(selectedIndex);
-    m_Ui->dataBrowserWidget->filterActivated(filter);
+    showFilterDataStructure(filter);
   }
   else
   {
-    m_Ui->dataBrowserWidget->filterActivated(AbstractFilter::NullPointer());
+    showFilterDataStructure(AbstractFilter::NullPointer());
   }
-
-  m_Ui->pipelineListWidget->pipelineFinished();
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLView_UI::showFilterHelp(const QString& className)
+void SIMPLView_UI::updatePreflightResults(int32_t pipelineFilterCount, int err)
 {
-// Launch the dialog
-#if(defined(SIMPL_USE_MKDOCS) || defined(SIMPL_USE_DISCOUNT))
-  QUrl helpURL = URL_GENERATOR::GenerateHTMLUrl(className);
-  bool didOpen = QDesktopServices::openUrl(helpURL);
-  if(!didOpen)
-  {
-    QMessageBox msgBox;
-    msgBox.setText(QString("Error Opening Help File"));
-    msgBox.setInformativeText(QString::fromLatin1("SIMPLView could not open the help file path ") + helpURL.path());
-    msgBox.setStandardButtons(QMessageBox::Ok);
-    msgBox.setDefaultButton(QMessageBox::Ok);
-    msgBox.setIcon(QMessageBox::Critical);
-    msgBox.exec();
-  }
-#else
-  QMessageBox::StandardButton reply;
-  reply = QMessageBox::critical(this, tr("Documentation Error"), "Documentation was disabled in this build.", QMessageBox::Ok);
-#endif
+  m_Ui->dataBrowserWidget->refreshData();
+  m_Ui->issuesWidget->displayCachedMessages();
+  m_Ui->pipelineListWidget->preflightFinished(pipelineFilterCount, err);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void SIMPLView_UI::showFilterHelpUrl(const QUrl& helpURL)
+void SIMPLView_UI::recordPipelineState()
 {
-  bool didOpen = QDesktopServices::openUrl(helpURL);
-  if(!didOpen)
+  // A pipeline that is still loading is recorded once it is complete
+  if(m_RestoringPipelineState || m_TransactionDepth > 0 || m_PipelineFileLoader->isLoading())
   {
-    QMessageBox msgBox;
-    msgBox.setText(QString("Error Opening Help File"));
-    msgBox.setInformativeText(QString::fromLatin1("SIMPLView could not open the help file path ") + helpURL.path());
-    msgBox.setStandardButtons(QMessageBox::Ok);
-    msgBox.setDefaultButton(QMessageBox::Ok);
-    msgBox.setIcon(QMessageBox::Critical);
-    msgBox.exec();
+    return;
   }
-}
 
+  QJsonObject pipeline;
+  try
+  {
+    pipeline = serializePipeline();
+  } catch(const std::exception& exception)
+  {
+    qDebug() << "Unable to record the pipeline state: " << exception.what();
+    return;
+  }
+
+  m_PipelineHistory->record(pipeline);
+  m_PipelineJournal->record(pipeline, isWindowModified(), windowFilePath());
+
+  // The history now holds the edit as a delta, so the commands of the view, which keep the filters they added or
+  // removed alive, are dropped
+  m_Ui->pipelineListWidget->getPipelineView()->clearUndoStack();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::restorePipelineState(const QJsonObject& pipeline)
+{
+  if(pipeline.isEmpty())
+  {
+    return;
+  }
+
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  JsonFilterParametersReader::Pointer jsonReader = JsonFilterParametersReader::New();
+  FilterPipeline::Pointer filterPipeline;
+  try
+  {
+    filterPipeline = jsonReader->readPipelineFromJson(pipeline, pipelineView);
+  } catch(const std::exception& exception)
+  {
+    DetailedErrorDialog::warning(nullptr, "Error", "Caught exception while restoring the pipeline state.", exception.what());
+    return;
+  }
+
+  if(filterPipeline == nullptr)
+  {
+    return;
+  }
+
+  auto filterContainer = filterPipeline->getFilterContainer();
+  std::vector<AbstractFilter::Pointer> filters(filterContainer.cbegin(), filterContainer.cend());
+
+  PipelineModel* model = getPipelineModel();
+  std::vector<AbstractFilter::Pointer> currentFilters;
+  for(int i = 0; i < model->rowCount(); i++)
+  {
+    currentFilters.push_back(model->filter(model->index(i, PipelineItem::PipelineItemData::Contents)));
+  }
+
+  m_RestoringPipelineState = true;
+  {
+    PipelineTransaction transaction(this, "Restore Pipeline State");
+    removeFilters(currentFilters);
+    addFilters(filters);
+  }
+  m_RestoringPipelineState = false;
+
+  // The history already points at the restored state, and the commands the restore pushed are not undo steps
+  m_HistoryRecordTimer->stop();
+  pipelineView->clearUndoStack();
+  m_PipelineJournal->record(pipeline, isWindowModified(), windowFilePath());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::updateUndoMemoryLabel(qint64 bytes)
+{
+  QLocale locale;
+  m_UndoMemoryLabel->setText(tr("Undo: %1").arg(locale.formattedDataSize(bytes)));
+  m_UndoMemoryLabel->setToolTip(tr("Memory used by the undo history (budget %1)").arg(locale.formattedDataSize(m_PipelineHistory->getByteBudget())));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenUndoTriggered()
+{
+  // Pending edits are recorded first so that undoing returns to the state before them
+  if(m_HistoryRecordTimer->isActive())
+  {
+    m_HistoryRecordTimer->stop();
+    recordPipelineState();
+  }
+
+  restorePipelineState(m_PipelineHistory->undo());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenRedoTriggered()
+{
+  if(m_HistoryRecordTimer->isActive())
+  {
+    m_HistoryRecordTimer->stop();
+    recordPipelineState();
+  }
+
+  restorePipelineState(m_PipelineHistory->redo());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::executePipeline()
+{
+  if(m_PipelineFileLoader->isLoading())
+  {
+    m_ExecuteAfterLoad = true;
+    return;
+  }
+
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  if(scheduler->isActive(m_PipelineJobId))
+  {
+    statusBar()->showMessage(tr("The pipeline is already queued or running."));
+    return;
+  }
+
+  // Nothing of this window runs yet, so the preflighted filters can be read
+  capturePreflightEstimate();
+  if(!confirmPipelineMemory(m_PreflightEstimate.peakBytes, tr("Run it anyway?")))
+  {
+    statusBar()->showMessage(tr("Pipeline not started"));
+    return;
+  }
+
+  // The run waits in the application wide queue until its threads and memory are available
+  m_PipelineJobId = scheduler->submit(tr("Pipeline"), getRunOwnerName(), ExecutionScheduler::Priority::Interactive, scheduler->getThreadsPerRun(), m_PreflightMemory,
+                                      [this](int jobId) { startScheduledPipeline(jobId); });
+  statusBar()->showMessage(tr("Pipeline queued"));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::startScheduledPipeline(int jobId)
+{
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+
+  // The user may have started the run from the pipeline view in the meantime
+  if(pipelineView->isPipelineCurrentlyRunning())
+  {
+    scheduler->finish(jobId);
+    return;
+  }
+
+  pipelineView->executePipeline();
+  if(!pipelineView->isPipelineCurrentlyRunning())
+  {
+    // The pipeline did not start, e.g. because its preflight failed
+    scheduler->finish(jobId);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::startPipelineClicked()
+{
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  if(pipelineView->isPipelineCurrentlyRunning())
+  {
+    m_PipelineCancelRequested = true;
+    pipelineView->cancelPipeline();
+    return;
+  }
+
+  executePipeline();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineDidStart()
+{
+  // The pipeline is already running on its own thread, so the data sizes come from the preflight it started with
+  m_TimingRecorder = std::make_unique<FilterTimingRecorder>(m_PreflightEstimate);
+  m_PipelineCancelRequested = false;
+  if(m_ActionCountHardwareEvents->isChecked() && !m_TimingRecorder->collectCounters())
+  {
+    statusBar()->showMessage(tr("The hardware counters could not be opened; the kernel may not allow it (perf_event_paranoid)."), 10000);
+  }
+
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  ExecutionScheduler::Job job;
+  if(scheduler->getJob(m_PipelineJobId, job))
+  {
+    if(job.state == ExecutionScheduler::State::Running)
+    {
+      // Started by the scheduler
+      return;
+    }
+    if(job.state == ExecutionScheduler::State::Queued)
+    {
+      scheduler->cancel(m_PipelineJobId);
+    }
+  }
+
+  // Runs that still start straight from the pipeline view count against the limits of the other runs once they started
+  m_PipelineJobId = scheduler->registerRunning(tr("Pipeline"), getRunOwnerName(), ExecutionScheduler::Priority::Interactive, scheduler->getThreadsPerRun(), m_PreflightMemory);
+
+  // These runs could not be checked before they started, but they can still be stopped before they run out
+  if(!confirmPipelineMemory(m_PreflightEstimate.peakBytes, tr("Keep it running?")))
+  {
+    m_PipelineCancelRequested = true;
+    m_Ui->pipelineListWidget->getPipelineView()->cancelPipeline();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::executePreview()
+{
+  if(isPreviewRunning() || m_PipelineFileLoader->isLoading())
+  {
+    statusBar()->showMessage(tr("A preview can only be started while no other preview is running."));
+    return;
+  }
+
+  QString errorMessage;
+  FilterPipeline::Pointer preview = m_PreviewRegion.createPipeline(serializePipeline(), errorMessage);
+  if(nullptr == preview)
+  {
+    QMessageBox::warning(this, tr("Preview on ROI"), errorMessage);
+    return;
+  }
+
+  m_PreviewExecution = new PipelineExecution(preview, this);
+  connect(m_PreviewExecution, &PipelineExecution::pipelineMessage, this, &SIMPLView_UI::processPreviewMessage);
+  connect(m_PreviewExecution, &PipelineExecution::finished, this, &SIMPLView_UI::previewDidFinish);
+
+  m_ActionPreviewPipeline->setEnabled(false);
+  m_ActionCancelPreview->setEnabled(true);
+  addStdOutputMessage(tr("Starting a preview on %1").arg(m_PreviewRegion.toString()));
+
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  m_PreviewJobId = scheduler->submitPipeline(tr("Preview on ROI"), getRunOwnerName(), ExecutionScheduler::Priority::Interactive, 0, m_PreviewExecution);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::cancelPreview()
+{
+  if(!isPreviewRunning())
+  {
+    return;
+  }
+
+  // A preview that is still queued is removed; jobFinished then cleans it up
+  dream3dApp->getExecutionScheduler()->cancel(m_PreviewJobId);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::isPreviewRunning() const
+{
+  return m_PreviewExecution != nullptr;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+PreviewRegion SIMPLView_UI::getPreviewRegion() const
+{
+  return m_PreviewRegion;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::setPreviewRegion(const PreviewRegion& region)
+{
+  m_PreviewRegion = region;
+  m_HasPreviewRegion = true;
+  markDocumentAsDirty();
+
+  // The region is saved with the pipeline, so the journal has to pick it up like any other edit
+  m_HistoryRecordTimer->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::processPreviewMessage(const AbstractMessage::Pointer& msg)
+{
+  std::shared_ptr<AbstractErrorMessage> errorMessage = std::dynamic_pointer_cast<AbstractErrorMessage>(msg);
+  if(nullptr != errorMessage)
+  {
+    addStdOutputMessage(tr("Preview error: %1").arg(errorMessage->generateMessageString()));
+    return;
+  }
+
+  processPipelineMessage(msg);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::previewDidFinish()
+{
+  PipelineExecution* execution = m_PreviewExecution;
+  m_PreviewExecution = nullptr;
+  execution->deleteLater();
+  m_ActionPreviewPipeline->setEnabled(true);
+  m_ActionCancelPreview->setEnabled(false);
+
+  if(execution->wasCancelled())
+  {
+    statusBar()->showMessage(tr("Preview cancelled"));
+    return;
+  }
+  if(!execution->getErrorMessages().isEmpty())
+  {
+    statusBar()->showMessage(tr("Preview failed with %1 error(s); see the output dock").arg(execution->getErrorMessages().size()));
+    return;
+  }
+
+  // The result stays in the Data Structure dock until a filter is selected or the pipeline changes
+  auto filterContainer = execution->getPipeline()->getFilterContainer();
+  std::vector<AbstractFilter::Pointer> filters(filterContainer.cbegin(), filterContainer.cend());
+  auto last = std::find_if(filters.crbegin(), filters.crend(), [](const AbstractFilter::Pointer& filter) { return filter->getEnabled(); });
+  if(last != filters.crend())
+  {
+    showFilterDataStructure(*last);
+  }
+  statusBar()->showMessage(tr("Preview finished on %1").arg(m_PreviewRegion.toString()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::scheduledJobFinished(int jobId)
+{
+  // A preview that was cancelled before it started never reports that it finished
+  if(jobId == m_PreviewJobId && m_PreviewExecution != nullptr && !m_PreviewExecution->isRunning())
+  {
+    m_PreviewExecution->deleteLater();
+    m_PreviewExecution = nullptr;
+    m_ActionPreviewPipeline->setEnabled(true);
+    m_ActionCancelPreview->setEnabled(false);
+    statusBar()->showMessage(tr("Preview cancelled"));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::scheduledJobCancelRequested(int jobId)
+{
+  if(jobId == m_PipelineJobId)
+  {
+    m_PipelineCancelRequested = true;
+    m_Ui->pipelineListWidget->getPipelineView()->cancelPipeline();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString SIMPLView_UI::getRunOwnerName() const
+{
+  return windowFilePath().isEmpty() ? tr("Untitled") : QFileInfo(windowFilePath()).fileName();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::confirmPipelineMemory(qint64 peakBytes, const QString& question)
+{
+  qint64 availableBytes = ProcessMemory::AvailablePhysicalBytes();
+  if(availableBytes <= 0 || peakBytes <= availableBytes)
+  {
+    return true;
+  }
+
+  QLocale locale;
+  QString text = tr("The pipeline is predicted to hold %1 of data at its peak, but only %2 of memory is available. It will probably be stopped by "
+                    "the system or slow down from swapping.")
+                     .arg(locale.formattedDataSize(peakBytes), locale.formattedDataSize(availableBytes));
+  return QMessageBox::warning(this, tr("Not Enough Memory"), text + "\n\n" + question, QMessageBox::Yes | QMessageBox::No, QMessageBox::No) == QMessageBox::Yes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::capturePreflightEstimate()
+{
+  std::vector<AbstractFilter::Pointer> filters = getPipelineFilters();
+  m_PreflightEstimate = PipelineCostEstimator::EstimatePipeline(filters, FilterTimingStore::Instance());
+  m_PreflightMemory = ExecutionScheduler::EstimatePipelineMemory(filters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<AbstractFilter::Pointer> SIMPLView_UI::getPipelineFilters()
+{
+  PipelineModel* model = getPipelineModel();
+  std::vector<AbstractFilter::Pointer> filters;
+  for(int i = 0; i < model->rowCount(); i++)
+  {
+    filters.push_back(model->filter(model->index(i, PipelineItem::PipelineItemData::Contents)));
+  }
+  return filters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::setLoadedPlugins(QVector<ISIMPLibPlugin*> plugins)
+{
+  m_LoadedPlugins = plugins;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QMessageBox::StandardButton SIMPLView_UI::checkDirtyDocument()
+{
+
+  if(this->isWindowModified())
+  {
+    int r = QMessageBox::warning(this, BrandedStrings::ApplicationName, tr("The Pipeline has been modified.\nDo you want to save your changes?"), QMessageBox::Save | QMessageBox::Default,
+                                 QMessageBox::Discard, QMessageBox::Cancel | QMessageBox::Escape);
+    if(r == QMessageBox::Save)
+    {
+      // The window may close as soon as this returns, so the pipeline is written before it does
+      if(savePipeline(true))
+      {
+        return QMessageBox::Save;
+      }
+
+      return QMessageBox::Cancel;
+    }
+    if(r == QMessageBox::Discard)
+    {
+      return QMessageBox::Discard;
+    }
+    if(r == QMessageBox::Cancel)
+    {
+      return QMessageBox::Cancel;
+    }
+  }
+
+  return QMessageBox::Ignore;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::populateMenus(QObject* plugin)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::processPipelineMessage(const AbstractMessage::Pointer& msg)
+{
+  SIMPLViewUIMessageHandler msgHandler(this);
+  msg->visit(&msgHandler);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineDidFinish()
+{
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  ExecutionScheduler::Job job;
+  bool hasJob = scheduler->getJob(m_PipelineJobId, job);
+  if(hasJob && job.state == ExecutionScheduler::State::Running)
+  {
+    scheduler->finish(m_PipelineJobId);
+  }
+
+  if(nullptr != m_TimingRecorder)
+  {
+    m_TimingRecorder->finish(FilterTimingStore::Instance(), !m_PipelineCancelRequested);
+
+    QJsonObject pipeline = serializePipeline();
+    RunHistory::Run run;
+    run.pipelineHash = RunHistory::PipelineHash(pipeline);
+    run.pipelineName = getRunOwnerName();
+    run.threads = hasJob ? job.threads : scheduler->getThreadsPerRun();
+    run.inputBytes = RunHistory::InputBytes(pipeline);
+    run.elapsedMilliseconds = m_TimingRecorder->getElapsedMilliseconds();
+    run.succeeded = !m_PipelineCancelRequested && !m_TimingRecorder->hasErrors();
+    run.filters = RunHistory::FilterRuns(*m_TimingRecorder);
+    for(const RunHistory::FilterRun& filterRun : run.filters)
+    {
+      run.peakMemory = std::max(run.peakMemory, filterRun.peakMemory);
+    }
+    dream3dApp->getRunHistory()->record(run);
+
+    // The report of the last run stays available until the next one starts
+    m_LastRunRecorder = std::move(m_TimingRecorder);
+    m_ActionRunReport->setEnabled(true);
+  }
+  m_PipelineForecastLabel->setVisible(false);
+
+  // Re-enable FilterListToolboxWidget signals - resume adding filters
+  m_Ui->filterListWidget->blockSignals(false);
+
+  // Re-enable FilterLibraryToolboxWidget signals - resume adding filters
+  m_Ui->filterLibraryWidget->blockSignals(false);
+
+  QModelIndexList selectedIndexes = m_Ui->pipelineListWidget->getPipelineView()->selectionModel()->selectedRows();
+  std::sort(selectedIndexes.begin(), selectedIndexes.end());
+
+  if(selectedIndexes.size() == 1)
+  {
+    QModelIndex selectedIndex = selectedIndexes[0];
+    PipelineModel* model = getPipelineModel();
+
+    AbstractFilter::Pointer filter = model->filter(selectedIndex);
+    showFilterDataStructure(filter);
+  }
+  else
+  {
+    showFilterDataStructure(AbstractFilter::NullPointer());
+  }
+
+  m_Ui->pipelineListWidget->pipelineFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showFilterHelp(const QString& className)
+{
+// Launch the dialog
+#if(defined(SIMPL_USE_MKDOCS) || defined(SIMPL_USE_DISCOUNT))
+  QUrl helpURL = URL_GENERATOR::GenerateHTMLUrl(className);
+  bool didOpen = QDesktopServices::openUrl(helpURL);
+  if(!didOpen)
+  {
+    QMessageBox msgBox;
+    msgBox.setText(QString("Error Opening Help File"));
+    msgBox.setInformativeText(QString::fromLatin1("SIMPLView could not open the help file path ") + helpURL.path());
+    msgBox.setStandardButtons(QMessageBox::Ok);
+    msgBox.setDefaultButton(QMessageBox::Ok);
+    msgBox.setIcon(QMessageBox::Critical);
+    msgBox.exec();
+  }
+#else
+  QMessageBox::StandardButton reply;
+  reply = QMessageBox::critical(this, tr("Documentation Error"), "Documentation was disabled in this build.", QMessageBox::Ok);
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showFilterHelpUrl(const QUrl& helpURL)
+{
+  bool didOpen = QDesktopServices::openUrl(helpURL);
+  if(!didOpen)
+  {
+    QMessageBox msgBox;
+    msgBox.setText(QString("Error Opening Help File"));
+    msgBox.setInformativeText(QString::fromLatin1("SIMPLView could not open the help file path ") + helpURL.path());
+    msgBox.setStandardButtons(QMessageBox::Ok);
+    msgBox.setDefaultButton(QMessageBox::Ok);
+    msgBox.setIcon(QMessageBox::Critical);
+    msgBox.exec();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
 // -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
 DataStructureWidget* SIMPLView_UI::getDataStructureWidget()
 {
   return m_Ui->dataBrowserWidget;
@@ -1066,12 +2038,12 @@ void SIMPLView_UI::filterSelectionChanged(const QItemSelection& selected, const
     setFilterInputWidget(fiw);
 
     AbstractFilter::Pointer filter = model->filter(selectedIndex);
-    m_Ui->dataBrowserWidget->filterActivated(filter);
+    showFilterDataStructure(filter);
   }
   else
   {
     clearFilterInputWidget();
-    m_Ui->dataBrowserWidget->filterActivated(AbstractFilter::NullPointer());
+    showFilterDataStructure(AbstractFilter::NullPointer());
   }
 }
 
@@ -1139,6 +2111,7 @@ void SIMPLView_UI::clearFilterInputWidget()
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::markDocumentAsDirty()
 {
+  m_EditCount++;
   setWindowModified(true);
 }
 
@@ -1206,7 +2179,7 @@ bool SIMPLView_UI::hasFilterInPipeline(const QUuid& uuid) const
   PipelineModel* model = pipelineView->getPipelineModel();
   for(size_t i = 0; i < model->rowCount(); i++)
   {
-    AbstractFilter::Pointer filter = model->filter(model->index(i, PipelineItem::Contents));
+    AbstractFilter::Pointer filter = model->filter(model->index(i, PipelineItem::PipelineItemData::Contents));
     if(filter->getUuid() == uuid)
     {
       return true;
@@ -1229,6 +2202,13 @@ void SIMPLView_UI::clearUndoStack()
 {
   SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
 
+  // Edits that are not recorded yet only exist as commands of the view
+  if(m_HistoryRecordTimer->isActive())
+  {
+    m_HistoryRecordTimer->stop();
+    recordPipelineState();
+  }
+
   pipelineView->clearUndoStack();
 }
 
@@ -1255,7 +2235,303 @@ void SIMPLView_UI::deserializePipeline(const QJsonObject& json)
   }
   auto filterContainer = pipeline->getFilterContainer();
   std::vector<AbstractFilter::Pointer> filters(filterContainer.cbegin(), filterContainer.cend());
-  pipelineView->addFilters(filters);
+
+  PipelineTransaction transaction(this, "Load Pipeline");
+  addFilters(filters);
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::preservePipelineJournal()
+{
+  // Catches up on the edits that are still waiting for the record timer
+  if(m_HistoryRecordTimer->isActive())
+  {
+    m_HistoryRecordTimer->stop();
+    recordPipelineState();
+  }
+
+  m_PipelineJournal->flush();
+  m_PipelineJournal->setPreserveOnClose(true);
+}
+
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::browseFile(const QString& filePath)
+{
+  QString errorMessage;
+  if(!m_FileBrowser->open(filePath, errorMessage))
+  {
+    closeBrowsedFile();
+    QMessageBox::critical(this, tr("Browse File"), errorMessage, QMessageBox::Ok);
+    return false;
+  }
+
+  m_Ui->dataBrowserWidget->filterActivated(m_FileBrowser->getBrowseFilter());
+  m_Ui->dataBrowserDockWidget->setWindowTitle(tr("%1 - %2").arg(m_DataBrowserTitle, QFileInfo(filePath).fileName()));
+  m_ActionPreviewArray->setEnabled(true);
+  m_Ui->arrayInspectorWidget->refreshArrays();
+  m_Ui->sliceViewerWidget->refreshArrays();
+  showDockWidget(m_Ui->dataBrowserDockWidget);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+DREAM3DFileBrowser* SIMPLView_UI::getFileBrowser() const
+{
+  return m_FileBrowser.get();
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenBrowseFileTriggered()
+{
+  QString proposedDir = m_FileBrowser->isOpen() ? QFileInfo(m_FileBrowser->getFilePath()).absolutePath() : m_LastOpenedFilePath;
+  QString filePath = QFileDialog::getOpenFileName(this, tr("Browse File"), proposedDir, tr("DREAM3D File (*.dream3d);;All Files (*.*)"));
+  if(filePath.isEmpty())
+  {
+    return;
+  }
+
+  browseFile(QDir::toNativeSeparators(filePath));
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenPreviewArrayTriggered()
+{
+  if(!m_FileBrowser->isOpen())
+  {
+    return;
+  }
+
+  QStringList paths;
+  for(const DataArrayPath& path : m_FileBrowser->getDataArrayPaths())
+  {
+    paths.push_back(path.serialize("/"));
+  }
+
+  bool ok = false;
+  QString selectedPath = QInputDialog::getItem(this, tr("Preview Array"), tr("Array:"), paths, 0, false, &ok);
+  if(!ok || selectedPath.isEmpty())
+  {
+    return;
+  }
+
+  DataArrayPath path = DataArrayPath::Deserialize(selectedPath, "/");
+  IDataArray::Pointer structure = m_FileBrowser->getArrayStructure(path);
+  QString filePath = m_FileBrowser->getFilePath();
+
+  // Only the first tuples are read, with one hyperslab, and shown; the text widget would not cope with millions of
+  // lines anyway
+  const size_t maxTuples = 1000;
+  std::shared_ptr<QString> errorMessage = std::make_shared<QString>();
+  auto readFirstTuples = [filePath, path, structure, maxTuples, errorMessage] { return DREAM3DFileBrowser::ReadFirstTuples(filePath, path, structure, maxTuples, *errorMessage); };
+
+  auto showPreview = [this, selectedPath, structure, errorMessage](const IDataArray::Pointer& array) {
+    statusBar()->clearMessage();
+    if(array == nullptr)
+    {
+      QMessageBox::critical(this, tr("Preview Array"), *errorMessage, QMessageBox::Ok);
+      return;
+    }
+
+    QString text;
+    QTextStream out(&text);
+    QString byteSize = QLocale().formattedDataSize(DREAM3DFileBrowser::ByteSize(structure));
+    out << tr("%1: %2 tuples, %3 components, %4, %5").arg(selectedPath).arg(structure->getNumberOfTuples()).arg(structure->getNumberOfComponents()).arg(structure->getTypeAsString(), byteSize) << "\n\n";
+    for(size_t i = 0; i < array->getNumberOfTuples(); i++)
+    {
+      out << i << ": ";
+      array->printTuple(out, i, ' ');
+      out << "\n";
+    }
+    if(array->getNumberOfTuples() < structure->getNumberOfTuples())
+    {
+      out << "...\n";
+    }
+
+    QDialog dialog(this);
+    dialog.setWindowTitle(tr("Preview Array"));
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+    QPlainTextEdit* textEdit = new QPlainTextEdit(text, &dialog);
+    textEdit->setReadOnly(true);
+    textEdit->setLineWrapMode(QPlainTextEdit::NoWrap);
+    layout->addWidget(textEdit);
+    QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, &dialog);
+    connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+    layout->addWidget(buttonBox);
+    dialog.resize(600, 400);
+    dialog.exec();
+  };
+
+  // Without a thread safe HDF5 the read stays on the GUI thread, where SIMPLib reads files too
+  if(!DREAM3DFileBrowser::IsHDF5ThreadSafe())
+  {
+    showPreview(readFirstTuples());
+    return;
+  }
+
+  auto watcher = new QFutureWatcher<IDataArray::Pointer>(this);
+  connect(watcher, &QFutureWatcher<IDataArray::Pointer>::finished, this, [watcher, showPreview] {
+    watcher->deleteLater();
+    showPreview(watcher->result());
+  });
+  statusBar()->showMessage(tr("Reading %1...").arg(selectedPath));
+  watcher->setFuture(QtConcurrent::run(readFirstTuples));
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenConfigurePreviewRegionTriggered()
+{
+  QDialog dialog(this);
+  dialog.setWindowTitle(tr("Preview Region"));
+  QFormLayout* layout = new QFormLayout(&dialog);
+
+  QComboBox* modeCombo = new QComboBox(&dialog);
+  modeCombo->addItem(tr("Crop to a box of voxels"), static_cast<int>(PreviewRegion::Mode::Crop));
+  modeCombo->addItem(tr("Downsample the whole volume"), static_cast<int>(PreviewRegion::Mode::Downsample));
+  modeCombo->setCurrentIndex(modeCombo->findData(static_cast<int>(m_PreviewRegion.mode)));
+  layout->addRow(tr("Mode"), modeCombo);
+
+  auto createIndexRow = [&](const QString& label, const std::array<int, 3>& values) {
+    QHBoxLayout* rowLayout = new QHBoxLayout();
+    std::array<QSpinBox*, 3> spinBoxes;
+    for(int i = 0; i < 3; i++)
+    {
+      spinBoxes[i] = new QSpinBox(&dialog);
+      spinBoxes[i]->setRange(0, std::numeric_limits<int>::max());
+      spinBoxes[i]->setValue(values[i]);
+      rowLayout->addWidget(spinBoxes[i]);
+    }
+    layout->addRow(label, rowLayout);
+    return spinBoxes;
+  };
+  std::array<QSpinBox*, 3> minimumSpinBoxes = createIndexRow(tr("First voxel (X, Y, Z)"), m_PreviewRegion.minimum);
+  std::array<QSpinBox*, 3> maximumSpinBoxes = createIndexRow(tr("Last voxel (X, Y, Z)"), m_PreviewRegion.maximum);
+
+  QSpinBox* factorSpinBox = new QSpinBox(&dialog);
+  factorSpinBox->setRange(2, 64);
+  factorSpinBox->setValue(std::max(m_PreviewRegion.factor, 2));
+  layout->addRow(tr("Downsampling factor"), factorSpinBox);
+
+  auto updateEnabledRows = [=] {
+    bool crop = modeCombo->currentData().toInt() == static_cast<int>(PreviewRegion::Mode::Crop);
+    for(int i = 0; i < 3; i++)
+    {
+      minimumSpinBoxes[i]->setEnabled(crop);
+      maximumSpinBoxes[i]->setEnabled(crop);
+    }
+    factorSpinBox->setEnabled(!crop);
+  };
+  connect(modeCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), &dialog, updateEnabledRows);
+  updateEnabledRows();
+
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Ok | QDialogButtonBox::Cancel, &dialog);
+  connect(buttonBox, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
+  connect(buttonBox, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
+  layout->addRow(buttonBox);
+
+  if(dialog.exec() != QDialog::Accepted)
+  {
+    return;
+  }
+
+  PreviewRegion region;
+  region.mode = static_cast<PreviewRegion::Mode>(modeCombo->currentData().toInt());
+  for(int i = 0; i < 3; i++)
+  {
+    region.minimum[i] = std::min(minimumSpinBoxes[i]->value(), maximumSpinBoxes[i]->value());
+    region.maximum[i] = std::max(minimumSpinBoxes[i]->value(), maximumSpinBoxes[i]->value());
+  }
+  region.factor = factorSpinBox->value();
+  setPreviewRegion(region);
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenEstimatePipelineTriggered()
+{
+  // The pipeline view keeps the pipeline preflighted, so the sizes of its arrays are known; a running pipeline owns
+  // its data, so the estimate of its last preflight is shown then
+  if(!m_Ui->pipelineListWidget->getPipelineView()->isPipelineCurrentlyRunning())
+  {
+    capturePreflightEstimate();
+  }
+  PipelineEstimateDialog dialog(m_PreflightEstimate, ProcessMemory::AvailablePhysicalBytes(), this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenRunHistoryTriggered()
+{
+  RunHistoryDialog dialog(dream3dApp->getRunHistory(), this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenRunReportTriggered()
+{
+  if(nullptr == m_LastRunRecorder)
+  {
+    return;
+  }
+  RunReportDialog dialog(*m_LastRunRecorder, getRunOwnerName(), this);
+  dialog.exec();
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenParameterSweepTriggered()
+{
+  if(m_ParameterSweepDialog == nullptr)
+  {
+    m_ParameterSweepDialog = new ParameterSweepDialog(this);
+  }
+
+  // A sweep that runs keeps the pipeline it was started with
+  if(!m_ParameterSweepDialog->isRunning())
+  {
+    m_ParameterSweepDialog->setPipeline(serializePipeline(), getRunOwnerName());
+  }
+  m_ParameterSweepDialog->show();
+  m_ParameterSweepDialog->raise();
+  m_ParameterSweepDialog->activateWindow();
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::listenWatchFolderTriggered()
+{
+  if(m_WatchFolderDialog == nullptr)
+  {
+    m_WatchFolderDialog = new WatchFolderDialog(this);
+  }
+
+  // A watched folder keeps the pipeline it was started with
+  if(!m_WatchFolderDialog->isBusy())
+  {
+    m_WatchFolderDialog->setPipeline(serializePipeline(), getRunOwnerName());
+  }
+  m_WatchFolderDialog->show();
+  m_WatchFolderDialog->raise();
+  m_WatchFolderDialog->activateWindow();
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::showFilterDataStructure(
+AbstractFilter::Pointer filter)
+{
+  closeBrowsedFile();
+  m_Ui->dataBrowserWidget->filterActivated(filter);
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::closeBrowsedFile()
+{
+  if(!m_FileBrowser->isOpen())
+  {
+    return;
+  }
+
+  m_FileBrowser->close();
+  m_Ui->dataBrowserDockWidget->setWindowTitle(m_DataBrowserTitle);
+  m_ActionPreviewArray->setEnabled(false);
+  m_Ui->arrayInspectorWidget->refreshArrays();
+  m_Ui->sliceViewerWidget->refreshArrays();
 }
 
 // -----------------------------------------------------------------------------
@@ -1265,6 +2541,169 @@ void SIMPLView_UI::clearPipeline(bool playAnimation)
   pipelineView->clearPipeline(playAnimation);
 }
 
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::beginPipelineTransaction(const QString& text)
+{
+  if(m_TransactionDepth == 0)
+  {
+    m_TransactionText = text;
+    m_TransactionEdits.clear();
+
+    // Every command applied while the transaction is open would preflight on its own, so the view only
+    // preflights once the transaction ends
+    m_Ui->pipelineListWidget->getPipelineView()->blockPreflightSignals(true);
+  }
+
+  m_TransactionDepth++;
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::endPipelineTransaction()
+{
+  if(m_TransactionDepth <= 0)
+  {
+    return;
+  }
+
+  if(m_TransactionDepth > 1)
+  {
+    m_TransactionDepth--;
+    return;
+  }
+
+  // The depth stays at one while committing so that the signals the view emits while
+  // applying the edits are deferred along with everything else
+  commitPipelineTransaction();
+  m_TransactionDepth = 0;
+
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+  pipelineView->blockPreflightSignals(false);
+
+  // A file that is still loading is preflighted once it is complete
+  if(m_PipelineChangesPending && !m_PipelineFileLoader->isLoading())
+  {
+    // The preflight reports its results right away now that the transaction is closed
+    m_PreflightResultPending = false;
+    pipelineView->preflightPipeline();
+  }
+  else if(m_PreflightResultPending)
+  {
+    m_PreflightResultPending = false;
+    updatePreflightResults(m_PendingPreflightFilterCount, m_PendingPreflightError);
+  }
+
+  flushPipelineChanges();
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::pipelineRowsAboutToChange()
+{
+  if(m_TransactionDepth > 0)
+  {
+    return;
+  }
+
+  // Cut, paste, drops and the other commands of the view change the model without a transaction.  One is opened
+  // at their first change and closed once the command is done and control is back in the event loop.
+  beginPipelineTransaction("Edit Pipeline");
+  QTimer::singleShot(0, this, &SIMPLView_UI::endPipelineTransaction);
+}
+
+// -----------------------------------------------------------------------------
+bool SIMPLView_UI::isPipelineTransactionOpen() const
+{
+  return m_TransactionDepth > 0;
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::commitPipelineTransaction()
+{
+  std::vector<PipelineEdit> edits;
+  edits.swap(m_TransactionEdits);
+  if(edits.empty())
+  {
+    return;
+  }
+
+  SVPipelineView* pipelineView = m_Ui->pipelineListWidget->getPipelineView();
+
+  // A single edit is pushed as is.  Several edits become the children of one command, so they are
+  // undone and redone together.
+  QUndoCommand* command = nullptr;
+  QUndoCommand* parent = nullptr;
+  if(edits.size() > 1)
+  {
+    command = new QUndoCommand(m_TransactionText);
+    parent = command;
+  }
+
+  for(const PipelineEdit& edit : edits)
+  {
+    QUndoCommand* editCommand = nullptr;
+    if(edit.add)
+    {
+      editCommand = new AddFilterCommand(edit.filters, pipelineView, m_TransactionText, edit.insertIndex, parent);
+    }
+    else
+    {
+      editCommand = new RemoveFilterCommand(edit.filters, pipelineView, m_TransactionText, parent);
+    }
+
+    if(command == nullptr)
+    {
+      command = editCommand;
+    }
+  }
+
+  pipelineView->addUndoCommand(command);
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::addFilters(const std::vector<AbstractFilter::Pointer>& filters, int insertIndex)
+{
+  if(filters.empty())
+  {
+    return;
+  }
+
+  PipelineTransaction transaction(this, "Add Filters");
+
+  // Additions that continue where the previous one stopped are merged, so that a transaction made of
+  // consecutive additions is applied by one command and preflighted once
+  if(!m_TransactionEdits.empty())
+  {
+    PipelineEdit& lastEdit = m_TransactionEdits.back();
+    int lastEnd = lastEdit.insertIndex < 0 ? -1 : lastEdit.insertIndex + static_cast<int>(lastEdit.filters.size());
+    if(lastEdit.add && insertIndex == lastEnd)
+    {
+      lastEdit.filters.insert(lastEdit.filters.end(), filters.cbegin(), filters.cend());
+      return;
+    }
+  }
+
+  PipelineEdit edit;
+  edit.add = true;
+  edit.filters = filters;
+  edit.insertIndex = insertIndex;
+  m_TransactionEdits.push_back(edit);
+}
+
+// -----------------------------------------------------------------------------
+void SIMPLView_UI::removeFilters(const std::vector<AbstractFilter::Pointer>& filters)
+{
+  if(filters.empty())
+  {
+    return;
+  }
+
+  PipelineTransaction transaction(this, "Remove Filters");
+
+  PipelineEdit edit;
+  edit.add = false;
+  edit.filters = filters;
+  m_TransactionEdits.push_back(edit);
+}
+
 #ifdef SIMPL_EMBED_PYTHON
 // -----------------------------------------------------------------------------
 void SIMPLView_UI::setPythonGUIEnabled(bool value)
@@ -35,6 +35,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 //-- Qt Includes
 #include <QtCore/QObject>
 #include <QtCore/QString>
@@ -52,6 +55,9 @@
 #include "SVWidgetsLib/QtSupport/QtSSettings.h"
 #include "SVWidgetsLib/Widgets/FilterInputWidget.h"
 
+#include "SIMPLView/PipelineCostEstimator.h"
+#include "SIMPLView/PreviewRegion.h"
+
 //-- UIC generated Header
 #include "ui_SIMPLView_UI.h"
 
@@ -71,6 +77,18 @@ class PipelineListWidget;
 class SVPipelineViewWidget;
 class SIMPLViewMenuItems;
 class SIMPLViewUIMessageHandler;
+class DREAM3DFileBrowser;
+class FilterTimingRecorder;
+class PipelineFileLoader;
+class PipelineFileWriter;
+class PipelineHistory;
+class PipelineJournal;
+class ParameterSweepDialog;
+class PipelineExecution;
+class WatchFolderDialog;
+class QLabel;
+class QTimer;
+class QUndoCommand;
 
 /**
  * @class SIMPLView_UI SIMPLView_UI Applications/SIMPLView/SIMPLView_UI.h
@@ -123,17 +141,48 @@ public:
   void writeSettings();
 
   /**
-   * @brief openPipeline
+   * @brief Opens a pipeline file.  JSON pipelines are loaded in the background and their filters appear in
+   * batches; the return value only reports whether the load could be started.
    * @param filePath
    * @return
    */
   int openPipeline(const QString& filePath);
 
   /**
-   * @brief executePipeline
+   * @brief Queues the pipeline with the execution scheduler of the application, which starts it once the threads
+   * and memory it needs are available.  If a pipeline file is still loading, the pipeline is queued once it is loaded.
    */
   void executePipeline();
 
+  /**
+   * @brief Queues a copy of the pipeline restricted to the preview region with the execution scheduler.  The copy leaves out the filters that
+   * write files and its result is shown in the Data Structure dock.
+   */
+  void executePreview();
+
+  /**
+   * @brief Stops the running preview
+   */
+  void cancelPreview();
+
+  /**
+   * @brief Returns true while a preview is running
+   * @return
+   */
+  bool isPreviewRunning() const;
+
+  /**
+   * @brief Returns the region previews are restricted to
+   * @return
+   */
+  PreviewRegion getPreviewRegion() const;
+
+  /**
+   * @brief Sets the region previews are restricted to.  The region is saved with the pipeline.
+   * @param region
+   */
+  void setPreviewRegion(const PreviewRegion& region);
+
   /**
    * @brief showDockWidget
    */
@@ -153,7 +202,8 @@ public:
   bool undoStackIsClear() const;
 
   /**
-   * @brief Clears the undo stack
+   * @brief Clears the undo stack of the pipeline view.  Edits that are not in the pipeline history yet are
+   * recorded first, so the history, which backs Undo and Redo, is kept.
    */
   void clearUndoStack();
 
@@ -175,6 +225,62 @@ public:
    */
   void clearPipeline(bool playAnimation);
 
+  /**
+   * @brief Opens a pipeline edit transaction.  Transactions may be nested.  Filters added or removed through
+   * addFilters() and removeFilters() while a transaction is open are grouped into a single undo command.  The
+   * view does not preflight while a transaction is open; the pipeline is preflighted once, and the data browser
+   * refresh and the dirty flag are applied once, when the outermost transaction ends.
+   * @param text The text of the grouped undo command
+   */
+  void beginPipelineTransaction(const QString& text);
+
+  /**
+   * @brief Closes the innermost pipeline edit transaction.  Closing the outermost transaction applies the grouped
+   * edits as one undo command, then refreshes the UI once.
+   */
+  void endPipelineTransaction();
+
+  /**
+   * @brief Returns true if a pipeline edit transaction is currently open
+   * @return
+   */
+  bool isPipelineTransactionOpen() const;
+
+  /**
+   * @brief Adds filters to the pipeline as part of the current transaction.  If no transaction is open, the
+   * filters are added as a single edit.
+   * @param filters
+   * @param insertIndex The row to insert the filters at, or -1 to append them
+   */
+  void addFilters(const std::vector<AbstractFilter::Pointer>& filters, int insertIndex = -1);
+
+  /**
+   * @brief Removes filters from the pipeline as part of the current transaction.  If no transaction is open, the
+   * filters are removed as a single edit.
+   * @param filters
+   */
+  void removeFilters(const std::vector<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief Writes out the crash recovery journal of this window and keeps it on disk after the window closes
+   */
+  void preservePipelineJournal();
+
+  /**
+   * @brief Shows the structure of a .dream3d file in the Data Structure dock without reading its data.  The dock
+   * goes back to showing the pipeline as soon as a filter is selected or the pipeline changes.
+   * @param filePath
+   * @return
+   */
+  bool browseFile(const QString& filePath);
+
+  /**
+   * @brief Returns the browser of the file shown in the Data Structure dock.  It is not open unless the dock is
+   * in browse mode.
+   * @return
+   */
+  DREAM3DFileBrowser* getFileBrowser() const;
+
 public Q_SLOTS:
   /**
    * @brief setFilterBeingDragged
@@ -291,6 +397,12 @@ protected:
    */
   void handlePipelineChanges();
 
+  /**
+   * @brief Applies the deferred dirty flag and data browser refresh for all pipeline changes that
+   * happened since the last flush
+   */
+  void flushPipelineChanges();
+
 protected Q_SLOTS:
   /**
    * @brief Writes the window settings for the SIMPLView_UI instance.  This includes the window position and size,
@@ -349,6 +461,84 @@ protected Q_SLOTS:
    */
   void filterSelectionChanged(const QItemSelection& selected, const QItemSelection& deselected);
 
+  /**
+   * @brief Restores the previous state from the pipeline history
+   */
+  void listenUndoTriggered();
+
+  /**
+   * @brief Restores the next state from the pipeline history
+   */
+  void listenRedoTriggered();
+
+  /**
+   * @brief Asks for a .dream3d file and shows its structure in the Data Structure dock
+   */
+  void listenBrowseFileTriggered();
+
+  /**
+   * @brief Asks for an array of the browsed file, reads its first tuples on a worker thread and shows them
+   */
+  void listenPreviewArrayTriggered();
+
+  /**
+   * @brief Asks for the region previews are restricted to
+   */
+  void listenConfigurePreviewRegionTriggered();
+
+  /**
+   * @brief Shows the predicted memory and runtime of the current pipeline
+   */
+  void listenEstimatePipelineTriggered();
+
+  /**
+   * @brief Shows the recorded runs of pipelines and filter types
+   */
+  void listenRunHistoryTriggered();
+
+  /**
+   * @brief Shows what each filter of the last finished run cost
+   */
+  void listenRunReportTriggered();
+
+  /**
+   * @brief Shows the parameter sweep dialog for the current pipeline
+   */
+  void listenParameterSweepTriggered();
+
+  /**
+   * @brief Shows the dialog that runs the current pipeline on the new files of a directory
+   */
+  void listenWatchFolderTriggered();
+
+  /**
+   * @brief Shows the result of a preview once its thread is done
+   */
+  void previewDidFinish();
+
+  /**
+   * @brief Accounts for a run of the pipeline view with the execution scheduler
+   */
+  void pipelineDidStart();
+
+  /**
+   * @brief Cleans up after a run of this window that was removed from the queue before it started
+   * @param jobId
+   */
+  void scheduledJobFinished(int jobId);
+
+  /**
+   * @brief Cancels the pipeline run when it is cancelled from the execution queue
+   * @param jobId
+   */
+  void scheduledJobCancelRequested(int jobId);
+
+  /**
+   * @brief Shows a message of the preview pipeline, which does not go to the issues table
+   * @param msg
+   */
+  void processPreviewMessage(const AbstractMessage::Pointer& msg);
+
   // Our Signals that we can emit custom for this class
 Q_SIGNALS:
   void parentResized();
@@ -405,6 +595,132 @@ private:
 
   QActionGroup* m_ThemeActionGroup = nullptr;
 
+  QAction* m_ActionBrowseFile = nullptr;
+  QAction* m_ActionPreviewArray = nullptr;
+  QAction* m_ActionPreviewPipeline = nullptr;
+  QAction* m_ActionCancelPreview = nullptr;
+  QAction* m_ActionConfigurePreviewRegion = nullptr;
+  QAction* m_ActionEstimatePipeline = nullptr;
+  QAction* m_ActionRunHistory = nullptr;
+  QAction* m_ActionRunReport = nullptr;
+  QAction* m_ActionCountHardwareEvents = nullptr;
+  QAction* m_ActionParameterSweep = nullptr;
+  QAction* m_ActionWatchFolder = nullptr;
+  QAction* m_ActionUndo = nullptr;
+  QAction* m_ActionRedo = nullptr;
+
+  PipelineJournal* m_PipelineJournal = nullptr;
+  QTimer* m_HistoryRecordTimer = nullptr;
+  PipelineHistory* m_PipelineHistory = nullptr;
+  QLabel* m_UndoMemoryLabel = nullptr;
+  bool m_RestoringPipelineState = false;
+  QLabel* m_PipelineForecastLabel = nullptr;
+
+  PipelineFileLoader* m_PipelineFileLoader = nullptr;
+  std::unique_ptr<QUndoCommand> m_LoadCommand;
+  PipelineFileWriter* m_PipelineFileWriter = nullptr;
+  QString m_PendingSaveAsFilePath; // Written in the background by Save As and not yet on disk
+  int m_EditCount = 0;
+  int m_SavedEditCount = 0;
+  bool m_ExecuteAfterLoad = false;
+
+  std::unique_ptr<DREAM3DFileBrowser> m_FileBrowser;
+  QString m_DataBrowserTitle;
+
+  PreviewRegion m_PreviewRegion;
+  bool m_HasPreviewRegion = false;
+  PipelineExecution* m_PreviewExecution = nullptr;
+  int m_PreviewJobId = 0;
+  int m_PipelineJobId = 0;
+  std::unique_ptr<FilterTimingRecorder> m_TimingRecorder;
+  std::unique_ptr<FilterTimingRecorder> m_LastRunRecorder;
+  PipelineCostEstimator::Estimate m_PreflightEstimate;
+  qint64 m_PreflightMemory = 0;
+  bool m_PipelineCancelRequested = false;
+  ParameterSweepDialog* m_ParameterSweepDialog = nullptr;
+  WatchFolderDialog* m_WatchFolderDialog = nullptr;
+
+  /**
+   * @brief The PipelineEdit struct is a single add or remove recorded by an open pipeline transaction
+   */
+  struct PipelineEdit
+  {
+    bool add = true;
+    std::vector<AbstractFilter::Pointer> filters;
+    int insertIndex = -1;
+  };
+
+  int m_TransactionDepth = 0;
+  QString m_TransactionText;
+  std::vector<PipelineEdit> m_TransactionEdits;
+  bool m_PipelineChangesPending = false;
+  bool m_PreflightResultPending = false;
+  int32_t m_PendingPreflightFilterCount = 0;
+  int m_PendingPreflightError = 0;
+
+  /**
+   * @brief Pushes the edits recorded by the outermost transaction onto the undo stack as one command
+   */
+  void commitPipelineTransaction();
+
+  /**
+   * @brief Opens a transaction around a command of the pipeline view that is about to change the filters, so
+   * the command preflights once.  The transaction is closed on the next pass through the event loop.
+   */
+  void pipelineRowsAboutToChange();
+
+  /**
+   * @brief Refreshes the data browser, issues table and pipeline list after a preflight
+   * @param pipelineFilterCount
+   * @param err
+   */
+  void updatePreflightResults(int32_t pipelineFilterCount, int err);
+
+  /**
+   * @brief Shows the structure produced by a pipeline filter in the Data Structure dock, leaving browse mode
+   * @param filter
+   */
+  void showFilterDataStructure(AbstractFilter::Pointer filter);
+
+  /**
+   * @brief Leaves browse mode and releases the arrays read from the browsed file
+   */
+  void closeBrowsedFile();
+
+  /**
+   * @brief Records the current pipeline in the pipeline history and the pipeline journal, then drops the
+   * commands on the undo stack of the view
+   */
+  void recordPipelineState();
+
+  /**
+   * @brief Replaces the filters in the pipeline with the filters of a state taken from the pipeline history,
+   * without leaving commands on the undo stack of the view
+   * @param pipeline
+   */
+  void restorePipelineState(const QJsonObject& pipeline);
+
+  /**
+   * @brief Shows the memory used by the pipeline history in the status bar
+   * @param bytes
+   */
+  void updateUndoMemoryLabel(qint64 bytes);
+
+  /**
+   * @brief Adds a batch of filters delivered by the pipeline file loader to the pipeline right away.  Its command
+   * becomes a child of m_LoadCommand, which is pushed as one undo step when the load finishes.
+   * @param filters
+   */
+  void pipelineFiltersLoaded(const std::vector<AbstractFilter::Pointer>& filters);
+
+  /**
+   * @brief Finishes opening a pipeline file once the loader is done.  A file that could only be read in part is
+   * reported and leaves the window modified and without a file path.
+   * @param err
+   * @param filterCount
+   */
+  void pipelineFileLoadFinished(int err, int filterCount);
+
   /**
    * @brief createSIMPLViewMenu
    */
@@ -418,15 +734,42 @@ private:
 
   /**
    * @brief savePipeline
+   * @param waitForWrite Writes the file before returning instead of in the background
    * @return
    */
-  bool savePipeline();
+  bool savePipeline(bool waitForWrite);
 
   /**
    * @brief saveAsPipeline
+   * @param waitForWrite Writes the file before returning instead of in the background.  A background write only
+   * becomes the file of the window once pipelineFileWritten reports it is on disk.
    * @return
    */
-  bool savePipelineAs();
+  bool savePipelineAs(bool waitForWrite);
+
+  /**
+   * @brief Makes a file written by Save As the file of the window and offers to bookmark it
+   * @param filePath
+   */
+  void pipelineSavedAs(const QString& filePath);
+
+  /**
+   * @brief Writes the pipeline to the file in the format selected by its suffix.  JSON and CBOR files are
+   * written in the background unless waitForWrite is set; pipelineFileWritten reports the outcome.
+   * @param filePath
+   * @param waitForWrite
+   * @return Negative on error
+   */
+  int writePipelineFile(const QString& filePath, bool waitForWrite);
+
+  /**
+   * @brief Reports the outcome of a background pipeline write in the status bar, and finishes a Save As once its
+   * file is on disk
+   * @param filePath
+   * @param success
+   * @param errorMessage
+   */
+  void pipelineFileWritten(const QString& filePath, bool success, const QString& errorMessage);
 
   /**
    * @brief getPipelineModel
@@ -434,6 +777,44 @@ private:
    */
   PipelineModel* getPipelineModel();
 
+  /**
+   * @brief Returns the filters of the pipeline model in order
+   * @return
+   */
+  std::vector<AbstractFilter::Pointer> getPipelineFilters();
+
+  /**
+   * @brief Starts the pipeline view once the scheduler admitted its run
+   * @param jobId
+   */
+  void startScheduledPipeline(int jobId);
+
+  /**
+   * @brief Handles the Start button of the pipeline list: cancels a running pipeline, otherwise queues a run with
+   * the scheduler like the Run action
+   */
+  void startPipelineClicked();
+
+  /**
+   * @brief Returns the name the runs of this window are listed under in the execution queue
+   * @return
+   */
+  QString getRunOwnerName() const;
+
+  /**
+   * @brief Asks whether to go on when the preflighted pipeline needs more memory than is available
+   * @param peakBytes The predicted peak of the pipeline
+   * @param question
+   * @return True if the memory suffices or the user answered yes
+   */
+  bool confirmPipelineMemory(qint64 peakBytes, const QString& question);
+
+  /**
+   * @brief Keeps the cost and memory of the pipeline as preflighted.  Runs that have already started use these,
+   * since the data of the filters belongs to the running pipeline by then.
+   */
+  void capturePreflightEstimate();
+
 public:
   SIMPLView_UI(const SIMPLView_UI&) = delete;            // Copy Constructor Not Implemented
   SIMPLView_UI(SIMPLView_UI&&) = delete;                 // Move Constructor Not Implemented
@@ -0,0 +1,490 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ScratchStager.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSet>
+#include <QtCore/QStorageInfo>
+#include <QtCore/QUuid>
+
+#include "SIMPLib/Common/Constants.h"
+
+#include "SIMPLView/InputPrefetcher.h"
+#include "SIMPLView/ParameterSweep.h"
+#include "SIMPLView/PipelineFileFormat.h"
+#include "SIMPLView/ProcessActivity.h"
+
+namespace
+{
+const int k_CopyThreads = 4;
+const int k_CapacityDivisor = 4; // Of the size of the scratch volume
+const QString k_IndexFileName("StagingIndex.json");
+const QString k_InputsDirectoryName("Inputs");
+const QString k_RunsDirectoryName("Runs");
+
+// -----------------------------------------------------------------------------
+bool CopyFileReplacing(const QString& sourcePath, const QString& destinationPath, QString& errorMessage)
+{
+  ProcessActivity::Scope activity;
+
+  // The destination is replaced only once the copy is complete
+  QDir().mkpath(QFileInfo(destinationPath).absolutePath());
+  QString partPath = QString("%1.%2.part").arg(destinationPath, QUuid::createUuid().toString(QUuid::WithoutBraces));
+  if(!QFile::copy(sourcePath, partPath))
+  {
+    errorMessage = QObject::tr("'%1' could not be copied to '%2'.").arg(sourcePath, destinationPath);
+    return false;
+  }
+  QFile::remove(destinationPath);
+  if(!QFile::rename(partPath, destinationPath))
+  {
+    QFile::remove(partPath);
+    errorMessage = QObject::tr("'%1' could not be replaced.").arg(destinationPath);
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ScratchStager::ScratchStager(const QString& scratchDirectory)
+: m_ScratchDirectory(scratchDirectory)
+{
+  m_CopyPool.setMaxThreadCount(k_CopyThreads);
+  readIndex();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ScratchStager::~ScratchStager()
+{
+  m_CopyPool.waitForDone();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ScratchStager::getScratchDirectory() const
+{
+  return m_ScratchDirectory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ScratchStager::Plan ScratchStager::createPlan(const QJsonObject& pipeline, const QString& runName) const
+{
+  Plan plan;
+  plan.pipeline = pipeline;
+  QString runDirectoryName = QString("%1_%2").arg(runName, QDateTime::currentDateTime().toString("yyyyMMdd-HHmmss-zzz"));
+  plan.runDirectory = QDir(m_ScratchDirectory).filePath(k_RunsDirectoryName + "/" + runDirectoryName);
+
+  std::vector<int> inputFilters = ParameterSweep::FindFiltersOfSubGroup(pipeline, SIMPL::FilterSubGroups::InputFilters);
+  for(int index : inputFilters)
+  {
+    QString key = QString::number(index);
+    QJsonObject filter = plan.pipeline[key].toObject();
+    if(!filter["Filter_Enabled"].toBool(true))
+    {
+      continue;
+    }
+
+    for(auto iter = filter.begin(); iter != filter.end(); ++iter)
+    {
+      if(iter.value().isString())
+      {
+        QString sourcePath = InputPrefetcher::AbsoluteInputPath(iter.value().toString());
+        if(iter.value().toString().isEmpty() || !QFileInfo(sourcePath).isFile())
+        {
+          continue;
+        }
+        QString stagedPath = stagedPathFor(sourcePath);
+        plan.inputs.emplace_back(sourcePath, stagedPath);
+        iter.value() = QDir::toNativeSeparators(stagedPath);
+      }
+      else if(iter.value().isObject() && InputPrefetcher::IsFileList(iter.value().toObject()))
+      {
+        QJsonObject fileList = iter.value().toObject();
+        QStringList filePaths = InputPrefetcher::FileListPaths(fileList);
+        if(filePaths.isEmpty())
+        {
+          continue;
+        }
+        for(const QString& filePath : filePaths)
+        {
+          plan.inputs.emplace_back(filePath, stagedPathFor(filePath));
+        }
+        fileList["InputPath"] = QDir::toNativeSeparators(QFileInfo(stagedPathFor(filePaths.front())).absolutePath());
+        iter.value() = fileList;
+      }
+    }
+    plan.pipeline[key] = filter;
+  }
+
+  std::vector<int> outputFilters = ParameterSweep::FindFiltersOfSubGroup(pipeline, SIMPL::FilterSubGroups::OutputFilters);
+  for(int index : outputFilters)
+  {
+    QString key = QString::number(index);
+    QJsonObject filter = plan.pipeline[key].toObject();
+    if(!filter["Filter_Enabled"].toBool(true))
+    {
+      continue;
+    }
+
+    // Each filter writes into its own directory, so two writers with the same file name do not collide
+    QDir localDirectory(QDir(plan.runDirectory).filePath(key));
+    for(auto iter = filter.begin(); iter != filter.end(); ++iter)
+    {
+      if(!iter.key().contains("Output", Qt::CaseInsensitive) || !iter.value().isString() || iter.value().toString().isEmpty())
+      {
+        continue;
+      }
+
+      // Members without a suffix name a directory, the others a file, as in ParameterSweep::RedirectOutputs
+      QString destinationPath = InputPrefetcher::AbsoluteInputPath(iter.value().toString());
+      QFileInfo destination(destinationPath);
+      QString localPath = localDirectory.filePath(destination.suffix().isEmpty() ? iter.key() : destination.fileName());
+      plan.outputs.emplace_back(localPath, destinationPath);
+      iter.value() = QDir::toNativeSeparators(localPath);
+    }
+    plan.pipeline[key] = filter;
+  }
+
+  return plan;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScratchStager::stageInputs(const Plan& plan, QString& errorMessage)
+{
+  for(const auto& output : plan.outputs)
+  {
+    QFileInfo local(output.first);
+    QString directory = local.suffix().isEmpty() ? output.first : local.absolutePath();
+    if(!QDir().mkpath(directory))
+    {
+      errorMessage = QObject::tr("The scratch directory '%1' could not be created.").arg(directory);
+      return false;
+    }
+  }
+
+  // Several parameters may read the same file, which is copied once.  A copy started for another run is shared.
+  QSet<QString> sources;
+  QSet<QString> stagedPaths;
+  std::vector<QFuture<QString>> copies;
+  {
+    QMutexLocker locker(&m_IndexMutex);
+    for(const auto& input : plan.inputs)
+    {
+      if(sources.contains(input.first))
+      {
+        continue;
+      }
+      sources.insert(input.first);
+      stagedPaths.insert(input.second);
+      m_Staging[input.second]++;
+
+      auto copy = m_Copies.find(input.first);
+      if(copy == m_Copies.end())
+      {
+        copy = m_Copies.insert(input.first, QtConcurrent::run(&m_CopyPool, [this, input] {
+          QString copyError = stageFile(input.first, input.second);
+          QMutexLocker copyLocker(&m_IndexMutex);
+          m_Copies.remove(input.first);
+          return copyError;
+        }));
+      }
+      copies.push_back(copy.value());
+    }
+  }
+
+  QStringList errors;
+  for(QFuture<QString>& copy : copies)
+  {
+    copy.waitForFinished();
+    if(!copy.result().isEmpty())
+    {
+      errors.push_back(copy.result());
+    }
+  }
+  writeIndex();
+
+  if(!errors.isEmpty())
+  {
+    QMutexLocker locker(&m_IndexMutex);
+    for(const QString& stagedPath : stagedPaths)
+    {
+      if(--m_Staging[stagedPath] <= 0)
+      {
+        m_Staging.remove(stagedPath);
+      }
+    }
+    errorMessage = errors.front();
+    return false;
+  }
+
+  // The inputs are held all at once.  Another run may have started to replace one of them in the meantime, so its
+  // copy is waited for first; nothing is held while waiting, so two stagings cannot wait on each other.
+  QMutexLocker locker(&m_IndexMutex);
+  while(true)
+  {
+    auto pending = std::find_if(sources.cbegin(), sources.cend(), [this](const QString& source) { return m_Copies.contains(source); });
+    if(pending == sources.cend())
+    {
+      break;
+    }
+    QFuture<QString> copy = m_Copies.value(*pending);
+    locker.unlock();
+    copy.waitForFinished();
+    locker.relock();
+  }
+  for(const QString& stagedPath : stagedPaths)
+  {
+    m_Users[stagedPath]++;
+    if(--m_Staging[stagedPath] <= 0)
+    {
+      m_Staging.remove(stagedPath);
+    }
+  }
+  locker.unlock();
+
+  evictInputs();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScratchStager::releaseInputs(const Plan& plan)
+{
+  QSet<QString> stagedPaths;
+  for(const auto& input : plan.inputs)
+  {
+    stagedPaths.insert(input.second);
+  }
+
+  QMutexLocker locker(&m_IndexMutex);
+  for(const QString& stagedPath : stagedPaths)
+  {
+    auto users = m_Users.find(stagedPath);
+    if(users != m_Users.end() && --users.value() <= 0)
+    {
+      m_Users.erase(users);
+    }
+  }
+  m_Released.wakeAll();
+  locker.unlock();
+
+  evictInputs();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ScratchStager::CopyOutputsBack(const Plan& plan, QString& errorMessage)
+{
+  for(const auto& output : plan.outputs)
+  {
+    // A writer that was disabled or wrote nothing leaves nothing to copy
+    QFileInfo local(output.first);
+    if(!local.exists())
+    {
+      continue;
+    }
+
+    if(!local.isDir())
+    {
+      if(!CopyFileReplacing(output.first, output.second, errorMessage))
+      {
+        return false;
+      }
+      continue;
+    }
+
+    QDir localDirectory(output.first);
+    QDirIterator iter(output.first, QDir::Files, QDirIterator::Subdirectories);
+    while(iter.hasNext())
+    {
+      QString filePath = iter.next();
+      if(!CopyFileReplacing(filePath, QDir(output.second).filePath(localDirectory.relativeFilePath(filePath)), errorMessage))
+      {
+        return false;
+      }
+    }
+  }
+
+  QDir(plan.runDirectory).removeRecursively();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ScratchStager::stagedPathFor(const QString& sourcePath) const
+{
+  QFileInfo source(sourcePath);
+  QByteArray directoryHash = QCryptographicHash::hash(source.absolutePath().toUtf8(), QCryptographicHash::Sha1).toHex();
+  return QDir(m_ScratchDirectory).filePath(QString("%1/%2/%3").arg(k_InputsDirectoryName, QString::fromLatin1(directoryHash), source.fileName()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ScratchStager::stageFile(const QString& sourcePath, const QString& stagedPath)
+{
+  QFileInfo source(sourcePath);
+  double size = static_cast<double>(source.size());
+  double modified = static_cast<double>(source.lastModified().toMSecsSinceEpoch());
+
+  {
+    QMutexLocker locker(&m_IndexMutex);
+    QJsonObject entry = m_Index[sourcePath].toObject();
+    QFileInfo staged(stagedPath);
+    if(entry["Size"].toDouble(-1) == size && entry["Modified"].toDouble(-1) == modified && staged.isFile() && static_cast<double>(staged.size()) == size)
+    {
+      entry["Used"] = static_cast<double>(QDateTime::currentMSecsSinceEpoch());
+      m_Index[sourcePath] = entry;
+      return QString();
+    }
+
+    // A run that holds the old copy may open it again at any point, so the source changed under it is copied once
+    // the run is done.  The copy stays in flight meanwhile, which keeps new runs from holding the old copy.
+    while(m_Users.value(stagedPath) > 0)
+    {
+      m_Released.wait(&m_IndexMutex);
+    }
+  }
+
+  QString errorMessage;
+  if(!CopyFileReplacing(sourcePath, stagedPath, errorMessage))
+  {
+    return errorMessage;
+  }
+
+  QJsonObject entry;
+  entry["Size"] = size;
+  entry["Modified"] = modified;
+  entry["Staged"] = stagedPath;
+  entry["Used"] = static_cast<double>(QDateTime::currentMSecsSinceEpoch());
+  QMutexLocker locker(&m_IndexMutex);
+  m_Index[sourcePath] = entry;
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScratchStager::evictInputs()
+{
+  QStorageInfo volume(m_ScratchDirectory);
+  if(!volume.isValid() || volume.bytesTotal() <= 0)
+  {
+    return;
+  }
+  double capacity = static_cast<double>(volume.bytesTotal() / k_CapacityDivisor);
+
+  {
+    QMutexLocker locker(&m_IndexMutex);
+    double stagedBytes = 0.0;
+    std::vector<std::pair<double, QString>> evictable; // Last use, source file
+    for(auto iter = m_Index.constBegin(); iter != m_Index.constEnd(); ++iter)
+    {
+      QJsonObject entry = iter.value().toObject();
+      QString stagedPath = entry["Staged"].toString();
+      stagedBytes += entry["Size"].toDouble(0.0);
+      if(!m_Users.contains(stagedPath) && !m_Staging.contains(stagedPath) && !m_Copies.contains(iter.key()))
+      {
+        evictable.emplace_back(entry["Used"].toDouble(0.0), iter.key());
+      }
+    }
+    if(stagedBytes <= capacity)
+    {
+      return;
+    }
+
+    std::sort(evictable.begin(), evictable.end());
+    for(const auto& candidate : evictable)
+    {
+      if(stagedBytes <= capacity)
+      {
+        break;
+      }
+      QJsonObject entry = m_Index.take(candidate.second).toObject();
+      QFileInfo staged(entry["Staged"].toString());
+      QFile::remove(staged.absoluteFilePath());
+      QDir().rmdir(staged.absolutePath()); // Only once the other files of its directory are gone
+      stagedBytes -= entry["Size"].toDouble(0.0);
+    }
+  }
+  writeIndex();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScratchStager::readIndex()
+{
+  QFile file(QDir(m_ScratchDirectory).filePath(k_IndexFileName));
+  if(file.open(QIODevice::ReadOnly))
+  {
+    m_Index = QJsonDocument::fromJson(file.readAll()).object();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ScratchStager::writeIndex() const
+{
+  QMutexLocker locker(&m_IndexMutex);
+  QString errorMessage;
+  PipelineFileFormat::WriteFileAtomically(QDir(m_ScratchDirectory).filePath(k_IndexFileName), QJsonDocument(m_Index).toJson(QJsonDocument::Compact), errorMessage);
+}
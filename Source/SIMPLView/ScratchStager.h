@@ -0,0 +1,155 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
+
+/**
+ * @brief The ScratchStager class moves the file I/O of a pipeline to a fast local scratch directory.  A plan
+ * rewrites the paths of the input filters to copies in the scratch directory and the paths of the output
+ * filters to a run directory there.  The inputs are copied in parallel before the run and the outputs are copied
+ * to their real destination after it.
+ *
+ * Staged inputs are kept between runs.  A copy is used again as long as the source file has the same path, size
+ * and modification time; the index of the copies is kept in the scratch directory.  A source that is already being
+ * copied for another run is waited for rather than copied twice.  The inputs of a staged plan are held until
+ * releaseInputs() is called, and a held copy is not replaced while a run may still read it.  Once the copies take
+ * more than a quarter of the scratch volume, the least recently used ones that no run holds are deleted.
+ *
+ * stageInputs() and CopyOutputsBack() block and are meant to run on a worker thread.  Several of them may run at
+ * the same time.
+ */
+class ScratchStager
+{
+public:
+  struct Plan
+  {
+    QJsonObject pipeline;
+    QString runDirectory;
+    std::vector<std::pair<QString, QString>> inputs;  // Source file, staged copy
+    std::vector<std::pair<QString, QString>> outputs; // Local path, destination path
+  };
+
+  ScratchStager(const QString& scratchDirectory);
+  ~ScratchStager();
+
+  /**
+   * @brief Returns the directory the files are staged in
+   * @return
+   */
+  QString getScratchDirectory() const;
+
+  /**
+   * @brief Rewrites the input and output paths of the pipeline
+   * @param pipeline The JSON form of the pipeline
+   * @param runName Names the run directory of the outputs
+   * @return
+   */
+  Plan createPlan(const QJsonObject& pipeline, const QString& runName) const;
+
+  /**
+   * @brief Copies the inputs of the plan that have no current copy and creates the output directories.  On success
+   * the staged inputs are held until releaseInputs() is called with the plan.
+   * @param plan
+   * @param errorMessage
+   * @return
+   */
+  bool stageInputs(const Plan& plan, QString& errorMessage);
+
+  /**
+   * @brief Releases the staged inputs of a plan whose run no longer reads them
+   * @param plan
+   */
+  void releaseInputs(const Plan& plan);
+
+  /**
+   * @brief Copies the outputs of a plan to their destinations and removes its run directory
+   * @param plan
+   * @param errorMessage
+   * @return
+   */
+  static bool CopyOutputsBack(const Plan& plan, QString& errorMessage);
+
+private:
+  QString m_ScratchDirectory;
+  QThreadPool m_CopyPool;
+  mutable QMutex m_IndexMutex;
+  QJsonObject m_Index;
+  QHash<QString, QFuture<QString>> m_Copies; // Source file, copy in flight
+  QHash<QString, int> m_Users;               // Staged copy, number of runs holding it
+  QHash<QString, int> m_Staging;             // Staged copy, number of stagings that are about to hold it
+  QWaitCondition m_Released;
+
+  /**
+   * @brief Returns where a source file is staged.  The files of one source directory share a staged directory,
+   * so file lists keep working.
+   * @param sourcePath
+   * @return
+   */
+  QString stagedPathFor(const QString& sourcePath) const;
+
+  /**
+   * @brief Copies a source file unless its staged copy is current.  A copy that is held by a run is replaced once
+   * it is released.
+   * @param sourcePath
+   * @param stagedPath
+   * @return An error message, or an empty string
+   */
+  QString stageFile(const QString& sourcePath, const QString& stagedPath);
+
+  /**
+   * @brief Deletes the least recently used copies that no run holds or is staging until the copies fit the capacity
+   */
+  void evictInputs();
+
+  void readIndex();
+  void writeIndex() const;
+
+public:
+  ScratchStager(const ScratchStager&) = delete;            // Copy Constructor Not Implemented
+  ScratchStager(ScratchStager&&) = delete;                 // Move Constructor Not Implemented
+  ScratchStager& operator=(const ScratchStager&) = delete; // Copy Assignment Not Implemented
+  ScratchStager& operator=(ScratchStager&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,326 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SlicePyramid.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+const size_t k_CoarsestSize = 32; // Levels stop once no axis is longer than this
+
+/**
+ * @brief Returns the number of voxels of a level with the given factor
+ */
+SliceVolume::Index ReducedDimensions(const SliceVolume::Index& dimensions, size_t factor)
+{
+  return {{(dimensions[0] + factor - 1) / factor, (dimensions[1] + factor - 1) / factor, (dimensions[2] + factor - 1) / factor}};
+}
+
+} // namespace
+
+/**
+ * @brief The LevelBuilder class box-filters a stream of z slices into a level.  Slices are added in order; once
+ * all the slices of one output slice have been added they are averaged and written out.
+ */
+class SlicePyramid::LevelBuilder
+{
+public:
+  LevelBuilder(const SliceVolume::Index& sourceDimensions, size_t factor, int channelCount, SlicePyramid::Level& level)
+  : m_SourceDimensions(sourceDimensions)
+  , m_Factor(factor)
+  , m_ChannelCount(channelCount)
+  , m_Level(level)
+  {
+    m_Level.dimensions = ReducedDimensions(sourceDimensions, factor);
+    m_Level.values.assign(m_Level.dimensions[0] * m_Level.dimensions[1] * m_Level.dimensions[2] * channelCount, 0.0f);
+    m_Sums.assign(m_Level.dimensions[0] * m_Level.dimensions[1] * channelCount, 0.0);
+  }
+
+  void addSlice(size_t z, const float* slice)
+  {
+    const size_t outWidth = m_Level.dimensions[0];
+    for(size_t y = 0; y < m_SourceDimensions[1]; y++)
+    {
+      double* sumRow = m_Sums.data() + (y / m_Factor) * outWidth * m_ChannelCount;
+      const float* row = slice + y * m_SourceDimensions[0] * m_ChannelCount;
+      for(size_t x = 0; x < m_SourceDimensions[0]; x++)
+      {
+        double* sum = sumRow + (x / m_Factor) * m_ChannelCount;
+        for(int c = 0; c < m_ChannelCount; c++)
+        {
+          sum[c] += row[x * m_ChannelCount + c];
+        }
+      }
+    }
+
+    // The last output slice along each axis may cover fewer source voxels than the factor
+    size_t zOut = z / m_Factor;
+    if((z + 1) % m_Factor == 0 || z + 1 == m_SourceDimensions[2])
+    {
+      const size_t zCount = z + 1 - zOut * m_Factor;
+      float* out = m_Level.values.data() + zOut * m_Level.dimensions[0] * m_Level.dimensions[1] * m_ChannelCount;
+      for(size_t yOut = 0; yOut < m_Level.dimensions[1]; yOut++)
+      {
+        const size_t yCount = std::min(m_Factor, m_SourceDimensions[1] - yOut * m_Factor);
+        for(size_t xOut = 0; xOut < outWidth; xOut++)
+        {
+          const size_t xCount = std::min(m_Factor, m_SourceDimensions[0] - xOut * m_Factor);
+          const double count = static_cast<double>(xCount * yCount * zCount);
+          const size_t index = (yOut * outWidth + xOut) * m_ChannelCount;
+          for(int c = 0; c < m_ChannelCount; c++)
+          {
+            out[index + c] = static_cast<float>(m_Sums[index + c] / count);
+          }
+        }
+      }
+      std::fill(m_Sums.begin(), m_Sums.end(), 0.0);
+    }
+  }
+
+private:
+  SliceVolume::Index m_SourceDimensions;
+  size_t m_Factor = 1;
+  int m_ChannelCount = 1;
+  SlicePyramid::Level& m_Level;
+  std::vector<double> m_Sums;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SlicePyramid::Builder::Builder(const SliceVolume& volume, qint64 memoryBudget, Sampling sampling)
+: m_Volume(volume)
+, m_Sampling(sampling)
+, m_Pyramid(new SlicePyramid())
+{
+  m_Pyramid->m_ChannelCount = volume.getChannelCount();
+  const SliceVolume::Index dims = volume.getDimensions();
+  const int channelCount = m_Pyramid->m_ChannelCount;
+
+  size_t factor = 1;
+  auto levelBytes = [&](size_t f) {
+    SliceVolume::Index reduced = ReducedDimensions(dims, f);
+    return static_cast<qint64>(reduced[0] * reduced[1] * reduced[2] * channelCount * sizeof(float));
+  };
+  while(levelBytes(factor) > memoryBudget && factor < std::max({dims[0], dims[1], dims[2]}))
+  {
+    factor *= 2;
+  }
+
+  m_Pyramid->m_Levels.emplace_back();
+  Level& level = m_Pyramid->m_Levels.back();
+  level.factor = factor;
+  if(m_Sampling == Sampling::Average)
+  {
+    m_LevelBuilder = std::make_unique<LevelBuilder>(dims, factor, channelCount, level);
+    m_ReadCount = dims[2];
+  }
+  else
+  {
+    level.dimensions = ReducedDimensions(dims, factor);
+    level.values.assign(level.dimensions[0] * level.dimensions[1] * level.dimensions[2] * channelCount, 0.0f);
+    m_ReadCount = level.dimensions[2];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SlicePyramid::Builder::~Builder() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SlicePyramid::Builder::readNext()
+{
+  if(isComplete())
+  {
+    return true;
+  }
+
+  if(m_Sampling == Sampling::Average)
+  {
+    const SliceVolume::Index dims = m_Volume.getDimensions();
+    if(!m_Volume.readRegion({{0, 0, m_NextRead}}, {{dims[0], dims[1], 1}}, {{1, 1, 1}}, m_Slice))
+    {
+      return false;
+    }
+    m_LevelBuilder->addSlice(m_NextRead, m_Slice.data());
+  }
+  else
+  {
+    Level& level = m_Pyramid->m_Levels.front();
+    const size_t factor = level.factor;
+    if(!m_Volume.readRegion({{0, 0, m_NextRead * factor}}, {{level.dimensions[0], level.dimensions[1], 1}}, {{factor, factor, 1}}, m_Slice))
+    {
+      return false;
+    }
+    std::copy(m_Slice.begin(), m_Slice.end(), level.values.begin() + m_NextRead * m_Slice.size());
+  }
+  m_NextRead++;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SlicePyramid::Builder::isComplete() const
+{
+  return m_NextRead >= m_ReadCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double SlicePyramid::Builder::getProgress() const
+{
+  return m_ReadCount > 0 ? static_cast<double>(m_NextRead) / m_ReadCount : 1.0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SlicePyramid::Pointer SlicePyramid::Builder::finish(const std::atomic_bool& cancelled)
+{
+  m_LevelBuilder.reset();
+  Pointer pyramid = std::move(m_Pyramid);
+  if(pyramid == nullptr || !isComplete() || cancelled)
+  {
+    return Pointer();
+  }
+  const int channelCount = pyramid->m_ChannelCount;
+
+  // Each coarser level halves the one before it, which is already in memory
+  while(true)
+  {
+    const Level& previous = pyramid->m_Levels.back();
+    if(std::max({previous.dimensions[0], previous.dimensions[1], previous.dimensions[2]}) <= k_CoarsestSize || cancelled)
+    {
+      break;
+    }
+
+    Level level;
+    level.factor = previous.factor * 2;
+    LevelBuilder builder(previous.dimensions, 2, channelCount, level);
+    const size_t sliceSize = previous.dimensions[0] * previous.dimensions[1] * channelCount;
+    for(size_t z = 0; z < previous.dimensions[2]; z++)
+    {
+      builder.addSlice(z, previous.values.data() + z * sliceSize);
+    }
+    pyramid->m_Levels.push_back(std::move(level));
+  }
+  if(cancelled)
+  {
+    return Pointer();
+  }
+
+  float minimum = std::numeric_limits<float>::max();
+  float maximum = std::numeric_limits<float>::lowest();
+  for(float value : pyramid->m_Levels.front().values)
+  {
+    minimum = (value < minimum) ? value : minimum;
+    maximum = (value > maximum) ? value : maximum;
+  }
+  pyramid->m_Minimum = minimum <= maximum ? minimum : 0.0f;
+  pyramid->m_Maximum = minimum <= maximum ? maximum : 0.0f;
+  return pyramid;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SlicePyramid::Pointer SlicePyramid::Build(const SliceVolume& volume, qint64 memoryBudget, const std::atomic_bool& cancelled)
+{
+  // The finest level streams the volume one z slice at a time
+  Builder builder(volume, memoryBudget, Builder::Sampling::Average);
+  while(!builder.isComplete())
+  {
+    if(cancelled || !builder.readNext())
+    {
+      return Pointer();
+    }
+  }
+  return builder.finish(cancelled);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<SlicePyramid::Level>& SlicePyramid::getLevels() const
+{
+  return m_Levels;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const SlicePyramid::Level& SlicePyramid::levelForFactor(size_t factor) const
+{
+  const Level* match = &m_Levels.front();
+  for(const Level& level : m_Levels)
+  {
+    if(level.factor <= factor)
+    {
+      match = &level;
+    }
+  }
+  return *match;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SlicePyramid::getChannelCount() const
+{
+  return m_ChannelCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float SlicePyramid::getMinimum() const
+{
+  return m_Minimum;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+float SlicePyramid::getMaximum() const
+{
+  return m_Maximum;
+}
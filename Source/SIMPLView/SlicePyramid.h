@@ -0,0 +1,172 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include "SIMPLView/SliceVolume.h"
+
+/**
+ * @brief The SlicePyramid class holds box-filtered copies of a SliceVolume at power of two reductions.  The finest
+ * level kept is the first one that fits in the memory budget; for a volume that fits, that is the volume itself.
+ * It is built by streaming the volume one z slice at a time, so building never needs more than one slice of the
+ * source plus the levels themselves.
+ */
+class SlicePyramid
+{
+  class LevelBuilder;
+
+public:
+  using Pointer = std::shared_ptr<SlicePyramid>;
+
+  struct Level
+  {
+    size_t factor = 1;         // Source voxels per level voxel along each axis
+    SliceVolume::Index dimensions = {{0, 0, 0}};
+    std::vector<float> values; // x fastest, channels interleaved
+  };
+
+  /**
+   * @brief The Builder class builds a pyramid one read at a time, so the reads can be spread over the turns of an
+   * event loop.  Only readNext touches the volume, which must outlive the builder; finish only works on the levels
+   * in memory and may be called from any thread.
+   */
+  class Builder
+  {
+  public:
+    enum class Sampling : int
+    {
+      Average = 0, // Box-filters every voxel; each read is a whole z slice of the volume
+      Decimate = 1 // Keeps every factor-th voxel; each read is one z slice of the finest level
+    };
+
+    Builder(const SliceVolume& volume, qint64 memoryBudget, Sampling sampling);
+    ~Builder();
+
+    /**
+     * @brief Reads the next slice into the finest level
+     * @return False if the read failed
+     */
+    bool readNext();
+
+    /**
+     * @brief Returns whether every slice of the finest level has been read
+     * @return
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Returns the fraction of the reads done, from 0 to 1
+     * @return
+     */
+    double getProgress() const;
+
+    /**
+     * @brief Builds the coarser levels once the reads are complete and hands over the pyramid.  The builder is
+     * spent afterwards.
+     * @param cancelled
+     * @return A null pointer if the build was cancelled
+     */
+    Pointer finish(const std::atomic_bool& cancelled);
+
+  private:
+    const SliceVolume& m_Volume;
+    Sampling m_Sampling = Sampling::Average;
+    Pointer m_Pyramid;
+    std::unique_ptr<LevelBuilder> m_LevelBuilder;
+    size_t m_ReadCount = 0;
+    size_t m_NextRead = 0;
+    std::vector<float> m_Slice;
+
+  public:
+    Builder(const Builder&) = delete;            // Copy Constructor Not Implemented
+    Builder(Builder&&) = delete;                 // Move Constructor Not Implemented
+    Builder& operator=(const Builder&) = delete; // Copy Assignment Not Implemented
+    Builder& operator=(Builder&&) = delete;      // Move Assignment Not Implemented
+  };
+
+  /**
+   * @brief Builds the pyramid of a volume.  May be called from any thread the volume may be read from.
+   * @param volume
+   * @param memoryBudget Bytes the finest level may use
+   * @param cancelled
+   * @return A null pointer if the build was cancelled or a read failed
+   */
+  static Pointer Build(const SliceVolume& volume, qint64 memoryBudget, const std::atomic_bool& cancelled);
+
+  /**
+   * @brief Returns the levels, finest first
+   * @return
+   */
+  const std::vector<Level>& getLevels() const;
+
+  /**
+   * @brief Returns the coarsest level whose factor does not exceed the requested one, or the finest level if they all do
+   * @param factor
+   * @return
+   */
+  const Level& levelForFactor(size_t factor) const;
+
+  /**
+   * @brief Returns the number of values per voxel
+   * @return
+   */
+  int getChannelCount() const;
+
+  /**
+   * @brief Returns the smallest value of the finest level, NaN excluded
+   * @return
+   */
+  float getMinimum() const;
+
+  /**
+   * @brief Returns the largest value of the finest level, NaN excluded
+   * @return
+   */
+  float getMaximum() const;
+
+private:
+  SlicePyramid() = default;
+
+  std::vector<Level> m_Levels;
+  int m_ChannelCount = 1;
+  float m_Minimum = 0.0f;
+  float m_Maximum = 0.0f;
+};
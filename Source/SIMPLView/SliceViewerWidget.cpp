@@ -0,0 +1,706 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SliceViewerWidget.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTimer>
+#include <QtGui/QMouseEvent>
+#include <QtGui/QPainter>
+#include <QtGui/QWheelEvent>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QSlider>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLib/DataContainers/DataContainerArray.h"
+#include "SIMPLib/Geometry/ImageGeom.h"
+
+#include "SIMPLView/DREAM3DFileBrowser.h"
+
+namespace
+{
+const qint64 k_PyramidMemoryBudget = 256 * 1024 * 1024;
+const int k_DetailDelay = 100;     // Milliseconds the view must stay still before the visible part is fetched
+const int k_PyramidReadSlice = 20; // Milliseconds of pyramid reads per turn of the event loop on the GUI thread
+const double k_MaxZoom = 64.0;
+
+// Volume axes (x = 0, y = 1, z = 2) along the horizontal and vertical directions of each plane, then across it
+const int k_PlaneAxes[3][3] = {{0, 1, 2}, {0, 2, 1}, {1, 2, 0}};
+
+/**
+ * @brief Converts a grid of values to an image, mapping [minimum, maximum] onto black to white.  Three channel
+ * values become the red, green and blue of a pixel.  NaN is drawn black.
+ * @param values
+ * @param width
+ * @param height
+ * @param channelCount
+ * @param uStep Values between horizontally adjacent voxels
+ * @param vStep Values between vertically adjacent voxels
+ * @param minimum
+ * @param maximum
+ * @return
+ */
+QImage MakeImage(const float* values, int width, int height, int channelCount, size_t uStep, size_t vStep, float minimum, float maximum)
+{
+  QImage image(width, height, QImage::Format_RGB32);
+  const float scale = maximum > minimum ? 255.0f / (maximum - minimum) : 0.0f;
+  for(int v = 0; v < height; v++)
+  {
+    QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(v));
+    const float* row = values + v * vStep;
+    for(int u = 0; u < width; u++)
+    {
+      const float* voxel = row + u * uStep;
+      int rgb[3];
+      for(int c = 0; c < 3; c++)
+      {
+        const float value = voxel[channelCount == 3 ? c : 0];
+        rgb[c] = (value == value) ? qBound(0, static_cast<int>((value - minimum) * scale), 255) : 0;
+      }
+      line[u] = qRgb(rgb[0], rgb[1], rgb[2]);
+    }
+  }
+  return image;
+}
+
+/**
+ * @brief Finds the smallest and largest values, NaN excluded
+ */
+void ValueRange(const std::vector<float>& values, float& minimum, float& maximum)
+{
+  minimum = std::numeric_limits<float>::max();
+  maximum = std::numeric_limits<float>::lowest();
+  for(float value : values)
+  {
+    minimum = (value < minimum) ? value : minimum;
+    maximum = (value > maximum) ? value : maximum;
+  }
+  if(minimum > maximum)
+  {
+    minimum = maximum = 0.0f;
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SliceViewerWidget::SliceRequest::operator==(const SliceRequest& other) const
+{
+  return plane == other.plane && slice == other.slice && region == other.region && stride == other.stride;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceViewerWidget::SliceViewerWidget(QWidget* parent)
+: QWidget(parent)
+, m_PyramidWatcher(new QFutureWatcher<SlicePyramid::Pointer>(this))
+, m_PyramidReadTimer(new QTimer(this))
+, m_DetailWatcher(new QFutureWatcher<QImage>(this))
+, m_DetailTimer(new QTimer(this))
+{
+  m_ArrayComboBox = new QComboBox(this);
+  m_PlaneComboBox = new QComboBox(this);
+  m_PlaneComboBox->addItems({"XY", "XZ", "YZ"});
+  m_SliceSlider = new QSlider(Qt::Horizontal, this);
+  m_SliceLabel = new QLabel(this);
+  m_StatusLabel = new QLabel(this);
+  m_StatusLabel->setWordWrap(true);
+  m_Canvas = new QWidget(this);
+  m_Canvas->setMinimumSize(128, 128);
+  m_Canvas->setAttribute(Qt::WA_OpaquePaintEvent);
+  m_Canvas->setToolTip(tr("Scroll to zoom, drag to pan, double click to fit"));
+  m_Canvas->installEventFilter(this);
+
+  QHBoxLayout* arrayLayout = new QHBoxLayout();
+  arrayLayout->addWidget(m_ArrayComboBox, 1);
+  arrayLayout->addWidget(m_PlaneComboBox);
+
+  QHBoxLayout* sliceLayout = new QHBoxLayout();
+  sliceLayout->addWidget(m_SliceSlider, 1);
+  sliceLayout->addWidget(m_SliceLabel);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addLayout(arrayLayout);
+  layout->addLayout(sliceLayout);
+  layout->addWidget(m_Canvas, 1);
+  layout->addWidget(m_StatusLabel);
+
+  m_DetailTimer->setSingleShot(true);
+  m_DetailTimer->setInterval(k_DetailDelay);
+  m_PyramidReadTimer->setInterval(0);
+
+  connect(m_ArrayComboBox, QOverload<int>::of(&QComboBox::activated), this, &SliceViewerWidget::showSelectedArray);
+  connect(m_PlaneComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SliceViewerWidget::planeChanged);
+  connect(m_SliceSlider, &QSlider::valueChanged, [=](int value) {
+    m_SliceLabel->setText(QString::number(value));
+    viewChanged();
+  });
+  connect(m_DetailTimer, &QTimer::timeout, this, &SliceViewerWidget::requestDetail);
+  connect(m_DetailWatcher, &QFutureWatcher<QImage>::finished, this, &SliceViewerWidget::detailFinished);
+  connect(m_PyramidWatcher, &QFutureWatcher<SlicePyramid::Pointer>::finished, this, &SliceViewerWidget::pyramidFinished);
+  connect(m_PyramidReadTimer, &QTimer::timeout, this, &SliceViewerWidget::readPyramidSlices);
+
+  refreshArrays();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceViewerWidget::~SliceViewerWidget()
+{
+  clearVolume();
+  m_PyramidWatcher->waitForFinished();
+  m_DetailWatcher->waitForFinished();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::setFileBrowser(DREAM3DFileBrowser* fileBrowser)
+{
+  m_FileBrowser = fileBrowser;
+  refreshArrays();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::refreshArrays()
+{
+  clearVolume();
+
+  QString currentPath = m_ArrayComboBox->currentText();
+  m_ArrayComboBox->clear();
+  if(m_FileBrowser != nullptr && m_FileBrowser->isOpen())
+  {
+    // Only cell arrays of image geometries can be sliced
+    DataContainerArray::Pointer dca = m_FileBrowser->getDataContainerArray();
+    for(const DataArrayPath& path : m_FileBrowser->getDataArrayPaths())
+    {
+      DataContainer::Pointer dc = dca->getDataContainer(path.getDataContainerName());
+      ImageGeom::Pointer geom = (dc != nullptr) ? dc->getGeometryAs<ImageGeom>() : ImageGeom::NullPointer();
+      AttributeMatrix::Pointer am = dca->getAttributeMatrix(path);
+      if(geom != nullptr && am != nullptr && am->getNumberOfTuples() == geom->getXPoints() * geom->getYPoints() * geom->getZPoints())
+      {
+        m_ArrayComboBox->addItem(path.serialize("/"));
+      }
+    }
+    m_ArrayComboBox->setCurrentText(currentPath);
+    m_StatusLabel->setText(m_ArrayComboBox->count() > 0 ? tr("Select an array to view.") : tr("The file has no image geometry arrays."));
+  }
+  else
+  {
+    m_StatusLabel->setText(tr("Browse a .dream3d file to view its image geometry arrays."));
+  }
+
+  m_ArrayComboBox->setEnabled(m_ArrayComboBox->count() > 0);
+  planeChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::showSelectedArray()
+{
+  clearVolume();
+
+  QString arrayPath = m_ArrayComboBox->currentText();
+  if(m_FileBrowser == nullptr || !m_FileBrowser->isOpen() || arrayPath.isEmpty())
+  {
+    planeChanged();
+    return;
+  }
+
+  DataArrayPath path = DataArrayPath::Deserialize(arrayPath, "/");
+  DataContainer::Pointer dc = m_FileBrowser->getDataContainerArray()->getDataContainer(path.getDataContainerName());
+  ImageGeom::Pointer geom = (dc != nullptr) ? dc->getGeometryAs<ImageGeom>() : ImageGeom::NullPointer();
+  if(geom == nullptr)
+  {
+    planeChanged();
+    return;
+  }
+  SliceVolume::Index dims = {{geom->getXPoints(), geom->getYPoints(), geom->getZPoints()}};
+
+  // An array the browser already holds is sliced in memory, anything else straight from the file
+  QString errorMessage;
+  IDataArray::Pointer array = m_FileBrowser->cachedDataArray(path);
+  m_Volume = (array != nullptr) ? SliceVolume::FromDataArray(array, dims) : SliceVolume::FromFile(m_FileBrowser->getFilePath(), path, dims, errorMessage);
+  if(m_Volume == nullptr)
+  {
+    m_StatusLabel->setText(errorMessage.isEmpty() ? tr("The array '%1' cannot be shown as slices.").arg(arrayPath) : errorMessage);
+    planeChanged();
+    return;
+  }
+
+  std::shared_ptr<std::atomic_bool> cancelled = std::make_shared<std::atomic_bool>(false);
+  SliceVolume::Pointer volume = m_Volume;
+  m_PyramidCancelled = cancelled;
+  m_ReadOnGuiThread = (array == nullptr && !DREAM3DFileBrowser::IsHDF5ThreadSafe());
+  if(m_ReadOnGuiThread)
+  {
+    // Strided reads keep each turn of the event loop short; only the coarser levels are left to a worker
+    m_PyramidBuilder = std::make_shared<SlicePyramid::Builder>(*m_Volume, k_PyramidMemoryBudget, SlicePyramid::Builder::Sampling::Decimate);
+    m_PyramidReadTimer->start();
+  }
+  else
+  {
+    m_PyramidWatcher->setFuture(QtConcurrent::run([volume, cancelled] { return SlicePyramid::Build(*volume, k_PyramidMemoryBudget, *cancelled); }));
+  }
+
+  m_StatusLabel->setText(tr("%1 x %2 x %3 voxels. Building overview...").arg(dims[0]).arg(dims[1]).arg(dims[2]));
+  planeChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SliceViewerWidget::eventFilter(QObject* watched, QEvent* event)
+{
+  if(watched != m_Canvas)
+  {
+    return QWidget::eventFilter(watched, event);
+  }
+
+  switch(event->type())
+  {
+  case QEvent::Paint:
+  {
+    QPainter painter(m_Canvas);
+    paintCanvas(painter);
+    return true;
+  }
+  case QEvent::Wheel:
+  {
+    // Zooms about the voxel under the cursor
+    QWheelEvent* wheelEvent = static_cast<QWheelEvent*>(event);
+    QPointF offset = QPointF(wheelEvent->pos()) - QPointF(m_Canvas->width() / 2.0, m_Canvas->height() / 2.0);
+    QPointF voxel = m_Center + offset / m_Zoom;
+    QSize size = planeSize();
+    double minZoom = 0.5 * std::min(m_Canvas->width(), m_Canvas->height()) / std::max({size.width(), size.height(), 1});
+    m_Zoom = qBound(minZoom, m_Zoom * std::pow(1.25, wheelEvent->angleDelta().y() / 120.0), k_MaxZoom);
+    m_Center = voxel - offset / m_Zoom;
+    m_FitToCanvas = false;
+    viewChanged();
+    return true;
+  }
+  case QEvent::MouseButtonPress:
+    m_Panning = true;
+    m_LastMousePosition = static_cast<QMouseEvent*>(event)->pos();
+    return true;
+  case QEvent::MouseMove:
+    if(m_Panning)
+    {
+      QPoint position = static_cast<QMouseEvent*>(event)->pos();
+      m_Center -= QPointF(position - m_LastMousePosition) / m_Zoom;
+      m_LastMousePosition = position;
+      m_FitToCanvas = false;
+      viewChanged();
+    }
+    return true;
+  case QEvent::MouseButtonRelease:
+    m_Panning = false;
+    return true;
+  case QEvent::MouseButtonDblClick:
+    fitView();
+    viewChanged();
+    return true;
+  case QEvent::Resize:
+    if(m_FitToCanvas)
+    {
+      fitView();
+    }
+    viewChanged();
+    break;
+  default:
+    break;
+  }
+
+  return QWidget::eventFilter(watched, event);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceViewerWidget::Plane SliceViewerWidget::currentPlane() const
+{
+  return static_cast<Plane>(std::max(0, m_PlaneComboBox->currentIndex()));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QSize SliceViewerWidget::planeSize() const
+{
+  if(m_Volume == nullptr)
+  {
+    return QSize();
+  }
+  const int* axes = k_PlaneAxes[static_cast<int>(currentPlane())];
+  SliceVolume::Index dims = m_Volume->getDimensions();
+  return QSize(static_cast<int>(dims[axes[0]]), static_cast<int>(dims[axes[1]]));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SliceViewerWidget::sliceCount() const
+{
+  if(m_Volume == nullptr)
+  {
+    return 0;
+  }
+  return m_Volume->getDimensions()[k_PlaneAxes[static_cast<int>(currentPlane())][2]];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceViewerWidget::SliceRequest SliceViewerWidget::currentRequest() const
+{
+  SliceRequest request;
+  request.plane = currentPlane();
+  request.slice = static_cast<size_t>(std::max(0, m_SliceSlider->value()));
+  request.stride = std::max<size_t>(1, static_cast<size_t>(1.0 / m_Zoom));
+
+  // The visible voxels, with the corner aligned to the stride so panning keeps sampling the same voxels
+  QSize size = planeSize();
+  const int stride = static_cast<int>(request.stride);
+  double halfWidth = m_Canvas->width() / (2.0 * m_Zoom);
+  double halfHeight = m_Canvas->height() / (2.0 * m_Zoom);
+  int left = std::max(0, static_cast<int>(std::floor(m_Center.x() - halfWidth)));
+  int top = std::max(0, static_cast<int>(std::floor(m_Center.y() - halfHeight)));
+  int right = std::min(size.width(), static_cast<int>(std::ceil(m_Center.x() + halfWidth)));
+  int bottom = std::min(size.height(), static_cast<int>(std::ceil(m_Center.y() + halfHeight)));
+  left -= left % stride;
+  top -= top % stride;
+  request.region = QRect(left, top, std::max(0, right - left), std::max(0, bottom - top));
+  return request;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QRectF SliceViewerWidget::toCanvas(const QRectF& region) const
+{
+  QPointF origin = (region.topLeft() - m_Center) * m_Zoom + QPointF(m_Canvas->width() / 2.0, m_Canvas->height() / 2.0);
+  return QRectF(origin, region.size() * m_Zoom);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::fitView()
+{
+  QSize size = planeSize();
+  if(size.isEmpty())
+  {
+    return;
+  }
+  m_Zoom = std::min(static_cast<double>(m_Canvas->width()) / size.width(), static_cast<double>(m_Canvas->height()) / size.height());
+  m_Center = QPointF(size.width() / 2.0, size.height() / 2.0);
+  m_FitToCanvas = true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::planeChanged()
+{
+  size_t count = sliceCount();
+  m_SliceSlider->blockSignals(true);
+  m_SliceSlider->setRange(0, static_cast<int>(std::max<size_t>(1, count)) - 1);
+  m_SliceSlider->setValue(static_cast<int>(count / 2));
+  m_SliceSlider->blockSignals(false);
+  m_SliceSlider->setEnabled(count > 1);
+  m_SliceLabel->setText(count > 0 ? QString::number(m_SliceSlider->value()) : QString());
+
+  m_DetailImage = QImage();
+  fitView();
+  viewChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::viewChanged()
+{
+  m_Canvas->update();
+  if(m_Volume != nullptr)
+  {
+    m_DetailTimer->start();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::requestDetail()
+{
+  if(m_Volume == nullptr)
+  {
+    return;
+  }
+
+  // Nothing to fetch when the pyramid already holds the slice at this resolution
+  SliceRequest request = currentRequest();
+  if(request.region.isEmpty() || (m_Pyramid != nullptr && m_Pyramid->getLevels().front().factor <= request.stride))
+  {
+    m_DetailImage = QImage();
+    return;
+  }
+  if(request == m_DetailRequest && !m_DetailImage.isNull())
+  {
+    return;
+  }
+  if(m_DetailWatcher->isRunning())
+  {
+    m_DetailRequestPending = true;
+    return;
+  }
+
+  const int* axes = k_PlaneAxes[static_cast<int>(request.plane)];
+  SliceVolume::Index start;
+  SliceVolume::Index count;
+  SliceVolume::Index stride;
+  start[axes[0]] = request.region.left();
+  count[axes[0]] = (request.region.width() + request.stride - 1) / request.stride;
+  stride[axes[0]] = request.stride;
+  start[axes[1]] = request.region.top();
+  count[axes[1]] = (request.region.height() + request.stride - 1) / request.stride;
+  stride[axes[1]] = request.stride;
+  start[axes[2]] = request.slice;
+  count[axes[2]] = 1;
+  stride[axes[2]] = 1;
+
+  // Before the pyramid exists there is no range for the whole array, so each fetch is scaled on its own
+  bool hasRange = (m_Pyramid != nullptr);
+  float minimum = hasRange ? m_Pyramid->getMinimum() : 0.0f;
+  float maximum = hasRange ? m_Pyramid->getMaximum() : 0.0f;
+  int width = static_cast<int>(count[axes[0]]);
+  int height = static_cast<int>(count[axes[1]]);
+  SliceVolume::Pointer volume = m_Volume;
+  auto fetch = [volume, start, count, stride, hasRange, minimum, maximum, width, height] {
+    std::vector<float> values;
+    if(!volume->readRegion(start, count, stride, values))
+    {
+      return QImage();
+    }
+    float low = minimum;
+    float high = maximum;
+    if(!hasRange)
+    {
+      ValueRange(values, low, high);
+    }
+    const int channelCount = volume->getChannelCount();
+    return MakeImage(values.data(), width, height, channelCount, channelCount, width * channelCount, low, high);
+  };
+
+  // The visible voxels are at most about one canvas of values, so they are read in place when they must be
+  if(m_ReadOnGuiThread)
+  {
+    m_DetailImage = fetch();
+    m_DetailRequest = request;
+    m_Canvas->update();
+    return;
+  }
+
+  m_RunningRequest = request;
+  m_DetailWatcher->setFuture(QtConcurrent::run(fetch));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::detailFinished()
+{
+  // A fetch for the slice still shown is kept even if the view moved; it is drawn where it belongs
+  QImage image = m_DetailWatcher->result();
+  SliceRequest request = currentRequest();
+  if(m_Volume != nullptr && !image.isNull() && m_RunningRequest.plane == request.plane && m_RunningRequest.slice == request.slice)
+  {
+    m_DetailImage = image;
+    m_DetailRequest = m_RunningRequest;
+    m_Canvas->update();
+  }
+
+  if(m_DetailRequestPending)
+  {
+    m_DetailRequestPending = false;
+    requestDetail();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::readPyramidSlices()
+{
+  if(m_PyramidBuilder == nullptr)
+  {
+    m_PyramidReadTimer->stop();
+    return;
+  }
+
+  QElapsedTimer elapsed;
+  elapsed.start();
+  while(!m_PyramidBuilder->isComplete() && elapsed.elapsed() < k_PyramidReadSlice)
+  {
+    if(!m_PyramidBuilder->readNext())
+    {
+      m_PyramidReadTimer->stop();
+      m_PyramidBuilder.reset();
+      m_PyramidCancelled.reset();
+      m_StatusLabel->setText(tr("The overview could not be built; slices are read from the source as they are shown."));
+      return;
+    }
+  }
+
+  SliceVolume::Index dims = m_Volume->getDimensions();
+  if(!m_PyramidBuilder->isComplete())
+  {
+    const int percent = static_cast<int>(m_PyramidBuilder->getProgress() * 100.0);
+    m_StatusLabel->setText(tr("%1 x %2 x %3 voxels. Building overview... %4%").arg(dims[0]).arg(dims[1]).arg(dims[2]).arg(percent));
+    return;
+  }
+
+  // The builder refers to the volume, so the worker keeps both alive
+  m_PyramidReadTimer->stop();
+  std::shared_ptr<SlicePyramid::Builder> builder = std::move(m_PyramidBuilder);
+  std::shared_ptr<std::atomic_bool> cancelled = m_PyramidCancelled;
+  SliceVolume::Pointer volume = m_Volume;
+  m_PyramidWatcher->setFuture(QtConcurrent::run([volume, builder, cancelled] { return builder->finish(*cancelled); }));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::pyramidFinished()
+{
+  // A build that was cancelled has already been forgotten
+  if(m_PyramidCancelled == nullptr || *m_PyramidCancelled)
+  {
+    return;
+  }
+  m_PyramidCancelled.reset();
+
+  SlicePyramid::Pointer pyramid = m_PyramidWatcher->result();
+  if(pyramid == nullptr)
+  {
+    m_StatusLabel->setText(tr("The overview could not be built; slices are read from the source as they are shown."));
+    return;
+  }
+
+  SliceVolume::Index dims = m_Volume->getDimensions();
+  m_StatusLabel->setText(tr("%1 x %2 x %3 voxels").arg(dims[0]).arg(dims[1]).arg(dims[2]));
+
+  // The fetched images were scaled to their own range, which no longer matches the overview
+  m_Pyramid = pyramid;
+  m_DetailImage = QImage();
+  viewChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::clearVolume()
+{
+  if(m_PyramidCancelled != nullptr)
+  {
+    *m_PyramidCancelled = true;
+    m_PyramidCancelled.reset();
+  }
+  m_PyramidReadTimer->stop();
+  m_PyramidBuilder.reset();
+  m_ReadOnGuiThread = false;
+  m_Volume.reset();
+  m_Pyramid.reset();
+  m_DetailTimer->stop();
+  m_DetailRequestPending = false;
+  m_DetailImage = QImage();
+  m_DetailRequest = SliceRequest();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SliceViewerWidget::paintCanvas(QPainter& painter)
+{
+  painter.fillRect(m_Canvas->rect(), palette().dark());
+  if(m_Volume == nullptr)
+  {
+    return;
+  }
+
+  SliceRequest request = currentRequest();
+  const int* axes = k_PlaneAxes[static_cast<int>(request.plane)];
+
+  if(m_Pyramid != nullptr)
+  {
+    // Only the visible voxels of the level are converted, so a paint costs about one canvas of pixels
+    const SlicePyramid::Level& level = m_Pyramid->levelForFactor(request.stride);
+    const SliceVolume::Index& dims = level.dimensions;
+    const int factor = static_cast<int>(level.factor);
+    const int channelCount = m_Pyramid->getChannelCount();
+    const size_t steps[3] = {static_cast<size_t>(channelCount), dims[0] * channelCount, dims[0] * dims[1] * channelCount};
+    int left = request.region.left() / factor;
+    int top = request.region.top() / factor;
+    int right = std::min(static_cast<int>(dims[axes[0]]), (request.region.right() + factor) / factor);
+    int bottom = std::min(static_cast<int>(dims[axes[1]]), (request.region.bottom() + factor) / factor);
+    size_t levelSlice = std::min(request.slice / level.factor, dims[axes[2]] - 1);
+    if(right > left && bottom > top)
+    {
+      const float* values = level.values.data() + levelSlice * steps[axes[2]] + left * steps[axes[0]] + top * steps[axes[1]];
+      QImage image = MakeImage(values, right - left, bottom - top, channelCount, steps[axes[0]], steps[axes[1]], m_Pyramid->getMinimum(), m_Pyramid->getMaximum());
+      QRectF region(left * factor, top * factor, (right - left) * factor, (bottom - top) * factor);
+      painter.drawImage(toCanvas(region), image);
+    }
+  }
+
+  if(!m_DetailImage.isNull() && m_DetailRequest.plane == request.plane && m_DetailRequest.slice == request.slice)
+  {
+    QRectF region(m_DetailRequest.region.left(), m_DetailRequest.region.top(), static_cast<double>(m_DetailImage.width() * m_DetailRequest.stride),
+                  static_cast<double>(m_DetailImage.height() * m_DetailRequest.stride));
+    painter.drawImage(toCanvas(region), m_DetailImage);
+  }
+}
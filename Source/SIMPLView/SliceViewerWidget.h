@@ -0,0 +1,236 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QPointF>
+#include <QtCore/QRect>
+#include <QtGui/QImage>
+#include <QtWidgets/QWidget>
+
+#include "SIMPLView/SlicePyramid.h"
+#include "SIMPLView/SliceVolume.h"
+
+class DREAM3DFileBrowser;
+class QComboBox;
+class QLabel;
+class QPainter;
+class QSlider;
+class QTimer;
+
+/**
+ * @brief The SliceViewerWidget class shows orthogonal slices of the image geometry arrays of the file browsed in the
+ * Data Structure dock.  Arrays the browser has already read are sliced in memory; all others are read from the file.
+ *
+ * A SlicePyramid is built in the background as soon as an array is shown, and every zoom level it covers is drawn
+ * from it without touching the source.  When the view is zoomed in further than the pyramid's finest level, the
+ * visible part of the slice is fetched in the background at the displayed resolution while the pyramid stands in.
+ *
+ * HDF5 that is not built thread safe may only be called from the GUI thread.  An array read from the file is then
+ * read there too, one strided slice of the pyramid's finest level per turn of the event loop, and a fetch is a single
+ * strided read of the visible voxels.
+ */
+class SliceViewerWidget : public QWidget
+{
+  Q_OBJECT
+
+public:
+  SliceViewerWidget(QWidget* parent = nullptr);
+  ~SliceViewerWidget() override;
+
+  enum class Plane : int
+  {
+    XY = 0,
+    XZ = 1,
+    YZ = 2
+  };
+
+  /**
+   * @brief Sets the browser the arrays are listed from
+   * @param fileBrowser
+   */
+  void setFileBrowser(DREAM3DFileBrowser* fileBrowser);
+
+  /**
+   * @brief Refills the array list from the browser.  Called whenever the browser opens or closes a file.
+   */
+  void refreshArrays();
+
+  /**
+   * @brief Handles painting, zooming and panning of the slice canvas
+   * @param watched
+   * @param event
+   * @return
+   */
+  bool eventFilter(QObject* watched, QEvent* event) override;
+
+public Q_SLOTS:
+  /**
+   * @brief Shows the selected array and starts building its pyramid
+   */
+  void showSelectedArray();
+
+private:
+  /**
+   * @brief The SliceRequest struct describes the part of a slice fetched at display resolution
+   */
+  struct SliceRequest
+  {
+    Plane plane = Plane::XY;
+    size_t slice = 0;
+    QRect region; // In voxels of the plane
+    size_t stride = 1;
+
+    bool operator==(const SliceRequest& other) const;
+  };
+
+  DREAM3DFileBrowser* m_FileBrowser = nullptr;
+
+  QComboBox* m_ArrayComboBox = nullptr;
+  QComboBox* m_PlaneComboBox = nullptr;
+  QSlider* m_SliceSlider = nullptr;
+  QLabel* m_SliceLabel = nullptr;
+  QLabel* m_StatusLabel = nullptr;
+  QWidget* m_Canvas = nullptr;
+
+  SliceVolume::Pointer m_Volume;
+  SlicePyramid::Pointer m_Pyramid;
+  QFutureWatcher<SlicePyramid::Pointer>* m_PyramidWatcher = nullptr;
+  QTimer* m_PyramidReadTimer = nullptr;
+  std::shared_ptr<std::atomic_bool> m_PyramidCancelled;
+  std::shared_ptr<SlicePyramid::Builder> m_PyramidBuilder;
+  bool m_ReadOnGuiThread = false; // The volume is a file and HDF5 is not thread safe
+
+  QFutureWatcher<QImage>* m_DetailWatcher = nullptr;
+  QTimer* m_DetailTimer = nullptr;
+  SliceRequest m_RunningRequest;
+  bool m_DetailRequestPending = false;
+  SliceRequest m_DetailRequest;
+  QImage m_DetailImage;
+
+  double m_Zoom = 1.0; // Screen pixels per voxel
+  QPointF m_Center;    // Plane voxel shown at the center of the canvas
+  QPoint m_LastMousePosition;
+  bool m_Panning = false;
+  bool m_FitToCanvas = true; // The view follows the canvas size until the user zooms or pans
+
+  /**
+   * @brief Returns the selected plane
+   * @return
+   */
+  Plane currentPlane() const;
+
+  /**
+   * @brief Returns the size in voxels of a slice of the selected plane
+   * @return
+   */
+  QSize planeSize() const;
+
+  /**
+   * @brief Returns the number of slices of the selected plane
+   * @return
+   */
+  size_t sliceCount() const;
+
+  /**
+   * @brief Returns the request for the part of the slice that is visible at the current zoom
+   * @return
+   */
+  SliceRequest currentRequest() const;
+
+  /**
+   * @brief Maps a rectangle of plane voxels onto the canvas
+   * @param region
+   * @return
+   */
+  QRectF toCanvas(const QRectF& region) const;
+
+  /**
+   * @brief Zooms the whole slice into the canvas
+   */
+  void fitView();
+
+  /**
+   * @brief Sets up the slice slider for the selected plane and redraws
+   */
+  void planeChanged();
+
+  /**
+   * @brief Redraws and schedules a display resolution fetch once the view settles
+   */
+  void viewChanged();
+
+  /**
+   * @brief Fetches the visible part of the slice at display resolution if the pyramid is too coarse for it
+   */
+  void requestDetail();
+
+  /**
+   * @brief Keeps a finished fetch if it still matches the view
+   */
+  void detailFinished();
+
+  /**
+   * @brief Reads slices of the pyramid on the GUI thread for a while, then hands the coarser levels to a worker
+   * once every slice has been read
+   */
+  void readPyramidSlices();
+
+  /**
+   * @brief Takes over a finished pyramid
+   */
+  void pyramidFinished();
+
+  /**
+   * @brief Cancels the pyramid build and forgets the shown array
+   */
+  void clearVolume();
+
+  /**
+   * @brief Draws the slice
+   * @param painter
+   */
+  void paintCanvas(QPainter& painter);
+
+public:
+  SliceViewerWidget(const SliceViewerWidget&) = delete;            // Copy Constructor Not Implemented
+  SliceViewerWidget(SliceViewerWidget&&) = delete;                 // Move Constructor Not Implemented
+  SliceViewerWidget& operator=(const SliceViewerWidget&) = delete; // Copy Assignment Not Implemented
+  SliceViewerWidget& operator=(SliceViewerWidget&&) = delete;      // Move Assignment Not Implemented
+};
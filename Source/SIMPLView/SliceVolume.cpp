@@ -0,0 +1,281 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "SliceVolume.h"
+
+#include <hdf5.h>
+
+#include <QtCore/QObject>
+
+#include "H5Support/H5ScopedSentinel.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLib/Common/Constants.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+namespace
+{
+/**
+ * @brief Returns the channels read from an array with the given number of components
+ */
+int ChannelCount(size_t componentCount)
+{
+  return componentCount == 3 ? 3 : 1;
+}
+
+/**
+ * @brief The DataArraySliceVolume class reads boxes out of an array in memory
+ */
+template <typename T>
+class DataArraySliceVolume : public SliceVolume
+{
+public:
+  DataArraySliceVolume(const typename DataArray<T>::Pointer& array, const Index& dimensions)
+  : SliceVolume(dimensions, ChannelCount(array->getNumberOfComponents()))
+  , m_Array(array)
+  , m_ComponentCount(array->getNumberOfComponents())
+  {
+  }
+
+protected:
+  bool readValidRegion(const Index& start, const Index& count, const Index& stride, float* values) const override
+  {
+    const Index dims = getDimensions();
+    const int channelCount = getChannelCount();
+    const T* data = m_Array->getPointer(0);
+    for(size_t z = 0; z < count[2]; z++)
+    {
+      const size_t zz = start[2] + z * stride[2];
+      for(size_t y = 0; y < count[1]; y++)
+      {
+        const size_t yy = start[1] + y * stride[1];
+        const T* row = data + (zz * dims[1] + yy) * dims[0] * m_ComponentCount;
+        for(size_t x = 0; x < count[0]; x++)
+        {
+          const T* voxel = row + (start[0] + x * stride[0]) * m_ComponentCount;
+          for(int c = 0; c < channelCount; c++)
+          {
+            *values++ = static_cast<float>(voxel[c]);
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+private:
+  typename DataArray<T>::Pointer m_Array;
+  size_t m_ComponentCount = 1;
+};
+
+/**
+ * @brief The FileSliceVolume class reads boxes out of a dataset of a .dream3d file with a strided hyperslab
+ * selection, so only the voxels that are displayed are transferred.  The file is opened for each read so it is
+ * never held open while a pipeline may want to rewrite it.
+ */
+class FileSliceVolume : public SliceVolume
+{
+public:
+  FileSliceVolume(const QString& filePath, const QString& datasetPath, const Index& dimensions, size_t componentCount)
+  : SliceVolume(dimensions, ChannelCount(componentCount))
+  , m_FilePath(filePath)
+  , m_DatasetPath(datasetPath.toLatin1())
+  {
+  }
+
+protected:
+  bool readValidRegion(const Index& start, const Index& count, const Index& stride, float* values) const override
+  {
+    hid_t fileId = QH5Utilities::openFile(m_FilePath, true);
+    if(fileId < 0)
+    {
+      return false;
+    }
+    H5ScopedFileSentinel sentinel(&fileId, true);
+
+    hid_t datasetId = H5Dopen2(fileId, m_DatasetPath.constData(), H5P_DEFAULT);
+    if(datasetId < 0)
+    {
+      return false;
+    }
+
+    // SIMPL stores the cell arrays of an image geometry as [z][y][x][component]
+    hid_t fileSpaceId = H5Dget_space(datasetId);
+    hsize_t fileStart[4] = {start[2], start[1], start[0], 0};
+    hsize_t fileStride[4] = {stride[2], stride[1], stride[0], 1};
+    hsize_t fileCount[4] = {count[2], count[1], count[0], static_cast<hsize_t>(getChannelCount())};
+    herr_t err = H5Sselect_hyperslab(fileSpaceId, H5S_SELECT_SET, fileStart, fileStride, fileCount, nullptr);
+
+    hsize_t memoryDims[1] = {count[0] * count[1] * count[2] * getChannelCount()};
+    hid_t memorySpaceId = H5Screate_simple(1, memoryDims, nullptr);
+    if(err >= 0)
+    {
+      err = H5Dread(datasetId, H5T_NATIVE_FLOAT, memorySpaceId, fileSpaceId, H5P_DEFAULT, values);
+    }
+
+    H5Sclose(memorySpaceId);
+    H5Sclose(fileSpaceId);
+    H5Dclose(datasetId);
+    return err >= 0;
+  }
+
+private:
+  QString m_FilePath;
+  QByteArray m_DatasetPath;
+};
+
+/**
+ * @brief Creates a volume over the array if it holds T
+ */
+template <typename T>
+bool CreateDataArrayVolume(const IDataArray::Pointer& array, const SliceVolume::Index& dimensions, SliceVolume::Pointer& volume)
+{
+  auto typedArray = std::dynamic_pointer_cast<DataArray<T>>(array);
+  if(typedArray == nullptr)
+  {
+    return false;
+  }
+  volume = std::make_shared<DataArraySliceVolume<T>>(typedArray, dimensions);
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceVolume::SliceVolume(const Index& dimensions, int channelCount)
+: m_Dimensions(dimensions)
+, m_ChannelCount(channelCount)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceVolume::~SliceVolume() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceVolume::Pointer SliceVolume::FromDataArray(const IDataArray::Pointer& array, const Index& dimensions)
+{
+  if(array == nullptr || array->getNumberOfTuples() != dimensions[0] * dimensions[1] * dimensions[2])
+  {
+    return Pointer();
+  }
+
+  Pointer volume;
+  bool created = CreateDataArrayVolume<int8_t>(array, dimensions, volume) || CreateDataArrayVolume<uint8_t>(array, dimensions, volume) ||
+      CreateDataArrayVolume<int16_t>(array, dimensions, volume) || CreateDataArrayVolume<uint16_t>(array, dimensions, volume) ||
+      CreateDataArrayVolume<int32_t>(array, dimensions, volume) || CreateDataArrayVolume<uint32_t>(array, dimensions, volume) ||
+      CreateDataArrayVolume<int64_t>(array, dimensions, volume) || CreateDataArrayVolume<uint64_t>(array, dimensions, volume) ||
+      CreateDataArrayVolume<float>(array, dimensions, volume) || CreateDataArrayVolume<double>(array, dimensions, volume) ||
+      CreateDataArrayVolume<bool>(array, dimensions, volume);
+  return created ? volume : Pointer();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceVolume::Pointer SliceVolume::FromFile(const QString& filePath, const DataArrayPath& path, const Index& dimensions, QString& errorMessage)
+{
+  QString datasetPath = QString("/%1/%2/%3/%4").arg(SIMPL::StringConstants::DataContainerGroupName, path.getDataContainerName(), path.getAttributeMatrixName(), path.getDataArrayName());
+
+  hid_t fileId = QH5Utilities::openFile(filePath, true);
+  if(fileId < 0)
+  {
+    errorMessage = QObject::tr("The file '%1' could not be opened.").arg(filePath);
+    return Pointer();
+  }
+  H5ScopedFileSentinel sentinel(&fileId, true);
+
+  hid_t datasetId = H5Dopen2(fileId, datasetPath.toLatin1().constData(), H5P_DEFAULT);
+  if(datasetId < 0)
+  {
+    errorMessage = QObject::tr("The array '%1' was not found in the file.").arg(datasetPath);
+    return Pointer();
+  }
+
+  hid_t fileSpaceId = H5Dget_space(datasetId);
+  hsize_t dims[4] = {0, 0, 0, 0};
+  int rank = H5Sget_simple_extent_ndims(fileSpaceId);
+  if(rank == 4)
+  {
+    H5Sget_simple_extent_dims(fileSpaceId, dims, nullptr);
+  }
+  H5Sclose(fileSpaceId);
+  H5Dclose(datasetId);
+
+  if(rank != 4 || dims[0] != dimensions[2] || dims[1] != dimensions[1] || dims[2] != dimensions[0])
+  {
+    errorMessage = QObject::tr("The array '%1' does not have one tuple per voxel of its image geometry.").arg(datasetPath);
+    return Pointer();
+  }
+
+  return std::make_shared<FileSliceVolume>(filePath, datasetPath, dimensions, dims[3]);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SliceVolume::Index SliceVolume::getDimensions() const
+{
+  return m_Dimensions;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int SliceVolume::getChannelCount() const
+{
+  return m_ChannelCount;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool SliceVolume::readRegion(const Index& start, const Index& count, const Index& stride, std::vector<float>& values) const
+{
+  for(size_t axis = 0; axis < 3; axis++)
+  {
+    if(count[axis] == 0 || stride[axis] == 0 || start[axis] + (count[axis] - 1) * stride[axis] >= m_Dimensions[axis])
+    {
+      return false;
+    }
+  }
+
+  values.resize(count[0] * count[1] * count[2] * m_ChannelCount);
+  return readValidRegion(start, count, stride, values.data());
+}
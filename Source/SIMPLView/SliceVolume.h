@@ -0,0 +1,123 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+
+#include "SIMPLib/DataArrays/IDataArray.h"
+#include "SIMPLib/DataContainers/DataArrayPath.h"
+
+/**
+ * @brief The SliceVolume class is a read-only view of a cell array of an image geometry that hands out sub-sampled
+ * boxes of voxels, so a slice can be fetched at the resolution it is displayed at instead of copying the whole
+ * array.  The values come either from an array in memory or straight from a .dream3d file through an HDF5
+ * hyperslab selection.  Arrays with three components are read as three channels; for any other component count
+ * only the first component is read.
+ *
+ * readRegion may be called from any thread, except that a volume over a file must only be read from the GUI thread
+ * unless HDF5 is built thread safe.
+ */
+class SliceVolume
+{
+public:
+  using Pointer = std::shared_ptr<SliceVolume>;
+  using Index = std::array<size_t, 3>; // x, y, z
+
+  virtual ~SliceVolume();
+
+  /**
+   * @brief Creates a volume over an array in memory
+   * @param array
+   * @param dimensions
+   * @return A null pointer if the array is not numeric or does not have one tuple per voxel
+   */
+  static Pointer FromDataArray(const IDataArray::Pointer& array, const Index& dimensions);
+
+  /**
+   * @brief Creates a volume over an array stored in a .dream3d file.  Only the dataset's shape is read.
+   * @param filePath
+   * @param path
+   * @param dimensions
+   * @param errorMessage
+   * @return A null pointer if the dataset cannot be found or does not have one tuple per voxel
+   */
+  static Pointer FromFile(const QString& filePath, const DataArrayPath& path, const Index& dimensions, QString& errorMessage);
+
+  /**
+   * @brief Returns the number of voxels along x, y and z
+   * @return
+   */
+  Index getDimensions() const;
+
+  /**
+   * @brief Returns the number of values read per voxel, 1 or 3
+   * @return
+   */
+  int getChannelCount() const;
+
+  /**
+   * @brief Reads count voxels along each axis, starting at start and taking every stride-th voxel.  The values are
+   * stored with x varying fastest and the channels of a voxel next to each other.
+   * @param start
+   * @param count
+   * @param stride
+   * @param values
+   * @return False if the box does not fit in the volume or the read failed
+   */
+  bool readRegion(const Index& start, const Index& count, const Index& stride, std::vector<float>& values) const;
+
+protected:
+  SliceVolume(const Index& dimensions, int channelCount);
+
+  /**
+   * @brief Reads a box that was checked against the dimensions into values, which is already sized
+   */
+  virtual bool readValidRegion(const Index& start, const Index& count, const Index& stride, float* values) const = 0;
+
+private:
+  Index m_Dimensions;
+  int m_ChannelCount = 1;
+
+public:
+  SliceVolume(const SliceVolume&) = delete;            // Copy Constructor Not Implemented
+  SliceVolume(SliceVolume&&) = delete;                 // Move Constructor Not Implemented
+  SliceVolume& operator=(const SliceVolume&) = delete; // Copy Assignment Not Implemented
+  SliceVolume& operator=(SliceVolume&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,202 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "ThreadUtilizationSampler.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTimer>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+namespace
+{
+#if defined(Q_OS_LINUX)
+// -----------------------------------------------------------------------------
+qint64 ReadStatCpuMilliseconds(const QString& statPath)
+{
+  QFile stat(statPath);
+  if(!stat.open(QIODevice::ReadOnly))
+  {
+    return -1;
+  }
+
+  // The name of the thread may hold spaces and parentheses, so the fields are counted from the last parenthesis.
+  // The user time and the system time are the 14th and 15th field.
+  QByteArray contents = stat.readAll();
+  QList<QByteArray> fields = contents.mid(contents.lastIndexOf(')') + 2).split(' ');
+  if(fields.size() < 13)
+  {
+    return -1;
+  }
+  qint64 ticks = fields[11].toLongLong() + fields[12].toLongLong();
+  static const qint64 ticksPerSecond = sysconf(_SC_CLK_TCK);
+  return ticks * 1000 / ticksPerSecond;
+}
+#endif
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThreadUtilizationSampler::ThreadUtilizationSampler(int interval, QObject* parent)
+: QObject(parent)
+{
+  m_Timer = new QTimer(this);
+  m_Timer->setInterval(interval);
+  connect(m_Timer, &QTimer::timeout, this, &ThreadUtilizationSampler::sample);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ThreadUtilizationSampler::~ThreadUtilizationSampler() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ThreadUtilizationSampler::IsSupported()
+{
+#if defined(Q_OS_LINUX)
+  return true;
+#else
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+qint64 ThreadUtilizationSampler::ProcessCpuMilliseconds()
+{
+#if defined(Q_OS_LINUX)
+  return ReadStatCpuMilliseconds("/proc/self/stat");
+#else
+  return -1;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThreadUtilizationSampler::start()
+{
+  m_Samples.clear();
+  if(!IsSupported())
+  {
+    return;
+  }
+  m_ThreadCpuMilliseconds = ReadThreadCpuMilliseconds();
+  m_Clock.start();
+  m_LastSampleTime = 0;
+  m_Timer->start();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThreadUtilizationSampler::stop()
+{
+  if(!m_Timer->isActive())
+  {
+    return;
+  }
+  m_Timer->stop();
+  sample();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<ThreadUtilizationSampler::Sample>& ThreadUtilizationSampler::getSamples() const
+{
+  return m_Samples;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ThreadUtilizationSampler::sample()
+{
+  qint64 now = m_Clock.elapsed();
+  qint64 interval = now - m_LastSampleTime;
+  if(interval <= 0)
+  {
+    return;
+  }
+
+  // A thread that ended since the last sample is left out; the CPU time it used in between is lost
+  std::map<qint64, qint64> threadCpuMilliseconds = ReadThreadCpuMilliseconds();
+  Sample sample;
+  sample.milliseconds = now;
+  qint64 cpuMilliseconds = 0;
+  for(const auto& thread : threadCpuMilliseconds)
+  {
+    auto previous = m_ThreadCpuMilliseconds.find(thread.first);
+    qint64 used = thread.second - (previous != m_ThreadCpuMilliseconds.end() ? previous->second : 0);
+    cpuMilliseconds += used;
+    if(used * 2 >= interval)
+    {
+      sample.busyThreads++;
+    }
+  }
+  sample.parallelism = static_cast<double>(cpuMilliseconds) / interval;
+  m_Samples.push_back(sample);
+
+  m_ThreadCpuMilliseconds = threadCpuMilliseconds;
+  m_LastSampleTime = now;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::map<qint64, qint64> ThreadUtilizationSampler::ReadThreadCpuMilliseconds()
+{
+  std::map<qint64, qint64> threadCpuMilliseconds;
+#if defined(Q_OS_LINUX)
+  QDir taskDirectory("/proc/self/task");
+  for(const QString& entry : taskDirectory.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+  {
+    qint64 cpuMilliseconds = ReadStatCpuMilliseconds(taskDirectory.filePath(entry + "/stat"));
+    if(cpuMilliseconds >= 0)
+    {
+      threadCpuMilliseconds[entry.toLongLong()] = cpuMilliseconds;
+    }
+  }
+#endif
+  return threadCpuMilliseconds;
+}
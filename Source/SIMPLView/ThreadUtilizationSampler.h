@@ -0,0 +1,119 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QObject>
+
+class QTimer;
+
+/**
+ * @brief The ThreadUtilizationSampler class reads the CPU time of every thread of the process from /proc/self/task
+ * at a fixed interval, which shows how many threads actually worked over time.  It is only supported on Linux;
+ * elsewhere no sample is taken.
+ */
+class ThreadUtilizationSampler : public QObject
+{
+  Q_OBJECT
+
+public:
+  struct Sample
+  {
+    qint64 milliseconds = 0;  // End of the interval, since start()
+    double parallelism = 0.0; // CPU time of all threads divided by the length of the interval
+    int busyThreads = 0;      // Threads that ran for at least half of the interval
+  };
+
+  ThreadUtilizationSampler(int interval, QObject* parent = nullptr);
+  ~ThreadUtilizationSampler() override;
+
+  /**
+   * @brief Returns true if the CPU time of the threads can be read on this platform
+   * @return
+   */
+  static bool IsSupported();
+
+  /**
+   * @brief Returns the CPU time the process used so far, including threads that already ended, or -1 if it cannot
+   * be read
+   * @return
+   */
+  static qint64 ProcessCpuMilliseconds();
+
+  /**
+   * @brief Starts sampling; the samples of an earlier start are dropped
+   */
+  void start();
+
+  /**
+   * @brief Takes a last sample and stops
+   */
+  void stop();
+
+  /**
+   * @brief Returns the samples taken since start()
+   * @return
+   */
+  const std::vector<Sample>& getSamples() const;
+
+protected Q_SLOTS:
+  /**
+   * @brief Reads the CPU time of the threads and adds a sample for the time since the last one
+   */
+  void sample();
+
+private:
+  QTimer* m_Timer = nullptr;
+  QElapsedTimer m_Clock;
+  qint64 m_LastSampleTime = 0;
+  std::map<qint64, qint64> m_ThreadCpuMilliseconds;
+  std::vector<Sample> m_Samples;
+
+  /**
+   * @brief Returns the CPU time of each thread that runs now
+   * @return
+   */
+  static std::map<qint64, qint64> ReadThreadCpuMilliseconds();
+
+public:
+  ThreadUtilizationSampler(const ThreadUtilizationSampler&) = delete;            // Copy Constructor Not Implemented
+  ThreadUtilizationSampler(ThreadUtilizationSampler&&) = delete;                 // Move Constructor Not Implemented
+  ThreadUtilizationSampler& operator=(const ThreadUtilizationSampler&) = delete; // Copy Assignment Not Implemented
+  ThreadUtilizationSampler& operator=(ThreadUtilizationSampler&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,763 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "WatchFolder.h"
+
+#include <algorithm>
+
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFileSystemWatcher>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSet>
+#include <QtCore/QTimer>
+
+#include "SIMPLib/Common/Constants.h"
+
+#include "SIMPLView/ExecutionScheduler.h"
+#include "SIMPLView/PipelineExecution.h"
+#include "SIMPLView/PipelineFileFormat.h"
+#include "SIMPLView/SIMPLViewApplication.h"
+
+namespace
+{
+const int k_PollInterval = 1000;
+const int k_ScanDelay = 200;
+const qint64 k_FallbackScanInterval = 30000;
+const qint64 k_SettleMilliseconds = 2000;
+const qint64 k_HashChunkSize = 4 * 1024 * 1024;
+const QString k_IndexFileName("WatchFolderIndex.json");
+const QString k_RunPipelineFileName("Pipeline.json");
+const int k_MaxEndedEntries = 1000;
+
+// Files that are only remembered by path, so they are not picked up again
+const int k_IgnoredEntryId = -1;
+const int k_PrunedEntryId = -2;
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WatchFolder::WatchFolder(QObject* parent)
+: QObject(parent)
+{
+  // A burst of changes, such as many files copied in at once, is listed once
+  m_ScanTimer = new QTimer(this);
+  m_ScanTimer->setSingleShot(true);
+  m_ScanTimer->setInterval(k_ScanDelay);
+  connect(m_ScanTimer, &QTimer::timeout, this, [this] { scanDirectory(); });
+
+  m_FileSystemWatcher = new QFileSystemWatcher(this);
+  connect(m_FileSystemWatcher, &QFileSystemWatcher::directoryChanged, this, [this] {
+    if(!m_ScanTimer->isActive())
+    {
+      m_ScanTimer->start();
+    }
+  });
+
+  // Polling notices when files stop growing and covers shares that do not report changes
+  m_PollTimer = new QTimer(this);
+  m_PollTimer->setInterval(k_PollInterval);
+  connect(m_PollTimer, &QTimer::timeout, this, &WatchFolder::poll);
+
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  connect(scheduler, &ExecutionScheduler::jobStarted, this, &WatchFolder::schedulerJobStarted);
+  connect(scheduler, &ExecutionScheduler::jobFinished, this, &WatchFolder::schedulerJobFinished);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WatchFolder::~WatchFolder()
+{
+  // Deleting an execution cancels it and ends its job in the scheduler
+  disconnect(dream3dApp->getExecutionScheduler(), nullptr, this, nullptr);
+  for(auto& entry : m_Tracking)
+  {
+    delete entry.second.execution;
+    entry.second.execution = nullptr;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<ParameterSweep::Parameter> WatchFolder::FindReaderParameters(const QJsonObject& pipeline)
+{
+  std::vector<int> inputFilters = ParameterSweep::FindFiltersOfSubGroup(pipeline, SIMPL::FilterSubGroups::InputFilters);
+  std::vector<ParameterSweep::Parameter> parameters = ParameterSweep::FindParameters(pipeline);
+
+  auto notReaderPath = [&inputFilters](const ParameterSweep::Parameter& parameter) {
+    return !parameter.values.front().isString() || std::find(inputFilters.cbegin(), inputFilters.cend(), parameter.filterIndex) == inputFilters.cend();
+  };
+  parameters.erase(std::remove_if(parameters.begin(), parameters.end(), notReaderPath), parameters.end());
+  return parameters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString WatchFolder::HashFile(const QString& filePath)
+{
+  QFile file(filePath);
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return QString();
+  }
+
+  QCryptographicHash hash(QCryptographicHash::Sha1);
+  while(!file.atEnd())
+  {
+    QByteArray chunk = file.read(k_HashChunkSize);
+    if(chunk.isEmpty() && file.error() != QFileDevice::NoError)
+    {
+      return QString();
+    }
+    hash.addData(chunk);
+  }
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::setPipeline(const QJsonObject& pipeline, const ParameterSweep::Parameter& reader)
+{
+  m_Pipeline = pipeline;
+  m_Reader = reader;
+  m_OutputFilters = ParameterSweep::FindFiltersOfSubGroup(m_Pipeline, SIMPL::FilterSubGroups::OutputFilters);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::setInputDirectory(const QString& directory)
+{
+  m_InputDirectory = directory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString WatchFolder::getInputDirectory() const
+{
+  return m_InputDirectory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::setNameFilters(const QStringList& nameFilters)
+{
+  m_NameFilters = nameFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList WatchFolder::getNameFilters() const
+{
+  return m_NameFilters;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::setOutputDirectory(const QString& directory)
+{
+  m_OutputDirectory = directory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString WatchFolder::getOutputDirectory() const
+{
+  return m_OutputDirectory;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::setConcurrency(int concurrency)
+{
+  m_Concurrency = std::max(concurrency, 1);
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int WatchFolder::getConcurrency() const
+{
+  return m_Concurrency;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::setOwner(const QString& owner)
+{
+  m_Owner = owner;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool WatchFolder::start(bool processExisting, QString& errorMessage)
+{
+  if(m_Watching)
+  {
+    return true;
+  }
+
+  if(!QFileInfo(m_InputDirectory).isDir())
+  {
+    errorMessage = tr("The input directory '%1' does not exist.").arg(m_InputDirectory);
+    return false;
+  }
+  if(m_OutputDirectory.isEmpty() || !QDir().mkpath(m_OutputDirectory))
+  {
+    errorMessage = tr("The output directory '%1' cannot be created.").arg(m_OutputDirectory);
+    return false;
+  }
+  if(m_Reader.filterIndex < 0 || m_Reader.path.isEmpty())
+  {
+    errorMessage = tr("Choose the reader parameter that receives the path of each file.");
+    return false;
+  }
+
+  // Files of an earlier session are not processed again
+  readIndex();
+  for(auto iter = m_EntryIds.begin(); iter != m_EntryIds.end();)
+  {
+    if(iter.value() == k_IgnoredEntryId)
+    {
+      iter = m_EntryIds.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+
+  m_Watching = true;
+  m_FileSystemWatcher->addPath(m_InputDirectory);
+  scanDirectory(!processExisting);
+  m_PollTimer->start();
+  Q_EMIT watchingChanged(m_Watching);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::stop()
+{
+  if(!m_Watching)
+  {
+    return;
+  }
+
+  m_Watching = false;
+  m_ScanTimer->stop();
+  m_PollTimer->stop();
+  if(!m_FileSystemWatcher->directories().isEmpty())
+  {
+    m_FileSystemWatcher->removePaths(m_FileSystemWatcher->directories());
+  }
+
+  // Files that were not handed to the scheduler yet are dropped so a later start sees them again
+  for(auto iter = m_Entries.begin(); iter != m_Entries.end();)
+  {
+    FileStatus status = iter->second.status;
+    if(status == FileStatus::Settling || status == FileStatus::Waiting)
+    {
+      m_EntryIds.remove(iter->second.filePath);
+      m_ActiveHashes.remove(iter->second.hash);
+      m_Tracking.erase(iter->first);
+      iter = m_Entries.erase(iter);
+    }
+    else
+    {
+      ++iter;
+    }
+  }
+
+  Q_EMIT entriesChanged();
+  Q_EMIT watchingChanged(m_Watching);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool WatchFolder::isWatching() const
+{
+  return m_Watching;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool WatchFolder::isBusy() const
+{
+  return m_Watching || m_ActiveRuns > 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::vector<WatchFolder::Entry> WatchFolder::getEntries() const
+{
+  std::vector<Entry> entries;
+  entries.reserve(m_Entries.size());
+  for(const auto& entry : m_Entries)
+  {
+    entries.push_back(entry.second);
+  }
+  return entries;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::poll()
+{
+  // Without the watcher, for example when it ran out of handles, the directory is listed on every poll
+  qint64 scanInterval = m_FileSystemWatcher->directories().isEmpty() ? k_PollInterval : k_FallbackScanInterval;
+  if(QDateTime::currentMSecsSinceEpoch() - m_LastScan >= scanInterval)
+  {
+    scanDirectory();
+  }
+  checkSettlingFiles();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::scanDirectory(bool ignore)
+{
+  if(!m_Watching)
+  {
+    return;
+  }
+
+  qint64 now = QDateTime::currentMSecsSinceEpoch();
+  m_LastScan = now;
+  bool changed = false;
+  QDir dir(m_InputDirectory);
+  QSet<QString> present;
+  for(const QFileInfo& fileInfo : dir.entryInfoList(m_NameFilters, QDir::Files, QDir::Time | QDir::Reversed))
+  {
+    QString filePath = fileInfo.absoluteFilePath();
+    present.insert(filePath);
+    if(m_EntryIds.contains(filePath))
+    {
+      continue;
+    }
+
+    // Ignored files are only remembered by path so they are not picked up later
+    if(ignore)
+    {
+      m_EntryIds.insert(filePath, k_IgnoredEntryId);
+      continue;
+    }
+
+    Entry entry;
+    entry.id = m_NextEntryId++;
+    entry.filePath = filePath;
+    m_Entries[entry.id] = entry;
+    m_EntryIds.insert(filePath, entry.id);
+
+    Tracking tracking;
+    tracking.size = fileInfo.size();
+    tracking.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    tracking.unchangedSince = now;
+    m_Tracking[entry.id] = tracking;
+    changed = true;
+  }
+
+  // Paths that are only remembered are forgotten once their file is gone, so a file that appears again under the
+  // same name is new.  A directory that cannot be listed, such as a share that went away, forgets nothing.
+  if(dir.exists())
+  {
+    for(auto iter = m_EntryIds.begin(); iter != m_EntryIds.end();)
+    {
+      if((iter.value() == k_IgnoredEntryId || iter.value() == k_PrunedEntryId) && !present.contains(iter.key()))
+      {
+        iter = m_EntryIds.erase(iter);
+      }
+      else
+      {
+        ++iter;
+      }
+    }
+  }
+
+  if(changed)
+  {
+    Q_EMIT entriesChanged();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::checkSettlingFiles()
+{
+  qint64 now = QDateTime::currentMSecsSinceEpoch();
+  bool changed = false;
+  QList<int> vanished;
+  for(auto& item : m_Entries)
+  {
+    Entry& entry = item.second;
+    if(entry.status != FileStatus::Settling)
+    {
+      continue;
+    }
+
+    Tracking& tracking = m_Tracking[entry.id];
+    QFileInfo fileInfo(entry.filePath);
+    if(!fileInfo.exists())
+    {
+      vanished.push_back(entry.id);
+      continue;
+    }
+
+    qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    if(fileInfo.size() != tracking.size || lastModified != tracking.lastModified)
+    {
+      tracking.size = fileInfo.size();
+      tracking.lastModified = lastModified;
+      tracking.unchangedSince = now;
+      continue;
+    }
+
+    // Writers on Windows keep the file locked, so a file that cannot be opened is still being written
+    QFile file(entry.filePath);
+    if(tracking.size == 0 || now - tracking.unchangedSince < k_SettleMilliseconds || !file.open(QIODevice::ReadOnly))
+    {
+      continue;
+    }
+    file.close();
+
+    entry.status = FileStatus::Hashing;
+    changed = true;
+
+    int entryId = entry.id;
+    QString filePath = entry.filePath;
+    QFutureWatcher<QString>* watcher = new QFutureWatcher<QString>(this);
+    connect(watcher, &QFutureWatcher<QString>::finished, this, [this, watcher, entryId] {
+      hashFinished(entryId, watcher->result());
+      watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run(&WatchFolder::HashFile, filePath));
+  }
+
+  // Temporary files of the writer come and go before they are complete
+  for(int entryId : vanished)
+  {
+    m_EntryIds.remove(m_Entries[entryId].filePath);
+    m_Entries.erase(entryId);
+    m_Tracking.erase(entryId);
+    changed = true;
+  }
+
+  if(changed)
+  {
+    Q_EMIT entriesChanged();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::hashFinished(int entryId, const QString& hash)
+{
+  auto iter = m_Entries.find(entryId);
+  if(iter == m_Entries.end() || iter->second.status != FileStatus::Hashing)
+  {
+    return;
+  }
+
+  Entry& entry = iter->second;
+  entry.hash = hash;
+  if(hash.isEmpty())
+  {
+    entry.status = FileStatus::Failed;
+    entry.message = tr("The file could not be read.");
+  }
+  else if(m_ProcessedHashes.contains(hash))
+  {
+    entry.status = FileStatus::Duplicate;
+    entry.message = tr("Same content as %1").arg(QFileInfo(m_ProcessedHashes.value(hash)).fileName());
+  }
+  else if(m_ActiveHashes.contains(hash))
+  {
+    entry.status = FileStatus::Duplicate;
+    entry.message = tr("Same content as %1").arg(QFileInfo(m_Entries[m_ActiveHashes.value(hash)].filePath).fileName());
+  }
+  else if(!m_Watching)
+  {
+    // Stopped while hashing; like the other files that were not queued yet it is seen again on the next start
+    m_EntryIds.remove(entry.filePath);
+    m_Tracking.erase(entryId);
+    m_Entries.erase(iter);
+    Q_EMIT entriesChanged();
+    return;
+  }
+  else
+  {
+    entry.status = FileStatus::Waiting;
+    m_ActiveHashes.insert(hash, entry.id);
+  }
+
+  pruneEntries();
+  Q_EMIT entriesChanged();
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::pruneEntries()
+{
+  auto ended = [](const Entry& entry) {
+    return entry.status == FileStatus::Succeeded || entry.status == FileStatus::Failed || entry.status == FileStatus::Duplicate || entry.status == FileStatus::Cancelled;
+  };
+  auto endedCount = static_cast<int>(std::count_if(m_Entries.cbegin(), m_Entries.cend(), [ended](const std::pair<const int, Entry>& item) { return ended(item.second); }));
+
+  // The oldest ended entries go first; their paths are kept so the files are not processed again
+  for(auto iter = m_Entries.begin(); iter != m_Entries.end() && endedCount > k_MaxEndedEntries;)
+  {
+    if(!ended(iter->second))
+    {
+      ++iter;
+      continue;
+    }
+    m_EntryIds.insert(iter->second.filePath, k_PrunedEntryId);
+    m_Tracking.erase(iter->first);
+    iter = m_Entries.erase(iter);
+    endedCount--;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::dispatch()
+{
+  bool changed = false;
+  for(auto& item : m_Entries)
+  {
+    if(m_ActiveRuns >= m_Concurrency)
+    {
+      break;
+    }
+    if(item.second.status == FileStatus::Waiting)
+    {
+      submitEntry(item.second);
+      changed = true;
+    }
+  }
+
+  if(changed)
+  {
+    Q_EMIT entriesChanged();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::submitEntry(Entry& entry)
+{
+  // The directory name carries part of the hash because a file name can be reused for new content
+  QFileInfo fileInfo(entry.filePath);
+  entry.outputDirectory = QDir(m_OutputDirectory).filePath(QString("%1_%2").arg(fileInfo.completeBaseName(), entry.hash.left(8)));
+
+  QJsonObject runPipeline = m_Pipeline;
+  QString readerKey = QString::number(m_Reader.filterIndex);
+  QJsonObject reader = runPipeline.value(readerKey).toObject();
+  ParameterSweep::SetValue(reader, m_Reader.path, QDir::toNativeSeparators(entry.filePath));
+  runPipeline[readerKey] = reader;
+  for(int filterIndex : m_OutputFilters)
+  {
+    QString key = QString::number(filterIndex);
+    QJsonObject filter = runPipeline.value(key).toObject();
+    ParameterSweep::RedirectOutputs(filter, entry.outputDirectory);
+    runPipeline[key] = filter;
+  }
+
+  auto fail = [this, &entry](const QString& message) {
+    entry.status = FileStatus::Failed;
+    entry.message = message;
+    m_ActiveHashes.remove(entry.hash);
+  };
+
+  QString errorMessage;
+  if(!QDir().mkpath(entry.outputDirectory) ||
+     !PipelineFileFormat::WriteFileAtomically(QDir(entry.outputDirectory).filePath(k_RunPipelineFileName), PipelineFileFormat::ToJson(runPipeline), errorMessage))
+  {
+    fail(errorMessage.isEmpty() ? tr("The output directory of the file could not be created.") : errorMessage);
+    return;
+  }
+
+  ExecutionScheduler* scheduler = dream3dApp->getExecutionScheduler();
+  ExecutionScheduler::PreparedRun run;
+  if(!scheduler->prepareRun(runPipeline, fileInfo.fileName(), m_Concurrency, run, errorMessage))
+  {
+    fail(errorMessage);
+    return;
+  }
+
+  Tracking& tracking = m_Tracking[entry.id];
+  tracking.execution = new PipelineExecution(run.pipeline, this);
+  entry.status = FileStatus::Queued;
+  m_ActiveRuns++;
+  tracking.schedulerJobId = scheduler->submitPreparedRun(run, m_Owner, tracking.execution);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int WatchFolder::findEntry(int schedulerJobId) const
+{
+  for(const auto& item : m_Tracking)
+  {
+    if(item.second.execution != nullptr && item.second.schedulerJobId == schedulerJobId)
+    {
+      return item.first;
+    }
+  }
+  return -1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::schedulerJobStarted(int schedulerJobId)
+{
+  int entryId = findEntry(schedulerJobId);
+  if(entryId < 0)
+  {
+    return;
+  }
+  m_Entries[entryId].status = FileStatus::Running;
+  Q_EMIT entriesChanged();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::schedulerJobFinished(int schedulerJobId)
+{
+  int entryId = findEntry(schedulerJobId);
+  if(entryId < 0)
+  {
+    return;
+  }
+
+  Entry& entry = m_Entries[entryId];
+  Tracking& tracking = m_Tracking[entryId];
+  PipelineExecution* execution = tracking.execution;
+  tracking.execution = nullptr;
+
+  entry.elapsedMilliseconds = execution->getElapsedMilliseconds();
+  QStringList errors = execution->getErrorMessages();
+  if(entry.status != FileStatus::Running || execution->wasCancelled())
+  {
+    entry.status = FileStatus::Cancelled;
+  }
+  else if(!errors.isEmpty())
+  {
+    entry.status = FileStatus::Failed;
+    entry.message = errors.front();
+  }
+  else
+  {
+    entry.status = FileStatus::Succeeded;
+    m_ProcessedHashes.insert(entry.hash, entry.filePath);
+    writeIndex();
+  }
+  m_ActiveHashes.remove(entry.hash);
+
+  ExecutionScheduler::ReleaseExecution(execution);
+  m_ActiveRuns--;
+
+  pruneEntries();
+  Q_EMIT entriesChanged();
+  dispatch();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::readIndex()
+{
+  m_ProcessedHashes.clear();
+
+  QFile file(QDir(m_OutputDirectory).filePath(k_IndexFileName));
+  if(!file.open(QIODevice::ReadOnly))
+  {
+    return;
+  }
+
+  QJsonObject index = QJsonDocument::fromJson(file.readAll()).object();
+  for(auto iter = index.constBegin(); iter != index.constEnd(); ++iter)
+  {
+    m_ProcessedHashes.insert(iter.key(), iter.value().toString());
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolder::writeIndex() const
+{
+  QJsonObject index;
+  for(auto iter = m_ProcessedHashes.constBegin(); iter != m_ProcessedHashes.constEnd(); ++iter)
+  {
+    index[iter.key()] = iter.value();
+  }
+
+  QString errorMessage;
+  PipelineFileFormat::WriteFileAtomically(QDir(m_OutputDirectory).filePath(k_IndexFileName), QJsonDocument(index).toJson(QJsonDocument::Compact), errorMessage);
+}
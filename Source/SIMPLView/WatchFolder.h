@@ -0,0 +1,268 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+
+#include "SIMPLView/ParameterSweep.h"
+
+class PipelineExecution;
+class QFileSystemWatcher;
+class QTimer;
+
+/**
+ * @brief The WatchFolder class runs a pipeline on every file that appears in a directory.  A file is picked up
+ * once its size and modification time stopped changing and it can be opened, so files that are still being
+ * written are left alone.  Its content is hashed on the thread pool and files whose content was processed before,
+ * also in an earlier session with the same output directory, are skipped.  The others get a copy of the pipeline
+ * with the file path put into the chosen reader parameter and the writer outputs moved into a directory of their
+ * own, and run as Batch jobs of the execution scheduler with at most getConcurrency() of them active.  Only the
+ * most recent entries that ended are kept.
+ */
+class WatchFolder : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum class FileStatus : int
+  {
+    Settling,
+    Hashing,
+    Waiting,
+    Queued,
+    Running,
+    Succeeded,
+    Failed,
+    Duplicate,
+    Cancelled
+  };
+
+  struct Entry
+  {
+    int id = 0;
+    QString filePath;
+    FileStatus status = FileStatus::Settling;
+    QString hash;
+    qint64 elapsedMilliseconds = 0;
+    QString message;
+    QString outputDirectory;
+  };
+
+  WatchFolder(QObject* parent = nullptr);
+
+  /**
+   * @brief Cancels the active runs
+   */
+  ~WatchFolder() override;
+
+  /**
+   * @brief Returns the string parameters of the input filters of the pipeline, which are the ones a file path
+   * can be put into
+   * @param pipeline
+   * @return
+   */
+  static std::vector<ParameterSweep::Parameter> FindReaderParameters(const QJsonObject& pipeline);
+
+  /**
+   * @brief Returns the content hash used to find files that were processed before
+   * @param filePath
+   * @return The hash in hex, or an empty string if the file cannot be read
+   */
+  static QString HashFile(const QString& filePath);
+
+  /**
+   * @brief Sets the pipeline and the parameter that receives the path of each file
+   * @param pipeline
+   * @param reader The filter index and path of the parameter
+   */
+  void setPipeline(const QJsonObject& pipeline, const ParameterSweep::Parameter& reader);
+
+  void setInputDirectory(const QString& directory);
+  QString getInputDirectory() const;
+
+  /**
+   * @brief Sets the wildcard patterns of the files that are processed, such as "*.tif"
+   * @param nameFilters
+   */
+  void setNameFilters(const QStringList& nameFilters);
+  QStringList getNameFilters() const;
+
+  void setOutputDirectory(const QString& directory);
+  QString getOutputDirectory() const;
+
+  void setConcurrency(int concurrency);
+  int getConcurrency() const;
+
+  /**
+   * @brief Sets the name the runs are shown with in the execution queue
+   * @param owner
+   */
+  void setOwner(const QString& owner);
+
+  /**
+   * @brief Starts watching the input directory
+   * @param processExisting True to also process the files that are already there
+   * @param errorMessage
+   * @return
+   */
+  bool start(bool processExisting, QString& errorMessage);
+
+  /**
+   * @brief Stops picking up files.  Runs that were already handed to the scheduler continue.
+   */
+  void stop();
+
+  bool isWatching() const;
+
+  /**
+   * @brief Returns true while watching or while runs are active
+   * @return
+   */
+  bool isBusy() const;
+
+  /**
+   * @brief Returns the files that were seen, in the order they appeared
+   * @return
+   */
+  std::vector<Entry> getEntries() const;
+
+Q_SIGNALS:
+  void entriesChanged();
+  void watchingChanged(bool watching);
+
+private:
+  struct Tracking
+  {
+    qint64 size = -1;
+    qint64 lastModified = 0;
+    qint64 unchangedSince = 0;
+    int schedulerJobId = -1;
+    PipelineExecution* execution = nullptr;
+  };
+
+  QJsonObject m_Pipeline;
+  ParameterSweep::Parameter m_Reader;
+  std::vector<int> m_OutputFilters;
+  QString m_InputDirectory;
+  QStringList m_NameFilters;
+  QString m_OutputDirectory;
+  QString m_Owner;
+  int m_Concurrency = 1;
+  bool m_Watching = false;
+
+  std::map<int, Entry> m_Entries;
+  std::map<int, Tracking> m_Tracking;
+  QHash<QString, int> m_EntryIds;
+  QHash<QString, QString> m_ProcessedHashes;
+  QHash<QString, int> m_ActiveHashes;
+  int m_NextEntryId = 0;
+  int m_ActiveRuns = 0;
+
+  QFileSystemWatcher* m_FileSystemWatcher = nullptr;
+  QTimer* m_ScanTimer = nullptr;
+  QTimer* m_PollTimer = nullptr;
+  qint64 m_LastScan = 0;
+
+  /**
+   * @brief Lists the input directory once the file system watcher reported a change, and regularly as a fallback
+   * for shares that do not report changes.  Polls the files that are still settling.
+   */
+  void poll();
+
+  /**
+   * @brief Adds the files of the input directory that are not known yet and forgets the remembered paths of the
+   * files that are gone
+   * @param ignore True to remember them without processing them
+   */
+  void scanDirectory(bool ignore = false);
+
+  /**
+   * @brief Starts hashing the files that stopped changing
+   */
+  void checkSettlingFiles();
+
+  /**
+   * @brief Skips a file whose content was seen before and queues the others
+   * @param entryId
+   * @param hash
+   */
+  void hashFinished(int entryId, const QString& hash);
+
+  /**
+   * @brief Drops the oldest entries that succeeded, failed, were duplicates or were cancelled, beyond a
+   * fixed number.  Their paths are still remembered.
+   */
+  void pruneEntries();
+
+  /**
+   * @brief Submits waiting files until getConcurrency() runs are active
+   */
+  void dispatch();
+
+  /**
+   * @brief Builds the pipeline of a file and queues it in the scheduler
+   * @param entry
+   */
+  void submitEntry(Entry& entry);
+
+  /**
+   * @brief Returns the id of the entry of a scheduler job, or -1
+   * @param schedulerJobId
+   * @return
+   */
+  int findEntry(int schedulerJobId) const;
+
+  void schedulerJobStarted(int schedulerJobId);
+  void schedulerJobFinished(int schedulerJobId);
+
+  /**
+   * @brief Reads and writes the hashes of the files processed into the output directory
+   */
+  void readIndex();
+  void writeIndex() const;
+
+public:
+  WatchFolder(const WatchFolder&) = delete;            // Copy Constructor Not Implemented
+  WatchFolder(WatchFolder&&) = delete;                 // Move Constructor Not Implemented
+  WatchFolder& operator=(const WatchFolder&) = delete; // Copy Assignment Not Implemented
+  WatchFolder& operator=(WatchFolder&&) = delete;      // Move Assignment Not Implemented
+};
@@ -0,0 +1,317 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include "WatchFolderDialog.h"
+
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSignalBlocker>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
+#include <QtWidgets/QCheckBox>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QDialogButtonBox>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QFormLayout>
+#include <QtWidgets/QHBoxLayout>
+#include <QtWidgets/QLabel>
+#include <QtWidgets/QLineEdit>
+#include <QtWidgets/QMessageBox>
+#include <QtWidgets/QPushButton>
+#include <QtWidgets/QSpinBox>
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QVBoxLayout>
+
+#include "SIMPLView/WatchFolder.h"
+
+namespace
+{
+const int k_RefreshDelay = 250;
+
+enum Column
+{
+  FileColumn = 0,
+  StatusColumn,
+  TimeColumn,
+  MessageColumn,
+  OutputColumn,
+  ColumnCount
+};
+
+// -----------------------------------------------------------------------------
+QString StatusName(WatchFolder::FileStatus status)
+{
+  switch(status)
+  {
+  case WatchFolder::FileStatus::Settling:
+    return QObject::tr("Being written");
+  case WatchFolder::FileStatus::Hashing:
+    return QObject::tr("Hashing");
+  case WatchFolder::FileStatus::Waiting:
+    return QObject::tr("Waiting");
+  case WatchFolder::FileStatus::Queued:
+    return QObject::tr("Queued");
+  case WatchFolder::FileStatus::Running:
+    return QObject::tr("Running");
+  case WatchFolder::FileStatus::Succeeded:
+    return QObject::tr("Succeeded");
+  case WatchFolder::FileStatus::Failed:
+    return QObject::tr("Failed");
+  case WatchFolder::FileStatus::Duplicate:
+    return QObject::tr("Duplicate");
+  case WatchFolder::FileStatus::Cancelled:
+    return QObject::tr("Cancelled");
+  }
+  return QString();
+}
+
+// -----------------------------------------------------------------------------
+QString FormatDuration(qint64 milliseconds)
+{
+  qint64 seconds = milliseconds / 1000;
+  return QString("%1:%2:%3").arg(seconds / 3600).arg((seconds / 60) % 60, 2, 10, QChar('0')).arg(seconds % 60, 2, 10, QChar('0'));
+}
+
+// -----------------------------------------------------------------------------
+QHBoxLayout* CreateDirectoryRow(QWidget* parent, QLineEdit* edit, const QString& caption)
+{
+  QPushButton* browseButton = new QPushButton(QObject::tr("Browse..."), parent);
+  QObject::connect(browseButton, &QPushButton::clicked, parent, [parent, edit, caption] {
+    QString directory = QFileDialog::getExistingDirectory(parent, caption, edit->text());
+    if(!directory.isEmpty())
+    {
+      edit->setText(QDir::toNativeSeparators(directory));
+    }
+  });
+
+  QHBoxLayout* layout = new QHBoxLayout();
+  layout->addWidget(edit, 1);
+  layout->addWidget(browseButton);
+  return layout;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WatchFolderDialog::WatchFolderDialog(QWidget* parent)
+: QDialog(parent)
+{
+  setWindowTitle(tr("Watch Folder"));
+  resize(800, 560);
+
+  m_WatchFolder = new WatchFolder(this);
+
+  m_InputDirectoryEdit = new QLineEdit(this);
+  m_NameFiltersEdit = new QLineEdit("*", this);
+  m_NameFiltersEdit->setToolTip(tr("Wildcard patterns of the files to process, separated by spaces, such as *.tif *.png"));
+  m_ReaderCombo = new QComboBox(this);
+  m_ReaderCombo->setToolTip(tr("The parameter of a reader filter that receives the path of each new file."));
+  m_OutputDirectoryEdit = new QLineEdit(this);
+  m_OutputDirectoryEdit->setToolTip(tr("Every file gets a directory of its own below this one for its results."));
+  m_ConcurrencySpinBox = new QSpinBox(this);
+  m_ConcurrencySpinBox->setRange(1, std::max(QThread::idealThreadCount(), 1) * 4);
+  m_ConcurrencySpinBox->setValue(std::max(QThread::idealThreadCount() / 2, 1));
+  m_ProcessExistingCheckBox = new QCheckBox(tr("Also process the files already in the folder"), this);
+
+  QFormLayout* settingsLayout = new QFormLayout();
+  settingsLayout->addRow(tr("Input directory:"), CreateDirectoryRow(this, m_InputDirectoryEdit, tr("Input Directory")));
+  settingsLayout->addRow(tr("Files:"), m_NameFiltersEdit);
+  settingsLayout->addRow(tr("Reader parameter:"), m_ReaderCombo);
+  settingsLayout->addRow(tr("Output directory:"), CreateDirectoryRow(this, m_OutputDirectoryEdit, tr("Output Directory")));
+  settingsLayout->addRow(tr("Concurrent runs:"), m_ConcurrencySpinBox);
+  settingsLayout->addRow(QString(), m_ProcessExistingCheckBox);
+
+  m_EntriesTree = new QTreeWidget(this);
+  m_EntriesTree->setColumnCount(ColumnCount);
+  m_EntriesTree->setHeaderLabels({tr("File"), tr("Status"), tr("Time"), tr("Message"), tr("Output Directory")});
+  m_EntriesTree->setRootIsDecorated(false);
+  m_SummaryLabel = new QLabel(this);
+
+  m_StartButton = new QPushButton(tr("Start Watching"), this);
+  QDialogButtonBox* buttonBox = new QDialogButtonBox(QDialogButtonBox::Close, this);
+  buttonBox->addButton(m_StartButton, QDialogButtonBox::ActionRole);
+
+  QVBoxLayout* layout = new QVBoxLayout(this);
+  layout->addLayout(settingsLayout);
+  layout->addWidget(m_EntriesTree, 1);
+  layout->addWidget(m_SummaryLabel);
+  layout->addWidget(buttonBox);
+
+  // Files can arrive quickly, so the list is refilled at most a few times per second
+  m_RefreshTimer = new QTimer(this);
+  m_RefreshTimer->setSingleShot(true);
+  m_RefreshTimer->setInterval(k_RefreshDelay);
+  connect(m_RefreshTimer, &QTimer::timeout, this, &WatchFolderDialog::refreshEntries);
+  connect(m_WatchFolder, &WatchFolder::entriesChanged, m_RefreshTimer, [this] {
+    if(!m_RefreshTimer->isActive())
+    {
+      m_RefreshTimer->start();
+    }
+  });
+  connect(m_WatchFolder, &WatchFolder::watchingChanged, this, &WatchFolderDialog::updateControls);
+
+  connect(m_StartButton, &QPushButton::clicked, this, &WatchFolderDialog::toggleWatching);
+  connect(m_ConcurrencySpinBox, QOverload<int>::of(&QSpinBox::valueChanged), m_WatchFolder, &WatchFolder::setConcurrency);
+  connect(buttonBox, &QDialogButtonBox::rejected, this, &WatchFolderDialog::hide);
+
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+WatchFolderDialog::~WatchFolderDialog() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolderDialog::setPipeline(const QJsonObject& pipeline, const QString& owner)
+{
+  if(m_WatchFolder->isBusy())
+  {
+    return;
+  }
+
+  m_Pipeline = pipeline;
+  m_WatchFolder->setOwner(owner);
+  m_ReaderParameters = WatchFolder::FindReaderParameters(m_Pipeline);
+
+  // The first parameter that names a file is the likely one
+  QSignalBlocker blocker(m_ReaderCombo);
+  m_ReaderCombo->clear();
+  int likely = -1;
+  for(size_t i = 0; i < m_ReaderParameters.size(); i++)
+  {
+    const ParameterSweep::Parameter& parameter = m_ReaderParameters[i];
+    m_ReaderCombo->addItem(QString("%1 - %2").arg(parameter.filterLabel, ParameterSweep::PathToString(parameter.path)));
+    QString key = parameter.path.last();
+    if(likely < 0 && (key.contains("File", Qt::CaseInsensitive) || key.contains("Path", Qt::CaseInsensitive)))
+    {
+      likely = static_cast<int>(i);
+    }
+  }
+  m_ReaderCombo->setCurrentIndex(std::max(likely, 0));
+  updateControls();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool WatchFolderDialog::isBusy() const
+{
+  return m_WatchFolder->isBusy();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolderDialog::toggleWatching()
+{
+  if(m_WatchFolder->isWatching())
+  {
+    m_WatchFolder->stop();
+    return;
+  }
+
+  int reader = m_ReaderCombo->currentIndex();
+  if(reader < 0 || reader >= static_cast<int>(m_ReaderParameters.size()))
+  {
+    QMessageBox::warning(this, tr("Watch Folder"), tr("The pipeline has no reader filter whose file can be replaced."));
+    return;
+  }
+
+  m_WatchFolder->setPipeline(m_Pipeline, m_ReaderParameters[reader]);
+  m_WatchFolder->setInputDirectory(QDir::fromNativeSeparators(m_InputDirectoryEdit->text().trimmed()));
+  m_WatchFolder->setNameFilters(m_NameFiltersEdit->text().split(' ', QString::SkipEmptyParts));
+  m_WatchFolder->setOutputDirectory(QDir::fromNativeSeparators(m_OutputDirectoryEdit->text().trimmed()));
+  m_WatchFolder->setConcurrency(m_ConcurrencySpinBox->value());
+
+  QString errorMessage;
+  if(!m_WatchFolder->start(m_ProcessExistingCheckBox->isChecked(), errorMessage))
+  {
+    QMessageBox::warning(this, tr("Watch Folder"), errorMessage);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolderDialog::updateControls()
+{
+  bool watching = m_WatchFolder->isWatching();
+  m_InputDirectoryEdit->setEnabled(!watching);
+  m_NameFiltersEdit->setEnabled(!watching);
+  m_ReaderCombo->setEnabled(!watching);
+  m_OutputDirectoryEdit->setEnabled(!watching);
+  m_ProcessExistingCheckBox->setEnabled(!watching);
+  m_StartButton->setText(watching ? tr("Stop Watching") : tr("Start Watching"));
+  m_StartButton->setEnabled(watching || m_ReaderCombo->count() > 0);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void WatchFolderDialog::refreshEntries()
+{
+  std::vector<WatchFolder::Entry> entries = m_WatchFolder->getEntries();
+  int succeeded = 0;
+  int failed = 0;
+  int duplicates = 0;
+
+  m_EntriesTree->setUpdatesEnabled(false);
+  m_EntriesTree->clear();
+  for(const WatchFolder::Entry& entry : entries)
+  {
+    QTreeWidgetItem* item = new QTreeWidgetItem(m_EntriesTree);
+    item->setText(FileColumn, QFileInfo(entry.filePath).fileName());
+    item->setToolTip(FileColumn, QDir::toNativeSeparators(entry.filePath));
+    item->setText(StatusColumn, StatusName(entry.status));
+    item->setText(TimeColumn, entry.elapsedMilliseconds > 0 ? FormatDuration(entry.elapsedMilliseconds) : QString());
+    item->setText(MessageColumn, entry.message);
+    item->setToolTip(MessageColumn, entry.message);
+    item->setText(OutputColumn, QDir::toNativeSeparators(entry.outputDirectory));
+
+    succeeded += entry.status == WatchFolder::FileStatus::Succeeded ? 1 : 0;
+    failed += entry.status == WatchFolder::FileStatus::Failed ? 1 : 0;
+    duplicates += entry.status == WatchFolder::FileStatus::Duplicate ? 1 : 0;
+  }
+  m_EntriesTree->setUpdatesEnabled(true);
+  m_EntriesTree->scrollToBottom();
+
+  m_SummaryLabel->setText(tr("%1 files seen, %2 processed, %3 failed, %4 duplicates").arg(entries.size()).arg(succeeded).arg(failed).arg(duplicates));
+}
@@ -0,0 +1,117 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtWidgets/QDialog>
+
+#include "SIMPLView/ParameterSweep.h"
+
+class QCheckBox;
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QPushButton;
+class QSpinBox;
+class QTimer;
+class QTreeWidget;
+class WatchFolder;
+
+/**
+ * @brief The WatchFolderDialog class binds the pipeline of a window to an input directory and shows the files the
+ * WatchFolder picked up from it.
+ */
+class WatchFolderDialog : public QDialog
+{
+  Q_OBJECT
+
+public:
+  WatchFolderDialog(QWidget* parent = nullptr);
+  ~WatchFolderDialog() override;
+
+  /**
+   * @brief Sets the pipeline that is run on the files.  Ignored while the folder is watched.
+   * @param pipeline
+   * @param owner The name the runs are shown with in the execution queue
+   */
+  void setPipeline(const QJsonObject& pipeline, const QString& owner);
+
+  /**
+   * @brief Returns true while the folder is watched or runs are active
+   * @return
+   */
+  bool isBusy() const;
+
+public Q_SLOTS:
+  /**
+   * @brief Starts or stops watching
+   */
+  void toggleWatching();
+
+  /**
+   * @brief Refills the file list
+   */
+  void refreshEntries();
+
+private:
+  WatchFolder* m_WatchFolder = nullptr;
+  QJsonObject m_Pipeline;
+  std::vector<ParameterSweep::Parameter> m_ReaderParameters;
+
+  QLineEdit* m_InputDirectoryEdit = nullptr;
+  QLineEdit* m_NameFiltersEdit = nullptr;
+  QComboBox* m_ReaderCombo = nullptr;
+  QLineEdit* m_OutputDirectoryEdit = nullptr;
+  QSpinBox* m_ConcurrencySpinBox = nullptr;
+  QCheckBox* m_ProcessExistingCheckBox = nullptr;
+  QPushButton* m_StartButton = nullptr;
+  QLabel* m_SummaryLabel = nullptr;
+  QTreeWidget* m_EntriesTree = nullptr;
+  QTimer* m_RefreshTimer = nullptr;
+
+  /**
+   * @brief Enables the settings that must not change while watching
+   */
+  void updateControls();
+
+public:
+  WatchFolderDialog(const WatchFolderDialog&) = delete;            // Copy Constructor Not Implemented
+  WatchFolderDialog(WatchFolderDialog&&) = delete;                 // Move Constructor Not Implemented
+  WatchFolderDialog& operator=(const WatchFolderDialog&) = delete; // Copy Assignment Not Implemented
+  WatchFolderDialog& operator=(WatchFolderDialog&&) = delete;      // Move Assignment Not Implemented
+};
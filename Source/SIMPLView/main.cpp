@@ -37,6 +37,7 @@
 #include <QtCore/QDir>
 #include <QtCore/QString>
 #include <QtCore/QOperatingSystemVersion>
+#include <QtCore/QTimer>
 
 #include <QtGui/QFontDatabase>
 
@@ -47,8 +48,11 @@
 #include "SVWidgetsLib/SVWidgetsLib.h"
 #include "SVWidgetsLib/Widgets/SVStyle.h"
 
+#include "PipelineWorker.h"
+#include "ProcessPool.h"
 #include "SIMPLView.h"
 #include "SIMPLViewApplication.h"
+#include "SIMPLViewConstants.h"
 #include "SIMPLView_UI.h"
 #include "StyleSheetEditor.h"
 
@@ -190,6 +194,16 @@ int main(int argc, char* argv[])
   QCoreApplication::setOrganizationName(BrandedStrings::OrganizationName);
   QCoreApplication::setApplicationName(BrandedStrings::ApplicationName);
 
+  // Worker processes of the process pool and batch runs from scripts do not open any window
+  if(argc >= 2 && ProcessPool::WorkerArgument == QString::fromLocal8Bit(argv[1]))
+  {
+    return PipelineWorker::Exec(argc, argv);
+  }
+  if(argc >= 2 && SIMPLView::Worker::BatchArgument == QString::fromLocal8Bit(argv[1]))
+  {
+    return PipelineWorker::ExecBatch(argc, argv);
+  }
+
   SIMPLViewApplication qtapp(argc, argv);
 
 #ifdef SIMPL_EMBED_PYTHON
@@ -291,6 +305,9 @@ int main(int argc, char* argv[])
   QtSDocServer::Instance();
 #endif
 
+  // Offer the pipelines a crashed session left behind once the first window is up
+  QTimer::singleShot(0, &qtapp, &SIMPLViewApplication::recoverPipelineJournals);
+
   int err = SIMPLViewApplication::exec();
   return err;
 }
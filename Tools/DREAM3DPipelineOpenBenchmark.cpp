@@ -0,0 +1,169 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <hdf5.h>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+
+#include "H5Support/QH5Lite.h"
+#include "H5Support/QH5Utilities.h"
+
+#include "SIMPLView/DREAM3DPipelineReader.h"
+
+namespace
+{
+const char k_SyntheticPipeline[] = R"({"0":{"Filter_Human_Label":"Create Data Container","Filter_Name":"CreateDataContainer","Filter_Uuid":"{816fbe6b-7c38-581b-b149-3f839fb65b93}"},)"
+                                   R"("PipelineBuilder":{"Name":"Benchmark","Number_Filters":1,"Version":6}})";
+
+/**
+ * @brief Writes a .dream3d file whose single array reserves the requested number of bytes.  The array is
+ * allocated in the file but never written, so the file is created instantly and is sparse on disk.
+ */
+bool GenerateFile(const QString& filePath, hsize_t bytes)
+{
+  hid_t fileId = QH5Utilities::createFile(filePath);
+  if(fileId < 0)
+  {
+    return false;
+  }
+
+  hid_t groupId = QH5Utilities::createGroup(fileId, "DataContainers");
+  hid_t dataSpaceId = H5Screate_simple(1, &bytes, nullptr);
+  hid_t propertyListId = H5Pcreate(H5P_DATASET_CREATE);
+  H5Pset_alloc_time(propertyListId, H5D_ALLOC_TIME_EARLY);
+  H5Pset_fill_time(propertyListId, H5D_FILL_TIME_NEVER);
+  hid_t dataSetId = H5Dcreate2(groupId, "Data", H5T_NATIVE_UINT8, dataSpaceId, H5P_DEFAULT, propertyListId, H5P_DEFAULT);
+  bool success = dataSetId >= 0;
+
+  H5Dclose(dataSetId);
+  H5Pclose(propertyListId);
+  H5Sclose(dataSpaceId);
+  H5Gclose(groupId);
+
+  hid_t pipelineGroupId = QH5Utilities::createGroup(fileId, "Pipeline");
+  H5Gclose(pipelineGroupId);
+  success = success && QH5Lite::writeStringAttribute(fileId, "Pipeline", "Pipeline", QString::fromLatin1(k_SyntheticPipeline)) >= 0;
+
+  QH5Utilities::closeFile(fileId);
+  return success;
+}
+
+/**
+ * @brief Returns the median time in microseconds taken to extract the pipeline from the file
+ */
+double MedianMicroseconds(const QString& filePath, int iterations, bool& success)
+{
+  std::vector<qint64> times;
+  success = true;
+  for(int i = 0; i < iterations; i++)
+  {
+    QByteArray json;
+    QString errorMessage;
+    QElapsedTimer timer;
+    timer.start();
+    success = DREAM3DPipelineReader::ReadPipelineJson(filePath, json, errorMessage) && success;
+    times.push_back(timer.nsecsElapsed());
+  }
+
+  std::sort(times.begin(), times.end());
+  return times[times.size() / 2] / 1000.0;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//  Measures how long it takes to extract the embedded pipeline from .dream3d files of increasing size.  The time
+//  should stay flat because no dataset is read.
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("DREAM3DPipelineOpenBenchmark");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Benchmarks extracting the pipeline from .dream3d files of different sizes");
+  parser.addHelpOption();
+  parser.addPositionalArgument("files", "Existing .dream3d files to benchmark", "[files...]");
+  QCommandLineOption generateOption("generate", "Generate sparse .dream3d files of 1, 10 and 100 GB in the directory", "directory");
+  QCommandLineOption iterationsOption({"n", "iterations"}, "Number of iterations per file", "count", "20");
+  parser.addOption(generateOption);
+  parser.addOption(iterationsOption);
+  parser.process(app);
+
+  QStringList files = parser.positionalArguments();
+  if(parser.isSet(generateOption))
+  {
+    QDir dir(parser.value(generateOption));
+    dir.mkpath(".");
+    for(hsize_t gigabytes : {1, 10, 100})
+    {
+      QString filePath = dir.absoluteFilePath(QString("Benchmark_%1GB.dream3d").arg(gigabytes));
+      if(!GenerateFile(filePath, gigabytes * 1024 * 1024 * 1024))
+      {
+        std::cerr << "Unable to generate " << filePath.toStdString() << std::endl;
+        return 1;
+      }
+      files.push_back(filePath);
+    }
+  }
+
+  if(files.isEmpty())
+  {
+    parser.showHelp(1);
+  }
+
+  int iterations = std::max(1, parser.value(iterationsOption).toInt());
+  int err = 0;
+  for(const QString& filePath : files)
+  {
+    bool success = false;
+    double time = MedianMicroseconds(filePath, iterations, success);
+    if(!success)
+    {
+      err = 1;
+    }
+
+    std::cout << QFileInfo(filePath).fileName().toStdString() << ": " << QFileInfo(filePath).size() << " bytes, open " << time << " us" << (success ? "" : " (no pipeline found)") << std::endl;
+  }
+
+  return err;
+}
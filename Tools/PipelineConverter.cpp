@@ -0,0 +1,81 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <iostream>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QJsonObject>
+
+#include "SIMPLView/PipelineFileFormat.h"
+
+// -----------------------------------------------------------------------------
+//  Converts a pipeline file between the JSON and CBOR formats.  The output format is chosen from the suffix of the
+//  output file, the input format is detected from the content.
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("PipelineConverter");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Converts a pipeline file between the .json and .cbor formats");
+  parser.addHelpOption();
+  parser.addPositionalArgument("input", "The pipeline file to read (.json or .cbor)");
+  parser.addPositionalArgument("output", "The pipeline file to write; its suffix selects the format");
+  parser.process(app);
+
+  QStringList arguments = parser.positionalArguments();
+  if(arguments.size() != 2)
+  {
+    parser.showHelp(1);
+  }
+
+  QJsonObject pipeline;
+  QString errorMessage;
+  if(!PipelineFileFormat::ReadFile(arguments[0], pipeline, errorMessage))
+  {
+    std::cerr << errorMessage.toStdString() << std::endl;
+    return 1;
+  }
+
+  if(!PipelineFileFormat::WriteFile(arguments[1], pipeline, errorMessage))
+  {
+    std::cerr << errorMessage.toStdString() << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+/* ============================================================================
+ * Copyright (c) 2009-2016 BlueQuartz Software, LLC
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * Redistributions in binary form must reproduce the above copyright notice, this
+ * list of conditions and the following disclaimer in the documentation and/or
+ * other materials provided with the distribution.
+ *
+ * Neither the name of BlueQuartz Software, the US Air Force, nor the names of its
+ * contributors may be used to endorse or promote products derived from this software
+ * without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+ * USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * The code contained herein was partially funded by the following contracts:
+ *    United States Air Force Prime Contract FA8650-07-D-5800
+ *    United States Air Force Prime Contract FA8650-10-D-5210
+ *    United States Prime Contract Navy N00173-07-C-2068
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+
+#include "SIMPLView/PipelineFileFormat.h"
+
+namespace
+{
+/**
+ * @brief Runs the function the given number of times and returns the median time in microseconds
+ */
+template <typename Function>
+double MedianMicroseconds(int iterations, Function function)
+{
+  std::vector<qint64> times;
+  times.reserve(iterations);
+  for(int i = 0; i < iterations; i++)
+  {
+    QElapsedTimer timer;
+    timer.start();
+    function();
+    times.push_back(timer.nsecsElapsed());
+  }
+
+  std::sort(times.begin(), times.end());
+  return times[times.size() / 2] / 1000.0;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//  Measures how long a pipeline takes to encode and decode in the JSON and CBOR formats, and checks that both
+//  round trips give back the same pipeline.
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  QCoreApplication app(argc, argv);
+  QCoreApplication::setApplicationName("PipelineFormatBenchmark");
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("Benchmarks loading and saving a pipeline in the .json and .cbor formats");
+  parser.addHelpOption();
+  parser.addPositionalArgument("pipeline", "The pipeline file to benchmark (.json or .cbor)");
+  QCommandLineOption iterationsOption({"n", "iterations"}, "Number of iterations per measurement", "count", "20");
+  parser.addOption(iterationsOption);
+  parser.process(app);
+
+  QStringList arguments = parser.positionalArguments();
+  if(arguments.size() != 1)
+  {
+    parser.showHelp(1);
+  }
+
+  int iterations = std::max(1, parser.value(iterationsOption).toInt());
+
+  QJsonObject pipeline;
+  QString errorMessage;
+  if(!PipelineFileFormat::ReadFile(arguments[0], pipeline, errorMessage))
+  {
+    std::cerr << errorMessage.toStdString() << std::endl;
+    return 1;
+  }
+
+  int err = 0;
+  for(PipelineFileFormat::Format format : {PipelineFileFormat::Format::Json, PipelineFileFormat::Format::Cbor})
+  {
+    QString name = format == PipelineFileFormat::Format::Cbor ? "CBOR" : "JSON";
+    QByteArray data = PipelineFileFormat::Encode(pipeline, format);
+
+    double saveTime = MedianMicroseconds(iterations, [&] { PipelineFileFormat::Encode(pipeline, format); });
+
+    QJsonObject decoded;
+    double loadTime = MedianMicroseconds(iterations, [&] { PipelineFileFormat::Decode(data, decoded, errorMessage); });
+
+    bool roundTrips = PipelineFileFormat::Decode(data, decoded, errorMessage) && decoded == pipeline;
+    if(!roundTrips)
+    {
+      err = 1;
+    }
+
+    std::cout << name.toStdString() << ": " << data.size() << " bytes, save " << saveTime << " us, load " << loadTime << " us, round trip " << (roundTrips ? "OK" : "FAILED")
+              << std::endl;
+  }
+
+  return err;
+}